@@ -3,6 +3,8 @@
 #include "ProjectManager.h"
 #include "EditorSettings.h"
 #include <Eunoia\Core\Engine.h>
+#include <Eunoia\Core\Benchmark.h>
+#include <Eunoia\Core\JobSystem.h>
 #include <Eunoia\ECS\Systems\TransformHierarchy2DSystem.h>
 #include <Eunoia\ECS\Systems\TransformHierarchy3DSystem.h>
 #include <Eunoia\ECS\Systems\ViewProjectionSystem.h>
@@ -25,6 +27,8 @@ namespace Eunoia_Editor
 		EditorSettings::LoadEditorSettingsFromFile();
 		EditorGUI::Init();
 		ProjectManager::Init();
+		//The editor mostly sits still, only redraw when something changes
+		Eunoia::Engine::SetRenderOnDemand(true);
 
 		m_ECS->CreateScene("Scene", true);
 		m_ECS->CreateSystem<Eunoia::ViewProjectionSystem>();
@@ -60,13 +64,14 @@ namespace Eunoia_Editor
 			EditorGUI::CheckForShortcuts();
 			if (project->stepApplication)
 			{
+				Eunoia::Engine::RequestRender();
 				project->application->Update(dt);
 				project->application->BeginECS();
 				project->application->UpdateECS(dt);
 			}
 			else
 			{
-				project->application->GetECS()->OnlyUpdateRequiredSystems(dt);
+				project->application->GetECS()->UpdateBackgroundSystems(dt);
 			}
 		}
 	}
@@ -100,13 +105,45 @@ namespace Eunoia_Editor
 	{
 		EunoiaProject* project = ProjectManager::GetProject();
 		if (project->loaded && project->stepApplication)
+		{
 			project->application->GetECS()->PostPhysicsSystems(dt);
+			project->playRecorder.RecordFrame(project->application->GetECS(), dt);
+		}
 	}
 }
 
-int main()
+int main(int argc, char** argv)
 {
+	//--run-tests and --run-benchmarks run without a window or the editor, the exit code is 1 if a test failed
+	b32 runTests = false;
+	b32 runBenchmarks = false;
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "--run-tests") == 0)
+			runTests = true;
+		else if (strcmp(argv[i], "--run-benchmarks") == 0)
+			runBenchmarks = true;
+	}
+
 	Eunoia::Application* app = new Eunoia_Editor::EditorApp();
+	if (runTests || runBenchmarks)
+	{
+		Eunoia::Engine::Init(app, "Eunoia Editor", 1280, 720, Eunoia::RENDER_API_NULL, false, Eunoia::EUNOIA_WORLD_FLAG_HEADLESS);
+		b32 passed = true;
+		if (runTests)
+		{
+			passed &= Eunoia::ECS::RunTests();
+			passed &= Eunoia::JobSystem::RunTests();
+		}
+		if (runBenchmarks)
+			Eunoia::RunAllBenchmarks();
+		Eunoia::Engine::DestroyWorld(Eunoia::EUNOIA_WORLD_MAIN);
+		Eunoia::JobSystem::Destroy();
+
+		delete app;
+		return passed ? 0 : 1;
+	}
+
 	Eunoia::Engine::Init(app, "Eunoia Editor - Select Project", 1280, 720, Eunoia::RENDER_API_VULKAN);
 	Eunoia::Engine::Start();
 
@@ -2,6 +2,8 @@
 
 #include <Eunoia\Core\Engine.h>
 #include <Eunoia\Core\Input.h>
+#include <Eunoia\Core\Benchmark.h>
+#include <Eunoia\Core\JobSystem.h>
 #include <Eunoia\Math\Math.h>
 #include <Eunoia\Rendering\RenderContext.h>
 #include <Eunoia\Rendering\Asset\AssetManager.h>
@@ -93,6 +95,7 @@ namespace Eunoia_Editor {
 		s32 selectedCollisionShape;
 		b32 waitForKeySelection;
 		Key* keyValueToSet;
+		b32 keyValueSet;
 		v3* colorPickerColor;
 
 		TransformWidgetMode transformWidgetMode;
@@ -130,6 +133,7 @@ namespace Eunoia_Editor {
 			{
 				data->waitForKeySelection = false;
 				*data->keyValueToSet = (Key)eventInfo.input;
+				data->keyValueSet = true;
 			}
 		}
 		if (eventInfo.type == Eunoia::DISPLAY_EVENT_KEY && eventInfo.inputType == Eunoia::DISPLAY_INPUT_EVENT_RELEASE)
@@ -160,6 +164,9 @@ namespace Eunoia_Editor {
 		s_Data.transformWidgetMode = TRANSFORM_WIDGET_TRANSLATE;
 		s_Data.materialEditMode = MATERIAL_EDIT_NONE;
 		s_Data.selectedCollisionShape = -1;
+		s_Data.waitForKeySelection = false;
+		s_Data.keyValueToSet = 0;
+		s_Data.keyValueSet = false;
 		s_Data.assetModifyIndex = 0;
 		s_Data.engineCamera = ENGINE_CAMERA_3D;
 
@@ -683,6 +690,18 @@ namespace Eunoia_Editor {
 				if (ImGui::MenuItem("Theme"))
 				{
 
+				} ImGui::Separator();
+				if (ImGui::MenuItem("Run Tests"))
+				{
+					Engine::WaitForRenderThread();
+					ECS::RunTests();
+					JobSystem::RunTests();
+				}
+				if (ImGui::MenuItem("Run Benchmarks"))
+				{
+					//Results go to the log, the editor stalls while they run
+					Engine::WaitForRenderThread();
+					RunAllBenchmarks();
 				}
 				ImGui::EndMenu();
 			}
@@ -724,7 +743,8 @@ namespace Eunoia_Editor {
 					{
 						project->stepApplication = false;
 						project->stepPaused = false;
-						project->application->GetECS()->RestoreResetPoint(project->resetPoint);
+						project->application->GetECS()->RestoreSnapshot(project->playSnapshot);
+						project->playRecorder.Reset();
 						SetEngineCamera(s_Data.engineCamera);
 					}
 				}
@@ -737,11 +757,18 @@ namespace Eunoia_Editor {
 							project->stepApplication = true;
 							project->stepPaused = false;
 						} ImGui::SameLine();
+						if (project->playRecorder.GetNumFrames() > 0)
+						{
+							if (ImGui::Button("STEP BACK"))
+								project->playRecorder.Rewind(project->application->GetECS(), 1);
+							ImGui::SameLine();
+						}
 						if (ImGui::Button("STOP"))
 						{
 							project->stepApplication = false;
 							project->stepPaused = false;
-							project->application->GetECS()->RestoreResetPoint(project->resetPoint);
+							project->application->GetECS()->RestoreSnapshot(project->playSnapshot);
+							project->playRecorder.Reset();
 							SetEngineCamera(s_Data.engineCamera);
 						}
 					}
@@ -751,7 +778,8 @@ namespace Eunoia_Editor {
 						{
 							project->stepApplication = true;
 							project->stepPaused = false;
-							project->application->GetECS()->CreateResetPoint(&project->resetPoint);
+							project->application->GetECS()->CreateSnapshot(&project->playSnapshot);
+							project->playRecorder.Reset();
 							SetEngineCamera(ENGINE_CAMERA_NONE);
 						}
 					}
@@ -763,7 +791,7 @@ namespace Eunoia_Editor {
 
 	static void DrawEntityHierarchy(EntityID entityID, const List<ECSEntityContainer>& entities)
 	{
-		const ECSEntityContainer& entity = entities[entityID - 2];
+		const ECSEntityContainer& entity = entities[EU_ECS_ENTITY_SLOT(entityID)];
 		if (ImGui::Selectable((entity.name + "##SelectEntity").C_Str(), entityID == s_Data.selectedEntity))
 		{
 			s_Data.selectedEntity = entityID;
@@ -862,7 +890,7 @@ namespace Eunoia_Editor {
 			{
 				const List<ECSEntityContainer>& entities = ecs->GetAllEntities_();
 				EntityID rootEntityID = ecs->GetRootEntity();
-				const ECSEntityContainer rootEntity = entities[rootEntityID - 2];
+				const ECSEntityContainer rootEntity = entities[EU_ECS_ENTITY_SLOT(rootEntityID)];
 
 				for (u32 i = 0; i < rootEntity.children.Size(); i++)
 					DrawSceneHierarchyEntity(rootEntity.children[i]);
@@ -875,7 +903,7 @@ namespace Eunoia_Editor {
 	{
 		ECS* ecs = ProjectManager::GetProject()->application->GetECS();
 		const List<ECSEntityContainer>& entities = ecs->GetAllEntities_();
-		const ECSEntityContainer& entity = entities[entityID - 2];
+		const ECSEntityContainer& entity = entities[EU_ECS_ENTITY_SLOT(entityID)];
 
 		ImGuiTreeNodeFlags flags = ImGuiTreeNodeFlags_OpenOnArrow | ImGuiTreeNodeFlags_SpanAvailWidth;
 		if (s_Data.selectedEntity == entityID)
@@ -939,7 +967,7 @@ namespace Eunoia_Editor {
 				ImGui::NewLine();
 
 				List<ECSEntityContainer>& entities = ecs->GetAllEntities_();
-				ECSEntityContainer* entity = &entities[s_Data.selectedEntity - 2];
+				ECSEntityContainer* entity = &entities[EU_ECS_ENTITY_SLOT(s_Data.selectedEntity)];
 
 				for (u32 i = 0; i < entity->components.Size(); i++)
 				{
@@ -962,7 +990,9 @@ namespace Eunoia_Editor {
 					}
 					if (opened)
 					{
-						DrawMetadata(componentMetadata, (const u8*)component->actualComponent);
+						//The inspector writes straight into the component memory
+						if (DrawMetadata(componentMetadata, (const u8*)component->actualComponent))
+							ecs->MarkComponentChanged(component->actualComponent);
 						if (component->typeID == Metadata::GetTypeID<Transform3DComponent>())
 						{
 							if(ImGui::Button("Set to Editor Camera Transform"))
@@ -974,6 +1004,7 @@ namespace Eunoia_Editor {
 								Transform3D* transform = &((Transform3DComponent*)component->actualComponent)->localTransform;
 								transform->pos = editorCameraTransform.pos;
 								transform->rot = editorCameraTransform.rot;
+								ecs->MarkComponentChanged(component->actualComponent);
 							}
 						}
 						ImGui::TreePop();
@@ -1591,7 +1622,7 @@ namespace Eunoia_Editor {
 					m4 projection = r3D->GetProjection().Transpose();
 
 					List<ECSEntityContainer>& entities = ecs->GetAllEntities_();
-					ECSEntityContainer* selectedEntity = &entities[s_Data.selectedEntity - 2];
+					ECSEntityContainer* selectedEntity = &entities[EU_ECS_ENTITY_SLOT(s_Data.selectedEntity)];
 
 					Transform3D transformation;
 					b32 usingCollisionShapeTransform;
@@ -1674,6 +1705,8 @@ namespace Eunoia_Editor {
 								transform3DComponent->localTransform.Rotate(v3(0.0f, 1.0f, 0.0f), deltaRot.y);
 							if (deltaRot.z != 0.0f)
 								transform3DComponent->localTransform.Rotate(v3(0.0f, 0.0f, 1.0f), -deltaRot.z);
+
+							ecs->MarkComponentChanged(transform3DComponent);
 						}
 							
 					}					
@@ -2278,33 +2311,40 @@ namespace Eunoia_Editor {
 		}
 	}
 
-	void EditorGUI::DrawMetadata(const MetadataInfo& metadata, const u8* data, const String& idString)
+	b32 EditorGUI::DrawMetadata(const MetadataInfo& metadata, const u8* data, const String& idString)
 	{
+		b32 modified = false;
 		if (metadata.type == METADATA_CLASS)
 		{
 			MetadataClass* cls = metadata.cls;
 
 			ImGui::BeginColumns((cls->name + "Colomns").C_Str(), 2);
-			DrawMetadataHelper(metadata, data, idString);
+			modified = DrawMetadataHelper(metadata, data, idString);
 			ImGui::EndColumns();
 		}
+
+		return modified;
 	}
 
-	void EditorGUI::DrawMetadataHelper(const MetadataInfo& metadata, const u8* data, const String& idString)
+	b32 EditorGUI::DrawMetadataHelper(const MetadataInfo& metadata, const u8* data, const String& idString)
 	{
 		MetadataClass* cls = metadata.cls;
 
+		b32 modified = false;
 		for (u32 i = 0; i < cls->members.Size(); i++)
 		{
 			String newIDString = idString.Empty() ? "##" + cls->name + String::S32ToString(i) : idString + cls->name + String::S32ToString(i);
-			DrawMetadataMember(cls, i, data, newIDString);
+			modified |= DrawMetadataMember(cls, i, data, newIDString);
 		}
+
+		return modified;
 	}
 
-	void EditorGUI::DrawMetadataMember(MetadataClass* cls, u32 memberIndex, const u8* data, const String& idString, u32 indent)
+	b32 EditorGUI::DrawMetadataMember(MetadataClass* cls, u32 memberIndex, const u8* data, const String& idString, u32 indent)
 	{
 		//ImGui::Indent(indent);
 		
+		b32 modified = false;
 		const MetadataMember& member = cls->members[memberIndex];
 		String memberName = member.name;
 		const MetadataInfo& metadata = Metadata::GetMetadata(member.typeID);
@@ -2339,6 +2379,7 @@ namespace Eunoia_Editor {
 						{
 							u32 w, h;
 							*texID = Engine::GetRenderContext()->CreateTexture2D(droppedFile.path);
+							modified = true;
 						}
 					}
 					ImGui::EndDragDropTarget();
@@ -2357,7 +2398,10 @@ namespace Eunoia_Editor {
 					for (u32 i = 0; i < materials.Size(); i++)
 					{
 						if (ImGui::Selectable(materials[i].name.C_Str()))
+						{
 							*(MaterialID*)offsetedData = (i + 1);
+							modified = true;
+						}
 					}
 					ImGui::EndCombo();
 				}
@@ -2379,8 +2423,11 @@ namespace Eunoia_Editor {
 					{
 						modelPath = AssetManager::GetModelPath(i + 1);
 						modelName = modelPath.SubString(modelPath.FindLastOf("/") + 1);
-						if(ImGui::Selectable(modelName.C_Str()))
+						if (ImGui::Selectable(modelName.C_Str()))
+						{
 							*(ModelID*)offsetedData = (i + 1);
+							modified = true;
+						}
 					}
 					ImGui::EndCombo();
 				}
@@ -2398,7 +2445,10 @@ namespace Eunoia_Editor {
 					for (u32 i = 0; i < modifiers.Size(); i++)
 					{
 						if (ImGui::Selectable(modifiers[i].name.C_Str()))
+						{
 							*(MaterialModifierID*)offsetedData = (i + 1);
+							modified = true;
+						}
 					}
 					ImGui::EndCombo();
 				}
@@ -2415,35 +2465,35 @@ namespace Eunoia_Editor {
 					bool* value = (bool*)offsetedData;
 					ImGui::Text(memberName.C_Str()); ImGui::SameLine();
 					ImGui::NextColumn();
-					ImGui::Checkbox(newIDString.C_Str(), value);
+					modified |= ImGui::Checkbox(newIDString.C_Str(), value);
 					ImGui::NextColumn();
 				} break;
 				case METADATA_PRIMITIVE_R32: {
 					r32* value = (r32*)offsetedData;
 					ImGui::Text(memberName.C_Str()); ImGui::SameLine();
 					ImGui::NextColumn();
-					ImGui::DragFloat(newIDString.C_Str(), value, cls->members[memberIndex].uiSliderSpeed, cls->members[memberIndex].uiSliderMin.x, cls->members[memberIndex].uiSliderMax.x);
+					modified |= ImGui::DragFloat(newIDString.C_Str(), value, cls->members[memberIndex].uiSliderSpeed, cls->members[memberIndex].uiSliderMin.x, cls->members[memberIndex].uiSliderMax.x);
 					ImGui::NextColumn();
 				} break;
 				case METADATA_PRIMITIVE_R64: {
 					r64* value = (r64*)offsetedData;
 					ImGui::Text(memberName.C_Str()); ImGui::SameLine();
 					ImGui::NextColumn();
-					ImGui::DragFloat(newIDString.C_Str(), (r32*)value, cls->members[memberIndex].uiSliderSpeed, cls->members[memberIndex].uiSliderMin.x, cls->members[memberIndex].uiSliderMax.x);
+					modified |= ImGui::DragFloat(newIDString.C_Str(), (r32*)value, cls->members[memberIndex].uiSliderSpeed, cls->members[memberIndex].uiSliderMin.x, cls->members[memberIndex].uiSliderMax.x);
 					ImGui::NextColumn();
 				} break;
 				case METADATA_PRIMITIVE_U8: {
 					u8* value = (u8*)offsetedData;
 					ImGui::Text(memberName.C_Str()); ImGui::SameLine();
 					ImGui::NextColumn();
-					ImGui::DragInt(newIDString.C_Str(), (s32*)value, cls->members[memberIndex].uiSliderSpeed, EU_MAX(cls->members[memberIndex].uiSliderMin.x, 0), EU_MIN(cls->members[memberIndex].uiSliderMax.x, EU_U8_MAX));
+					modified |= ImGui::DragInt(newIDString.C_Str(), (s32*)value, cls->members[memberIndex].uiSliderSpeed, EU_MAX(cls->members[memberIndex].uiSliderMin.x, 0), EU_MIN(cls->members[memberIndex].uiSliderMax.x, EU_U8_MAX));
 					ImGui::NextColumn();
 				} break;
 				case METADATA_PRIMITIVE_U16: {
 					u16* value = (u16*)offsetedData;
 					ImGui::Text(memberName.C_Str()); ImGui::SameLine();
 					ImGui::NextColumn();
-					ImGui::DragInt(newIDString.C_Str(), (s32*)value, cls->members[memberIndex].uiSliderSpeed, EU_MAX(cls->members[memberIndex].uiSliderMin.x, 0), EU_MIN(cls->members[memberIndex].uiSliderMax.x, EU_U16_MAX));
+					modified |= ImGui::DragInt(newIDString.C_Str(), (s32*)value, cls->members[memberIndex].uiSliderSpeed, EU_MAX(cls->members[memberIndex].uiSliderMin.x, 0), EU_MIN(cls->members[memberIndex].uiSliderMax.x, EU_U16_MAX));
 					ImGui::NextColumn();
 				} break;
 				case METADATA_PRIMITIVE_U32: {
@@ -2451,9 +2501,9 @@ namespace Eunoia_Editor {
 					ImGui::Text(memberName.C_Str()); ImGui::SameLine();
 					ImGui::NextColumn();
 					if (member.is32BitBool)
-						ImGui::Checkbox(newIDString.C_Str(), (bool*)value);
+						modified |= ImGui::Checkbox(newIDString.C_Str(), (bool*)value);
 					else
-						ImGui::DragInt(newIDString.C_Str(), (s32*)value, cls->members[memberIndex].uiSliderSpeed, EU_MAX(cls->members[memberIndex].uiSliderMin.x, 0), EU_MIN(cls->members[memberIndex].uiSliderMax.x, EU_U32_MAX));
+						modified |= ImGui::DragInt(newIDString.C_Str(), (s32*)value, cls->members[memberIndex].uiSliderSpeed, EU_MAX(cls->members[memberIndex].uiSliderMin.x, 0), EU_MIN(cls->members[memberIndex].uiSliderMax.x, EU_U32_MAX));
 				
 					ImGui::NextColumn();
 				} break;
@@ -2461,21 +2511,21 @@ namespace Eunoia_Editor {
 					s8* value = (s8*)offsetedData;
 					ImGui::Text(memberName.C_Str()); ImGui::SameLine();
 					ImGui::NextColumn();
-					ImGui::DragInt(newIDString.C_Str(), (s32*)value, cls->members[memberIndex].uiSliderSpeed, EU_MAX(cls->members[memberIndex].uiSliderMin.x, 0), EU_MIN(cls->members[memberIndex].uiSliderMax.x, EU_S8_MAX));
+					modified |= ImGui::DragInt(newIDString.C_Str(), (s32*)value, cls->members[memberIndex].uiSliderSpeed, EU_MAX(cls->members[memberIndex].uiSliderMin.x, 0), EU_MIN(cls->members[memberIndex].uiSliderMax.x, EU_S8_MAX));
 					ImGui::NextColumn();
 				} break;
 				case METADATA_PRIMITIVE_S16: {
 					s16* value = (s16*)offsetedData;
 					ImGui::Text(memberName.C_Str()); ImGui::SameLine();
 					ImGui::NextColumn();
-					ImGui::DragInt(newIDString.C_Str(), (s32*)value, cls->members[memberIndex].uiSliderSpeed, EU_MAX(cls->members[memberIndex].uiSliderMin.x, 0), EU_MIN(cls->members[memberIndex].uiSliderMax.x, EU_S16_MAX));
+					modified |= ImGui::DragInt(newIDString.C_Str(), (s32*)value, cls->members[memberIndex].uiSliderSpeed, EU_MAX(cls->members[memberIndex].uiSliderMin.x, 0), EU_MIN(cls->members[memberIndex].uiSliderMax.x, EU_S16_MAX));
 					ImGui::NextColumn();
 				} break;
 				case METADATA_PRIMITIVE_S32: {
 					s32* value = (s32*)offsetedData;
 					ImGui::Text(memberName.C_Str()); ImGui::SameLine();
 					ImGui::NextColumn();
-					ImGui::DragInt(newIDString.C_Str(), (s32*)value, cls->members[memberIndex].uiSliderSpeed, EU_MAX(cls->members[memberIndex].uiSliderMin.x, 0), EU_MIN(cls->members[memberIndex].uiSliderMax.x, EU_S32_MAX));
+					modified |= ImGui::DragInt(newIDString.C_Str(), (s32*)value, cls->members[memberIndex].uiSliderSpeed, EU_MAX(cls->members[memberIndex].uiSliderMin.x, 0), EU_MIN(cls->members[memberIndex].uiSliderMax.x, EU_S32_MAX));
 					ImGui::NextColumn();
 				} break;
 				}
@@ -2498,10 +2548,10 @@ namespace Eunoia_Editor {
 				ImGui::Text((memberName + " ").C_Str()); ImGui::SameLine();
 				ImGui::NextColumn();
 				ImGui::Text("X"); ImGui::SameLine();
-				ImGui::DragFloat((newIDString + "x").C_Str(), xValue, cls->members[memberIndex].uiSliderSpeed, cls->members[memberIndex].uiSliderMin.x, cls->members[memberIndex].uiSliderMax.x);
+				modified |= ImGui::DragFloat((newIDString + "x").C_Str(), xValue, cls->members[memberIndex].uiSliderSpeed, cls->members[memberIndex].uiSliderMin.x, cls->members[memberIndex].uiSliderMax.x);
 				ImGui::NextColumn();
 				ImGui::Text("Y"); ImGui::SameLine();
-				ImGui::DragFloat((newIDString + "y").C_Str(), yValue, cls->members[memberIndex].uiSliderSpeed, cls->members[memberIndex].uiSliderMin.y, cls->members[memberIndex].uiSliderMax.y);
+				modified |= ImGui::DragFloat((newIDString + "y").C_Str(), yValue, cls->members[memberIndex].uiSliderSpeed, cls->members[memberIndex].uiSliderMin.y, cls->members[memberIndex].uiSliderMax.y);
 				ImGui::PopItemWidth();
 				ImGui::EndColumns();
 				ImGui::BeginColumns((newIDString + "Columns").C_Str(), 2);
@@ -2517,13 +2567,13 @@ namespace Eunoia_Editor {
 				ImGui::Text((memberName + " ").C_Str()); ImGui::SameLine();
 				ImGui::NextColumn();
 				ImGui::Text("X"); ImGui::SameLine();
-				ImGui::DragFloat((newIDString + "x").C_Str(), xValue, cls->members[memberIndex].uiSliderSpeed, cls->members[memberIndex].uiSliderMin.x, cls->members[memberIndex].uiSliderMax.x);
+				modified |= ImGui::DragFloat((newIDString + "x").C_Str(), xValue, cls->members[memberIndex].uiSliderSpeed, cls->members[memberIndex].uiSliderMin.x, cls->members[memberIndex].uiSliderMax.x);
 				ImGui::NextColumn();
 				ImGui::Text("Y"); ImGui::SameLine();
-				ImGui::DragFloat((newIDString + "y").C_Str(), yValue, cls->members[memberIndex].uiSliderSpeed, cls->members[memberIndex].uiSliderMin.y, cls->members[memberIndex].uiSliderMax.y);
+				modified |= ImGui::DragFloat((newIDString + "y").C_Str(), yValue, cls->members[memberIndex].uiSliderSpeed, cls->members[memberIndex].uiSliderMin.y, cls->members[memberIndex].uiSliderMax.y);
 				ImGui::NextColumn();
 				ImGui::Text("Z"); ImGui::SameLine();
-				ImGui::DragFloat((newIDString + "z").C_Str(), zValue, cls->members[memberIndex].uiSliderSpeed, cls->members[memberIndex].uiSliderMin.z, cls->members[memberIndex].uiSliderMax.z);
+				modified |= ImGui::DragFloat((newIDString + "z").C_Str(), zValue, cls->members[memberIndex].uiSliderSpeed, cls->members[memberIndex].uiSliderMin.z, cls->members[memberIndex].uiSliderMax.z);
 				ImGui::PopItemWidth();
 				ImGui::EndColumns();
 				ImGui::BeginColumns((newIDString + "Columns").C_Str(), 2);
@@ -2541,16 +2591,16 @@ namespace Eunoia_Editor {
 				ImGui::Text((memberName + " ").C_Str()); ImGui::SameLine();
 				ImGui::NextColumn();
 				ImGui::Text("X"); ImGui::SameLine();
-				ImGui::DragFloat((newIDString + "x").C_Str(), xValue, cls->members[memberIndex].uiSliderSpeed, cls->members[memberIndex].uiSliderMin.x, cls->members[memberIndex].uiSliderMax.x);
+				modified |= ImGui::DragFloat((newIDString + "x").C_Str(), xValue, cls->members[memberIndex].uiSliderSpeed, cls->members[memberIndex].uiSliderMin.x, cls->members[memberIndex].uiSliderMax.x);
 				ImGui::NextColumn();
 				ImGui::Text("Y"); ImGui::SameLine();
-				ImGui::DragFloat((newIDString + "y").C_Str(), yValue, cls->members[memberIndex].uiSliderSpeed, cls->members[memberIndex].uiSliderMin.y, cls->members[memberIndex].uiSliderMax.y);
+				modified |= ImGui::DragFloat((newIDString + "y").C_Str(), yValue, cls->members[memberIndex].uiSliderSpeed, cls->members[memberIndex].uiSliderMin.y, cls->members[memberIndex].uiSliderMax.y);
 				ImGui::NextColumn();
 				ImGui::Text("Z"); ImGui::SameLine();
-				ImGui::DragFloat((newIDString + "z").C_Str(), zValue, cls->members[memberIndex].uiSliderSpeed, cls->members[memberIndex].uiSliderMin.z, cls->members[memberIndex].uiSliderMax.z);
+				modified |= ImGui::DragFloat((newIDString + "z").C_Str(), zValue, cls->members[memberIndex].uiSliderSpeed, cls->members[memberIndex].uiSliderMin.z, cls->members[memberIndex].uiSliderMax.z);
 				ImGui::NextColumn();
 				ImGui::Text("W"); ImGui::SameLine();
-				ImGui::DragFloat((newIDString + "w").C_Str(), wValue, cls->members[memberIndex].uiSliderSpeed, cls->members[memberIndex].uiSliderMin.w, cls->members[memberIndex].uiSliderMax.w);
+				modified |= ImGui::DragFloat((newIDString + "w").C_Str(), wValue, cls->members[memberIndex].uiSliderSpeed, cls->members[memberIndex].uiSliderMin.w, cls->members[memberIndex].uiSliderMax.w);
 				ImGui::PopItemWidth();
 				ImGui::EndColumns();
 				ImGui::BeginColumns((newIDString + "Columns").C_Str(), 2);
@@ -2612,14 +2662,24 @@ namespace Eunoia_Editor {
 						btVector3 btLocalInetia;
 						rigidBody->GetRigidBody()->getCollisionShape()->calculateLocalInertia(rigidBody->GetMass(), btLocalInetia);
 						rigidBody->SetLocalInertia(PhysicsEngine3D::ToEngineVector(btLocalInetia));
+						modified = true;
 					}
 
 					if (mass != initialMass)
+					{
 						rigidBody->SetMass(mass);
+						modified = true;
+					}
 					if (friction != initialFriction)
+					{
 						rigidBody->SetFriction(friction);
+						modified = true;
+					}
 					if (localInertia != initialLocalInertia)
+					{
 						rigidBody->SetLocalInertia(localInertia);
+						modified = true;
+					}
 				}
 
 				MetadataEnum* shapeTypeEnumMetadata = Metadata::GetMetadata(Metadata::GetTypeID<RigidBodyShapeType>()).enm;
@@ -2652,6 +2712,7 @@ namespace Eunoia_Editor {
 				ImGui::SameLine();
 				if (ImGui::Button("Add Shape Type"))
 				{
+					modified = true;
 					switch (SelectedShapeType)
 					{
 					case RIGID_BODY_SHAPE_STATIC_PLANE: {
@@ -2733,6 +2794,7 @@ namespace Eunoia_Editor {
 								shapeInfo->info.z = planeNormal.z;
 
 								rigidBody->CreateRigidBodyFromInfo(rigidBodyInfo);
+								modified = true;
 							}
 
 							if (planeConstant != initialPlaneConstant)
@@ -2746,6 +2808,7 @@ namespace Eunoia_Editor {
 								shapeInfo->info.w = planeConstant;
 
 								rigidBody->CreateRigidBodyFromInfo(rigidBodyInfo);
+								modified = true;
 
 							}
 						} break;
@@ -2785,6 +2848,7 @@ namespace Eunoia_Editor {
 								shapeInfo->localTransform.setOrigin(PhysicsEngine3D::ToBulletVector(localPos));
 
 								rigidBody->CreateRigidBodyFromInfo(rigidBodyInfo);
+								modified = true;
 							}
 
 							if (localRot != initialLocalRot)
@@ -2802,6 +2866,7 @@ namespace Eunoia_Editor {
 
 								shapeInfo->info.x = radius;
 								rigidBody->CreateRigidBodyFromInfo(rigidBodyInfo);
+								modified = true;
 							}
 						} break;
 						case BOX_SHAPE_PROXYTYPE: {
@@ -2843,6 +2908,7 @@ namespace Eunoia_Editor {
 								shapeInfo->localTransform.setOrigin(PhysicsEngine3D::ToBulletVector(localPos));
 
 								rigidBody->CreateRigidBodyFromInfo(rigidBodyInfo);
+								modified = true;
 							}
 
 							if (localRot != initialLocalRot)
@@ -2863,6 +2929,7 @@ namespace Eunoia_Editor {
 								shapeInfo->info.z = halfExtents.z;
 
 								rigidBody->CreateRigidBodyFromInfo(rigidBodyInfo);
+								modified = true;
 							}
 						} break;
 						}
@@ -2876,7 +2943,7 @@ namespace Eunoia_Editor {
 				if (ImGui::TreeNodeEx((memberName + newIDString + "DropDown").C_Str(), ImGuiTreeNodeFlags_DefaultOpen))
 				{
 					ImGui::EndColumns();
-					DrawMetadata(metadata, offsetedData, idString);
+					modified |= DrawMetadata(metadata, offsetedData, idString);
 					ImGui::TreePop();
 				}
 				ImGui::BeginColumns((newIDString + "Columns").C_Str(), 2);
@@ -2893,6 +2960,13 @@ namespace Eunoia_Editor {
 				ImGui::Text(memberName.C_Str()); ImGui::SameLine();
 				ImGui::NextColumn();
 
+				//The key is written by the display event callback, the member reports the change the next time it is drawn
+				if (s_Data.keyValueSet && s_Data.keyValueToSet == (Key*)offsetedData)
+				{
+					s_Data.keyValueSet = false;
+					modified = true;
+				}
+
 				for (u32 i = 0; i < enm->values.Size(); i++)
 				{
 					if (enm->values[i].value == currentValue)
@@ -2930,6 +3004,7 @@ namespace Eunoia_Editor {
 						if (ImGui::Selectable((memberName + enumValue.name + newIDString).C_Str()))
 						{
 							*(u32*)offsetedData = enm->values[i].value;
+							modified = true;
 						}
 					}
 					ImGui::EndCombo();
@@ -2939,6 +3014,7 @@ namespace Eunoia_Editor {
 		}
 
 		//ImGui::Unindent(indent);
+		return modified;
 	}
 
 	void EditorGUI::BlueText(const char* chars)
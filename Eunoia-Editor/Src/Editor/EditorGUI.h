@@ -45,9 +45,9 @@ namespace Eunoia_Editor {
 		static void DrawSpritePlacerWindow();
 		static void DoDragDropMaterialTexture(Eunoia::MaterialTextureType texType);
 		static void DrawPopupWindows();
-		static void DrawMetadata(const Eunoia::MetadataInfo& metadata, const u8* data, const Eunoia::String& idString = "");
-		static void DrawMetadataHelper(const Eunoia::MetadataInfo& metadata, const u8* data, const Eunoia::String& idString = "");
-		static void DrawMetadataMember(Eunoia::MetadataClass* cls, u32 memberIndex, const u8* data, const Eunoia::String& idString = "", u32 indent = 0);
+		static b32 DrawMetadata(const Eunoia::MetadataInfo& metadata, const u8* data, const Eunoia::String& idString = "");
+		static b32 DrawMetadataHelper(const Eunoia::MetadataInfo& metadata, const u8* data, const Eunoia::String& idString = "");
+		static b32 DrawMetadataMember(Eunoia::MetadataClass* cls, u32 memberIndex, const u8* data, const Eunoia::String& idString = "", u32 indent = 0);
 
 		static void BlueText(const char* chars);
 		static void SetEngineCamera(EngineCamera camera);
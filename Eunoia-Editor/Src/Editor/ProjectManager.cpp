@@ -158,6 +158,10 @@ namespace Eunoia_Editor {
 		Eunoia::Metadata::UnregisterProjectMetadata();
 		project->application->RegisterMetadata();
 		project->application->GetECS()->RestoreResetPoint(project->resetPoint);
+		//The old snapshot points into the unloaded dll so STOP goes back to the state at recompile time
+		if (project->playSnapshot.valid)
+			project->application->GetECS()->CreateSnapshot(&project->playSnapshot);
+		project->playRecorder.Reset();
 		project->application->OnRecompile();
 
 		EU_LOG_INFO("Recompiled project");
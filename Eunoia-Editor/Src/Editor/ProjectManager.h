@@ -3,6 +3,7 @@
 #include <Eunoia\Core\Application.h>
 #include <Eunoia\DataStructures\List.h>
 #include <Eunoia\ECS\ECSLoader.h>
+#include <Eunoia\ECS\ECSRecorder.h>
 #include <Eunoia\Utils\FileUtils.h>
 #include <Eunoia\Rendering\Renderer2D.h>
 #include <Eunoia\Rendering\Renderer3D.h>
@@ -16,6 +17,10 @@ namespace Eunoia_Editor {
 		HMODULE dllHandle;
 		Eunoia::Application* application;
 		Eunoia::ECSResetPoint resetPoint;
+		//Taken when PLAY is pressed and restored by STOP
+		Eunoia::ECSSnapshot playSnapshot;
+		//Frames simulated since PLAY so a paused simulation can be stepped back
+		Eunoia::ECSRecorder playRecorder;
 		Eunoia::EUDirectory* assetDirectory;
 
 		b32 stepApplication;
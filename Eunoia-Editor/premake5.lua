@@ -69,6 +69,11 @@ project (""..ApplicationName)
 			"EU_PLATFORM_WINDOWS"
 		}
 
+	-- Projects built on Linux run headless, see the engine project
+	filter "system:linux"
+		cppdialect "C++17"
+		pic "On"
+
 	filter "configurations:Debug"
 		defines "EU_DEBUG"
 		symbols "On"
@@ -25,6 +25,7 @@ namespace Eunoia {
 
 		virtual void Update(r32 dt) {}
 		virtual void Render() {}
+		//Called once the frame is recorded, on the render thread with pipelined rendering
 		virtual void EndFrame() {}
 		virtual void PrePhysicsSimulation(r32 dt) {}
 		virtual void PostPhysicsSimulation(r32 dt) {}
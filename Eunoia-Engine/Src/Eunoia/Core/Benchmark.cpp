@@ -0,0 +1,50 @@
+#include "Benchmark.h"
+#include "JobSystem.h"
+#include "Profiler.h"
+#include "../ECS/ECS.h"
+#include "../ECS/ECSRecorder.h"
+#include "../ECS/Components/Transform3DComponet.h"
+#include "../ECS/Systems/TransformHierarchy3DSystem.h"
+#include "../ECS/Systems/SpatialIndex3DSystem.h"
+
+namespace Eunoia {
+
+	ECSBenchmarkScene::ECSBenchmarkScene() :
+		ecs(new ECS()),
+		numMoved(0)
+	{
+	}
+
+	ECSBenchmarkScene::~ECSBenchmarkScene()
+	{
+		delete ecs;
+	}
+
+	void ECSBenchmarkScene::Create(const String& name, u32 numEntities, u32 treeFanout)
+	{
+		ecs->CreateScene(name, true, false);
+
+		entities.SetCapacity(numEntities);
+		entities.Clear();
+		for (u32 i = 0; i < numEntities; i++)
+		{
+			EntityID parent = treeFanout == 0 || i == 0 ? EU_ECS_ROOT_ENTITY : entities[(i - 1) / treeFanout];
+			EntityID entity = ecs->CreateEntity(parent);
+			ecs->CreateComponent<Transform3DComponent>(entity);
+			entities.Push(entity);
+		}
+
+		numMoved = EU_MAX(numEntities / 100, 1);
+	}
+
+	void RunAllBenchmarks()
+	{
+		JobSystem::RunBenchmark();
+		Profiler::RunBenchmark();
+		ECS::RunBenchmark();
+		TransformHierarchy3DSystem::RunBenchmark(100000);
+		SpatialIndex3DSystem::RunBenchmark();
+		ECSRecorder::RunBenchmark();
+	}
+
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "../Common.h"
+#include "../Utils/Log.h"
+#include "../DataStructures/List.h"
+#include "../DataStructures/String.h"
+#include "../ECS/ECSTypes.h"
+#include <chrono>
+#include <algorithm>
+
+//Logs one result line of a RunBenchmark function, name and format have to be string literals
+#define EU_LOG_BENCHMARK(name, format, ...) EU_LOG_INFO(name " benchmark: " format, __VA_ARGS__)
+
+//How often the RunBenchmark functions repeat a measurement, cold frames are repeated on a fresh scene
+#define EU_BENCHMARK_NUM_SAMPLES 5
+
+namespace Eunoia {
+
+	//Times the sections of the RunBenchmark functions, call Restart before each section
+	class BenchmarkTimer
+	{
+	public:
+		BenchmarkTimer() { Restart(); }
+
+		void Restart() { m_Start = std::chrono::high_resolution_clock::now(); }
+
+		r64 GetElapsedMicroseconds() const { return std::chrono::duration<r64, std::micro>(std::chrono::high_resolution_clock::now() - m_Start).count(); }
+		r64 GetElapsedNanoseconds() const { return std::chrono::duration<r64, std::nano>(std::chrono::high_resolution_clock::now() - m_Start).count(); }
+	private:
+		std::chrono::high_resolution_clock::time_point m_Start;
+	};
+
+	//Times a single call of body
+	template<typename Body>
+	r64 MeasureMicroseconds(Body body)
+	{
+		BenchmarkTimer timer;
+		body();
+		return timer.GetElapsedMicroseconds();
+	}
+
+	//The samples of one measurement, the median is logged so a single preempted run doesn't skew the result
+	class BenchmarkSamples
+	{
+	public:
+		void Add(r64 sample) { m_Samples.Push(sample); }
+
+		r64 GetMedian() const
+		{
+			if (m_Samples.Empty())
+				return 0.0;
+
+			List<r64> sorted = m_Samples;
+			std::sort(&sorted[0], &sorted[0] + sorted.Size());
+			u32 middle = sorted.Size() / 2;
+			return sorted.Size() % 2 ? sorted[middle] : (sorted[middle - 1] + sorted[middle]) * 0.5;
+		}
+	private:
+		List<r64> m_Samples;
+	};
+
+	class ECS;
+
+	/*
+		The scene the ECS benchmarks start from, an ECS with one active scene and numEntities entities with a default
+		Transform3DComponent. With a treeFanout entity i is parented to entity (i - 1) / treeFanout so the depth grows
+		with the count like in a real scene. The ECS can be configured between the constructor and Create
+	*/
+	struct ECSBenchmarkScene
+	{
+		ECSBenchmarkScene();
+		~ECSBenchmarkScene();
+
+		void Create(const String& name, u32 numEntities, u32 treeFanout = 0);
+
+		ECS* ecs;
+		List<EntityID> entities;
+		//How many entities the benchmarks move for a frame where a few things changed
+		u32 numMoved;
+	};
+
+	//Runs every RunBenchmark function with its default size. Restarts the job system so wait for the render thread first
+	EU_API void RunAllBenchmarks();
+
+}
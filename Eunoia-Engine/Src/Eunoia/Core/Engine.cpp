@@ -9,6 +9,19 @@
 #include "../ECS/Systems/TransformHierarchy2DSystem.h"
 #include "../Rendering/GuiManager.h"
 #include "../Physics/PhysicsEngine3D.h"
+#include "JobSystem.h"
+#include "Profiler.h"
+#include "../Platform/Null/DisplayNull.h"
+#include <chrono>
+#include <cmath>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#ifdef EU_PLATFORM_WINDOWS
+#include <Windows.h>
+#include <timeapi.h>
+#endif
 
 #define EU_WORLD0 0
 #define EU_WORLD1 1
@@ -24,6 +37,8 @@ namespace Eunoia {
 
 		b32 created;
 		b32 active;
+		b32 headless;
+		b32 wasFocused;
 	};
 
 	struct Engine_Data
@@ -32,15 +47,189 @@ namespace Eunoia {
 		Application* activeApp;
 		b32 running;
 		r32 timeInSeconds;
+
+		r32 fixedDeltaTime;
+		u32 maxSubSteps;
+		r32 frameDeltaTime;
+		r32 accumulatedTime;
+		r32 interpolationAlpha;
 		b32 editorAttached;
 		EunoiaWorldData activeWorlds[MAX_EUNOIA_WORLDS];
+
+		b32 pipelinedRendering;
+		std::thread renderThread;
+		std::mutex renderMutex;
+		std::condition_variable renderCondition;
+		b32 renderFramePending;
+		b32 renderThreadRunning;
+		//Which worlds the pending frame was submitted for, worlds can be deactivated while it is being recorded
+		b32 renderedWorlds[MAX_EUNOIA_WORLDS];
+
+		r32 frameRateLimit;
+		r32 backgroundFrameRateLimit;
+		b32 renderOnDemand;
+		b32 renderRequested;
+		u32 renderOnDemandFramesLeft;
+		//Running estimate of how long a 1ms sleep really takes, it varies a lot between machines
+		r32 sleepTimeMean;
+		r32 sleepTimeVariance;
 	};
 
 	static Engine_Data s_Data;
 
-	void Engine::Init(Application* app, const String& title, u32 width, u32 height, RenderAPI api, b32 editorAttached)
+	static void RecordFrame()
+	{
+		EU_PROFILE_FUNCTION();
+		for (u32 i = 0; i < MAX_EUNOIA_WORLDS; i++)
+		{
+			EunoiaWorldData* world = &s_Data.activeWorlds[i];
+			if (!s_Data.renderedWorlds[i])
+				continue;
+
+			world->renderContext->BeginFrame();
+			world->renderer->RenderFrame();
+			s_Data.activeApp->EndFrame();
+			world->renderContext->Present();
+		}
+	}
+
+	static void RenderThreadMain()
+	{
+		for (;;)
+		{
+			{
+				std::unique_lock<std::mutex> lock(s_Data.renderMutex);
+				s_Data.renderCondition.wait(lock, [] { return s_Data.renderFramePending || !s_Data.renderThreadRunning; });
+				if (!s_Data.renderFramePending)
+					return;
+			}
+
+			RecordFrame();
+
+			{
+				std::lock_guard<std::mutex> lock(s_Data.renderMutex);
+				s_Data.renderFramePending = false;
+			}
+			s_Data.renderCondition.notify_all();
+		}
+	}
+
+	static void StopRenderThread()
+	{
+		if (!s_Data.renderThreadRunning)
+			return;
+
+		{
+			std::lock_guard<std::mutex> lock(s_Data.renderMutex);
+			s_Data.renderThreadRunning = false;
+		}
+		s_Data.renderCondition.notify_all();
+		s_Data.renderThread.join();
+	}
+
+	static b32 ShouldRender()
+	{
+		if (!s_Data.renderOnDemand)
+			return true;
+
+		b32 changed = s_Data.renderRequested;
+		s_Data.renderRequested = false;
+		for (u32 i = 0; i < MAX_EUNOIA_WORLDS; i++)
+		{
+			EunoiaWorldData* world = &s_Data.activeWorlds[i];
+			if (!world->active)
+				continue;
+
+			Display* display = world->display;
+			b32 focused = display->IsFocused();
+			if (display->CheckForEvent(DISPLAY_EVENT_CREATE) || display->CheckForEvent(DISPLAY_EVENT_RESIZE) ||
+				display->CheckForEvent(DISPLAY_EVENT_KEY) || display->CheckForEvent(DISPLAY_EVENT_MOUSE_BUTTON) || focused != world->wasFocused)
+				changed = true;
+
+			//The cursor also moves over other windows, only the focused display redraws for it
+			if (focused)
+			{
+				v2 mouseDelta = display->GetMouseDeltaPos();
+				if (mouseDelta.x != 0.0f || mouseDelta.y != 0.0f)
+					changed = true;
+			}
+
+			world->wasFocused = focused;
+		}
+
+		//Held keys only send events on press and repeat, anything they move has to be drawn every frame
+		for (u32 i = 0; i < EU_MAX_KEYS && !changed; i++)
+			changed = EUInput::IsKeyDown((Key)i);
+		for (u32 i = 0; i < EU_MAX_MOUSE_BUTTONS && !changed; i++)
+			changed = EUInput::IsButtonDown((MouseButton)i);
+
+		if (changed)
+			s_Data.renderOnDemandFramesLeft = EU_ENGINE_RENDER_ON_DEMAND_FRAMES;
+
+		if (s_Data.renderOnDemandFramesLeft == 0)
+			return false;
+
+		s_Data.renderOnDemandFramesLeft--;
+		return true;
+	}
+
+	//Render pumps the displays itself, skipped frames still have to so input and close events keep coming in
+	static void UpdateDisplays()
+	{
+		Engine::WaitForRenderThread();
+		for (u32 i = 0; i < MAX_EUNOIA_WORLDS; i++)
+		{
+			EunoiaWorldData* world = &s_Data.activeWorlds[i];
+			if (!world->active)
+				continue;
+
+			world->display->Update();
+			world->display->AccumulateStepInput();
+		}
+	}
+
+	static void SleepUntil(std::chrono::high_resolution_clock::time_point target)
+	{
+		EU_PROFILE_FUNCTION();
+		//Sleeps can overshoot, so they stop while the remaining time is still above what a sleep usually takes and the rest is spun
+		for (;;)
+		{
+			std::chrono::high_resolution_clock::time_point sleepStart = std::chrono::high_resolution_clock::now();
+			r32 remaining = std::chrono::duration<r32>(target - sleepStart).count();
+			if (remaining <= s_Data.sleepTimeMean + sqrtf(s_Data.sleepTimeVariance))
+				break;
+
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			r32 slept = std::chrono::duration<r32>(std::chrono::high_resolution_clock::now() - sleepStart).count();
+			r32 error = slept - s_Data.sleepTimeMean;
+			s_Data.sleepTimeMean += error * 0.1f;
+			s_Data.sleepTimeVariance += (error * error - s_Data.sleepTimeVariance) * 0.1f;
+		}
+
+		while (std::chrono::high_resolution_clock::now() < target)
+			std::this_thread::yield();
+	}
+
+	static void LimitFrameRate(std::chrono::high_resolution_clock::time_point frameStart, b32 idle)
+	{
+		r32 limit = s_Data.frameRateLimit;
+
+		EunoiaWorldData* mainWorld = &s_Data.activeWorlds[EUNOIA_WORLD_MAIN];
+		b32 background = idle || (mainWorld->created && (mainWorld->display->IsMinimized() || !mainWorld->display->IsFocused()));
+		if (background && s_Data.backgroundFrameRateLimit > 0.0f)
+			limit = limit > 0.0f ? EU_MIN(limit, s_Data.backgroundFrameRateLimit) : s_Data.backgroundFrameRateLimit;
+
+		if (limit <= 0.0f)
+			return;
+
+		std::chrono::duration<r32> frameTime(1.0f / limit);
+		SleepUntil(frameStart + std::chrono::duration_cast<std::chrono::high_resolution_clock::duration>(frameTime));
+	}
+
+	void Engine::Init(Application* app, const String& title, u32 width, u32 height, RenderAPI api, b32 editorAttached, EunoiaWorldFlags mainWorldFlags)
 	{
 		Logger::Init();
+		JobSystem::Init();
 		Metadata::Init();
 		ECSLoader::Init();
 		
@@ -50,6 +239,18 @@ namespace Eunoia {
 		}
 
 		s_Data.editorAttached = editorAttached;
+		s_Data.pipelinedRendering = false;
+		s_Data.renderFramePending = false;
+		s_Data.renderThreadRunning = false;
+		s_Data.fixedDeltaTime = 1.0f / EU_ENGINE_DEFAULT_SIMULATION_RATE;
+		s_Data.maxSubSteps = EU_ENGINE_DEFAULT_MAX_SUB_STEPS;
+		s_Data.frameRateLimit = 0.0f;
+		s_Data.backgroundFrameRateLimit = EU_ENGINE_DEFAULT_BACKGROUND_FRAME_RATE;
+		s_Data.renderOnDemand = false;
+		s_Data.renderRequested = false;
+		s_Data.renderOnDemandFramesLeft = 0;
+		s_Data.sleepTimeMean = 0.002f;
+		s_Data.sleepTimeVariance = 0.0f;
 		s_Data.applications.Push(app);
 		s_Data.activeApp = app;
 
@@ -64,7 +265,7 @@ namespace Eunoia {
 		displayInfo.width = width;
 		displayInfo.height = height;
 
-		CreateWorld(displayInfo, api, EUNOIA_WORLD_FLAG_ALL, true, EUNOIA_WORLD_MAIN);
+		CreateWorld(displayInfo, api, mainWorldFlags, true, EUNOIA_WORLD_MAIN);
 		AssetManager::Init();
 
 		EUInput::InitInput();
@@ -76,9 +277,21 @@ namespace Eunoia {
 		s_Data.running = true;
 		s_Data.activeApp->Init();
 
-		r32 dt = 1.0f / 60.0f;
+#ifdef EU_PLATFORM_WINDOWS
+		//The default timer resolution of ~15.6ms is too coarse to sleep between frames
+		timeBeginPeriod(1);
+#endif
+
+		std::chrono::high_resolution_clock::time_point lastFrameStart = std::chrono::high_resolution_clock::now();
+		s_Data.accumulatedTime = 0.0f;
+		s_Data.interpolationAlpha = 1.0f;
 		while (s_Data.running)
 		{
+			EU_PROFILE_SCOPE("Engine::Frame");
+			std::chrono::high_resolution_clock::time_point frameStart = std::chrono::high_resolution_clock::now();
+			s_Data.frameDeltaTime = std::chrono::duration<r32>(frameStart - lastFrameStart).count();
+			lastFrameStart = frameStart;
+
 			for (u32 i = 0; i < MAX_EUNOIA_WORLDS; i++)
 			{
 				EunoiaWorldData* world = &s_Data.activeWorlds[i];
@@ -100,11 +313,36 @@ namespace Eunoia {
 				}
 			}
 
-			Update(dt);
-			Render();
+			//Read every frame so the rate can change between frames
+			r32 dt = s_Data.fixedDeltaTime;
+			s_Data.accumulatedTime += s_Data.frameDeltaTime;
+			for (u32 i = 0; i < s_Data.maxSubSteps && s_Data.accumulatedTime >= dt; i++)
+			{
+				Update(dt);
+				s_Data.timeInSeconds += dt;
+				s_Data.accumulatedTime -= dt;
+			}
+
+			if (s_Data.accumulatedTime >= dt)
+				s_Data.accumulatedTime = fmodf(s_Data.accumulatedTime, dt);
+
+			s_Data.interpolationAlpha = s_Data.accumulatedTime / dt;
+
+			b32 render = ShouldRender();
+			if (render)
+				Render();
+			else
+				UpdateDisplays();
 
-			s_Data.timeInSeconds += dt;
+			LimitFrameRate(frameStart, !render);
 		}
+
+#ifdef EU_PLATFORM_WINDOWS
+		timeEndPeriod(1);
+#endif
+
+		StopRenderThread();
+		JobSystem::Destroy();
 	}
 
 	void Engine::Stop()
@@ -166,9 +404,16 @@ namespace Eunoia {
 			DestroyWorld(worldHandle);
 		}
 
-		world->display = Display::CreateDisplay();
+		world->headless = (flags & EUNOIA_WORLD_FLAG_HEADLESS) || renderAPI == RENDER_API_NULL;
+#ifndef EU_PLATFORM_WINDOWS
+		//Neither a window nor the Vulkan backend is built on this platform
+		if (!world->headless)
+			EU_LOG_WARN("Engine::CreateWorld() Only headless worlds can run on this platform, creating {0} headless", displayInfo.title.C_Str());
+		world->headless = true;
+#endif
+		world->display = world->headless ? new DisplayNull() : Display::CreateDisplay();
 		world->display->Create(displayInfo.title, displayInfo.width, displayInfo.height);
-		world->renderContext = RenderContext::CreateRenderContext(renderAPI);
+		world->renderContext = RenderContext::CreateRenderContext(world->headless ? RENDER_API_NULL : renderAPI);
 		world->renderContext->Init(world->display);
 		world->renderer = new MasterRenderer(world->renderContext, world->display);
 		world->renderer->Init();
@@ -176,12 +421,14 @@ namespace Eunoia {
 		world->physicsEngine->Init();
 		world->created = true; 
 		world->active = active;
+		world->wasFocused = world->display->IsFocused();
 
 		return worldHandle;
 	}
 
 	void Engine::DestroyWorld(EunoiaWorld worldID)
 	{
+		WaitForRenderThread();
 		EunoiaWorldData* world = &s_Data.activeWorlds[worldID];
 
 		if (world->created)
@@ -204,6 +451,8 @@ namespace Eunoia {
 		displayInfo.width = GetDisplay(world)->GetWidth();
 		displayInfo.height = GetDisplay(world)->GetHeigth();
 		RenderAPI renderAPI = GetRenderContext(world)->GetRenderAPI();
+		if (IsHeadless(world))
+			flags |= EUNOIA_WORLD_FLAG_HEADLESS;
 
 		DestroyWorld(world);
 		CreateWorld(displayInfo, renderAPI, flags, active, world);
@@ -271,11 +520,121 @@ namespace Eunoia {
 		return s_Data.timeInSeconds;
 	}
 
+	void Engine::SetSimulationRate(r32 stepsPerSecond)
+	{
+		s_Data.fixedDeltaTime = 1.0f / stepsPerSecond;
+	}
+
+	r32 Engine::GetFixedDeltaTime()
+	{
+		return s_Data.fixedDeltaTime;
+	}
+
+	void Engine::SetMaxSubSteps(u32 maxSubSteps)
+	{
+		s_Data.maxSubSteps = EU_MAX(maxSubSteps, 1);
+	}
+
+	u32 Engine::GetMaxSubSteps()
+	{
+		return s_Data.maxSubSteps;
+	}
+
+	r32 Engine::GetFrameDeltaTime()
+	{
+		return s_Data.frameDeltaTime;
+	}
+
+	r32 Engine::GetInterpolationAlpha()
+	{
+		return s_Data.interpolationAlpha;
+	}
+
 	b32 Engine::IsEditorAttached()
 	{
 		return s_Data.editorAttached;
 	}
 
+	b32 Engine::IsHeadless(EunoiaWorld world)
+	{
+		return s_Data.activeWorlds[world].headless;
+	}
+
+	void Engine::SetPipelinedRendering(b32 pipelined)
+	{
+		if (pipelined && s_Data.editorAttached)
+		{
+			EU_LOG_WARN("Engine::SetPipelinedRendering() pipelined rendering is not available with the editor attached");
+			return;
+		}
+
+		if (pipelined == s_Data.pipelinedRendering)
+			return;
+
+		s_Data.pipelinedRendering = pipelined;
+		if (pipelined)
+		{
+			s_Data.renderThreadRunning = true;
+			s_Data.renderThread = std::thread(RenderThreadMain);
+		}
+		else
+		{
+			//Finishes the pending frame before the thread exits
+			StopRenderThread();
+		}
+	}
+
+	b32 Engine::IsPipelinedRendering()
+	{
+		return s_Data.pipelinedRendering;
+	}
+
+	void Engine::WaitForRenderThread()
+	{
+		if (!s_Data.renderThreadRunning || std::this_thread::get_id() == s_Data.renderThread.get_id())
+			return;
+
+		EU_PROFILE_FUNCTION();
+		std::unique_lock<std::mutex> lock(s_Data.renderMutex);
+		s_Data.renderCondition.wait(lock, [] { return !s_Data.renderFramePending; });
+	}
+
+	void Engine::SetFrameRateLimit(r32 framesPerSecond)
+	{
+		s_Data.frameRateLimit = EU_MAX(framesPerSecond, 0.0f);
+	}
+
+	r32 Engine::GetFrameRateLimit()
+	{
+		return s_Data.frameRateLimit;
+	}
+
+	void Engine::SetBackgroundFrameRateLimit(r32 framesPerSecond)
+	{
+		s_Data.backgroundFrameRateLimit = EU_MAX(framesPerSecond, 0.0f);
+	}
+
+	r32 Engine::GetBackgroundFrameRateLimit()
+	{
+		return s_Data.backgroundFrameRateLimit;
+	}
+
+	void Engine::SetRenderOnDemand(b32 onDemand)
+	{
+		s_Data.renderOnDemand = onDemand;
+		s_Data.renderRequested = true;
+	}
+
+	b32 Engine::IsRenderOnDemand()
+	{
+		return s_Data.renderOnDemand;
+	}
+
+	void Engine::RequestRender()
+	{
+		s_Data.renderRequested = true;
+	}
+
 	Application* Engine::GetActiveApplication()
 	{
 		return s_Data.activeApp;
@@ -288,14 +647,18 @@ namespace Eunoia {
 
 	void Engine::Update(r32 dt)
 	{
+		EU_PROFILE_FUNCTION();
 		EUInput::BeginInput();
+		for (u32 i = 0; i < MAX_EUNOIA_WORLDS; i++)
+			if (s_Data.activeWorlds[i].active)
+				s_Data.activeWorlds[i].display->BeginStepInput();
 		s_Data.activeApp->BeginECS();
 		s_Data.activeApp->UpdateECS(dt);
 		s_Data.activeApp->Update(dt);
 
 		for (u32 i = 0; i < s_Data.applications.Size(); i++)
 			if (s_Data.applications[i] != s_Data.activeApp)
-				s_Data.applications[i]->GetECS()->OnlyUpdateRequiredSystems(dt);
+				s_Data.applications[i]->GetECS()->UpdateBackgroundSystems(dt);
 
 		s_Data.activeApp->GetECS()->PrePhysicsSystems(dt);
 		s_Data.activeApp->PrePhysicsSimulation(dt);
@@ -316,33 +679,45 @@ namespace Eunoia {
 
 	void Engine::Render()
 	{
+		EU_PROFILE_FUNCTION();
+		//Submitting only touches the renderers' submission frame, the render thread can still be recording the last one
 		for (u32 i = 0; i < MAX_EUNOIA_WORLDS; i++)
 		{
 			EunoiaWorldData* world = &s_Data.activeWorlds[i];
 			if (!world->active)
 				continue;
 
-			world->renderContext->BeginFrame();
 			world->renderer->BeginFrame();
 		}
 
-		
 		s_Data.activeApp->RenderECS();
 		s_Data.activeApp->Render();
-		
 
+		WaitForRenderThread();
 		for (u32 i = 0; i < MAX_EUNOIA_WORLDS; i++)
 		{
 			EunoiaWorldData* world = &s_Data.activeWorlds[i];
+			s_Data.renderedWorlds[i] = world->active;
 			if (!world->active)
 				continue;
 
 			world->renderer->EndFrame();
-			world->renderer->RenderFrame();
-			s_Data.activeApp->EndFrame();
-
-			world->renderContext->Present();
+			//Display callbacks resize framebuffers, they have to run while nothing is being recorded
 			world->display->Update();
+			world->display->AccumulateStepInput();
+		}
+
+		if (s_Data.pipelinedRendering)
+		{
+			{
+				std::lock_guard<std::mutex> lock(s_Data.renderMutex);
+				s_Data.renderFramePending = true;
+			}
+			s_Data.renderCondition.notify_all();
+		}
+		else
+		{
+			RecordFrame();
 		}
 	}
 
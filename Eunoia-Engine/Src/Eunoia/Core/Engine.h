@@ -7,6 +7,12 @@
 #include "../Physics/PhysicsEngine3D.h"
 
 #define EU_MAIN_APPLICATION 0
+#define EU_ENGINE_DEFAULT_SIMULATION_RATE 60.0f
+#define EU_ENGINE_DEFAULT_MAX_SUB_STEPS 5
+//Low enough to free the core, high enough that the default max sub steps still cover a frame
+#define EU_ENGINE_DEFAULT_BACKGROUND_FRAME_RATE 15.0f
+//Frames rendered after a change with render on demand, so anything that settles over a few frames still gets drawn
+#define EU_ENGINE_RENDER_ON_DEMAND_FRAMES 3
 
 namespace Eunoia {
 
@@ -19,6 +25,8 @@ namespace Eunoia {
 		EUNOIA_WORLD_FLAG_RENDER_3D = 2,
 		EUNOIA_WORLD_FLAG_DISPLAY = 4,
 		EUNOIA_WORLD_FLAG_PHYSICS_ENGINE_3D = 8,
+		//No window and a null render context, the renderers still run but nothing reaches a GPU
+		EUNOIA_WORLD_FLAG_HEADLESS = 16,
 		EUNOIA_WORLD_FLAG_RENDER = EUNOIA_WORLD_FLAG_RENDER_2D | EUNOIA_WORLD_FLAG_RENDER_3D,
 		EUNOIA_WORLD_FLAG_RENDER_DISPLAY = EUNOIA_WORLD_FLAG_RENDER | EUNOIA_WORLD_FLAG_DISPLAY,
 		EUNOIA_WORLD_FLAG_ALL = EUNOIA_WORLD_FLAG_RENDER_DISPLAY | EUNOIA_WORLD_FLAG_PHYSICS_ENGINE_3D
@@ -42,7 +50,7 @@ namespace Eunoia {
 	class EU_API Engine
 	{
 	public:
-		static void Init(Application* app, const String& title, u32 width, u32 height, RenderAPI api, b32 editorAttached = true);
+		static void Init(Application* app, const String& title, u32 width, u32 height, RenderAPI api, b32 editorAttached = true, EunoiaWorldFlags mainWorldFlags = EUNOIA_WORLD_FLAG_ALL);
 		static void Start();
 		static void Stop();
 
@@ -63,8 +71,50 @@ namespace Eunoia {
 		static void SetWorldActive(EunoiaWorld world, b32 active);
 		static void SetWorldActiveOpposite(EunoiaWorld world);
 
+		//Simulated time, advanced by the fixed step
 		static r32 GetTime();
 		static b32 IsEditorAttached();
+		static b32 IsHeadless(EunoiaWorld world = EUNOIA_WORLD_MAIN);
+
+		/*
+			Update and physics run in fixed steps of 1 / stepsPerSecond, as many as the real frame time covers but at most maxSubSteps
+			a frame. A machine that can't keep up with maxSubSteps drops the time it is behind instead of falling further behind
+		*/
+		static void SetSimulationRate(r32 stepsPerSecond);
+		static r32 GetFixedDeltaTime();
+		static void SetMaxSubSteps(u32 maxSubSteps);
+		static u32 GetMaxSubSteps();
+		//Real time the last frame took
+		static r32 GetFrameDeltaTime();
+		//How far rendering is between the last two simulation steps, 0 is the previous step and 1 the latest
+		static r32 GetInterpolationAlpha();
+
+		/*
+			With pipelined rendering a render thread records and submits the last frame while the main thread simulates the next one.
+			The renderers give the render thread its own copy of everything submitted, Application::EndFrame runs on the render thread.
+			Not available with the editor attached, its gui records into the render context from the main thread
+		*/
+		static void SetPipelinedRendering(b32 pipelined);
+		static b32 IsPipelinedRendering();
+		//Blocks until the render thread is done with its frame, call it before creating or changing render resources during update
+		static void WaitForRenderThread();
+
+		/*
+			Frames are held to the limit with a sleep and a short spin for the last part, so the limit is hit precisely without
+			keeping a core busy. 0 removes the limit
+		*/
+		static void SetFrameRateLimit(r32 framesPerSecond);
+		static r32 GetFrameRateLimit();
+		//Limit used while the main display is minimized or not focused, or while render on demand has nothing to draw. 0 disables it
+		static void SetBackgroundFrameRateLimit(r32 framesPerSecond);
+		static r32 GetBackgroundFrameRateLimit();
+		/*
+			With render on demand a frame is only rendered after input, a display event or RequestRender, the simulation keeps running.
+			Meant for tools like the editor that sit still most of the time
+		*/
+		static void SetRenderOnDemand(b32 onDemand);
+		static b32 IsRenderOnDemand();
+		static void RequestRender();
 
 		static Application* GetActiveApplication();
 		static Application* GetApplication(EngineApplicationHandle handle);
@@ -0,0 +1,267 @@
+#include "JobSystem.h"
+#include "../Utils/Log.h"
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <vector>
+#include <chrono>
+
+namespace Eunoia {
+
+	struct JobQueue
+	{
+		std::mutex mutex;
+		std::deque<Job> jobs;
+	};
+
+	struct JobSystem_Data
+	{
+		std::vector<std::thread> threads;
+		JobQueue queues[EU_JOB_SYSTEM_MAX_THREAD_INDICES];
+		u32 numQueues;
+		b32 initialized;
+
+		std::atomic<b32> running;
+		//Jobs sitting in a queue, workers only wake up for these
+		std::atomic<u32> numQueuedJobs;
+		std::mutex sleepMutex;
+		std::condition_variable sleepCondition;
+
+		//Jobs waiting on a dependency, they are queued by the job that brings the dependency to zero
+		std::mutex blockedMutex;
+		std::vector<Job> blockedJobs;
+	};
+
+	static JobSystem_Data s_Data;
+	static thread_local u32 s_WorkerIndex = EU_JOB_SYSTEM_EXTERNAL_THREAD_INDEX;
+
+	//The deque of external threads sits after the worker deques
+	static u32 GetQueueIndex(u32 workerIndex)
+	{
+		return workerIndex == EU_JOB_SYSTEM_EXTERNAL_THREAD_INDEX ? s_Data.numQueues - 1 : workerIndex;
+	}
+
+	static b32 PopJob(u32 queueIndex, b32 steal, Job* job)
+	{
+		JobQueue* queue = &s_Data.queues[queueIndex];
+		std::lock_guard<std::mutex> lock(queue->mutex);
+		if (queue->jobs.empty())
+			return false;
+
+		s_Data.numQueuedJobs.fetch_sub(1, std::memory_order_relaxed);
+
+		if (steal)
+		{
+			*job = queue->jobs.front();
+			queue->jobs.pop_front();
+		}
+		else
+		{
+			*job = queue->jobs.back();
+			queue->jobs.pop_back();
+		}
+
+		return true;
+	}
+
+	static void PushJob(u32 queueIndex, const Job& job)
+	{
+		JobQueue* queue = &s_Data.queues[queueIndex];
+		std::lock_guard<std::mutex> lock(queue->mutex);
+		queue->jobs.push_back(job);
+		s_Data.numQueuedJobs.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	void JobSystem::Init(u32 numWorkers)
+	{
+		if (s_Data.initialized)
+			return;
+
+		if (numWorkers == 0)
+		{
+			u32 hardwareThreads = std::thread::hardware_concurrency();
+			numWorkers = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+		}
+
+		if (numWorkers > EU_JOB_SYSTEM_MAX_WORKERS)
+			numWorkers = EU_JOB_SYSTEM_MAX_WORKERS;
+
+		s_Data.numQueues = numWorkers + 2;
+		s_Data.running = true;
+		s_Data.numQueuedJobs = 0;
+		s_Data.initialized = true;
+		s_WorkerIndex = 0;
+
+		for (u32 i = 1; i <= numWorkers; i++)
+			s_Data.threads.push_back(std::thread(WorkerMain, i));
+	}
+
+	void JobSystem::Destroy()
+	{
+		if (!s_Data.initialized)
+			return;
+
+		//Drain whatever is left so no counter is left waiting forever
+		for (;;)
+		{
+			if (ExecuteNextJob())
+				continue;
+
+			b32 hasBlockedJobs;
+			{
+				std::lock_guard<std::mutex> lock(s_Data.blockedMutex);
+				hasBlockedJobs = !s_Data.blockedJobs.empty();
+			}
+
+			if (!hasBlockedJobs && s_Data.numQueuedJobs.load() == 0)
+				break;
+			std::this_thread::yield();
+		}
+
+		s_Data.running = false;
+		s_Data.sleepCondition.notify_all();
+		for (u32 i = 0; i < s_Data.threads.size(); i++)
+			s_Data.threads[i].join();
+
+		//A job that was still running may have released blocked jobs
+		while (ExecuteNextJob());
+
+		s_Data.threads.clear();
+		s_Data.numQueues = 0;
+		s_Data.initialized = false;
+	}
+
+	void JobSystem::Run(JobFunction function, void* userData, JobCounter* counter, u32 begin, u32 end, JobCounter* dependency)
+	{
+		if (counter)
+			counter->value.fetch_add(1, std::memory_order_relaxed);
+
+		Job job;
+		job.function = function;
+		job.userData = userData;
+		job.begin = begin;
+		job.end = end;
+		job.counter = counter;
+		job.dependency = dependency;
+
+		if (!s_Data.initialized)
+		{
+			function(userData, begin, end);
+			if (counter)
+				counter->value.fetch_sub(1, std::memory_order_release);
+			return;
+		}
+
+		if (dependency)
+		{
+			//Checked under the lock so the job finishing the dependency can't release the blocked jobs in between
+			std::lock_guard<std::mutex> lock(s_Data.blockedMutex);
+			if (!dependency->IsDone())
+			{
+				s_Data.blockedJobs.push_back(job);
+				return;
+			}
+		}
+
+		PushJob(GetQueueIndex(s_WorkerIndex), job);
+		s_Data.sleepCondition.notify_one();
+	}
+
+	void JobSystem::Dispatch(u32 count, u32 batchSize, JobFunction function, void* userData, JobCounter* counter, JobCounter* dependency)
+	{
+		if (batchSize == 0)
+			batchSize = 1;
+
+		for (u32 begin = 0; begin < count; begin += batchSize)
+		{
+			u32 end = begin + batchSize < count ? begin + batchSize : count;
+			Run(function, userData, counter, begin, end, dependency);
+		}
+	}
+
+	void JobSystem::Wait(JobCounter* counter)
+	{
+		while (!counter->IsDone())
+			if (!ExecuteNextJob())
+				std::this_thread::yield();
+	}
+
+	b32 JobSystem::IsInitialized()
+	{
+		return s_Data.initialized;
+	}
+
+	u32 JobSystem::GetNumWorkers()
+	{
+		return s_Data.initialized ? s_Data.numQueues - 2 : 0;
+	}
+
+	u32 JobSystem::GetWorkerIndex()
+	{
+		return s_WorkerIndex;
+	}
+
+	b32 JobSystem::ExecuteNextJob()
+	{
+		if (!s_Data.initialized)
+			return false;
+
+		u32 queueIndex = GetQueueIndex(s_WorkerIndex);
+		Job job;
+		b32 found = PopJob(queueIndex, false, &job);
+		for (u32 i = 1; i < s_Data.numQueues && !found; i++)
+			found = PopJob((queueIndex + i) % s_Data.numQueues, true, &job);
+
+		if (!found)
+			return false;
+
+		job.function(job.userData, job.begin, job.end);
+
+		if (job.counter && job.counter->value.fetch_sub(1, std::memory_order_acq_rel) == 1)
+			ReleaseBlockedJobs(job.counter);
+
+		return true;
+	}
+
+	void JobSystem::ReleaseBlockedJobs(JobCounter* dependency)
+	{
+		u32 numReleased = 0;
+		{
+			std::lock_guard<std::mutex> lock(s_Data.blockedMutex);
+			for (u32 i = 0; i < s_Data.blockedJobs.size();)
+			{
+				if (s_Data.blockedJobs[i].dependency != dependency)
+				{
+					i++;
+					continue;
+				}
+
+				PushJob(GetQueueIndex(s_WorkerIndex), s_Data.blockedJobs[i]);
+				s_Data.blockedJobs[i] = s_Data.blockedJobs.back();
+				s_Data.blockedJobs.pop_back();
+				numReleased++;
+			}
+		}
+
+		if (numReleased > 1)
+			s_Data.sleepCondition.notify_all();
+		else if (numReleased == 1)
+			s_Data.sleepCondition.notify_one();
+	}
+
+	void JobSystem::WorkerMain(u32 workerIndex)
+	{
+		s_WorkerIndex = workerIndex;
+
+		while (s_Data.running.load())
+		{
+			if (ExecuteNextJob())
+				continue;
+
+			std::unique_lock<std::mutex> lock(s_Data.sleepMutex);
+			s_Data.sleepCondition.wait_for(lock, std::chrono::milliseconds(1), []() { return s_Data.numQueuedJobs.load() > 0 || !s_Data.running.load(); });
+		}
+	}
+
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+#include "../Common.h"
+#include <atomic>
+
+#define EU_JOB_SYSTEM_MAX_WORKERS 63
+//Shared by every thread that is neither a worker nor the thread that called Init (render thread, scene loaders)
+#define EU_JOB_SYSTEM_EXTERNAL_THREAD_INDEX (EU_JOB_SYSTEM_MAX_WORKERS + 1)
+//Worker indices, the thread that called Init and the external threads
+#define EU_JOB_SYSTEM_MAX_THREAD_INDICES (EU_JOB_SYSTEM_MAX_WORKERS + 2)
+
+namespace Eunoia {
+
+	typedef void(*JobFunction)(void* userData, u32 begin, u32 end);
+
+	/*
+		Incremented when a job is submitted with it and decremented when that job finishes.
+		Waiting on a counter helps execute queued jobs until it reaches zero
+	*/
+	struct JobCounter
+	{
+		JobCounter() :
+			value(0)
+		{}
+
+		inline b32 IsDone() const { return value.load(std::memory_order_acquire) == 0; }
+
+		std::atomic<u32> value;
+	};
+
+	struct Job
+	{
+		JobFunction function;
+		void* userData;
+		u32 begin;
+		u32 end;
+		JobCounter* counter;
+		JobCounter* dependency;
+	};
+
+	/*
+		Every worker owns a deque, jobs pushed from a worker go to its own deque and are popped LIFO by the owner.
+		Idle workers steal the oldest job of another deque. The thread that called Init is worker 0 and only
+		executes jobs while it is waiting on a counter. Other threads share one more deque under
+		EU_JOB_SYSTEM_EXTERNAL_THREAD_INDEX and can submit and wait like worker 0.
+		A job whose dependency isn't done is parked until the job that finishes the dependency releases it.
+		If the job system was never initialized jobs run immediately on the calling thread
+	*/
+	class EU_API JobSystem
+	{
+	public:
+		//numWorkers of 0 sizes the pool to the hardware (one thread per core minus the calling thread)
+		static void Init(u32 numWorkers = 0);
+		static void Destroy();
+
+		//The job is not started before dependency reaches zero
+		static void Run(JobFunction function, void* userData, JobCounter* counter, u32 begin = 0, u32 end = 0, JobCounter* dependency = 0);
+		//Splits [0, count) into jobs of batchSize elements
+		static void Dispatch(u32 count, u32 batchSize, JobFunction function, void* userData, JobCounter* counter, JobCounter* dependency = 0);
+		static void Wait(JobCounter* counter);
+
+		//function(u32 index)
+		template<class F>
+		static void ParallelFor(u32 count, u32 batchSize, const F& function)
+		{
+			JobCounter counter;
+			Dispatch(count, batchSize, ParallelForJob<F>, (void*)&function, &counter);
+			Wait(&counter);
+		}
+
+		//function(u32 begin, u32 end)
+		template<class F>
+		static void ParallelForBatch(u32 count, u32 batchSize, const F& function)
+		{
+			JobCounter counter;
+			Dispatch(count, batchSize, ParallelForBatchJob<F>, (void*)&function, &counter);
+			Wait(&counter);
+		}
+
+		static b32 IsInitialized();
+		static u32 GetNumWorkers();
+		//1 to GetNumWorkers() on the workers, 0 on the thread that called Init, EU_JOB_SYSTEM_EXTERNAL_THREAD_INDEX anywhere else
+		static u32 GetWorkerIndex();
+
+		//Logs the scheduling overhead per job and the parallel-for scaling from 1 to the hardware thread count
+		static void RunBenchmark(u32 numJobs = 100000);
+
+		//Checks dependencies and submitting from other threads on the running job system, failures are logged as errors
+		static b32 RunTests();
+	private:
+		template<class F>
+		static void ParallelForJob(void* userData, u32 begin, u32 end)
+		{
+			const F& function = *(const F*)userData;
+			for (u32 i = begin; i < end; i++)
+				function(i);
+		}
+
+		template<class F>
+		static void ParallelForBatchJob(void* userData, u32 begin, u32 end)
+		{
+			(*(const F*)userData)(begin, end);
+		}
+
+		static b32 ExecuteNextJob();
+		static void ReleaseBlockedJobs(JobCounter* dependency);
+		static void WorkerMain(u32 workerIndex);
+	};
+
+}
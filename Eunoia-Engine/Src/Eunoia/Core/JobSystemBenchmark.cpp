@@ -0,0 +1,68 @@
+#include "JobSystem.h"
+#include "Benchmark.h"
+#include <thread>
+#include <cmath>
+
+namespace Eunoia {
+
+	static void EmptyJob(void* userData, u32 begin, u32 end)
+	{
+	}
+
+	static r64 MeasureJobOverhead(u32 numJobs)
+	{
+		JobCounter counter;
+		BenchmarkTimer timer;
+		for (u32 i = 0; i < numJobs; i++)
+			JobSystem::Run(EmptyJob, 0, &counter);
+		JobSystem::Wait(&counter);
+		return timer.GetElapsedNanoseconds() / numJobs;
+	}
+
+	static r64 MeasureParallelFor(r32* values, u32 numValues)
+	{
+		return MeasureMicroseconds([values, numValues]()
+		{
+			JobSystem::ParallelFor(numValues, 1024, [values](u32 i)
+			{
+				r32 v = (r32)i;
+				for (u32 j = 0; j < 64; j++)
+					v = sqrtf(v * v + 1.0f);
+				values[i] = v;
+			});
+		});
+	}
+
+	//Restarts the job system with every worker count, must not be called from inside a job
+	void JobSystem::RunBenchmark(u32 numJobs)
+	{
+		u32 originalNumWorkers = GetNumWorkers();
+		u32 hardwareThreads = std::thread::hardware_concurrency();
+		u32 maxWorkers = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+
+		const u32 numValues = 1 << 20;
+		r32* values = new r32[numValues];
+
+		r64 singleWorkerTime = 0.0;
+		for (u32 numWorkers = 1; numWorkers <= maxWorkers; numWorkers++)
+		{
+			Destroy();
+			Init(numWorkers);
+
+			r64 overhead = MeasureJobOverhead(numJobs);
+			r64 parallelForTime = MeasureParallelFor(values, numValues);
+			if (numWorkers == 1)
+				singleWorkerTime = parallelForTime;
+
+			EU_LOG_BENCHMARK("JobSystem", "{0} workers, {1:.1f}ns per empty job, parallel for {2:.0f}us ({3:.2f}x)",
+				numWorkers, overhead, parallelForTime, singleWorkerTime / parallelForTime);
+		}
+
+		delete[] values;
+
+		Destroy();
+		if (originalNumWorkers)
+			Init(originalNumWorkers);
+	}
+
+}
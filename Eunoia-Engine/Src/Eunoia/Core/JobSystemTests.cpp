@@ -0,0 +1,84 @@
+#include "JobSystem.h"
+#include "../Utils/Log.h"
+#include <thread>
+#include <chrono>
+
+#define EU_JOB_CHECK(condition) if (!(condition)) { EU_LOG_ERROR("JobSystem test failed: {0} ({1})", #condition, __LINE__); passed = false; }
+
+namespace Eunoia {
+
+	struct JobTestOrder
+	{
+		std::atomic<u32> numFirst;
+		std::atomic<u32> numSecond;
+		std::atomic<u32> numEarly;
+	};
+
+	static void FirstJob(void* userData, u32 begin, u32 end)
+	{
+		//Long enough that the second batch is submitted while this one still runs
+		std::this_thread::sleep_for(std::chrono::microseconds(100));
+		((JobTestOrder*)userData)->numFirst.fetch_add(end - begin);
+	}
+
+	static void SecondJob(void* userData, u32 begin, u32 end)
+	{
+		JobTestOrder* order = (JobTestOrder*)userData;
+		if (order->numFirst.load() != 64)
+			order->numEarly.fetch_add(1);
+		order->numSecond.fetch_add(end - begin);
+	}
+
+	//Jobs depending on a counter start only after every job of that counter finished
+	static b32 TestDependencies()
+	{
+		b32 passed = true;
+
+		JobTestOrder order;
+		order.numFirst = 0;
+		order.numSecond = 0;
+		order.numEarly = 0;
+
+		JobCounter first, second;
+		JobSystem::Dispatch(64, 4, FirstJob, &order, &first);
+		JobSystem::Dispatch(64, 4, SecondJob, &order, &second, &first);
+		JobSystem::Wait(&second);
+
+		EU_JOB_CHECK(first.IsDone());
+		EU_JOB_CHECK(order.numFirst == 64);
+		EU_JOB_CHECK(order.numSecond == 64);
+		EU_JOB_CHECK(order.numEarly == 0);
+		return passed;
+	}
+
+	//A thread the job system didn't start gets its own index and can still submit and wait
+	static b32 TestExternalThread()
+	{
+		b32 passed = true;
+
+		u32 workerIndex = 0;
+		std::atomic<u32> sum(0);
+		std::thread thread([&workerIndex, &sum]()
+		{
+			workerIndex = JobSystem::GetWorkerIndex();
+			JobSystem::ParallelFor(1000, 16, [&sum](u32 i) { sum.fetch_add(i); });
+		});
+		thread.join();
+
+		EU_JOB_CHECK(workerIndex == EU_JOB_SYSTEM_EXTERNAL_THREAD_INDEX);
+		EU_JOB_CHECK(sum == 999 * 1000 / 2);
+		return passed;
+	}
+
+	b32 JobSystem::RunTests()
+	{
+		b32 passed = true;
+		passed &= TestDependencies();
+		passed &= TestExternalThread();
+
+		if (passed)
+			EU_LOG_INFO("JobSystem tests passed");
+		return passed;
+	}
+
+}
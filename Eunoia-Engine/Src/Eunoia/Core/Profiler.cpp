@@ -0,0 +1,207 @@
+#include "Profiler.h"
+#include "JobSystem.h"
+#include "../Utils/Log.h"
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <stdio.h>
+
+namespace Eunoia {
+
+	struct ProfilerThreadBuffer
+	{
+		ProfilerEvent events[EU_PROFILER_EVENTS_PER_THREAD];
+		//Only written by the owning thread, the events below it are complete
+		std::atomic<u64> numWritten;
+		u32 workerIndex;
+		//Cleared when the owning thread exits so the next registered thread reuses the buffer, guarded by registerMutex
+		b32 inUse;
+	};
+
+	//Only touched when a thread registers so scopes don't pay for a thread local with a destructor
+	struct ProfilerThreadOwner
+	{
+		ProfilerThreadOwner() : buffer(0) {}
+		~ProfilerThreadOwner();
+
+		ProfilerThreadBuffer* buffer;
+	};
+
+	struct Profiler_Data
+	{
+		std::mutex registerMutex;
+		ProfilerThreadBuffer* threads[EU_PROFILER_MAX_THREADS];
+		std::atomic<u32> numThreads;
+		u64 captureBegin;
+
+		std::mutex internMutex;
+		std::unordered_set<std::string> internedNames;
+	};
+
+	static Profiler_Data s_Data;
+	static thread_local ProfilerThreadBuffer* s_ThreadBuffer = 0;
+	static thread_local ProfilerThreadOwner s_ThreadOwner;
+	static thread_local b32 s_ThreadDropped = false;
+	static thread_local u32 s_Depth = 0;
+
+	std::atomic<b32> Profiler::s_Recording(false);
+
+	//Threads that come and go (the render thread, scene loaders) take over the buffer of a thread that exited
+	static ProfilerThreadBuffer* RegisterThread()
+	{
+		std::lock_guard<std::mutex> lock(s_Data.registerMutex);
+		u32 numThreads = s_Data.numThreads.load(std::memory_order_relaxed);
+
+		ProfilerThreadBuffer* buffer = 0;
+		for (u32 i = 0; i < numThreads; i++)
+		{
+			if (!s_Data.threads[i]->inUse)
+			{
+				buffer = s_Data.threads[i];
+				break;
+			}
+		}
+
+		if (!buffer)
+		{
+			if (numThreads == EU_PROFILER_MAX_THREADS)
+			{
+				EU_LOG_WARN("More than {0} threads are recording profiler scopes, the scopes of this thread are dropped", EU_PROFILER_MAX_THREADS);
+				s_ThreadDropped = true;
+				return 0;
+			}
+
+			buffer = new ProfilerThreadBuffer();
+			buffer->numWritten.store(0, std::memory_order_relaxed);
+			s_Data.threads[numThreads] = buffer;
+			s_Data.numThreads.store(numThreads + 1, std::memory_order_release);
+		}
+
+		buffer->workerIndex = JobSystem::GetWorkerIndex();
+		buffer->inUse = true;
+		s_ThreadOwner.buffer = buffer;
+		return buffer;
+	}
+
+	ProfilerThreadOwner::~ProfilerThreadOwner()
+	{
+		if (!buffer)
+			return;
+
+		//The events stay in the ring, the next thread appends to them
+		std::lock_guard<std::mutex> lock(s_Data.registerMutex);
+		buffer->inUse = false;
+		s_ThreadBuffer = 0;
+	}
+
+	static void WriteEscapedString(FILE* file, const char* string)
+	{
+		for (const char* c = string; *c; c++)
+		{
+			if (*c == '"' || *c == '\\')
+				fputc('\\', file);
+			fputc(*c, file);
+		}
+	}
+
+	void Profiler::BeginCapture()
+	{
+		//The calling thread is registered first so it shows up as the main thread
+		if (!s_ThreadBuffer && !s_ThreadDropped)
+			s_ThreadBuffer = RegisterThread();
+
+		u32 numThreads = s_Data.numThreads.load(std::memory_order_acquire);
+		for (u32 i = 0; i < numThreads; i++)
+			s_Data.threads[i]->numWritten.store(0, std::memory_order_relaxed);
+
+		s_Data.captureBegin = GetTimestamp();
+		s_Recording.store(true, std::memory_order_release);
+	}
+
+	void Profiler::EndCapture()
+	{
+		s_Recording.store(false, std::memory_order_release);
+	}
+
+	b32 Profiler::WriteChromeTrace(const String& path)
+	{
+		FILE* file = fopen(path.C_Str(), "w");
+		if (!file)
+		{
+			EU_LOG_WARN("Could not write profiler trace {0}", path.C_Str());
+			return false;
+		}
+
+		fprintf(file, "{\"traceEvents\":[\n");
+		b32 first = true;
+		u32 numThreads = s_Data.numThreads.load(std::memory_order_acquire);
+		for (u32 i = 0; i < numThreads; i++)
+		{
+			const ProfilerThreadBuffer* buffer = s_Data.threads[i];
+
+			fprintf(file, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%u,\"args\":{\"name\":\"", first ? "" : ",\n", i);
+			if (i == 0)
+				fprintf(file, "Main");
+			else if (buffer->workerIndex != 0 && buffer->workerIndex != EU_JOB_SYSTEM_EXTERNAL_THREAD_INDEX)
+				fprintf(file, "Worker %u", buffer->workerIndex);
+			else
+				fprintf(file, "Thread %u", i);
+			fprintf(file, "\"}}");
+			first = false;
+
+			u64 numWritten = buffer->numWritten.load(std::memory_order_acquire);
+			u64 firstEvent = numWritten > EU_PROFILER_EVENTS_PER_THREAD ? numWritten - EU_PROFILER_EVENTS_PER_THREAD : 0;
+			for (u64 j = firstEvent; j < numWritten; j++)
+			{
+				const ProfilerEvent& event = buffer->events[j % EU_PROFILER_EVENTS_PER_THREAD];
+				if (event.begin < s_Data.captureBegin)
+					continue;
+
+				fprintf(file, ",\n{\"name\":\"");
+				WriteEscapedString(file, event.name);
+				fprintf(file, "\",\"ph\":\"X\",\"pid\":0,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"depth\":%u}}",
+					i, (event.begin - s_Data.captureBegin) / 1000.0, (event.end - event.begin) / 1000.0, event.depth);
+			}
+		}
+
+		fprintf(file, "\n]}\n");
+		fclose(file);
+		return true;
+	}
+
+	const char* Profiler::InternName(const String& name)
+	{
+		std::lock_guard<std::mutex> lock(s_Data.internMutex);
+		return s_Data.internedNames.insert(std::string(name.C_Str())).first->c_str();
+	}
+
+	u32 Profiler::BeginScope()
+	{
+		return s_Depth++;
+	}
+
+	void Profiler::EndScope(const char* name, u64 begin, u64 end, u32 depth)
+	{
+		s_Depth--;
+
+		ProfilerThreadBuffer* buffer = s_ThreadBuffer;
+		if (!buffer)
+		{
+			if (s_ThreadDropped)
+				return;
+
+			buffer = s_ThreadBuffer = RegisterThread();
+			if (!buffer)
+				return;
+		}
+
+		u64 index = buffer->numWritten.load(std::memory_order_relaxed);
+		ProfilerEvent* event = &buffer->events[index % EU_PROFILER_EVENTS_PER_THREAD];
+		event->name = name;
+		event->begin = begin;
+		event->end = end;
+		event->depth = depth;
+		buffer->numWritten.store(index + 1, std::memory_order_release);
+	}
+
+}
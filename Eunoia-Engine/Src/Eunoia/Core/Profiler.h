@@ -0,0 +1,96 @@
+#pragma once
+
+#include "../Common.h"
+#include "../DataStructures/String.h"
+#include <atomic>
+#include <chrono>
+
+#ifndef EU_DIST
+#define EU_PROFILE_ENABLED
+#endif
+
+//Completed scopes kept per thread, the oldest are overwritten once a thread wraps around
+#define EU_PROFILER_EVENTS_PER_THREAD (64 * 1024)
+//Threads that can record at the same time, the buffer of a thread that exited is reused
+#define EU_PROFILER_MAX_THREADS 64
+
+#ifdef EU_PROFILE_ENABLED
+#define EU_PROFILE_CONCAT_(A, B) A##B
+#define EU_PROFILE_CONCAT(A, B) EU_PROFILE_CONCAT_(A, B)
+//The name is stored as a pointer, it has to outlive the capture (string literals and metadata names do)
+#define EU_PROFILE_SCOPE(name) Eunoia::ProfilerScope EU_PROFILE_CONCAT(euProfilerScope, __LINE__)(name)
+#define EU_PROFILE_FUNCTION() EU_PROFILE_SCOPE(__FUNCTION__)
+#else
+#define EU_PROFILE_SCOPE(name)
+#define EU_PROFILE_FUNCTION()
+#endif
+
+namespace Eunoia {
+
+	struct ProfilerEvent
+	{
+		const char* name;
+		u64 begin;
+		u64 end;
+		u32 depth;
+	};
+
+	/*
+		Records named scopes into a ring buffer per thread. Recording a scope is two clock reads and one write into memory only
+		the recording thread touches, nothing is shared between threads until the capture is written out.
+		Captures should be written while no other thread is inside a scope, between frames the workers are idle
+	*/
+	class EU_API Profiler
+	{
+	public:
+		static void BeginCapture();
+		static void EndCapture();
+
+		//Chrome trace event format, open in chrome://tracing or Perfetto
+		static b32 WriteChromeTrace(const String& path);
+
+		static inline b32 IsRecording() { return s_Recording.load(std::memory_order_relaxed); }
+		static inline u64 GetTimestamp() { return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now().time_since_epoch()).count(); }
+
+		//Keeps a copy of the name for as long as the engine runs, for scope names that aren't string literals
+		static const char* InternName(const String& name);
+
+		//Used by ProfilerScope, the depth lives in the engine since thread locals can't be shared with projects
+		static u32 BeginScope();
+		static void EndScope(const char* name, u64 begin, u64 end, u32 depth);
+
+		//Logs the cost of a recorded and an ignored scope, throws away the current capture
+		static void RunBenchmark(u32 numScopes = 1000000);
+	private:
+		static std::atomic<b32> s_Recording;
+	};
+
+#ifdef EU_PROFILE_ENABLED
+	class ProfilerScope
+	{
+	public:
+		inline ProfilerScope(const char* name) :
+			m_Name(name),
+			m_Recording(Profiler::IsRecording())
+		{
+			if (!m_Recording)
+				return;
+
+			m_Depth = Profiler::BeginScope();
+			m_Begin = Profiler::GetTimestamp();
+		}
+
+		inline ~ProfilerScope()
+		{
+			if (m_Recording)
+				Profiler::EndScope(m_Name, m_Begin, Profiler::GetTimestamp(), m_Depth);
+		}
+	private:
+		const char* m_Name;
+		b32 m_Recording;
+		u32 m_Depth;
+		u64 m_Begin;
+	};
+#endif
+
+}
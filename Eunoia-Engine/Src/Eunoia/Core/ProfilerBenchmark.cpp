@@ -0,0 +1,28 @@
+#include "Profiler.h"
+#include "Benchmark.h"
+
+namespace Eunoia {
+
+	static r64 GetNanosecondsPerScope(u32 numScopes)
+	{
+		BenchmarkTimer timer;
+		for (u32 i = 0; i < numScopes; i++)
+		{
+			EU_PROFILE_SCOPE("ProfilerBenchmark");
+		}
+		return timer.GetElapsedNanoseconds() / numScopes;
+	}
+
+	void Profiler::RunBenchmark(u32 numScopes)
+	{
+		EndCapture();
+		r64 ignoredTime = GetNanosecondsPerScope(numScopes);
+
+		BeginCapture();
+		r64 recordedTime = GetNanosecondsPerScope(numScopes);
+		EndCapture();
+
+		EU_LOG_BENCHMARK("Profiler", "{0} scopes, {1:.1f}ns per recorded scope, {2:.1f}ns per scope while not capturing", numScopes, recordedTime, ignoredTime);
+	}
+
+}
@@ -222,6 +222,25 @@ namespace Eunoia {
 			return *this;
 		}
 
+		//Exchanges the memory of both lists without copying any elements
+		void Swap(List<T>& other)
+		{
+			T* memory = m_Memory;
+			u32 elementCount = m_ElementCount;
+			u32 capacity = m_Capacity;
+			ListCapacityChange capacityChange = m_CapacityChange;
+
+			m_Memory = other.m_Memory;
+			m_ElementCount = other.m_ElementCount;
+			m_Capacity = other.m_Capacity;
+			m_CapacityChange = other.m_CapacityChange;
+
+			other.m_Memory = memory;
+			other.m_ElementCount = elementCount;
+			other.m_Capacity = capacity;
+			other.m_CapacityChange = capacityChange;
+		}
+
 		T& operator[](u32 index)
 		{
 			return *(m_Memory + index);
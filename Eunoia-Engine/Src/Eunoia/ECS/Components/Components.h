@@ -17,4 +17,5 @@
 #include "RigidBodyComponent.h"
 #include "Gamepad3DComponent.h"
 #include "KeyboardLookAround3DComponent.h"
-#include "Camera2DComponent.h"
\ No newline at end of file
+#include "Camera2DComponent.h"
+#include "SpatialIndex3DComponent.h"
\ No newline at end of file
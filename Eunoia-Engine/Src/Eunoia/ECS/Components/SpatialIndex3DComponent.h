@@ -0,0 +1,22 @@
+#pragma once
+
+#include "../ECS.h"
+#include "../../Math/Math.h"
+
+namespace Eunoia {
+
+	//Puts the entity into the SpatialIndex3DSystem as a bounding sphere around its Transform3DComponent
+	EU_REFLECT(Component)
+	struct SpatialIndex3DComponent : public ECSComponent
+	{
+		SpatialIndex3DComponent(r32 radius = 1.0f, const v3& center = v3(0.0f, 0.0f, 0.0f)) :
+			radius(radius),
+			center(center)
+		{}
+
+		//In local space, scaled by the largest axis of the world scale
+		EU_PROPERTY() r32 radius;
+		EU_PROPERTY() v3 center;
+	};
+
+}
@@ -10,12 +10,36 @@ namespace Eunoia {
 	{
 		Transform3DComponent(const Transform3D& localTransform = Transform3D()) :
 			localTransform(localTransform),
-			worldTransform(localTransform)
-		{}
+			worldTransform(localTransform),
+			previousWorldTransform(localTransform),
+			hasPreviousWorldTransform(false)
+		{
+			UpdateWorldMatrices();
+		}
+
+		//Called by the transform hierarchy whenever worldTransform changes, anything else should only read the matrices
+		inline void UpdateWorldMatrices()
+		{
+			worldMatrix = worldTransform.CreateTransformMatrix();
+			worldMatrixInverse = worldTransform.CreateInverseTransformMatrix();
+			renderTransform = worldTransform;
+			renderMatrix = worldMatrix;
+		}
 
 		EU_PROPERTY()
 		Transform3D localTransform;
 		Transform3D worldTransform;
+		m4 worldMatrix;
+		m4 worldMatrixInverse;
+
+		/*
+			The world transform before the last simulation step. Rendering happens between simulation steps so anything drawn
+			should use renderTransform and renderMatrix, the transform hierarchy blends them from the last two steps before every frame
+		*/
+		Transform3D previousWorldTransform;
+		b32 hasPreviousWorldTransform;
+		Transform3D renderTransform;
+		m4 renderMatrix;
 	};
 
 }
\ No newline at end of file
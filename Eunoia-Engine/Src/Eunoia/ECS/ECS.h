@@ -7,8 +7,20 @@
 #include "../Utils/Log.h"
 #include "../DataStructures/String.h"
 #include <string>
+#include <algorithm>
+#include <chrono>
 #include "ECSLoader.h"
 #include "ECSTypes.h"
+#include "ECSArchetype.h"
+#include "ECSSparseSet.h"
+#include "ECSView.h"
+#include "ECSNameIndex.h"
+#include "ECSCommandBuffer.h"
+#include "ECSEventQueue.h"
+#include "ECSPrefab.h"
+#include "ECSSceneStreamer.h"
+#include "../Core/JobSystem.h"
+#include "../Core/Profiler.h"
 
 namespace Eunoia
 {
@@ -21,6 +33,9 @@ namespace Eunoia
 
 		EU_PROPERTY() b32 enabled;
 		EU_PROPERTY() EntityID parent;
+
+		//Stamped by the ECS whenever the component is created or written through a mutable accessor
+		ECSVersion version;
 	};
 
 	struct ECSComponentContainer
@@ -35,13 +50,20 @@ namespace Eunoia
 	typedef u32 SystemIndex;
 	struct ECSEntityContainer
 	{
+		//The full ID including generation, EU_ECS_INVALID_ENTITY_ID while the slot is free
+		EntityID id;
 		b32 enabled;
 		ComponentList components;
 		String name;
+		ECSNameHash nameHash;
 		List<EntityID> children;
 		EntityID parent;
-		List<SystemIndex> compatibleSystems;
-		b32 checkedForCompatibleSystems;
+		SceneID scene;
+		u32 hierarchyOrder;
+		b32 activeInHierarchy;
+		ArchetypeIndex archetype;
+		u32 archetypeChunk;
+		u32 archetypeRow;
 	};
 
 	EU_REFLECT()
@@ -51,6 +73,33 @@ namespace Eunoia
 		r32 time;
 	};
 
+	enum ECSComponentAccess
+	{
+		ECS_COMPONENT_ACCESS_READ = 1,
+		ECS_COMPONENT_ACCESS_WRITE = 2,
+		ECS_COMPONENT_ACCESS_READ_WRITE = ECS_COMPONENT_ACCESS_READ | ECS_COMPONENT_ACCESS_WRITE
+	};
+
+	enum ECSSystemThreading
+	{
+		//Runs on the thread that called the ECS and is ordered against every other system. Use this for anything touching the renderer, physics or global state
+		ECS_SYSTEM_THREADING_MAIN_THREAD,
+		//May run on a worker at the same time as other systems whose declared component accesses don't conflict
+		ECS_SYSTEM_THREADING_PARALLEL,
+		//Same as parallel but the entities of the system are also split into chunks processed on different workers
+		ECS_SYSTEM_THREADING_PARALLEL_ENTITIES
+	};
+
+	//What happens to a system while its application is not the active one
+	enum ECSSystemBackgroundPolicy
+	{
+		ECS_SYSTEM_BACKGROUND_PAUSE,
+		//Updated at its own tick rate as if the application was active
+		ECS_SYSTEM_BACKGROUND_RUN,
+		//Updated at the ECS background tick rate, or its own tick rate if that is lower
+		ECS_SYSTEM_BACKGROUND_THROTTLE
+	};
+
 	class ECS;
 	EU_REFLECT()
 	class ECSSystem
@@ -58,11 +107,32 @@ namespace Eunoia
 	public:
 		ECSSystem() :
 			m_NumRequiredComponents(0),
+			m_NumOptionalComponents(0),
+			m_Threading(ECS_SYSTEM_THREADING_MAIN_THREAD),
+			m_ProcessInHierarchyOrder(false),
+			m_BatchProcessing(false),
+			m_HierarchyVersion(0),
+			m_LastChangeVersion(0),
+			m_ChangeVersion(0),
+			m_TickRate(0.0f),
+			m_TimeBudget(0.0f),
+			m_BackgroundPolicy(ECS_SYSTEM_BACKGROUND_PAUSE),
+			m_Ticking(true),
+			m_TickAccumulator(0.0f),
+			m_TimeSinceTick(0.0f),
+			m_TickDt(0.0f),
+			m_NextSlicedEntity(0),
+			m_SweepTime(0.0f),
+			m_SweepDt(0.0f),
+			m_ProfileName("ECSSystem"),
 			enabled(true)
 		{}
 
 		virtual void Init() {}
 
+		//Called after ECS::RestoreSnapshot, the reflected members are restored but anything the system cached about the entities is stale
+		virtual void OnSnapshotRestored() {}
+
 		virtual ~ECSSystem() {}
 
 		virtual void PrePhysicsSimulation(EntityID entity, r32 dt) {}
@@ -76,15 +146,116 @@ namespace Eunoia
 		virtual void ProcessEntityOnRender(EntityID entity) {}
 		virtual void PostRender() {}
 
+		//Called instead of the per entity callbacks once SetBatchProcessing(true) is set
+		virtual void PrePhysicsSimulationBatch(const ECSEntityBatch& batch, r32 dt) {}
+		virtual void PostPhysicsSimulationBatch(const ECSEntityBatch& batch, r32 dt) {}
+		virtual void ProcessBatchOnUpdate(const ECSEntityBatch& batch, r32 dt) {}
+		virtual void ProcessBatchOnRender(const ECSEntityBatch& batch) {}
+
 		b32 enabled;
 	protected:
 		template<class C>
-		inline void AddComponentType() { m_RequiredComponets[m_NumRequiredComponents++] = Metadata::GetTypeID<C>(); }
+		inline void AddComponentType(ECSComponentAccess access = ECS_COMPONENT_ACCESS_READ_WRITE)
+		{
+			m_RequiredComponentAccess[m_NumRequiredComponents] = access;
+			m_RequiredComponets[m_NumRequiredComponents++] = Metadata::GetTypeID<C>();
+		}
+
+		//Declares a component the system touches without requiring it, used to schedule parallel systems and resolved in batches
+		template<class C>
+		inline void AddOptionalComponentType(ECSComponentAccess access = ECS_COMPONENT_ACCESS_READ)
+		{
+			m_OptionalComponentAccess[m_NumOptionalComponents] = access;
+			m_OptionalComponents[m_NumOptionalComponents++] = Metadata::GetTypeID<C>();
+		}
+
+		/*
+			Parallel systems must declare every component they access and must not create or destroy entities or components
+			while they are processing
+		*/
+		inline void SetThreading(ECSSystemThreading threading) { m_Threading = threading; }
+		inline ECSSystemThreading GetThreading() const { return m_Threading; }
+
+		inline u32 GetComponentAccess(metadata_typeid typeID) const
+		{
+			u32 access = 0;
+			for (u32 i = 0; i < m_NumRequiredComponents; i++)
+				if (m_RequiredComponets[i] == typeID)
+					access |= m_RequiredComponentAccess[i];
+			for (u32 i = 0; i < m_NumOptionalComponents; i++)
+				if (m_OptionalComponents[i] == typeID)
+					access |= m_OptionalComponentAccess[i];
+			return access;
+		}
+
+		//Entities will be processed parents first, in the same order as a depth first walk of the scene
+		inline void SetProcessInHierarchyOrder(b32 hierarchyOrder) { m_ProcessInHierarchyOrder = hierarchyOrder; }
+
+		/*
+			Updates the system at most tickRate times a second instead of every frame, 0 updates every frame.
+			PreUpdate, the update callbacks and PostUpdate get the time since the previous tick. Render and physics callbacks still run every frame
+		*/
+		inline void SetTickRate(r32 tickRate) { m_TickRate = tickRate; }
+		inline r32 GetTickRate() const { return m_TickRate; }
+
+		/*
+			Limits the update callbacks to about milliseconds per tick, 0 processes every entity every tick. The entities are processed
+			round robin, every tick continues where the previous one stopped and entities get the time one full pass over them took.
+			A budgeted system processes its entities on one thread
+		*/
+		inline void SetTimeBudget(r32 milliseconds) { m_TimeBudget = milliseconds; }
+		inline r32 GetTimeBudget() const { return m_TimeBudget; }
+
+		inline void SetBackgroundPolicy(ECSSystemBackgroundPolicy policy) { m_BackgroundPolicy = policy; }
+		inline ECSSystemBackgroundPolicy GetBackgroundPolicy() const { return m_BackgroundPolicy; }
+
+		inline const ECSEntityList& GetEntities() const { return m_Entities; }
+
+		/*
+			The ECS resolves the declared components of every entity up front and calls the batch callbacks once
+			(once per chunk for ECS_SYSTEM_THREADING_PARALLEL_ENTITIES) instead of the per entity callbacks
+		*/
+		inline void SetBatchProcessing(b32 batchProcessing) { m_BatchProcessing = batchProcessing; }
+
+		//True when the component was created or marked changed since the previous update of this system
+		inline b32 HasComponentChanged(const ECSComponent* component) const { return EU_ECS_VERSION_NEWER(component->version, m_LastChangeVersion); }
+
+		/*
+			The version the ECS handed this system for the current update. Components written by the system during its update
+			can be stamped with it so other systems see the change but the system itself doesn't on its next update
+		*/
+		inline ECSVersion GetChangeVersion() const { return m_ChangeVersion; }
 
 		friend class ECS;
 		ECS* m_ECS;
 		metadata_typeid m_RequiredComponets[EU_ECS_MAX_COMPONENTS_A_SYSTEM_CAN_PROCESS];
+		u8 m_RequiredComponentAccess[EU_ECS_MAX_COMPONENTS_A_SYSTEM_CAN_PROCESS];
 		u32 m_NumRequiredComponents;
+		metadata_typeid m_OptionalComponents[EU_ECS_MAX_COMPONENTS_A_SYSTEM_CAN_PROCESS];
+		u8 m_OptionalComponentAccess[EU_ECS_MAX_COMPONENTS_A_SYSTEM_CAN_PROCESS];
+		u32 m_NumOptionalComponents;
+		ECSSystemThreading m_Threading;
+		ECSEntityList m_Entities;
+		b32 m_ProcessInHierarchyOrder;
+		b32 m_BatchProcessing;
+		u32 m_HierarchyVersion;
+		ECSVersion m_LastChangeVersion;
+		ECSVersion m_ChangeVersion;
+		List<EntityID> m_BatchEntities;
+		List<ECSComponent*> m_BatchComponents;
+		List<ECSArchetype*> m_BatchArchetypes;
+
+		r32 m_TickRate;
+		r32 m_TimeBudget;
+		ECSSystemBackgroundPolicy m_BackgroundPolicy;
+		b32 m_Ticking;
+		r32 m_TickAccumulator;
+		r32 m_TimeSinceTick;
+		r32 m_TickDt;
+		u32 m_NextSlicedEntity;
+		r32 m_SweepTime;
+		r32 m_SweepDt;
+		const char* m_ProfileName;
 	};
 
 	struct ECSSystemContainer
@@ -95,14 +266,142 @@ namespace Eunoia
 
 	struct ECSScene
 	{
+		ECSScene() :
+			numScheduleWaves(0),
+			scheduleDirty(true)
+		{}
+
 		String name;
 		EntityID rootEntity;
 		b32 created;
 		List<ECSSystemContainer> systems;
+
+		//systemWaves[i] is the wave system i runs in. Systems in the same wave have no conflicting component accesses
+		List<u32> systemWaves;
+		u32 numScheduleWaves;
+		b32 scheduleDirty;
 	};
 
 	typedef List<ECSLoadedScene> ECSResetPoint;
 
+	struct ECSSnapshotComponent
+	{
+		metadata_typeid typeID;
+		u32 dataOffset;
+		u32 firstRuntimeMember;
+		u32 numRuntimeMembers;
+	};
+
+	//A member saved through its ECSLoader unsafe runtime member handler
+	struct ECSSnapshotRuntimeMember
+	{
+		u32 offset;
+		u32 handler;
+		u32 dataOffset;
+		u32 dataSize;
+	};
+
+	//Where the members that own runtime objects are in one component type
+	struct ECSSnapshotTypeLayout
+	{
+		List<u32> runtimeMemberOffsets;
+		List<u32> runtimeMemberHandlers;
+	};
+
+	struct ECSSnapshotSystem
+	{
+		metadata_typeid typeID;
+		ECSSystem* system;
+		b32 enabled;
+		ECSEntityList entities;
+		//The reflected members are stored one after another in member order
+		u32 dataOffset;
+	};
+
+	/*
+		A copy of the ECS tables and components taken with ECS::CreateSnapshot. Components are copied with their copy constructors,
+		members that own runtime objects go through their ECSLoader handlers and reflected String members of systems get deep copies.
+		A snapshot still holds vtables and asset IDs of the running process so it can't outlive a project reload,
+		use ECSResetPoint for anything that has to survive one
+	*/
+	struct ECSSnapshot
+	{
+		ECSSnapshot() :
+			valid(false)
+		{}
+
+		ECSSnapshot(const ECSSnapshot&) = delete;
+		ECSSnapshot& operator=(const ECSSnapshot&) = delete;
+
+		~ECSSnapshot()
+		{
+			Clear();
+		}
+
+		inline void Clear()
+		{
+			for (u32 i = 0; i < components.Size(); i++)
+				Metadata::GetMetadata(components[i].typeID).cls->Destructor(&data[components[i].dataOffset]);
+			for (u32 i = 0; i < stringOffsets.Size(); i++)
+				((String*)&data[stringOffsets[i]])->~String();
+
+			entities.Clear();
+			scenes.Clear();
+			freeSceneIDs.Clear();
+			freeEntityIDs.Clear();
+			nameIndex.Clear();
+			childNameIndex.Clear();
+			components.Clear();
+			runtimeMembers.Clear();
+			systems.Clear();
+			stringOffsets.Clear();
+			data.Clear();
+			valid = false;
+		}
+
+		//Makes room for size bytes aligned for any component and returns their offset
+		inline u32 AllocateData(u32 size)
+		{
+			u32 offset = (u32)EU_ALIGN_UP(data.Size(), EU_DEFAULT_ALIGNMENT);
+			u32 dataSize = offset + size;
+			if (dataSize > data.GetCapacity())
+				data.SetCapacity(EU_MAX(dataSize, (u32)data.GetCapacity() * 2));
+			data.AddToElementCount(dataSize - data.Size());
+			return offset;
+		}
+
+		inline u32 AppendData(const void* src, u32 size)
+		{
+			u32 offset = AllocateData(size);
+			memcpy(&data[offset], src, size);
+			return offset;
+		}
+
+		//Replaces the raw String bytes at offset with a copy that the snapshot owns
+		inline void CopyString(u32 offset, const String& string)
+		{
+			new(&data[offset]) String(string);
+			stringOffsets.Push(offset);
+		}
+
+		List<ECSEntityContainer> entities;
+		List<ECSScene> scenes;
+		List<SceneID> freeSceneIDs;
+		SceneID activeScene;
+		List<EntityID> freeEntityIDs;
+		EntityID nextEntityID;
+		ECSEntityNameIndex nameIndex;
+		ECSEntityNameIndex childNameIndex;
+		//One per component in entity order
+		List<ECSSnapshotComponent> components;
+		List<ECSSnapshotRuntimeMember> runtimeMembers;
+		List<ECSSnapshotSystem> systems;
+		//The String members of the systems
+		List<u32> stringOffsets;
+		List<u8> data;
+		b32 valid;
+	};
+
 	enum ECSProcessType
 	{
 		ECS_PROCESS_UPDATE,
@@ -119,22 +418,105 @@ namespace Eunoia
 		inline ECS() :
 			m_NextEntityID(2),
 			m_ActiveScene(EU_ECS_INVALID_SCENE_ID),
-			m_SystemAllocator(32, 512),
-			m_EventAllocator(EU_KB(5))
+			m_StorageMode(ECS_STORAGE_MODE_POOLED),
+			m_HierarchyDirty(true),
+			m_HierarchyVersion(0),
+			m_ParallelSystems(true),
+			m_BackgroundTickRate(EU_ECS_DEFAULT_BACKGROUND_TICK_RATE),
+			m_ChangeVersion(0),
+			m_SystemAllocator(EU_ECS_MAX_SYSTEMS, EU_ECS_MAX_SYSTEM_SIZE)
 		{
-			
+			for (u32 i = 0; i < EU_ECS_MAX_EVENT_TYPES; i++)
+				m_EventQueues[i].store(0, std::memory_order_relaxed);
 		}
 
 		~ECS()
 		{
 			for (const auto& it_cta : m_ComponentTypeAllocators)
 				delete it_cta.second;
+
+			for (u32 i = 0; i < m_Archetypes.Size(); i++)
+				delete m_Archetypes[i];
+
+			for (u32 i = 0; i < m_ComponentSets.Size(); i++)
+				delete m_ComponentSets[i];
+
+			for (u32 i = 0; i < EU_ECS_MAX_EVENT_TYPES; i++)
+				delete m_EventQueues[i].load();
+		}
+
+		/*
+			Switches where component memory lives. Pooled mode keeps one DynamicPoolAllocator per component type,
+			archetype mode packs entities with the same component set into chunks with one array per component type.
+			In archetype mode adding or removing a component moves all components of the entity to another archetype and
+			destroying an entity moves another one into its row, so component pointers are only valid until the next structural change.
+			Batch systems that don't process in hierarchy order walk the archetype chunks instead of the sparse sets.
+			The mode can only be changed while the ECS has no entities
+		*/
+		inline b32 SetStorageMode(ECSStorageMode mode)
+		{
+			if (!m_CreatedEntities.Empty())
+			{
+				EU_LOG_WARN("The ECS storage mode can only be changed before any entities are created");
+				return false;
+			}
+
+			m_StorageMode = mode;
+			return true;
+		}
+
+		inline ECSStorageMode GetStorageMode() const { return m_StorageMode; }
+
+		/*
+			Moves pooled components out of their least used pools and releases the pools left empty.
+			Component pointers held outside the ECS are invalidated so never call this while systems are processing.
+			Archetype storage keeps its chunks packed already so this does nothing in that mode
+		*/
+		inline void CompactComponentMemory()
+		{
+			if (m_StorageMode != ECS_STORAGE_MODE_POOLED)
+				return;
+
+			for (const auto& it_cta : m_ComponentTypeAllocators)
+			{
+				DynamicPoolAllocator* allocator = it_cta.second;
+				if (!allocator->BeginCompaction())
+					continue;
+
+				metadata_typeid typeID = it_cta.first;
+				mem_size size = Metadata::GetMetadata(typeID).cls->size;
+				ECSComponentSparseSet* set = m_ComponentSets[typeID];
+				for (u32 i = 0; i < set->Size(); i++)
+				{
+					EntityID entity = set->denseEntities[i];
+					ECSComponentContainer* component = GetComponentContainer(entity, typeID);
+					if (!component || !allocator->IsEvacuating(component->allocatorIndex))
+						continue;
+
+					u32 allocatorIndex;
+					ECSComponent* memory = (ECSComponent*)allocator->Allocate(&allocatorIndex);
+					memcpy(memory, component->actualComponent, size);
+					allocator->Free(component->actualComponent, component->allocatorIndex);
+
+					component->actualComponent = memory;
+					component->allocatorIndex = allocatorIndex;
+					set->denseComponents[i] = memory;
+				}
+
+				allocator->EndCompaction();
+			}
 		}
 
 		inline void Begin()
 		{
-			for (u32 i = 0; i < m_EventsToReset.Size(); i++)
-				m_ActiveEvents[m_EventsToReset[i]] = false;
+			for (u32 i = 0; i < EU_ECS_MAX_EVENT_TYPES; i++)
+			{
+				ECSEventQueue* queue = m_EventQueues[i].load(std::memory_order_relaxed);
+				if (queue)
+					queue->BeginFrame();
+			}
+
+			m_SceneStreamer.Update(this);
 		}
 
 		inline EntityID CreateEntity(const String& name, EntityID parent = EU_ECS_ROOT_ENTITY)
@@ -145,59 +527,238 @@ namespace Eunoia
 				return EU_ECS_INVALID_ENTITY_ID;
 			}
 
-			ECSEntityContainer container;
-			container.name = name;
-			container.enabled = true;
-			container.parent = parent;
-			container.checkedForCompatibleSystems = false;
+			EntityID createdEntityID = AllocateEntity(name, ECSHashName(name.C_Str()), parent);
+			if (createdEntityID != EU_ECS_INVALID_ENTITY_ID)
+				UpdateEntitySystemMatches(createdEntityID);
 
-			if (parent == EU_ECS_ROOT_ENTITY)
+			return createdEntityID;
+		}
+
+		inline EntityID CreateEntity(EntityID parent = EU_ECS_ROOT_ENTITY)
+		{
+			String name = "Entity_";
+			if (!m_FreeEntityIDs.Empty())
+				name += std::to_string(m_FreeEntityIDs[m_FreeEntityIDs.Size() - 1]).c_str();
+			else
+				name += std::to_string(m_NextEntityID).c_str();
+
+			return CreateEntity(name, parent);
+		}
+
+		/*
+			Captures the entity and all its children into the prefab. Components are copied with their copy constructors and
+			members that own runtime objects, like rigid bodies, are saved through their ECSLoader handlers. EntityID members
+			that point inside the captured subtree are remembered so instances point at their own copies
+		*/
+		inline void CreatePrefab(EntityID root, ECSPrefab* prefab)
+		{
+			prefab->Clear();
+			if (!DoesEntityExist(root))
 			{
-				ECSScene* scene = &m_CreatedScenes[m_ActiveScene - 1];
-				container.parent = scene->rootEntity;
+				EU_LOG_WARN("Tried to create a prefab from an entity that does not exist");
+				return;
 			}
 
+			std::map<EntityID, u32> prefabIndices;
+			std::map<metadata_typeid, ECSSnapshotTypeLayout> layouts;
+			if (!CapturePrefabEntity(prefab, root, EU_ECS_PREFAB_NO_PARENT, &prefabIndices, &layouts))
+			{
+				prefab->Clear();
+				return;
+			}
 
-			EntityID createdEntityID = EU_ECS_INVALID_ENTITY_ID;
-			if (!m_FreeEntityIDs.Empty())
+			List<u32> offsets;
+			for (u32 i = 0; i < prefab->components.Size(); i++)
 			{
-				EntityID id = m_FreeEntityIDs.GetLastElement();
-				m_FreeEntityIDs.Pop();
-				m_CreatedEntities[id - 2] = container;
-				createdEntityID = id;
+				const ECSPrefabComponent& component = prefab->components[i];
+				offsets.Clear();
+				ECSCollectEntityIDFields(component.typeID, 0, &offsets);
+
+				for (u32 j = 0; j < offsets.Size(); j++)
+				{
+					//ECSComponent::parent is set for every instance anyway
+					if (offsets[j] < sizeof(ECSComponent))
+						continue;
+
+					EntityID target = *(EntityID*)&prefab->data[component.dataOffset + offsets[j]];
+					const auto& it = prefabIndices.find(target);
+					if (it == prefabIndices.end())
+						continue;
+
+					ECSPrefabEntityField field;
+					field.component = i;
+					field.offset = offsets[j];
+					field.targetEntity = it->second;
+					prefab->entityFields.Push(field);
+				}
 			}
-			else
+		}
+
+		/*
+			Creates count copies of the prefab under parent. Entity slots, component memory and system matches are worked
+			out once for the whole batch so each instance only copy constructs its components and builds its own runtime objects.
+			The root of every instance is written to outRoots if given
+		*/
+		inline void InstantiatePrefab(const ECSPrefab& prefab, u32 count, EntityID parent = EU_ECS_ROOT_ENTITY, EntityID* outRoots = 0)
+		{
+			if (m_ActiveScene == EU_ECS_INVALID_SCENE_ID)
 			{
-				m_CreatedEntities.Push(container);
-				createdEntityID = m_NextEntityID++;
+				EU_LOG_WARN("You need to set a scene before instantiating a prefab");
+				return;
 			}
 
-			ECSEntityContainer* parentContainer = 0;
-			if (parent == EU_ECS_ROOT_ENTITY)
+			u32 numEntities = prefab.entities.Size();
+			u32 numComponents = prefab.components.Size();
+			if (!numEntities || !count)
+				return;
+
+			u32 numNewEntities = numEntities * count;
+			u32 numRecycled = EU_MIN(numNewEntities, m_FreeEntityIDs.Size());
+			if (m_NextEntityID + (numNewEntities - numRecycled) > EU_ECS_MAX_ENTITIES + 1)
 			{
-				ECSScene* scene = &m_CreatedScenes[m_ActiveScene - 1];
-				parentContainer = &m_CreatedEntities[scene->rootEntity - 2];
+				EU_LOG_WARN("Cannot create anymore entities");
+				return;
 			}
-			else if (parent != EU_ECS_INVALID_ENTITY_ID)
+
+			u32 requiredCapacity = m_CreatedEntities.Size() + (numNewEntities - numRecycled);
+			if (requiredCapacity > m_CreatedEntities.GetCapacity())
+				m_CreatedEntities.SetCapacity(requiredCapacity);
+
+			const List<ECSLoaderUnsafeRuntimeMember>& unsafeMembers = ECSLoader::GetUnsafeRuntimeMembers();
+			List<ECSComponentSparseSet*> componentSets(numComponents);
+			List<DynamicPoolAllocator*> allocators(numComponents);
+			List<s32> archetypeComponentIndices(numComponents);
+			List<void (*)(void*, const void*)> copyConstructors(numComponents);
+			for (u32 i = 0; i < numComponents; i++)
 			{
-				parentContainer = &m_CreatedEntities[parent - 2];
+				const ECSPrefabComponent& component = prefab.components[i];
+				copyConstructors.Push(Metadata::GetMetadata(component.typeID).cls->CopyConstructor);
+				componentSets.Push(GetOrCreateComponentSet(component.typeID));
+				allocators.Push(m_StorageMode == ECS_STORAGE_MODE_POOLED ? GetOrCreateComponentAllocator(component.typeID, component.size) : 0);
+				archetypeComponentIndices.Push(-1);
 			}
 
-			if (parentContainer)
-				parentContainer->children.Push(createdEntityID);
+			for (const auto& it_cta : m_ComponentTypeAllocators)
+			{
+				u32 numOfType = 0;
+				for (u32 i = 0; i < numComponents; i++)
+					if (prefab.components[i].typeID == it_cta.first)
+						numOfType++;
 
-			return createdEntityID;
-		}
+				if (numOfType)
+					it_cta.second->Reserve((mem_size)numOfType * count);
+			}
 
-		inline EntityID CreateEntity(EntityID parent = EU_ECS_ROOT_ENTITY)
-		{
-			String name = "Entity_";
-			if (!m_FreeEntityIDs.Empty())
-				name += std::to_string(m_FreeEntityIDs[m_FreeEntityIDs.Size() - 1]).c_str();
-			else
-				name += std::to_string(m_NextEntityID).c_str();
+			//Archetypes and system matches only depend on the component types so they are the same for every instance
+			List<ArchetypeIndex> archetypes(numEntities);
+			List<u32> firstMatchedSystem(numEntities + 1);
+			List<ECSSystem*> matchedSystems;
+			List<metadata_typeid> componentTypes;
+			ECSScene* scene = &m_CreatedScenes[m_ActiveScene - 1];
+			for (u32 i = 0; i < numEntities; i++)
+			{
+				const ECSPrefabEntity& entity = prefab.entities[i];
 
-			return CreateEntity(name, parent);
+				componentTypes.Clear();
+				for (u32 j = 0; j < entity.numComponents; j++)
+					componentTypes.Push(prefab.components[entity.firstComponent + j].typeID);
+
+				firstMatchedSystem.Push(matchedSystems.Size());
+				for (u32 j = 0; j < scene->systems.Size(); j++)
+				{
+					ECSSystem* system = scene->systems[j].actualSystem;
+					b32 compatible = true;
+					for (u32 k = 0; k < system->m_NumRequiredComponents && compatible; k++)
+						compatible = componentTypes.GetIndexOfElement(system->m_RequiredComponets[k]) != -1;
+
+					if (compatible)
+						matchedSystems.Push(system);
+				}
+
+				if (m_StorageMode == ECS_STORAGE_MODE_ARCHETYPE && entity.numComponents)
+				{
+					ArchetypeIndex archetypeIndex = FindOrCreateArchetype(&componentTypes);
+					for (u32 j = 0; j < entity.numComponents; j++)
+						archetypeComponentIndices[entity.firstComponent + j] = m_Archetypes[archetypeIndex]->GetComponentIndex(prefab.components[entity.firstComponent + j].typeID);
+					archetypes.Push(archetypeIndex);
+				}
+				else
+				{
+					archetypes.Push(EU_ECS_INVALID_ARCHETYPE);
+				}
+			}
+			firstMatchedSystem.Push(matchedSystems.Size());
+
+			ECSVersion version = NextChangeVersion();
+			List<EntityID> instanceEntities;
+			List<ECSComponent*> instanceComponents;
+			instanceEntities.SetCapacityAndElementCount(numEntities);
+			instanceComponents.SetCapacityAndElementCount(numComponents);
+			for (u32 instance = 0; instance < count; instance++)
+			{
+				for (u32 i = 0; i < numEntities; i++)
+				{
+					const ECSPrefabEntity& prefabEntity = prefab.entities[i];
+					EntityID entityParent = prefabEntity.parentIndex == EU_ECS_PREFAB_NO_PARENT ? parent : instanceEntities[prefabEntity.parentIndex];
+					EntityID entity = AllocateEntity(prefabEntity.name, prefabEntity.nameHash, entityParent);
+					instanceEntities[i] = entity;
+
+					ECSEntityContainer* container = &m_CreatedEntities[EU_ECS_ENTITY_SLOT(entity)];
+					container->enabled = prefabEntity.enabled;
+					container->components.SetCapacity(EU_MAX(prefabEntity.numComponents, 1));
+
+					ECSArchetype* archetype = 0;
+					if (archetypes[i] != EU_ECS_INVALID_ARCHETYPE)
+					{
+						archetype = m_Archetypes[archetypes[i]];
+						archetype->AllocateRow(entity, &container->archetypeChunk, &container->archetypeRow);
+						container->archetype = archetypes[i];
+					}
+
+					for (u32 j = 0; j < prefabEntity.numComponents; j++)
+					{
+						u32 componentIndex = prefabEntity.firstComponent + j;
+						const ECSPrefabComponent& prefabComponent = prefab.components[componentIndex];
+
+						ECSComponentContainer component;
+						component.typeID = prefabComponent.typeID;
+						if (archetype)
+						{
+							component.allocatorIndex = 0;
+							component.actualComponent = (ECSComponent*)archetype->GetComponent(container->archetypeChunk, container->archetypeRow, archetypeComponentIndices[componentIndex]);
+						}
+						else
+						{
+							component.actualComponent = (ECSComponent*)allocators[componentIndex]->Allocate(&component.allocatorIndex);
+						}
+
+						copyConstructors[componentIndex](component.actualComponent, &prefab.data[prefabComponent.dataOffset]);
+						for (u32 k = 0; k < prefabComponent.numRuntimeMembers; k++)
+						{
+							const ECSPrefabRuntimeMember& runtimeMember = prefab.runtimeMembers[prefabComponent.firstRuntimeMember + k];
+							unsafeMembers[runtimeMember.handler].ReadUnsafeMember((u8*)component.actualComponent + runtimeMember.offset, runtimeMember.safeData);
+						}
+						component.actualComponent->parent = entity;
+						component.actualComponent->version = version;
+						componentSets[componentIndex]->Insert(entity, component.actualComponent);
+
+						container->components.Push(component);
+						instanceComponents[componentIndex] = component.actualComponent;
+					}
+
+					for (u32 j = firstMatchedSystem[i]; j < firstMatchedSystem[i + 1]; j++)
+						matchedSystems[j]->m_Entities.Add(entity);
+				}
+
+				for (u32 i = 0; i < prefab.entityFields.Size(); i++)
+				{
+					const ECSPrefabEntityField& field = prefab.entityFields[i];
+					*(EntityID*)((u8*)instanceComponents[field.component] + field.offset) = instanceEntities[field.targetEntity];
+				}
+
+				if (outRoots)
+					outRoots[instance] = instanceEntities[0];
+			}
 		}
 
 		template<class C>
@@ -208,95 +769,122 @@ namespace Eunoia
 
 		inline b32 DoesEntityHaveComponent(EntityID entity, metadata_typeid componentType)
 		{
-			ECSEntityContainer* container = &m_CreatedEntities[entity - 2];
-			for (u32 i = 0; i < container->components.Size(); i++)
-				if (container->components[i].typeID == componentType)
-					return true;
-
-			return false;
+			const ECSComponentSparseSet* set = GetComponentSet(componentType);
+			return set && set->Has(entity);
 		}
 
 		inline void SetEntityName(EntityID entity, const String& name)
 		{
-			if (entity > EU_ECS_ROOT_ENTITY)
-				m_CreatedEntities[entity - 2].name = name;
+			if (!DoesEntityExist(entity))
+				return;
+
+			ECSEntityContainer* container = &m_CreatedEntities[EU_ECS_ENTITY_SLOT(entity)];
+			RemoveEntityFromNameIndex(entity);
+			container->name = name;
+			container->nameHash = ECSHashName(name.C_Str());
+			AddEntityToNameIndex(entity);
 		}
 
 		inline void DestroyEntity(EntityID entity)
 		{
-			DestroyEntity(entity, &m_CreatedEntities[entity - 2]);
+			if (!DoesEntityExist(entity))
+			{
+				EU_LOG_WARN("Tried to destroy an entity that does not exist");
+				return;
+			}
+
+			DestroyEntity(entity, &m_CreatedEntities[EU_ECS_ENTITY_SLOT(entity)]);
 		}
 
 		inline void DestroyEntity(const String& name)
 		{
-			for (u32 i = 0; i < m_CreatedEntities.Size(); i++)
-			{
-				if (m_CreatedEntities[i].name == name)
-				{
-					DestroyEntity(i + 2);
-					return;
-				}
-			}
+			EntityID entity = GetEntityID(name);
+			if (entity != EU_ECS_INVALID_ENTITY_ID)
+				DestroyEntity(entity);
 		}
 
 
 		inline void SetEntityEnabled(EntityID entity, b32 enabled)
 		{
-			if (entity > EU_ECS_ROOT_ENTITY)
-				m_CreatedEntities[entity - 2].enabled = enabled;
+			if (!DoesEntityExist(entity))
+			{
+				EU_LOG_WARN("Tried to enable or disable an entity that does not exist");
+				return;
+			}
+
+			m_CreatedEntities[EU_ECS_ENTITY_SLOT(entity)].enabled = enabled;
+			m_HierarchyDirty = true;
 		}
 
 		inline void SetEntityEnabledOpposite(EntityID entity)
 		{
-			if (entity > EU_ECS_ROOT_ENTITY)
-				m_CreatedEntities[entity - 2].enabled = !m_CreatedEntities[entity - 2].enabled;
+			if (!DoesEntityExist(entity))
+			{
+				EU_LOG_WARN("Tried to enable or disable an entity that does not exist");
+				return;
+			}
+
+			m_CreatedEntities[EU_ECS_ENTITY_SLOT(entity)].enabled = !m_CreatedEntities[EU_ECS_ENTITY_SLOT(entity)].enabled;
+			m_HierarchyDirty = true;
 		}
 
 
 		inline void SetEntityEnabled(const String& name, b32 enabled)
 		{
-			for (u32 i = 0; i < m_CreatedEntities.Size(); i++)
-			{
-				if (m_CreatedEntities[i].name == name)
-				{
-					SetEntityEnabled(i + 2, enabled);
-					break;
-				}
-			}
+			EntityID entity = GetEntityID(name);
+			if (entity != EU_ECS_INVALID_ENTITY_ID)
+				SetEntityEnabled(entity, enabled);
 		}
 
 		inline void SetEntityEnabledOpposite(const String& name)
 		{
-			for (u32 i = 0; i < m_CreatedEntities.Size(); i++)
-			{
-				if (m_CreatedEntities[i].name == name)
-				{
-					SetEntityEnabledOpposite(i + 2);
-					break;
-				}
-			}
+			EntityID entity = GetEntityID(name);
+			if (entity != EU_ECS_INVALID_ENTITY_ID)
+				SetEntityEnabledOpposite(entity);
 		}
 
+		//Stale IDs are never enabled
 		inline b32 IsEntityEnabled(EntityID entity) const
 		{
-			return m_CreatedEntities[entity - 2].enabled;
+			if (!DoesEntityExist(entity))
+				return false;
+
+			return m_CreatedEntities[EU_ECS_ENTITY_SLOT(entity)].enabled;
 		}
 
 		inline String GetEntityName(EntityID entity) const
 		{
-			return m_CreatedEntities[entity - 2].name;
+			if (!DoesEntityExist(entity))
+				return "";
+
+			return m_CreatedEntities[EU_ECS_ENTITY_SLOT(entity)].name;
 		}
 
+		//If several entities share the name the one in the lowest slot is returned
 		inline EntityID GetEntityID(const String& name) const
 		{
-			for (u32 i = 0; i < m_CreatedEntities.Size(); i++)
-				if (m_CreatedEntities[i].name == name)
-					return i + 2;
+			const List<EntityID>* candidates = m_NameIndex.Find(ECSHashName(name.C_Str()));
+			if (!candidates)
+				return EU_ECS_INVALID_ENTITY_ID;
+
+			EntityID found = EU_ECS_INVALID_ENTITY_ID;
+			for (u32 i = 0; i < candidates->Size(); i++)
+			{
+				EntityID candidate = (*candidates)[i];
+				if (m_CreatedEntities[EU_ECS_ENTITY_SLOT(candidate)].name == name &&
+					(found == EU_ECS_INVALID_ENTITY_ID || EU_ECS_ENTITY_INDEX(candidate) < EU_ECS_ENTITY_INDEX(found)))
+					found = candidate;
+			}
+
+			return found;
 		}
 
 		inline EntityID GetParentEntity(EntityID entity) const
 		{
-			return m_CreatedEntities[entity - 2].parent;
+			if (!DoesEntityExist(entity))
+				return EU_ECS_INVALID_ENTITY_ID;
+
+			return m_CreatedEntities[EU_ECS_ENTITY_SLOT(entity)].parent;
 		}
 
 		inline EntityID GetRootEntity(SceneID scene) const
@@ -306,91 +894,99 @@ namespace Eunoia
 
 		inline EntityID GetChildEntity(EntityID parent, const String& childName) const
 		{
-			const ECSEntityContainer* ent = &m_CreatedEntities[parent - 2];
-			for (u32 i = 0; i < ent->children.Size(); i++)
-				if (m_CreatedEntities[ent->children[i] - 2].name == childName)
-					return ent->children[i];
+			const List<EntityID>* candidates = m_ChildNameIndex.Find(ECSChildNameKey(parent, ECSHashName(childName.C_Str())));
+			if (!candidates)
+				return EU_ECS_INVALID_ENTITY_ID;
+
+			for (u32 i = 0; i < candidates->Size(); i++)
+			{
+				const ECSEntityContainer* child = &m_CreatedEntities[EU_ECS_ENTITY_SLOT((*candidates)[i])];
+				if (child->parent == parent && child->name == childName)
+					return (*candidates)[i];
+			}
 
 			return EU_ECS_INVALID_ENTITY_ID;
 		}
 
-		inline b32 DoesEntityExist(EntityID entity)
+		//Finds the child named <parent name><suffix> without building the concatenated name
+		inline EntityID GetChildEntityWithNameSuffix(EntityID parent, const char* suffix) const
 		{
-			if (entity > m_CreatedEntities.Size() + 1)
-				return false;
+			if (!DoesEntityExist(parent))
+				return EU_ECS_INVALID_ENTITY_ID;
 
-			for (u32 i = 0; i < m_FreeEntityIDs.Size(); i++)
-				if (entity == m_FreeEntityIDs[i])
-					return false;
+			const ECSEntityContainer* parentContainer = &m_CreatedEntities[EU_ECS_ENTITY_SLOT(parent)];
+			const List<EntityID>* candidates = m_ChildNameIndex.Find(ECSChildNameKey(parent, ECSHashName(suffix, parentContainer->nameHash)));
+			if (!candidates)
+				return EU_ECS_INVALID_ENTITY_ID;
 
-			return true;
+			u32 parentNameLength = parentContainer->name.Length();
+			u32 suffixLength = (u32)strlen(suffix);
+			for (u32 i = 0; i < candidates->Size(); i++)
+			{
+				const ECSEntityContainer* child = &m_CreatedEntities[EU_ECS_ENTITY_SLOT((*candidates)[i])];
+				if (child->parent != parent || child->name.Length() != parentNameLength + suffixLength)
+					continue;
+
+				const char* childName = child->name.C_Str();
+				if (memcmp(childName, parentContainer->name.C_Str(), parentNameLength) == 0 && memcmp(childName + parentNameLength, suffix, suffixLength) == 0)
+					return (*candidates)[i];
+			}
+
+			return EU_ECS_INVALID_ENTITY_ID;
+		}
+
+		inline b32 DoesEntityExist(EntityID entity) const
+		{
+			u32 index = EU_ECS_ENTITY_INDEX(entity);
+			if (index <= EU_ECS_ROOT_ENTITY || index > m_CreatedEntities.Size() + 1)
+				return false;
+
+			return m_CreatedEntities[EU_ECS_ENTITY_SLOT(entity)].id == entity;
 		}
 
+		//In archetype storage the returned pointer and every other pointer into the entity are invalidated by the next structural change
 		template<class C, class...Args>
 		inline C* CreateComponent(EntityID entity, Args&&... args)
 		{
-			if (entity <= EU_ECS_ROOT_ENTITY)
+			if (!DoesEntityExist(entity))
 				return 0;
 
-			ECSEntityContainer* entityContainer = &m_CreatedEntities[entity - 2];
-			entityContainer->checkedForCompatibleSystems = false;
+			ECSEntityContainer* entityContainer = &m_CreatedEntities[EU_ECS_ENTITY_SLOT(entity)];
 
 			ECSComponentContainer component;
 			component.typeID = Metadata::GetTypeID<C>();
-
-			DynamicPoolAllocator* typeAllocator = 0;
-
-			const auto&& it = m_ComponentTypeAllocators.find(component.typeID);
-			if (it == m_ComponentTypeAllocators.end())
-			{
-				typeAllocator = new DynamicPoolAllocator(sizeof(C), 16);
-				m_ComponentTypeAllocators[component.typeID] = typeAllocator;
-			}
-			else
-			{
-				typeAllocator = it->second;
-			}
-
-			component.actualComponent = (ECSComponent*)typeAllocator->Allocate(&component.allocatorIndex);
-			new(component.actualComponent) C(std::forward<Args>(args)...);
-			component.actualComponent->enabled = true;
-			component.actualComponent->parent = entity;
+			component.actualComponent = AllocateComponentMemory(entity, entityContainer, component.typeID, sizeof(C), &component.allocatorIndex);
+			new(component.actualComponent) C(std::forward<Args>(args)...);
+			component.actualComponent->enabled = true;
+			component.actualComponent->parent = entity;
+			component.actualComponent->version = NextChangeVersion();
+			GetOrCreateComponentSet(component.typeID)->Insert(entity, component.actualComponent);
 
 			entityContainer->components.Push(component);
+			UpdateEntitySystemMatches(entity);
 			return (C*)component.actualComponent;
 		}
 
 		inline ECSComponent* CreateComponent(EntityID entity, metadata_typeid componentTypeID)
 		{
-			if (entity <= EU_ECS_ROOT_ENTITY);
+			if (!DoesEntityExist(entity))
+				return 0;
 
 			const MetadataInfo& info = Metadata::GetMetadata(componentTypeID);
 
-			ECSEntityContainer* entityContainer = &m_CreatedEntities[entity - 2];
-			entityContainer->checkedForCompatibleSystems = false;
+			ECSEntityContainer* entityContainer = &m_CreatedEntities[EU_ECS_ENTITY_SLOT(entity)];
 
 			ECSComponentContainer component;
 			component.typeID = info.id;
-
-			DynamicPoolAllocator* typeAllocator = 0;
-
-			const auto&& it = m_ComponentTypeAllocators.find(component.typeID);
-			if (it == m_ComponentTypeAllocators.end())
-			{
-				typeAllocator = new DynamicPoolAllocator(info.cls->size, 16);
-				m_ComponentTypeAllocators[component.typeID] = typeAllocator;
-			}
-			else
-			{
-				typeAllocator = it->second;
-			}
-
-			component.actualComponent = (ECSComponent*)typeAllocator->Allocate(&component.allocatorIndex);
+			component.actualComponent = AllocateComponentMemory(entity, entityContainer, component.typeID, info.cls->size, &component.allocatorIndex);
 			info.cls->DefaultConstructor(component.actualComponent);
 			component.actualComponent->enabled = true;
 			component.actualComponent->parent = entity;
+			component.actualComponent->version = NextChangeVersion();
+			GetOrCreateComponentSet(component.typeID)->Insert(entity, component.actualComponent);
 
 			entityContainer->components.Push(component);
+			UpdateEntitySystemMatches(entity);
 			return component.actualComponent;
 		}
 
@@ -403,20 +999,14 @@ namespace Eunoia
 
 		inline b32 DestroyComponent(EntityID entity, metadata_typeid typeID)
 		{
-			if (entity <= EU_ECS_ROOT_ENTITY)
-				return false;
-
-			ECSEntityContainer* entityContainer = &m_CreatedEntities[entity - 2];
-			entityContainer->compatibleSystems.Clear();
-			entityContainer->checkedForCompatibleSystems = false;
-
-			const auto&& it = m_ComponentTypeAllocators.find(typeID);
-			if (it == m_ComponentTypeAllocators.end())
+			if (!DoesEntityExist(entity))
 			{
-				EU_LOG_WARN("Tried to delete ECS component with invalid component");
+				EU_LOG_WARN("Tried to delete ECS component of an entity that does not exist");
 				return false;
 			}
 
+			ECSEntityContainer* entityContainer = &m_CreatedEntities[EU_ECS_ENTITY_SLOT(entity)];
+
 			List<ECSComponentContainer>& components = entityContainer->components;
 			for (u32 i = 0; i < components.Size(); i++)
 			{
@@ -425,8 +1015,11 @@ namespace Eunoia
 					ECSComponent* actualComponent = (ECSComponent*)components[i].actualComponent;
 					actualComponent->OnDestroy();
 					//actualComponent->~ECSComponent();
-					it->second->Free(components[i].actualComponent, components[i].allocatorIndex);
+					if (!FreeComponentMemory(entity, entityContainer, i))
+						return false;
+					m_ComponentSets[typeID]->Remove(entity);
 					components.Remove(i);
+					UpdateEntitySystemMatches(entity);
 					return true;
 				}
 			}
@@ -437,43 +1030,93 @@ namespace Eunoia
 
 		inline b32 DestroyComponentByIndex(EntityID entity, u32 componentIndex)
 		{
-			if (entity <= EU_ECS_ROOT_ENTITY)
+			if (!DoesEntityExist(entity))
+			{
+				EU_LOG_WARN("Tried to delete ECS component of an entity that does not exist");
 				return false;
+			}
 
-			ECSEntityContainer* entityContainer = &m_CreatedEntities[entity - 2];
-			entityContainer->compatibleSystems.Clear();
-			entityContainer->checkedForCompatibleSystems = false;
-			ECSComponentContainer* component = &entityContainer->components[componentIndex];
-
-			const auto&& it = m_ComponentTypeAllocators.find(component->typeID);
-			if (it == m_ComponentTypeAllocators.end())
+			ECSEntityContainer* entityContainer = &m_CreatedEntities[EU_ECS_ENTITY_SLOT(entity)];
+			if (componentIndex >= entityContainer->components.Size())
 			{
-				EU_LOG_WARN("Tried to delete ECS component with invalid component");
+				EU_LOG_WARN("Tried to delete ECS component with invalid component index");
 				return false;
 			}
+			ECSComponentContainer* component = &entityContainer->components[componentIndex];
+
 			component->actualComponent->OnDestroy();
-			it->second->Free(component->actualComponent, component->allocatorIndex);
+			metadata_typeid typeID = component->typeID;
+			if (!FreeComponentMemory(entity, entityContainer, componentIndex))
+				return false;
+			m_ComponentSets[typeID]->Remove(entity);
 			entityContainer->components.Remove(componentIndex);
+			UpdateEntitySystemMatches(entity);
 			return true;
 		}
 
+		//Look the component up again after a structural change instead of keeping the pointer, see SetStorageMode
 		template<class C>
 		inline C* GetComponent(EntityID entity)
 		{
-			if (entity <= EU_ECS_ROOT_ENTITY)
-				return false;
-
-			ECSEntityContainer* entityContainer = &m_CreatedEntities[entity - 2];
-			return GetComponent<C>(entityContainer->components);
+			return (C*)GetComponent(entity, Metadata::GetTypeID<C>());
 		}
 
 		inline ECSComponent* GetComponent(EntityID entity, metadata_typeid componentTypeID)
 		{
 			if (entity <= EU_ECS_ROOT_ENTITY)
-				return false;
+				return 0;
+
+			const ECSComponentSparseSet* set = GetComponentSet(componentTypeID);
+			if (!set)
+				return 0;
+
+			return set->Get(entity);
+		}
+
+		/*
+			Same as GetComponent but marks the component changed so systems tracking versions pick the write up.
+			Use this for any write that other systems derive data from (transforms and so on)
+		*/
+		template<class C>
+		inline C* GetComponentMutable(EntityID entity)
+		{
+			return (C*)GetComponentMutable(entity, Metadata::GetTypeID<C>());
+		}
+
+		inline ECSComponent* GetComponentMutable(EntityID entity, metadata_typeid componentTypeID)
+		{
+			ECSComponent* component = GetComponent(entity, componentTypeID);
+			if (component)
+				MarkComponentChanged(component);
+			return component;
+		}
+
+		//Safe to call from parallel systems
+		inline void MarkComponentChanged(ECSComponent* component)
+		{
+			component->version = NextChangeVersion();
+		}
+
+		inline ECSVersion NextChangeVersion()
+		{
+			return m_ChangeVersion.fetch_add(1, std::memory_order_relaxed) + 1;
+		}
+
+		//Changes every time an entity is created, destroyed, reparented, enabled or disabled
+		inline u32 GetHierarchyVersion() const { return m_HierarchyVersion; }
+
+		template<class C>
+		inline ECSComponentView<C> GetComponentView()
+		{
+			return ECSComponentView<C>(GetComponentSet(Metadata::GetTypeID<C>()));
+		}
+
+		inline const ECSComponentSparseSet* GetComponentSet(metadata_typeid typeID) const
+		{
+			if (typeID >= m_ComponentSets.Size())
+				return 0;
 
-			ECSEntityContainer* entityContainer = &m_CreatedEntities[entity - 2];
-			return GetComponent(entityContainer->components, componentTypeID);
+			return m_ComponentSets[typeID];
 		}
 
 		template<class C>
@@ -502,15 +1145,25 @@ namespace Eunoia
 			return 0;
 		}
 
+		inline ECSComponentContainer* GetComponentContainer(EntityID entity, metadata_typeid typeID)
+		{
+			ComponentList& components = m_CreatedEntities[EU_ECS_ENTITY_SLOT(entity)].components;
+			for (u32 i = 0; i < components.Size(); i++)
+				if (components[i].typeID == typeID)
+					return &components[i];
+
+			return 0;
+		}
+
 		inline ECSComponent* GetComponentByIndex(EntityID entity, u32 index)
 		{
-			return m_CreatedEntities[entity - 2].components[index].actualComponent;
+			return m_CreatedEntities[EU_ECS_ENTITY_SLOT(entity)].components[index].actualComponent;
 		}
 
 		template<class C>
 		inline void SetComponentEnabled(EntityID entity, b32 enabled)
 		{
-			SetComponentEnabled(entity, Metadata::GetTypeID<C>());
+			SetComponentEnabled(entity, Metadata::GetTypeID<C>(), enabled);
 		}
 
 		template<class C>
@@ -521,32 +1174,16 @@ namespace Eunoia
 
 		inline void SetComponentEnabled(EntityID entity, metadata_typeid typeID, b32 enabled)
 		{
-			if (entity <= EU_ECS_ROOT_ENTITY)
-				return;
-
-			ECSEntityContainer* entityContainer = &m_CreatedEntities[entity - 2];
-
-			List<ECSComponentContainer>& components = entityContainer->components;
-			for (u32 i = 0; i < components.Size(); i++)
-			{
-				if (components[i].typeID == typeID)
-					components[i].actualComponent->enabled = enabled;
-			}
+			ECSComponent* component = GetComponent(entity, typeID);
+			if (component)
+				component->enabled = enabled;
 		}
 
 		inline void SetComponentEnabledOpposite(EntityID entity, metadata_typeid typeID)
 		{
-			if (entity <= EU_ECS_ROOT_ENTITY)
-				return;
-
-			ECSEntityContainer* entityContainer = &m_CreatedEntities[entity - 2];
-
-			List<ECSComponentContainer>& components = entityContainer->components;
-			for (u32 i = 0; i < components.Size(); i++)
-			{
-				if (components[i].typeID == typeID)
-					components[i].actualComponent->enabled = !components[i].actualComponent->enabled;
-			}
+			ECSComponent* component = GetComponent(entity, typeID);
+			if (component)
+				component->enabled = !component->enabled;
 		}
 
 		template<class S, class... Args>
@@ -563,7 +1200,7 @@ namespace Eunoia
 			ECSSystemContainer system;
 			system.typeID = Metadata::GetTypeID<S>();
 
-			if (sizeof(S) > 512)
+			if (sizeof(S) > EU_ECS_MAX_SYSTEM_SIZE)
 			{
 				EU_LOG_FATAL("This system is to big. TODO: Allow for bigger systems...");
 				return 0;
@@ -572,16 +1209,13 @@ namespace Eunoia
 			system.actualSystem = (ECSSystem*)m_SystemAllocator.Allocate();
 			new(system.actualSystem) S(std::forward<Args>(args)...);
 			system.actualSystem->m_ECS = this;
+			system.actualSystem->m_ProfileName = Profiler::InternName(Metadata::GetMetadata(system.typeID).cls->name);
 			system.actualSystem->enabled = true;
 			system.actualSystem->Init();
-			SystemIndex index = scene->systems.Size();
 			scene->systems.Push(system);
+			scene->scheduleDirty = true;
 
-			for (u32 i = 0; i < m_CreatedEntities.Size(); i++)
-			{
-				ECSEntityContainer* container = &m_CreatedEntities[i];
-				CheckEntityAndSystemCompatiblity(container, index);
-			}
+			AddMatchingEntitiesToSystem(system.actualSystem);
 
 			return (S*)system.actualSystem;
 		}
@@ -599,7 +1233,7 @@ namespace Eunoia
 			ECSSystemContainer system;
 			system.typeID = typeID;
 
-			if (Metadata::GetMetadata(typeID).cls->size > 512)
+			if (Metadata::GetMetadata(typeID).cls->size > EU_ECS_MAX_SYSTEM_SIZE)
 			{
 				EU_LOG_FATAL("This system is to big. TODO: Allow for bigger systems...");
 				return 0;
@@ -608,16 +1242,13 @@ namespace Eunoia
 			system.actualSystem = (ECSSystem*)m_SystemAllocator.Allocate();
 			Metadata::CallDefaultConstructor(typeID, system.actualSystem);
 			system.actualSystem->m_ECS = this;
+			system.actualSystem->m_ProfileName = Profiler::InternName(Metadata::GetMetadata(typeID).cls->name);
 			system.actualSystem->enabled = enabled;
 			system.actualSystem->Init();
-			SystemIndex index = scene->systems.Size();
 			scene->systems.Push(system);
+			scene->scheduleDirty = true;
 
-			for (u32 i = 0; i < m_CreatedEntities.Size(); i++)
-			{
-				ECSEntityContainer* container = &m_CreatedEntities[i];
-				CheckEntityAndSystemCompatiblity(container, index);
-			}
+			AddMatchingEntitiesToSystem(system.actualSystem);
 
 			return system.actualSystem;
 		}
@@ -666,19 +1297,14 @@ namespace Eunoia
 				if (system->typeID == typeID)
 				{
 					ECSSystem* actualSystem = (ECSSystem*)system->actualSystem;
+					actualSystem->~ECSSystem();
 					m_SystemAllocator.Free(actualSystem);
 					scene->systems.Remove(i);
+					scene->scheduleDirty = true;
 					return;
 				}
 			}
 
-			for (u32 i = 0; i < m_CreatedEntities.Size(); i++)
-			{
-				ECSEntityContainer* entity = &m_CreatedEntities[i];
-				entity->compatibleSystems.Clear();
-				entity->checkedForCompatibleSystems = false;
-			}
-
 			EU_LOG_WARN("Unable to destroy ECS system");
 		}
 
@@ -693,15 +1319,10 @@ namespace Eunoia
 			ECSScene* scene = &m_CreatedScenes[m_ActiveScene - 1];
 
 			ECSSystemContainer* system = &scene->systems[systemIndex];
+			system->actualSystem->~ECSSystem();
 			m_SystemAllocator.Free(system->actualSystem);
 			scene->systems.Remove(systemIndex);
-
-			for (u32 i = 0; i < m_CreatedEntities.Size(); i++)
-			{
-				ECSEntityContainer* entity = &m_CreatedEntities[i];
-				entity->compatibleSystems.Clear();
-				entity->checkedForCompatibleSystems = false;
-			}
+			scene->scheduleDirty = true;
 		}
 
 		template<class S>
@@ -764,83 +1385,83 @@ namespace Eunoia
 			return false;
 		}
 
+		//Safe to call from any thread, every dispatched event is kept until the start of the next frame
 		template<class E, class... Args>
 		inline void DispatchEvent(Args&&... args)
 		{
-			metadata_typeid typeID = Metadata::GetTypeID<E>();
-			const auto&& it = m_Events.find(typeID);
-			if (it == m_Events.end())
-			{
-				ECSEvent* ecsEvent = (ECSEvent*)m_EventAllocator.Allocate(sizeof(E));
-				new(ecsEvent) E(std::forward<Args>(args)...);
-				ecsEvent->time = Engine::GetTime();
-				m_Events[typeID] = ecsEvent;
-
-				m_ActiveEvents[typeID] = true;
-			}
-			else
-			{
-				ECSEvent* ecsEvent = m_Events[typeID];
-				new(m_Events[typeID]) E(std::forward<Args>(args)...);
-				ecsEvent->time = Engine::GetTime();
-				m_ActiveEvents[typeID] = true;
-			}
+			ECSEventQueue* queue = GetOrCreateEventQueue(Metadata::GetTypeID<E>(), sizeof(E));
+			if (!queue)
+				return;
 
-			m_EventsToReset.Push(typeID);
+			ECSEventSlot slot = queue->Reserve();
+			ECSEvent* ecsEvent = new(slot.memory) E(std::forward<Args>(args)...);
+			ecsEvent->time = Engine::GetTime();
+			ECSEventQueue::Publish(slot);
 		}
 
+		//Main thread only, the pending event stays active until it is reset
 		template<class E, class... Args>
 		inline void DispatchPendingEvent(Args&&... args)
 		{
-			metadata_typeid typeID = Metadata::GetTypeID<E>();
-			const auto&& it = m_Events.find(typeID);
-			if (it == m_Events.end())
-			{
-				ECSEvent* ecsEvent = (ECSEvent*)m_EventAllocator.Allocate(sizeof(E));
-				new(ecsEvent) E(std::forward<Args>(args)...);
-				ecsEvent->time = Engine::GetTime();
-				m_Events[typeID] = ecsEvent;
-				m_ActiveEvents[typeID] = true;
-			}
-			else
-			{
-				ECSEvent* ecsEvent = m_Events[typeID];
-				new(ecsEvent) E(std::forward<Args>(args)...);
-				ecsEvent->time = Engine::GetTime();
-				m_ActiveEvents[typeID] = true;
-			}
+			ECSEventQueue* queue = GetOrCreateEventQueue(Metadata::GetTypeID<E>(), sizeof(E));
+			if (!queue)
+				return;
+
+			ECSEvent* ecsEvent = new(queue->pending) E(std::forward<Args>(args)...);
+			ecsEvent->time = Engine::GetTime();
+			queue->pendingActive = true;
+			queue->resetPendingNextFrame = false;
 		}
 
 		template<class E>
 		inline void ResetPendingEventNextFrame()
 		{
-			metadata_typeid typeID = Metadata::GetTypeID<E>();
-			m_EventsToReset.Push(typeID);
+			ECSEventQueue* queue = GetEventQueue(Metadata::GetTypeID<E>());
+			if (queue)
+				queue->resetPendingNextFrame = true;
 		}
 
 		template<class E>
 		inline void ResetPendingEvent()
 		{
-			metadata_typeid typeID = Metadata::GetTypeID<E>();
-			m_ActiveEvents[typeID] = false;
+			ECSEventQueue* queue = GetEventQueue(Metadata::GetTypeID<E>());
+			if (queue)
+				queue->pendingActive = false;
 		}
 
+		//Returns the last event of the type dispatched this frame, or the pending event if there is none
 		template<class E>
 		inline ECSEvent* CheckForEvent()
 		{
-			metadata_typeid typeID = Metadata::GetTypeID<E>();
-			const auto&& it_event = m_Events.find(typeID);
-			if (it_event == m_Events.end())
+			ECSEventQueue* queue = GetEventQueue(Metadata::GetTypeID<E>());
+			if (!queue)
 				return 0;
 
-			const auto&& it = m_ActiveEvents.find(typeID);
-			if (it == m_ActiveEvents.end())
-				return 0;
+			//Overflowed events were dispatched after the ring filled up so they are the newest
+			for (u32 index = queue->GetOverflowEnd(); index > 0; index--)
+			{
+				const ECSEventOverflowBlock* block = queue->GetOverflowBlock(index - 1);
+				u32 blockIndex = (index - 1) % EU_ECS_EVENT_OVERFLOW_BLOCK_SIZE;
+				if (block->published[blockIndex].load(std::memory_order_acquire))
+					return (ECSEvent*)(block->events + blockIndex * queue->eventSize);
+			}
 
-			if (!it->second)
-				return 0;
+			for (u32 index = queue->GetEnd(); index != queue->begin; index--)
+				if (queue->IsPublished(index - 1))
+					return (ECSEvent*)queue->GetEvent(index - 1);
+
+			return queue->pendingActive ? (ECSEvent*)queue->pending : 0;
+		}
+
+		template<class E>
+		inline ECSEventRange<E> GetEvents() const
+		{
+			return ECSEventRange<E>(GetEventQueue(Metadata::GetTypeID<E>()));
+		}
 
-			return it_event->second;
+		inline ECSEventQueue* GetEventQueue(metadata_typeid typeID) const
+		{
+			return typeID < EU_ECS_MAX_EVENT_TYPES ? m_EventQueues[typeID].load(std::memory_order_acquire) : 0;
 		}
 
 		inline SceneID CreateScene(const String& name, b32 setActive = false, b32 addRequiredSystems = true)
@@ -931,12 +1552,31 @@ namespace Eunoia
 		inline List<ECSScene>& GetAllScenes_() { return m_CreatedScenes; }
 		inline List<ECSSystemContainer>& GetSystems_() { return m_CreatedScenes[m_ActiveScene - 1].systems; }
 		inline List<ECSEntityContainer>& GetAllEntities_() { return m_CreatedEntities; }
+		inline const List<ECSArchetype*>& GetAllArchetypes_() const { return m_Archetypes; }
+
+		//Only returns archetypes when the ECS is in ECS_STORAGE_MODE_ARCHETYPE
+		inline void GetArchetypesWithComponents(const metadata_typeid* componentTypes, u32 numComponentTypes, List<ECSArchetype*>* archetypes) const
+		{
+			archetypes->Clear();
+			for (u32 i = 0; i < m_Archetypes.Size(); i++)
+			{
+				ECSArchetype* archetype = m_Archetypes[i];
+				if (archetype->numEntities > 0 && archetype->ContainsAll(componentTypes, numComponentTypes))
+					archetypes->Push(archetype);
+			}
+		}
+
+		inline void GetArchetypesForSystem(const ECSSystem* system, List<ECSArchetype*>* archetypes) const
+		{
+			GetArchetypesWithComponents(system->m_RequiredComponets, system->m_NumRequiredComponents, archetypes);
+		}
 
 		inline void UpdateSystems(r32 dt)
 		{
 			//ECSScene* gs = &m_CreatedScenes[m_SceneStack[m_SceneStack.Size() - 1]];
 			//ProcessSystemsHelper(gs, 0, dt);
 			ProcessEntities(ECS_PROCESS_UPDATE, dt);
+			FlushCommandBuffer();
 		}
 
 		inline void RenderSystems()
@@ -950,16 +1590,62 @@ namespace Eunoia
 		{
 			//ECSScene* gs = &m_CreatedScenes[m_SceneStack[m_SceneStack.Size() - 1]];
 			//ProcessSystemsHelper(gs, 2, dt);
-			ProcessEntities(ECS_PROCESS_PRE_PHYSICS_SIM);
+			ProcessEntities(ECS_PROCESS_PRE_PHYSICS_SIM, dt);
 		}
 
 		inline void PostPhysicsSystems(r32 dt)
 		{
 			//ECSScene* gs = &m_CreatedScenes[m_SceneStack[m_SceneStack.Size() - 1]];
 			//ProcessSystemsHelper(gs, 3, dt);
-			ProcessEntities(ECS_PROCESS_POST_PHYSICS_SIM);
+			ProcessEntities(ECS_PROCESS_POST_PHYSICS_SIM, dt);
 		}
 
+		template<class... Cs>
+		using View = ECSView<Cs...>;
+
+		//Structural changes recorded here are safe from parallel systems and are applied after the update systems ran
+		inline ECSCommandBuffer* GetCommandBuffer() { return &m_CommandBuffer; }
+
+		inline void FlushCommandBuffer()
+		{
+			m_CommandBuffer.BeginPlayback();
+
+			for (u32 i = 0; i < EU_JOB_SYSTEM_MAX_THREAD_INDICES; i++)
+			{
+				ECSCommandQueue* queue = &m_CommandBuffer.m_Playback[i];
+				for (u32 j = 0; j < queue->createCommands.Size(); j++)
+				{
+					ECSDeferredEntity entity;
+					entity.handle = (i << EU_ECS_COMMAND_QUEUE_SHIFT) | j;
+					PlayCreateEntityCommand(entity);
+				}
+			}
+
+			for (u32 i = 0; i < EU_JOB_SYSTEM_MAX_THREAD_INDICES; i++)
+			{
+				ECSCommandQueue* queue = &m_CommandBuffer.m_Playback[i];
+				for (u32 j = 0; j < queue->commands.Size(); j++)
+					if (queue->commands[j].type != ECS_COMMAND_CREATE_ENTITY)
+						PlayCommand(queue, &queue->commands[j]);
+			}
+
+			m_CommandBuffer.EndPlayback();
+		}
+
+		//When disabled every system runs on the calling thread in creation order
+		inline void SetParallelSystemsEnabled(b32 enabled) { m_ParallelSystems = enabled; }
+		inline b32 IsParallelSystemsEnabled() const { return m_ParallelSystems; }
+
+		//Logs the per entity callbacks against the batch callbacks of the same system, creates and destroys its own ECS
+		static void RunBenchmark(u32 numEntities = 100000);
+
+		//Runs the ECS self checks on their own ECS, failures are logged as errors. Returns true when every check passed
+		static b32 RunTests();
+
+		//How often systems with ECS_SYSTEM_BACKGROUND_THROTTLE update while the application is in the background
+		inline void SetBackgroundTickRate(r32 tickRate) { m_BackgroundTickRate = tickRate; }
+		inline r32 GetBackgroundTickRate() const { return m_BackgroundTickRate; }
+
 		inline void CreateResetPoint(ECSResetPoint* resetPoint)
 		{
 			resetPoint->Clear();
@@ -980,6 +1666,270 @@ namespace Eunoia
 			}
 		}
 
+		/*
+			Copies the entity tables, the components and the reflected system members. Much faster than a reset point since nothing
+			is serialized, but the snapshot is only valid in this ECS until the project is reloaded. Fails if a component can't be copied
+		*/
+		inline void CreateSnapshot(ECSSnapshot* snapshot)
+		{
+			snapshot->Clear();
+			snapshot->entities = m_CreatedEntities;
+			snapshot->scenes = m_CreatedScenes;
+			snapshot->freeSceneIDs = m_FreeSceneIDs;
+			snapshot->activeScene = m_ActiveScene;
+			snapshot->freeEntityIDs = m_FreeEntityIDs;
+			snapshot->nextEntityID = m_NextEntityID;
+			snapshot->nameIndex = m_NameIndex;
+			snapshot->childNameIndex = m_ChildNameIndex;
+
+			const List<ECSLoaderUnsafeRuntimeMember>& unsafeMembers = ECSLoader::GetUnsafeRuntimeMembers();
+			std::map<metadata_typeid, ECSSnapshotTypeLayout> layouts;
+			List<u8> safeData;
+			for (u32 i = 0; i < m_CreatedEntities.Size(); i++)
+			{
+				const ComponentList& components = m_CreatedEntities[i].components;
+				for (u32 j = 0; j < components.Size(); j++)
+				{
+					const ECSComponentContainer& component = components[j];
+					const u8* src = (const u8*)component.actualComponent;
+					const MetadataClass* cls = Metadata::GetMetadata(component.typeID).cls;
+					if (!cls->CopyConstructor)
+					{
+						EU_LOG_WARN("Tried to create an ECS snapshot with a {0} which can't be copied", cls->name.C_Str());
+						snapshot->Clear();
+						return;
+					}
+
+					auto it = layouts.find(component.typeID);
+					if (it == layouts.end())
+					{
+						it = layouts.insert(std::make_pair(component.typeID, ECSSnapshotTypeLayout())).first;
+						BuildSnapshotTypeLayout(component.typeID, &it->second);
+					}
+					const ECSSnapshotTypeLayout& layout = it->second;
+
+					ECSSnapshotComponent snapshotComponent;
+					snapshotComponent.typeID = component.typeID;
+					snapshotComponent.dataOffset = snapshot->AllocateData((u32)cls->size);
+					snapshotComponent.firstRuntimeMember = snapshot->runtimeMembers.Size();
+					snapshotComponent.numRuntimeMembers = layout.runtimeMemberOffsets.Size();
+					cls->CopyConstructor(&snapshot->data[snapshotComponent.dataOffset], src);
+					snapshot->components.Push(snapshotComponent);
+
+					for (u32 k = 0; k < layout.runtimeMemberOffsets.Size(); k++)
+					{
+						ECSSnapshotRuntimeMember runtimeMember;
+						runtimeMember.offset = layout.runtimeMemberOffsets[k];
+						runtimeMember.handler = layout.runtimeMemberHandlers[k];
+
+						safeData.Clear();
+						unsafeMembers[runtimeMember.handler].WriteUnsafeMember(&safeData, src + runtimeMember.offset);
+						runtimeMember.dataSize = safeData.Size();
+						runtimeMember.dataOffset = runtimeMember.dataSize ? snapshot->AppendData(&safeData[0], runtimeMember.dataSize) : 0;
+						snapshot->runtimeMembers.Push(runtimeMember);
+
+						//The copy would share the runtime objects of the live component, they are rebuilt from the safe data
+						ClearRuntimeMember(&snapshot->data[snapshotComponent.dataOffset + runtimeMember.offset], runtimeMember.handler);
+					}
+				}
+			}
+
+			for (u32 i = 0; i < m_CreatedScenes.Size(); i++)
+			{
+				const List<ECSSystemContainer>& systems = m_CreatedScenes[i].systems;
+				for (u32 j = 0; j < systems.Size(); j++)
+				{
+					ECSSnapshotSystem snapshotSystem;
+					snapshotSystem.typeID = systems[j].typeID;
+					snapshotSystem.system = systems[j].actualSystem;
+					snapshotSystem.enabled = systems[j].actualSystem->enabled;
+					snapshotSystem.entities = systems[j].actualSystem->m_Entities;
+					snapshotSystem.dataOffset = (u32)EU_ALIGN_UP(snapshot->data.Size(), EU_DEFAULT_ALIGNMENT);
+
+					const MetadataClass* cls = Metadata::GetMetadata(systems[j].typeID).cls;
+					for (u32 k = 0; k < cls->members.Size(); k++)
+					{
+						const MetadataMember& member = cls->members[k];
+						if (member.isStatic || member.isPointer)
+							continue;
+
+						const u8* src = (const u8*)systems[j].actualSystem + member.offset;
+						u32 offset = snapshot->AppendData(src, (u32)(member.size * member.arrayLength));
+						if (member.typeName == "String")
+							for (u32 l = 0; l < member.arrayLength; l++)
+								snapshot->CopyString(offset + (u32)(member.size * l), ((const String*)src)[l]);
+					}
+
+					snapshot->systems.Push(snapshotSystem);
+				}
+			}
+
+			snapshot->valid = true;
+		}
+
+		/*
+			Puts the ECS back into the state of the snapshot. The live components are destroyed and every component is copy constructed
+			from the snapshot. The system objects are kept when the scenes still have the same systems, otherwise they are recreated
+			from their types, either way ECSSystem::OnSnapshotRestored lets them drop what they cached. Pending events and scene streams are dropped
+		*/
+		inline void RestoreSnapshot(const ECSSnapshot& snapshot)
+		{
+			if (!snapshot.valid)
+			{
+				EU_LOG_WARN("Tried to restore an empty ECS snapshot");
+				return;
+			}
+
+			m_CommandBuffer.Reset();
+
+			//Lets components release what they registered outside the ECS, like rigid bodies in the physics world, and then frees what they own
+			for (u32 i = 0; i < m_CreatedEntities.Size(); i++)
+			{
+				const ComponentList& components = m_CreatedEntities[i].components;
+				for (u32 j = 0; j < components.Size(); j++)
+				{
+					components[j].actualComponent->OnDestroy();
+					components[j].actualComponent->~ECSComponent();
+				}
+			}
+
+			m_SceneStreamer.CancelAll();
+			for (u32 i = 0; i < EU_ECS_MAX_EVENT_TYPES; i++)
+			{
+				ECSEventQueue* queue = m_EventQueues[i].load(std::memory_order_relaxed);
+				if (queue)
+					queue->Clear();
+			}
+
+			b32 sameSystems = m_CreatedScenes.Size() == snapshot.scenes.Size();
+			u32 numSystems = 0;
+			for (u32 i = 0; i < m_CreatedScenes.Size() && sameSystems; i++)
+			{
+				const List<ECSSystemContainer>& systems = m_CreatedScenes[i].systems;
+				for (u32 j = 0; j < systems.Size() && sameSystems; j++, numSystems++)
+					sameSystems = numSystems < snapshot.systems.Size() && snapshot.systems[numSystems].system == systems[j].actualSystem && snapshot.systems[numSystems].typeID == systems[j].typeID;
+			}
+			sameSystems = sameSystems && numSystems == snapshot.systems.Size();
+
+			if (!sameSystems)
+			{
+				for (u32 i = 0; i < m_CreatedScenes.Size(); i++)
+					for (u32 j = 0; j < m_CreatedScenes[i].systems.Size(); j++)
+						m_CreatedScenes[i].systems[j].actualSystem->~ECSSystem();
+				m_SystemAllocator.Reset();
+			}
+
+			for (const auto& it_cta : m_ComponentTypeAllocators)
+				it_cta.second->Reset();
+			for (u32 i = 0; i < m_Archetypes.Size(); i++)
+				m_Archetypes[i]->Reset();
+			for (u32 i = 0; i < m_ComponentSets.Size(); i++)
+				if (m_ComponentSets[i])
+					m_ComponentSets[i]->Clear();
+
+			m_CreatedEntities = snapshot.entities;
+			m_CreatedScenes = snapshot.scenes;
+			m_FreeSceneIDs = snapshot.freeSceneIDs;
+			m_FreeEntityIDs = snapshot.freeEntityIDs;
+			m_NextEntityID = snapshot.nextEntityID;
+			m_NameIndex = snapshot.nameIndex;
+			m_ChildNameIndex = snapshot.childNameIndex;
+
+			//Everything restored counts as changed so systems that skip unchanged components pick it up
+			const List<ECSLoaderUnsafeRuntimeMember>& unsafeMembers = ECSLoader::GetUnsafeRuntimeMembers();
+			ECSVersion version = NextChangeVersion();
+			u32 componentIndex = 0;
+			for (u32 i = 0; i < m_CreatedEntities.Size(); i++)
+			{
+				ECSEntityContainer* container = &m_CreatedEntities[i];
+				ECSArchetype* archetype = 0;
+				if (container->archetype != EU_ECS_INVALID_ARCHETYPE)
+				{
+					archetype = m_Archetypes[container->archetype];
+					archetype->AllocateRow(container->id, &container->archetypeChunk, &container->archetypeRow);
+				}
+
+				for (u32 j = 0; j < container->components.Size(); j++, componentIndex++)
+				{
+					ECSComponentContainer* component = &container->components[j];
+					const ECSSnapshotComponent& snapshotComponent = snapshot.components[componentIndex];
+					const MetadataClass* cls = Metadata::GetMetadata(component->typeID).cls;
+
+					if (archetype)
+						component->actualComponent = (ECSComponent*)archetype->GetComponent(container->archetypeChunk, container->archetypeRow, archetype->GetComponentIndex(component->typeID));
+					else
+						component->actualComponent = (ECSComponent*)GetOrCreateComponentAllocator(component->typeID, cls->size)->Allocate(&component->allocatorIndex);
+
+					cls->CopyConstructor(component->actualComponent, &snapshot.data[snapshotComponent.dataOffset]);
+					for (u32 k = 0; k < snapshotComponent.numRuntimeMembers; k++)
+					{
+						const ECSSnapshotRuntimeMember& runtimeMember = snapshot.runtimeMembers[snapshotComponent.firstRuntimeMember + k];
+						List<u8> safeData(runtimeMember.dataSize, runtimeMember.dataSize);
+						if (runtimeMember.dataSize)
+							memcpy(&safeData[0], &snapshot.data[runtimeMember.dataOffset], runtimeMember.dataSize);
+						unsafeMembers[runtimeMember.handler].ReadUnsafeMember((u8*)component->actualComponent + runtimeMember.offset, safeData);
+					}
+
+					component->actualComponent->version = version;
+					GetOrCreateComponentSet(component->typeID)->Insert(container->id, component->actualComponent);
+				}
+			}
+
+			SceneID activeScene = snapshot.activeScene;
+			for (u32 i = 0, systemIndex = 0; i < m_CreatedScenes.Size(); i++)
+			{
+				ECSScene* scene = &m_CreatedScenes[i];
+				scene->scheduleDirty = true;
+
+				u32 numSceneSystems = scene->systems.Size();
+				if (!sameSystems)
+				{
+					scene->systems.Clear();
+					m_ActiveScene = i + 1;
+				}
+
+				for (u32 j = 0; j < numSceneSystems; j++, systemIndex++)
+				{
+					const ECSSnapshotSystem& snapshotSystem = snapshot.systems[systemIndex];
+
+					ECSSystem* system = snapshotSystem.system;
+					if (sameSystems)
+						system->m_Entities = snapshotSystem.entities;
+					else
+						system = CreateSystem(snapshotSystem.typeID, snapshotSystem.enabled);
+
+					system->enabled = snapshotSystem.enabled;
+
+					const MetadataClass* cls = Metadata::GetMetadata(snapshotSystem.typeID).cls;
+					u32 offset = snapshotSystem.dataOffset;
+					for (u32 k = 0; k < cls->members.Size(); k++)
+					{
+						const MetadataMember& member = cls->members[k];
+						if (member.isStatic || member.isPointer)
+							continue;
+
+						offset = (u32)EU_ALIGN_UP(offset, EU_DEFAULT_ALIGNMENT);
+						u8* dst = (u8*)system + member.offset;
+						if (member.typeName == "String")
+						{
+							for (u32 l = 0; l < member.arrayLength; l++)
+								((String*)dst)[l] = ((const String*)&snapshot.data[offset])[l];
+						}
+						else
+						{
+							memcpy(dst, &snapshot.data[offset], member.size * member.arrayLength);
+						}
+						offset += (u32)(member.size * member.arrayLength);
+					}
+
+					system->OnSnapshotRestored();
+				}
+			}
+
+			m_ActiveScene = activeScene;
+			m_HierarchyDirty = true;
+		}
+
 		inline void ConvertSceneToLoadedDataFormat(ECSLoadedScene* loadedScene)
 		{
 			ConvertSceneToLoadedDataFormat(loadedScene, m_ActiveScene);
@@ -1011,7 +1961,7 @@ namespace Eunoia
 				loadedScene->systems.Push(loadedSystem);
 			}
 
-			ECSEntityContainer* rootEntity = &m_CreatedEntities[scene->rootEntity - 2];
+			ECSEntityContainer* rootEntity = &m_CreatedEntities[EU_ECS_ENTITY_SLOT(scene->rootEntity)];
 			ConvertSceneEntityToLoadedDataFormat(loadedScene, rootEntity);
 		}
 
@@ -1042,25 +1992,25 @@ namespace Eunoia
 			loadedScene->entities.Push(loadedEntity);
 
 			for (u32 i = 0; i < entity->children.Size(); i++)
-				ConvertSceneEntityToLoadedDataFormat(loadedScene, &m_CreatedEntities[entity->children[i] - 2]);
+				ConvertSceneEntityToLoadedDataFormat(loadedScene, &m_CreatedEntities[EU_ECS_ENTITY_SLOT(entity->children[i])]);
 		}
 
+		/*
+			Loads a scene file without stalling the frame, see ECSSceneStreamer. The scene is created a little every frame
+			from Begin and SceneStreamedEvent is dispatched once it is done
+		*/
+		inline ECSSceneStreamID LoadSceneAsync(const String& path, b32 setActive = false) { return m_SceneStreamer.LoadSceneAsync(path, setActive); }
+		inline ECSSceneStreamState GetSceneStreamState(ECSSceneStreamID stream) const { return m_SceneStreamer.GetState(stream); }
+		inline void SetSceneStreamingBudget(r32 milliseconds) { m_SceneStreamer.SetBudget(milliseconds); }
+		inline r32 GetSceneStreamingBudget() const { return m_SceneStreamer.GetBudget(); }
+
 		inline SceneID LoadSceneFromLoadedDataFormat(const ECSLoadedScene& loadedScene, b32 setActive = false)
 		{
 			SceneID activeScene = m_ActiveScene;
 			SceneID newScene = CreateScene(loadedScene.name, true, false);
 
 			for (u32 i = 0; i < loadedScene.systems.Size(); i++)
-			{
-				const ECSLoadedSystem& loadedSystem = loadedScene.systems[i];
-				ECSSystem* system = CreateSystem(loadedSystem.typeID, loadedSystem.enabled);
-				MetadataClass* systemMetadata = Metadata::GetMetadata(loadedSystem.typeID).cls;
-				mem_size systemSize = systemMetadata->size - sizeof(ECSSystem);
-				if (systemSize > 0 && !systemMetadata->members.Empty())
-					memcpy((u8*)system + sizeof(ECSSystem), &loadedSystem.data[0], systemSize);
-				system->enabled = loadedSystem.enabled;
-				system->Init();
-			}
+				LoadSystemFromLoadedDataFormat(loadedScene.systems[i]);
 
 			if (!loadedScene.entities.Empty())
 			{
@@ -1074,16 +2024,21 @@ namespace Eunoia
 			return newScene;
 		}
 
-		inline void LoadSceneEntityFromLoadedDataFormat(const List<ECSLoadedEntity>& loadedEntities, u32& entityIndex, EntityID parent)
+		//Creates the system in the active scene
+		inline void LoadSystemFromLoadedDataFormat(const ECSLoadedSystem& loadedSystem)
 		{
-			const ECSLoadedEntity& loadedEntity = loadedEntities[entityIndex];
-
-			EntityID entity;
-			if (entityIndex == 0)
-				entity = GetRootEntity();
-			else
-				entity = CreateEntity(loadedEntity.name, parent);
+			ECSSystem* system = CreateSystem(loadedSystem.typeID, loadedSystem.enabled);
+			MetadataClass* systemMetadata = Metadata::GetMetadata(loadedSystem.typeID).cls;
+			mem_size systemSize = systemMetadata->size - sizeof(ECSSystem);
+			if (systemSize > 0 && !systemMetadata->members.Empty())
+				memcpy((u8*)system + sizeof(ECSSystem), &loadedSystem.data[0], systemSize);
+			system->enabled = loadedSystem.enabled;
+			system->Init();
+		}
 
+		//Adds the loaded components to an entity that already exists
+		inline void LoadEntityFromLoadedDataFormat(EntityID entity, const ECSLoadedEntity& loadedEntity)
+		{
 			SetEntityEnabled(entity, loadedEntity.enabled);
 
 			for (u32 i = 0; i < loadedEntity.components.Size(); i++)
@@ -1095,6 +2050,19 @@ namespace Eunoia
 					memcpy((u8*)component + sizeof(ECSComponent), &loadedComponent.data[0], componentSize);
 				component->enabled = loadedComponent.enabled;
 			}
+		}
+
+		inline void LoadSceneEntityFromLoadedDataFormat(const List<ECSLoadedEntity>& loadedEntities, u32& entityIndex, EntityID parent)
+		{
+			const ECSLoadedEntity& loadedEntity = loadedEntities[entityIndex];
+
+			EntityID entity;
+			if (entityIndex == 0)
+				entity = GetRootEntity();
+			else
+				entity = CreateEntity(loadedEntity.name, parent);
+
+			LoadEntityFromLoadedDataFormat(entity, loadedEntity);
 
 			entityIndex++;
 
@@ -1203,174 +2171,952 @@ namespace Eunoia
 			}
 		}*/
 
-		inline void OnlyUpdateRequiredSystems(r32 dt)
+		//Called instead of UpdateSystems while the application is not the active one, only updates systems by their background policy
+		inline void UpdateBackgroundSystems(r32 dt)
 		{
+			EU_PROFILE_FUNCTION();
+			if (m_ActiveScene == EU_ECS_INVALID_SCENE_ID)
+				return;
+
 			ECSScene* scene = &m_CreatedScenes[m_ActiveScene - 1];
-			for (u32 i = 0; i < m_CreatedEntities.Size(); i++)
+
+			b32 anyTicking = false;
+			for (u32 i = 0; i < scene->systems.Size(); i++)
 			{
-				ECSEntityContainer* entity = &m_CreatedEntities[i];
-				if (!entity->checkedForCompatibleSystems)
+				ECSSystem* system = scene->systems[i].actualSystem;
+				if (!system->enabled || system->m_BackgroundPolicy == ECS_SYSTEM_BACKGROUND_PAUSE)
 				{
-					for (u32 j = 0; j < scene->systems.Size(); j++)
-						CheckEntityAndSystemCompatiblity(entity, j);
-
-					entity->checkedForCompatibleSystems = true;
+					system->m_Ticking = false;
+					continue;
 				}
 
-				for (u32 j = 0; j < entity->compatibleSystems.Size(); j++)
-				{
-					if (entity->compatibleSystems[j] == 0 ||
-						entity->compatibleSystems[j] == 1)
-						scene->systems[entity->compatibleSystems[j]].actualSystem->ProcessEntityOnUpdate(i + 2, dt);
-				}
+				r32 tickRate = system->m_TickRate;
+				if (system->m_BackgroundPolicy == ECS_SYSTEM_BACKGROUND_THROTTLE && (tickRate <= 0.0f || tickRate > m_BackgroundTickRate))
+					tickRate = m_BackgroundTickRate;
+
+				if (BeginSystemTick(system, tickRate, dt))
+					anyTicking = true;
+			}
+
+			if (!anyTicking)
+				return;
+
+			UpdateHierarchyCache();
+
+			for (u32 i = 0; i < scene->systems.Size(); i++)
+				ProcessSystemEntities(scene->systems[i].actualSystem, ECS_PROCESS_UPDATE, dt);
+
+			for (u32 i = 0; i < scene->systems.Size(); i++)
+			{
+				ECSSystem* system = scene->systems[i].actualSystem;
+				if (system->enabled && system->m_Ticking)
+					system->PostUpdate(system->m_TickDt);
 			}
+
+			FlushCommandBuffer();
 		}
 
 	private:
-		inline void DestroyEntitiesInList()
+		inline EntityID ResolveCommandEntity(EntityID entity, u32 deferredEntity)
 		{
-			for (u32 i = 0; i < m_EntitiesToDelete.Size(); i++)
-				DestroyEntityHelper2(m_EntitiesToDelete[i]);
+			if (deferredEntity == EU_ECS_INVALID_DEFERRED_ENTITY)
+				return entity;
 
-			m_EntitiesToDelete.Clear();
+			ECSDeferredEntity deferred;
+			deferred.handle = deferredEntity;
+			return PlayCreateEntityCommand(deferred);
 		}
 
-		inline void DestroyEntityHelper2(EntityID entity)
+		//Creates a deferred entity the first time it is needed, parents recorded on other threads are created first
+		inline EntityID PlayCreateEntityCommand(ECSDeferredEntity entity)
 		{
-			if (entity <= EU_ECS_ROOT_ENTITY)
-				return;
+			ECSCommandQueue* queue = &m_CommandBuffer.m_Playback[entity.handle >> EU_ECS_COMMAND_QUEUE_SHIFT];
+			u32 index = entity.handle & ((1 << EU_ECS_COMMAND_QUEUE_SHIFT) - 1);
+			if (queue->createdEntities[index] != EU_ECS_INVALID_ENTITY_ID)
+				return queue->createdEntities[index];
 
-			ECSEntityContainer& container = m_CreatedEntities[entity - 2];
+			const ECSCommand& command = queue->commands[queue->createCommands[index]];
+			EntityID parent = ResolveCommandEntity(command.parent, command.deferredParent);
+			queue->createdEntities[index] = CreateEntity(queue->names[command.dataOffset], parent);
+			return queue->createdEntities[index];
+		}
 
-			if (container.parent != EU_ECS_INVALID_ENTITY_ID)
+		inline void PlayCommand(ECSCommandQueue* queue, ECSCommand* command)
+		{
+			EntityID entity = ResolveCommandEntity(command->entity, command->deferredEntity);
+			if (!DoesEntityExist(entity))
 			{
-				ECSEntityContainer* parent = &m_CreatedEntities[container.parent - 2];
-				for (u32 i = 0; i < parent->children.Size(); i++)
+				if (command->type == ECS_COMMAND_CREATE_COMPONENT)
 				{
-					if (parent->children[i] == entity)
-					{
-						parent->children.Remove(i);
-						break;
-					}
+					command->releaseComponent(0, &queue->data[command->dataOffset]);
+					command->releaseComponent = 0;
 				}
+				return;
 			}
 
-			u32 startIndex = m_FreeEntityIDs.Size();
-			DestroyEntityHelper(entity);
-			RemoveDestroyChildEntities(entity, startIndex);
+			switch (command->type)
+			{
+			case ECS_COMMAND_DESTROY_ENTITY: {
+				if (command->flag)
+					DestroyEntityHierarchy(entity);
+				else
+					DestroyEntity(entity);
+			} break;
+			case ECS_COMMAND_CREATE_COMPONENT: {
+				ECSCommandReleaseComponentFunction releaseComponent = command->releaseComponent;
+				command->releaseComponent = 0;
+				CreateRecordedComponent(entity, command->typeID, releaseComponent, &queue->data[command->dataOffset]);
+			} break;
+			case ECS_COMMAND_DESTROY_COMPONENT: DestroyComponent(entity, command->typeID); break;
+			case ECS_COMMAND_SET_ENTITY_ENABLED: SetEntityEnabled(entity, command->flag); break;
+			}
 		}
 
-		inline void DestroyEntityHelper(EntityID entity)
+		//Like CreateComponent but the component is moved out of the command buffer before the systems are matched against it
+		inline ECSComponent* CreateRecordedComponent(EntityID entity, metadata_typeid typeID, ECSCommandReleaseComponentFunction releaseComponent, void* recorded)
 		{
-			ECSEntityContainer* container = &m_CreatedEntities[entity - 2];
-			DestroyEntity(entity, container);
+			ECSEntityContainer* entityContainer = &m_CreatedEntities[EU_ECS_ENTITY_SLOT(entity)];
 
-			for (u32 i = 0; i < container->children.Size(); i++)
-				DestroyEntityHelper(container->children[i]);
+			ECSComponentContainer component;
+			component.typeID = typeID;
+			component.actualComponent = AllocateComponentMemory(entity, entityContainer, typeID, Metadata::GetMetadata(typeID).cls->size, &component.allocatorIndex);
+			releaseComponent(component.actualComponent, recorded);
+			component.actualComponent->enabled = true;
+			component.actualComponent->parent = entity;
+			component.actualComponent->version = NextChangeVersion();
+			GetOrCreateComponentSet(typeID)->Insert(entity, component.actualComponent);
+
+			entityContainer->components.Push(component);
+			UpdateEntitySystemMatches(entity);
+			return component.actualComponent;
 		}
 
-		inline void RemoveDestroyChildEntities(EntityID entity, u32 startIndex)
+		inline void DestroyEntityHierarchy(EntityID entity)
 		{
-			ECSEntityContainer* container = &m_CreatedEntities[entity - 2];
-			for (u32 i = 0; i < container->children.Size(); i++)
+			List<EntityID> children = m_CreatedEntities[EU_ECS_ENTITY_SLOT(entity)].children;
+			for (u32 i = 0; i < children.Size(); i++)
+				DestroyEntityHierarchy(children[i]);
+
+			DestroyEntity(entity);
+		}
+
+		//Lock free so the first dispatch of a type can race with another thread, the loser deletes its queue
+		inline ECSEventQueue* GetOrCreateEventQueue(metadata_typeid typeID, mem_size eventSize)
+		{
+			if (typeID >= EU_ECS_MAX_EVENT_TYPES)
 			{
-				for (u32 j = startIndex; j < m_FreeEntityIDs.Size(); j++)
+				EU_LOG_WARN("Event type ID exceeds EU_ECS_MAX_EVENT_TYPES");
+				return 0;
+			}
+
+			ECSEventQueue* queue = m_EventQueues[typeID].load(std::memory_order_acquire);
+			if (queue)
+				return queue;
+
+			ECSEventQueue* newQueue = new ECSEventQueue(eventSize);
+			if (m_EventQueues[typeID].compare_exchange_strong(queue, newQueue, std::memory_order_acq_rel))
+				return newQueue;
+
+			delete newQueue;
+			return queue;
+		}
+
+		//Takes a free slot and links the entity into the hierarchy and name index, the caller matches it against the systems
+		inline EntityID AllocateEntity(const String& name, ECSNameHash nameHash, EntityID parent)
+		{
+			ECSEntityContainer container;
+			container.name = name;
+			container.nameHash = nameHash;
+			container.enabled = true;
+			container.parent = parent;
+			container.scene = m_ActiveScene;
+			container.hierarchyOrder = EU_U32_MAX;
+			container.activeInHierarchy = true;
+			container.archetype = EU_ECS_INVALID_ARCHETYPE;
+			container.archetypeChunk = 0;
+			container.archetypeRow = 0;
+
+			if (parent == EU_ECS_ROOT_ENTITY)
+			{
+				ECSScene* scene = &m_CreatedScenes[m_ActiveScene - 1];
+				container.parent = scene->rootEntity;
+			}
+
+
+			EntityID createdEntityID = EU_ECS_INVALID_ENTITY_ID;
+			if (!m_FreeEntityIDs.Empty())
+			{
+				EntityID id = m_FreeEntityIDs.GetLastElement();
+				m_FreeEntityIDs.Pop();
+				container.id = id;
+				m_CreatedEntities[EU_ECS_ENTITY_SLOT(id)] = container;
+				createdEntityID = id;
+			}
+			else
+			{
+				if (m_NextEntityID > EU_ECS_MAX_ENTITIES)
 				{
-					if (container->children[i] == m_FreeEntityIDs[j])
-					{
-						container->children.Remove(i);
-						i--;
-						break;
-					}
+					EU_LOG_WARN("Cannot create anymore entities");
+					return EU_ECS_INVALID_ENTITY_ID;
+				}
+
+				container.id = m_NextEntityID;
+				m_CreatedEntities.Push(container);
+				createdEntityID = m_NextEntityID++;
+			}
+
+			ECSEntityContainer* parentContainer = 0;
+			if (parent == EU_ECS_ROOT_ENTITY)
+			{
+				ECSScene* scene = &m_CreatedScenes[m_ActiveScene - 1];
+				parentContainer = &m_CreatedEntities[EU_ECS_ENTITY_SLOT(scene->rootEntity)];
+			}
+			else if (parent != EU_ECS_INVALID_ENTITY_ID)
+			{
+				parentContainer = &m_CreatedEntities[EU_ECS_ENTITY_SLOT(parent)];
+			}
+
+			if (parentContainer)
+			{
+				parentContainer->children.Push(createdEntityID);
+				m_CreatedEntities[EU_ECS_ENTITY_SLOT(createdEntityID)].activeInHierarchy = parentContainer->activeInHierarchy;
+			}
+
+			AddEntityToNameIndex(createdEntityID);
+			m_HierarchyDirty = true;
+
+			return createdEntityID;
+		}
+
+		//Pre order so parents always come before their children in the prefab. Fails on components that can't be copied
+		inline b32 CapturePrefabEntity(ECSPrefab* prefab, EntityID entity, u32 parentIndex, std::map<EntityID, u32>* prefabIndices, std::map<metadata_typeid, ECSSnapshotTypeLayout>* layouts)
+		{
+			const ECSEntityContainer* container = &m_CreatedEntities[EU_ECS_ENTITY_SLOT(entity)];
+
+			u32 entityIndex = prefab->entities.Size();
+			(*prefabIndices)[entity] = entityIndex;
+
+			ECSPrefabEntity prefabEntity;
+			prefabEntity.name = container->name;
+			prefabEntity.nameHash = container->nameHash;
+			prefabEntity.enabled = container->enabled;
+			prefabEntity.parentIndex = parentIndex;
+			prefabEntity.firstComponent = prefab->components.Size();
+			prefabEntity.numComponents = container->components.Size();
+			prefab->entities.Push(prefabEntity);
+
+			const List<ECSLoaderUnsafeRuntimeMember>& unsafeMembers = ECSLoader::GetUnsafeRuntimeMembers();
+			for (u32 i = 0; i < container->components.Size(); i++)
+			{
+				const ECSComponentContainer& component = container->components[i];
+				const MetadataClass* cls = Metadata::GetMetadata(component.typeID).cls;
+				if (!cls->CopyConstructor)
+				{
+					EU_LOG_WARN("Tried to create a prefab with a {0} which can't be copied", cls->name.C_Str());
+					return false;
+				}
+
+				auto it = layouts->find(component.typeID);
+				if (it == layouts->end())
+				{
+					it = layouts->insert(std::make_pair(component.typeID, ECSSnapshotTypeLayout())).first;
+					BuildSnapshotTypeLayout(component.typeID, &it->second);
+				}
+				const ECSSnapshotTypeLayout& layout = it->second;
+
+				ECSPrefabComponent prefabComponent;
+				prefabComponent.typeID = component.typeID;
+				prefabComponent.size = (u32)cls->size;
+				prefabComponent.dataOffset = prefab->AllocateData(prefabComponent.size);
+				prefabComponent.firstRuntimeMember = prefab->runtimeMembers.Size();
+				prefabComponent.numRuntimeMembers = layout.runtimeMemberOffsets.Size();
+				u8* dst = &prefab->data[prefabComponent.dataOffset];
+				cls->CopyConstructor(dst, component.actualComponent);
+				prefab->components.Push(prefabComponent);
+
+				//The copy would share the runtime objects of the captured component, the prefab keeps their safe data instead
+				for (u32 j = 0; j < layout.runtimeMemberOffsets.Size(); j++)
+				{
+					ECSPrefabRuntimeMember runtimeMember;
+					runtimeMember.offset = layout.runtimeMemberOffsets[j];
+					runtimeMember.handler = layout.runtimeMemberHandlers[j];
+					unsafeMembers[runtimeMember.handler].WriteUnsafeMember(&runtimeMember.safeData, (const u8*)component.actualComponent + runtimeMember.offset);
+					ClearRuntimeMember(dst + runtimeMember.offset, runtimeMember.handler);
+					prefab->runtimeMembers.Push(runtimeMember);
 				}
 			}
 
 			for (u32 i = 0; i < container->children.Size(); i++)
-				RemoveDestroyChildEntities(container->children[i], startIndex);
+				if (!CapturePrefabEntity(prefab, container->children[i], entityIndex, prefabIndices, layouts))
+					return false;
+
+			return true;
 		}
 
-		inline void CheckEntityAndSystemCompatiblity(ECSEntityContainer* entity, SystemIndex systemIndex)
+		//Forgets the runtime objects a copied member points at so it can be refilled through its ECSLoader handler
+		inline void ClearRuntimeMember(void* member, u32 handler)
 		{
-			ECSScene* scene = &m_CreatedScenes[m_ActiveScene - 1];
+			const MetadataInfo& memberInfo = Metadata::GetMetadata(Metadata::GetClassTypeID(ECSLoader::GetUnsafeRuntimeMembers()[handler].typeName));
+			if (memberInfo.type == METADATA_CLASS)
+				memset(member, 0, memberInfo.cls->size);
+		}
 
-			b32 systemCompatible = true;
-			ECSSystemContainer* system = &scene->systems[systemIndex];
-			for (u32 i = 0; i < system->actualSystem->m_NumRequiredComponents; i++)
+		inline void BuildSnapshotTypeLayout(metadata_typeid typeID, ECSSnapshotTypeLayout* layout)
+		{
+			const List<ECSLoaderUnsafeRuntimeMember>& unsafeMembers = ECSLoader::GetUnsafeRuntimeMembers();
+			for (u32 i = 0; i < unsafeMembers.Size(); i++)
+			{
+				if (!unsafeMembers[i].ownsRuntimeObjects)
+					continue;
+
+				u32 firstOffset = layout->runtimeMemberOffsets.Size();
+				ECSCollectMemberOffsets(typeID, unsafeMembers[i].typeName, 0, &layout->runtimeMemberOffsets);
+				for (u32 j = firstOffset; j < layout->runtimeMemberOffsets.Size(); j++)
+					layout->runtimeMemberHandlers.Push(i);
+			}
+		}
+
+		inline void AddEntityToNameIndex(EntityID entity)
+		{
+			const ECSEntityContainer* container = &m_CreatedEntities[EU_ECS_ENTITY_SLOT(entity)];
+			m_NameIndex.Add(container->nameHash, entity);
+			m_ChildNameIndex.Add(ECSChildNameKey(container->parent, container->nameHash), entity);
+		}
+
+		inline void RemoveEntityFromNameIndex(EntityID entity)
+		{
+			const ECSEntityContainer* container = &m_CreatedEntities[EU_ECS_ENTITY_SLOT(entity)];
+			m_NameIndex.Remove(container->nameHash, entity);
+			m_ChildNameIndex.Remove(ECSChildNameKey(container->parent, container->nameHash), entity);
+		}
+
+		inline b32 IsEntityCompatibleWithSystem(EntityID entity, const ECSSystem* system)
+		{
+			for (u32 i = 0; i < system->m_NumRequiredComponents; i++)
+				if (!DoesEntityHaveComponent(entity, system->m_RequiredComponets[i]))
+					return false;
+
+			return true;
+		}
+
+		//Adds or removes the entity from the match lists of every system in the entities scene
+		inline void UpdateEntitySystemMatches(EntityID entity)
+		{
+			const ECSEntityContainer* container = &m_CreatedEntities[EU_ECS_ENTITY_SLOT(entity)];
+			if (container->scene == EU_ECS_INVALID_SCENE_ID)
+				return;
+
+			ECSScene* scene = &m_CreatedScenes[container->scene - 1];
+			for (u32 i = 0; i < scene->systems.Size(); i++)
 			{
-				b32 requiredComponentFound = false;
-				for (u32 j = 0; j < entity->components.Size(); j++)
+				ECSSystem* system = scene->systems[i].actualSystem;
+				b32 compatible = IsEntityCompatibleWithSystem(entity, system);
+				if (compatible)
+					system->m_Entities.Add(entity);
+				else
+					system->m_Entities.Remove(entity);
+			}
+		}
+
+		inline void RemoveEntityFromSystems(EntityID entity, SceneID sceneID)
+		{
+			if (sceneID == EU_ECS_INVALID_SCENE_ID)
+				return;
+
+			ECSScene* scene = &m_CreatedScenes[sceneID - 1];
+			for (u32 i = 0; i < scene->systems.Size(); i++)
+				scene->systems[i].actualSystem->m_Entities.Remove(entity);
+		}
+
+		inline void AddMatchingEntitiesToSystem(ECSSystem* system)
+		{
+			for (u32 i = 0; i < m_CreatedEntities.Size(); i++)
+			{
+				EntityID entity = m_CreatedEntities[i].id;
+				if (m_CreatedEntities[i].scene == m_ActiveScene && IsEntityCompatibleWithSystem(entity, system))
+					system->m_Entities.Add(entity);
+			}
+		}
+
+		/*
+			Recomputes the depth first order and the effective enabled state of every entity.
+			Only runs after the hierarchy changed so frames without structural changes don't walk the scene
+		*/
+		inline void UpdateHierarchyCache()
+		{
+			if (!m_HierarchyDirty)
+				return;
+
+			//Entities that can't be reached from a scene root (children of destroyed entities) are never processed
+			for (u32 i = 0; i < m_CreatedEntities.Size(); i++)
+				m_CreatedEntities[i].activeInHierarchy = false;
+
+			u32 order = 0;
+			for (u32 i = 0; i < m_CreatedScenes.Size(); i++)
+			{
+				const ECSScene* scene = &m_CreatedScenes[i];
+				if (scene->created)
+					UpdateHierarchyCache(scene->rootEntity, true, &order);
+			}
+
+			m_HierarchyVersion++;
+			m_HierarchyDirty = false;
+		}
+
+		inline void UpdateHierarchyCache(EntityID entity, b32 parentActive, u32* order)
+		{
+			ECSEntityContainer* container = &m_CreatedEntities[EU_ECS_ENTITY_SLOT(entity)];
+			container->hierarchyOrder = (*order)++;
+			container->activeInHierarchy = parentActive && container->enabled;
+
+			for (u32 i = 0; i < container->children.Size(); i++)
+				UpdateHierarchyCache(container->children[i], container->activeInHierarchy, order);
+		}
+
+		struct HierarchyOrderCompare
+		{
+			const List<ECSEntityContainer>* entities;
+			inline bool operator()(EntityID a, EntityID b) const { return (*entities)[EU_ECS_ENTITY_SLOT(a)].hierarchyOrder < (*entities)[EU_ECS_ENTITY_SLOT(b)].hierarchyOrder; }
+		};
+
+		inline void SortSystemEntities(ECSSystem* system)
+		{
+			ECSEntityList* entities = &system->m_Entities;
+			if (entities->sorted && system->m_HierarchyVersion == m_HierarchyVersion)
+				return;
+
+			if (!entities->Empty())
+			{
+				HierarchyOrderCompare compare;
+				compare.entities = &m_CreatedEntities;
+				std::sort(&entities->entities[0], &entities->entities[0] + entities->Size(), compare);
+				entities->RebuildIndices();
+			}
+
+			entities->sorted = true;
+			system->m_HierarchyVersion = m_HierarchyVersion;
+		}
+
+		inline ECSComponent* AllocateComponentMemory(EntityID entity, ECSEntityContainer* entityContainer, metadata_typeid typeID, mem_size size, u32* allocatorIndex)
+		{
+			if (m_StorageMode == ECS_STORAGE_MODE_ARCHETYPE)
+			{
+				*allocatorIndex = 0;
+
+				List<metadata_typeid>& componentTypes = m_ArchetypeComponentTypes;
+				componentTypes.Clear();
+				for (u32 i = 0; i < entityContainer->components.Size(); i++)
+					componentTypes.Push(entityContainer->components[i].typeID);
+				componentTypes.Push(typeID);
+
+				ArchetypeIndex archetypeIndex = FindOrCreateArchetype(&componentTypes);
+				MoveEntityToArchetype(entity, entityContainer, archetypeIndex, EU_U32_MAX);
+
+				ECSArchetype* archetype = m_Archetypes[archetypeIndex];
+				return (ECSComponent*)archetype->GetComponent(entityContainer->archetypeChunk, entityContainer->archetypeRow, archetype->GetComponentIndex(typeID));
+			}
+
+			return (ECSComponent*)GetOrCreateComponentAllocator(typeID, size)->Allocate(allocatorIndex);
+		}
+
+		inline DynamicPoolAllocator* GetOrCreateComponentAllocator(metadata_typeid typeID, mem_size size)
+		{
+			const auto&& it = m_ComponentTypeAllocators.find(typeID);
+			if (it != m_ComponentTypeAllocators.end())
+				return it->second;
+
+			DynamicPoolAllocator* typeAllocator = new DynamicPoolAllocator(size, 16);
+			m_ComponentTypeAllocators[typeID] = typeAllocator;
+			return typeAllocator;
+		}
+
+		//Does not remove the component from the entities component list
+		inline b32 FreeComponentMemory(EntityID entity, ECSEntityContainer* entityContainer, u32 componentIndex)
+		{
+			const ECSComponentContainer* component = &entityContainer->components[componentIndex];
+
+			if (m_StorageMode == ECS_STORAGE_MODE_ARCHETYPE)
+			{
+				if (entityContainer->components.Size() == 1)
 				{
-					if (system->actualSystem->m_RequiredComponets[i] == entity->components[j].typeID)
-					{
-						requiredComponentFound = true;
-						break;
-					}
+					RemoveEntityFromArchetype(entityContainer);
+					return true;
 				}
 
-				if (!requiredComponentFound)
+				List<metadata_typeid>& componentTypes = m_ArchetypeComponentTypes;
+				componentTypes.Clear();
+				for (u32 i = 0; i < entityContainer->components.Size(); i++)
+					if (i != componentIndex)
+						componentTypes.Push(entityContainer->components[i].typeID);
+
+				ArchetypeIndex archetypeIndex = FindOrCreateArchetype(&componentTypes);
+				MoveEntityToArchetype(entity, entityContainer, archetypeIndex, componentIndex);
+				return true;
+			}
+
+			const auto&& it = m_ComponentTypeAllocators.find(component->typeID);
+			if (it == m_ComponentTypeAllocators.end())
+			{
+				EU_LOG_WARN("Tried to delete ECS component with invalid component");
+				return false;
+			}
+
+			it->second->Free(component->actualComponent, component->allocatorIndex);
+			return true;
+		}
+
+		inline ECSComponentSparseSet* GetOrCreateComponentSet(metadata_typeid typeID)
+		{
+			while (typeID >= m_ComponentSets.Size())
+				m_ComponentSets.Push(0);
+
+			if (!m_ComponentSets[typeID])
+				m_ComponentSets[typeID] = new ECSComponentSparseSet();
+
+			return m_ComponentSets[typeID];
+		}
+
+		inline ArchetypeIndex FindOrCreateArchetype(List<metadata_typeid>* componentTypes)
+		{
+			//Insertion sort, component lists are small
+			for (u32 i = 1; i < componentTypes->Size(); i++)
+			{
+				metadata_typeid key = (*componentTypes)[i];
+				s32 j = i - 1;
+				while (j >= 0 && (*componentTypes)[j] > key)
 				{
-					systemCompatible = false;
-					break;
+					(*componentTypes)[j + 1] = (*componentTypes)[j];
+					j--;
 				}
+				(*componentTypes)[j + 1] = key;
+			}
+
+			for (u32 i = 0; i < m_Archetypes.Size(); i++)
+				if (m_Archetypes[i]->Matches(*componentTypes))
+					return i;
+
+			ECSArchetype* archetype = new ECSArchetype();
+			archetype->Init(*componentTypes);
+			m_Archetypes.Push(archetype);
+			return m_Archetypes.Size() - 1;
+		}
+
+		//Copies every component except skipComponentIndex into a new row of the destination archetype and patches the component pointers
+		inline void MoveEntityToArchetype(EntityID entity, ECSEntityContainer* entityContainer, ArchetypeIndex dstIndex, u32 skipComponentIndex)
+		{
+			ECSArchetype* dst = m_Archetypes[dstIndex];
+
+			u32 chunk, row;
+			dst->AllocateRow(entity, &chunk, &row);
+
+			List<ECSComponentContainer>& components = entityContainer->components;
+			for (u32 i = 0; i < components.Size(); i++)
+			{
+				if (i == skipComponentIndex)
+					continue;
+
+				s32 dstComponentIndex = dst->GetComponentIndex(components[i].typeID);
+				u8* dstComponent = dst->GetComponent(chunk, row, dstComponentIndex);
+				memcpy(dstComponent, components[i].actualComponent, dst->componentSizes[dstComponentIndex]);
+				components[i].actualComponent = (ECSComponent*)dstComponent;
+				m_ComponentSets[components[i].typeID]->Relocate(entity, components[i].actualComponent);
 			}
 
-			if (systemCompatible)
+			if (entityContainer->archetype != EU_ECS_INVALID_ARCHETYPE)
+				RemoveEntityFromArchetype(entityContainer);
+
+			entityContainer->archetype = dstIndex;
+			entityContainer->archetypeChunk = chunk;
+			entityContainer->archetypeRow = row;
+		}
+
+		inline void RemoveEntityFromArchetype(ECSEntityContainer* entityContainer)
+		{
+			ECSArchetype* archetype = m_Archetypes[entityContainer->archetype];
+			u32 chunk = entityContainer->archetypeChunk;
+			u32 row = entityContainer->archetypeRow;
+
+			EntityID movedEntity = archetype->RemoveRow(chunk, row);
+			if (movedEntity != EU_ECS_INVALID_ENTITY_ID)
 			{
-				b32 systemAlreadyInList = false;
-				for (u32 i = 0; i < entity->compatibleSystems.Size(); i++)
+				ECSEntityContainer* movedContainer = &m_CreatedEntities[EU_ECS_ENTITY_SLOT(movedEntity)];
+				movedContainer->archetypeChunk = chunk;
+				movedContainer->archetypeRow = row;
+				for (u32 i = 0; i < movedContainer->components.Size(); i++)
 				{
-					if (entity->compatibleSystems[i] == systemIndex)
-					{
-						systemAlreadyInList = true;
-						break;
-					}
+					ECSComponentContainer* component = &movedContainer->components[i];
+					component->actualComponent = (ECSComponent*)archetype->GetComponent(chunk, row, archetype->GetComponentIndex(component->typeID));
+					m_ComponentSets[component->typeID]->Relocate(movedEntity, component->actualComponent);
 				}
+			}
 
-				if(!systemAlreadyInList)
-					entity->compatibleSystems.Push(systemIndex);
+			entityContainer->archetype = EU_ECS_INVALID_ARCHETYPE;
+			entityContainer->archetypeChunk = 0;
+			entityContainer->archetypeRow = 0;
+		}
+
+		//Advances the tick clock of the system, on a tick the change versions are handed out and PreUpdate is called
+		inline b32 BeginSystemTick(ECSSystem* system, r32 tickRate, r32 dt)
+		{
+			system->m_TimeSinceTick += dt;
+			system->m_Ticking = true;
+			if (tickRate > 0.0f)
+			{
+				//The remainder is carried over so the tick rate holds on average, but never more than one tick
+				r32 interval = 1.0f / tickRate;
+				system->m_TickAccumulator += dt;
+				system->m_Ticking = system->m_TickAccumulator >= interval;
+				if (system->m_Ticking)
+					system->m_TickAccumulator = EU_MIN(system->m_TickAccumulator - interval, interval);
 			}
+
+			if (!system->m_Ticking)
+				return false;
+
+			system->m_TickDt = system->m_TimeSinceTick;
+			system->m_TimeSinceTick = 0.0f;
+			system->m_LastChangeVersion = system->m_ChangeVersion;
+			system->m_ChangeVersion = NextChangeVersion();
+			system->PreUpdate(system->m_TickDt);
+			return true;
 		}
 
-		inline void ProcessEntity(EntityID entityID, ECSProcessType processType, r32 dt)
+		inline void ProcessSystemEntities(ECSSystem* system, ECSProcessType processType, r32 dt)
 		{
-			ECSScene* scene = &m_CreatedScenes[m_ActiveScene - 1];
-			ECSEntityContainer* entity = &m_CreatedEntities[entityID - 2];
+			if (!system->enabled)
+				return;
 
-			if (!entity->checkedForCompatibleSystems)
+			if (processType == ECS_PROCESS_UPDATE)
 			{
-				for (u32 j = 0; j < scene->systems.Size(); j++)
-					CheckEntityAndSystemCompatiblity(entity, j);
+				if (!system->m_Ticking)
+					return;
+				dt = system->m_TickDt;
+			}
+
+			EU_PROFILE_SCOPE(system->m_ProfileName);
 
-				entity->checkedForCompatibleSystems = true;
+			if (system->m_ProcessInHierarchyOrder)
+				SortSystemEntities(system);
+
+			if (processType == ECS_PROCESS_UPDATE && system->m_TimeBudget > 0.0f)
+			{
+				ProcessSystemEntitiesSliced(system, dt);
+				return;
 			}
 
-			if (!entity->enabled)
+			if (system->m_BatchProcessing)
+			{
+				ProcessSystemBatch(system, processType, dt);
 				return;
+			}
 
-			for (u32 j = 0; j < entity->compatibleSystems.Size(); j++)
+			u32 numEntities = system->m_Entities.Size();
+			if (!m_ParallelSystems || system->m_Threading != ECS_SYSTEM_THREADING_PARALLEL_ENTITIES ||
+				system->m_ProcessInHierarchyOrder || numEntities <= EU_ECS_PARALLEL_ENTITY_CHUNK_SIZE)
 			{
-				SystemIndex index = entity->compatibleSystems[j];
-				ECSSystemContainer* system = &scene->systems[index];
+				ProcessSystemEntityRange(system, processType, dt, 0, numEntities);
+				return;
+			}
 
-				if (!system->actualSystem->enabled)
+			JobSystem::ParallelForBatch(numEntities, EU_ECS_PARALLEL_ENTITY_CHUNK_SIZE, [=](u32 begin, u32 end)
+			{
+				ProcessSystemEntityRange(system, processType, dt, begin, end);
+			});
+		}
+
+		//Continues the round robin pass over the entities of a budgeted system until its time budget is used up
+		inline void ProcessSystemEntitiesSliced(ECSSystem* system, r32 dt)
+		{
+			ECSEntityBatch batch;
+			u32 numEntities;
+			if (system->m_BatchProcessing)
+			{
+				BuildSystemBatch(system, &batch);
+				numEntities = batch.numEntities;
+			}
+			else
+			{
+				numEntities = system->m_Entities.Size();
+			}
+
+			system->m_SweepTime += dt;
+			if (numEntities == 0)
+				return;
+
+			//Entities added or removed since the last tick shift the pass a little, they are never skipped for more than one pass
+			if (system->m_NextSlicedEntity >= numEntities)
+				system->m_NextSlicedEntity = 0;
+
+			if (system->m_NextSlicedEntity == 0)
+			{
+				system->m_SweepDt = system->m_SweepTime;
+				system->m_SweepTime = 0.0f;
+			}
+
+			std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+			u32 begin = system->m_NextSlicedEntity;
+			while (begin < numEntities)
+			{
+				u32 end = EU_MIN(begin + EU_ECS_TIME_SLICE_CHUNK_SIZE, numEntities);
+				if (system->m_BatchProcessing)
+					DispatchSystemBatch(system, ECS_PROCESS_UPDATE, system->m_SweepDt, batch.GetRange(begin, end));
+				else
+					ProcessSystemEntityRange(system, ECS_PROCESS_UPDATE, system->m_SweepDt, begin, end);
+				begin = end;
+
+				if (std::chrono::duration<r32, std::milli>(std::chrono::high_resolution_clock::now() - start).count() >= system->m_TimeBudget)
+					break;
+			}
+
+			system->m_NextSlicedEntity = begin < numEntities ? begin : 0;
+		}
+
+		inline void ProcessSystemEntityRange(ECSSystem* system, ECSProcessType processType, r32 dt, u32 begin, u32 end)
+		{
+			const ECSEntityList& entities = system->m_Entities;
+			for (u32 i = begin; i < end; i++)
+			{
+				EntityID entityID = entities[i];
+				if (!m_CreatedEntities[EU_ECS_ENTITY_SLOT(entityID)].activeInHierarchy)
 					continue;
 
 				if (processType == ECS_PROCESS_UPDATE)
-					system->actualSystem->ProcessEntityOnUpdate(entityID, dt);
+					system->ProcessEntityOnUpdate(entityID, dt);
 				else if (processType == ECS_PROCESS_RENDER)
-					system->actualSystem->ProcessEntityOnRender(entityID);
+					system->ProcessEntityOnRender(entityID);
 				else if (processType == ECS_PROCESS_PRE_PHYSICS_SIM)
-					system->actualSystem->PrePhysicsSimulation(entityID, dt);
+					system->PrePhysicsSimulation(entityID, dt);
 				else if (processType == ECS_PROCESS_POST_PHYSICS_SIM)
-					system->actualSystem->PostPhysicsSimulation(entityID, dt);
+					system->PostPhysicsSimulation(entityID, dt);
 			}
+		}
 
-			for (u32 i = 0; i < entity->children.Size(); i++)
-				ProcessEntity(entity->children[i], processType, dt);
+		inline void BuildSystemBatch(ECSSystem* system, ECSEntityBatch* batch)
+		{
+			if (m_StorageMode == ECS_STORAGE_MODE_ARCHETYPE && !system->m_ProcessInHierarchyOrder)
+			{
+				BuildSystemBatchFromArchetypes(system, batch);
+				return;
+			}
+
+			system->m_BatchEntities.Clear();
+			for (u32 i = 0; i < system->m_Entities.Size(); i++)
+			{
+				EntityID entityID = system->m_Entities[i];
+				if (m_CreatedEntities[EU_ECS_ENTITY_SLOT(entityID)].activeInHierarchy)
+					system->m_BatchEntities.Push(entityID);
+			}
+
+			u32 numEntities = system->m_BatchEntities.Size();
+			batch->numEntities = numEntities;
+			batch->numComponentTypes = system->m_NumRequiredComponents + system->m_NumOptionalComponents;
+			for (u32 i = 0; i < batch->numComponentTypes; i++)
+			{
+				batch->componentTypes[i] = i < system->m_NumRequiredComponents ? system->m_RequiredComponets[i] :
+					system->m_OptionalComponents[i - system->m_NumRequiredComponents];
+				batch->components[i] = 0;
+			}
+
+			if (numEntities == 0)
+			{
+				batch->entities = 0;
+				return;
+			}
+
+			batch->entities = &system->m_BatchEntities[0];
+
+			u32 numPointers = numEntities * batch->numComponentTypes;
+			if (system->m_BatchComponents.GetCapacity() < numPointers)
+				system->m_BatchComponents.SetCapacityAndElementCount(numPointers);
+
+			ECSComponent** pointers = &system->m_BatchComponents[0];
+			for (u32 i = 0; i < batch->numComponentTypes; i++)
+			{
+				ECSComponent** components = pointers + i * numEntities;
+				const ECSComponentSparseSet* set = GetComponentSet(batch->componentTypes[i]);
+				for (u32 j = 0; j < numEntities; j++)
+					components[j] = set ? set->Get(batch->entities[j]) : 0;
+
+				batch->components[i] = components;
+			}
+		}
+
+		/*
+			Walks the rows of every archetype the system matches so the component pointers are gathered from contiguous arrays
+			instead of one sparse set lookup per entity and component. Rows of entities in other scenes are skipped.
+			The pointer arrays are sized for every row and strided by that count
+		*/
+		inline void BuildSystemBatchFromArchetypes(ECSSystem* system, ECSEntityBatch* batch)
+		{
+			GetArchetypesForSystem(system, &system->m_BatchArchetypes);
+
+			u32 maxEntities = 0;
+			for (u32 i = 0; i < system->m_BatchArchetypes.Size(); i++)
+				maxEntities += system->m_BatchArchetypes[i]->numEntities;
+
+			batch->numComponentTypes = system->m_NumRequiredComponents + system->m_NumOptionalComponents;
+			for (u32 i = 0; i < batch->numComponentTypes; i++)
+			{
+				batch->componentTypes[i] = i < system->m_NumRequiredComponents ? system->m_RequiredComponets[i] :
+					system->m_OptionalComponents[i - system->m_NumRequiredComponents];
+				batch->components[i] = 0;
+			}
+
+			system->m_BatchEntities.Clear();
+			if (maxEntities == 0)
+			{
+				batch->entities = 0;
+				batch->numEntities = 0;
+				return;
+			}
+
+			if (system->m_BatchEntities.GetCapacity() < maxEntities)
+				system->m_BatchEntities.SetCapacity(maxEntities);
+
+			u32 numPointers = maxEntities * batch->numComponentTypes;
+			if (system->m_BatchComponents.GetCapacity() < numPointers)
+				system->m_BatchComponents.SetCapacityAndElementCount(numPointers);
+
+			ECSComponent** pointers = numPointers ? &system->m_BatchComponents[0] : 0;
+			for (u32 i = 0; i < batch->numComponentTypes; i++)
+				batch->components[i] = pointers + i * maxEntities;
+
+			for (u32 i = 0; i < system->m_BatchArchetypes.Size(); i++)
+			{
+				const ECSArchetype* archetype = system->m_BatchArchetypes[i];
+
+				s32 componentIndices[EU_ECS_MAX_BATCH_COMPONENT_TYPES];
+				for (u32 j = 0; j < batch->numComponentTypes; j++)
+					componentIndices[j] = archetype->GetComponentIndex(batch->componentTypes[j]);
+
+				for (u32 chunk = 0; chunk < archetype->chunks.Size(); chunk++)
+				{
+					const EntityID* entities = archetype->GetEntityArray(chunk);
+					u32 numRows = archetype->chunks[chunk].numEntities;
+					for (u32 row = 0; row < numRows; row++)
+					{
+						EntityID entityID = entities[row];
+						if (!m_CreatedEntities[EU_ECS_ENTITY_SLOT(entityID)].activeInHierarchy || !system->m_Entities.Contains(entityID))
+							continue;
+
+						u32 index = system->m_BatchEntities.Size();
+						system->m_BatchEntities.Push(entityID);
+						for (u32 j = 0; j < batch->numComponentTypes; j++)
+							pointers[j * maxEntities + index] = componentIndices[j] == -1 ? 0 :
+								(ECSComponent*)archetype->GetComponent(chunk, row, componentIndices[j]);
+					}
+				}
+			}
+
+			batch->numEntities = system->m_BatchEntities.Size();
+			batch->entities = batch->numEntities ? &system->m_BatchEntities[0] : 0;
+		}
+
+		inline void ProcessSystemBatch(ECSSystem* system, ECSProcessType processType, r32 dt)
+		{
+			ECSEntityBatch batch;
+			BuildSystemBatch(system, &batch);
+			if (batch.numEntities == 0)
+				return;
+
+			if (!m_ParallelSystems || system->m_Threading != ECS_SYSTEM_THREADING_PARALLEL_ENTITIES ||
+				system->m_ProcessInHierarchyOrder || batch.numEntities <= EU_ECS_PARALLEL_ENTITY_CHUNK_SIZE)
+			{
+				DispatchSystemBatch(system, processType, dt, batch);
+				return;
+			}
+
+			JobSystem::ParallelForBatch(batch.numEntities, EU_ECS_PARALLEL_ENTITY_CHUNK_SIZE, [&](u32 begin, u32 end)
+			{
+				DispatchSystemBatch(system, processType, dt, batch.GetRange(begin, end));
+			});
+		}
+
+		inline void DispatchSystemBatch(ECSSystem* system, ECSProcessType processType, r32 dt, const ECSEntityBatch& batch)
+		{
+			if (processType == ECS_PROCESS_UPDATE)
+				system->ProcessBatchOnUpdate(batch, dt);
+			else if (processType == ECS_PROCESS_RENDER)
+				system->ProcessBatchOnRender(batch);
+			else if (processType == ECS_PROCESS_PRE_PHYSICS_SIM)
+				system->PrePhysicsSimulationBatch(batch, dt);
+			else if (processType == ECS_PROCESS_POST_PHYSICS_SIM)
+				system->PostPhysicsSimulationBatch(batch, dt);
+		}
+
+		inline b32 DoSystemsConflict(const ECSSystem* a, const ECSSystem* b) const
+		{
+			if (a->m_Threading == ECS_SYSTEM_THREADING_MAIN_THREAD || b->m_Threading == ECS_SYSTEM_THREADING_MAIN_THREAD)
+				return true;
+
+			for (u32 i = 0; i < a->m_NumRequiredComponents + a->m_NumOptionalComponents; i++)
+			{
+				metadata_typeid typeID = i < a->m_NumRequiredComponents ? a->m_RequiredComponets[i] : a->m_OptionalComponents[i - a->m_NumRequiredComponents];
+				u32 accessA = a->GetComponentAccess(typeID);
+				u32 accessB = b->GetComponentAccess(typeID);
+				if (accessB && ((accessA | accessB) & ECS_COMPONENT_ACCESS_WRITE))
+					return true;
+			}
+
+			return false;
+		}
+
+		/*
+			Places every system in the earliest wave after all earlier systems it conflicts with.
+			Creation order is kept between conflicting systems so results match running them serially
+		*/
+		inline void BuildSystemSchedule(ECSScene* scene)
+		{
+			scene->systemWaves.Clear();
+			scene->numScheduleWaves = 0;
+
+			for (u32 i = 0; i < scene->systems.Size(); i++)
+			{
+				u32 wave = 0;
+				for (u32 j = 0; j < i; j++)
+					if (scene->systemWaves[j] + 1 > wave && DoSystemsConflict(scene->systems[i].actualSystem, scene->systems[j].actualSystem))
+						wave = scene->systemWaves[j] + 1;
+
+				scene->systemWaves.Push(wave);
+				scene->numScheduleWaves = EU_MAX(scene->numScheduleWaves, wave + 1);
+			}
+
+			scene->scheduleDirty = false;
+		}
+
+		inline void ProcessSystemWave(ECSScene* scene, u32 wave, ECSProcessType processType, r32 dt)
+		{
+			ECSSystem* waveSystems[EU_ECS_MAX_SYSTEMS];
+			u32 numWaveSystems = 0;
+
+			for (u32 i = 0; i < scene->systems.Size(); i++)
+			{
+				ECSSystem* system = scene->systems[i].actualSystem;
+				if (scene->systemWaves[i] == wave && system->enabled && (processType != ECS_PROCESS_UPDATE || system->m_Ticking))
+					waveSystems[numWaveSystems++] = system;
+			}
+
+			if (numWaveSystems == 0)
+				return;
+
+			//Main thread systems always end up alone in their wave so they run here on the calling thread
+			if (numWaveSystems == 1)
+			{
+				ProcessSystemEntities(waveSystems[0], processType, dt);
+				return;
+			}
+
+			JobSystem::ParallelFor(numWaveSystems, 1, [&](u32 i)
+			{
+				ProcessSystemEntities(waveSystems[i], processType, dt);
+			});
 		}
 
 		inline void ProcessEntities(ECSProcessType processType, r32 dt = 0.0f)
 		{
+			static const char* processTypeNames[NUM_ECS_PROCESS_TYPES] = { "ECS::Update", "ECS::Render", "ECS::PrePhysicsSimulation", "ECS::PostPhysicsSimulation" };
+			EU_PROFILE_SCOPE(processTypeNames[processType]);
+
 			if (m_ActiveScene == EU_ECS_INVALID_SCENE_ID)
 				return;
 
@@ -1385,12 +3131,26 @@ namespace Eunoia
 
 				switch (processType)
 				{
-				case ECS_PROCESS_UPDATE: system->actualSystem->PreUpdate(dt); break;
+				case ECS_PROCESS_UPDATE: BeginSystemTick(system->actualSystem, system->actualSystem->m_TickRate, dt); break;
 				case ECS_PROCESS_RENDER: system->actualSystem->PreRender(); break;
 				}
 			}
 
-			ProcessEntity(scene->rootEntity, processType, dt);
+			UpdateHierarchyCache();
+
+			if (m_ParallelSystems)
+			{
+				if (scene->scheduleDirty)
+					BuildSystemSchedule(scene);
+
+				for (u32 i = 0; i < scene->numScheduleWaves; i++)
+					ProcessSystemWave(scene, i, processType, dt);
+			}
+			else
+			{
+				for (u32 i = 0; i < scene->systems.Size(); i++)
+					ProcessSystemEntities(scene->systems[i].actualSystem, processType, dt);
+			}
 
 			for (u32 i = 0; i < scene->systems.Size(); i++)
 			{
@@ -1401,7 +3161,10 @@ namespace Eunoia
 
 				switch (processType)
 				{
-				case ECS_PROCESS_UPDATE: system->actualSystem->PostUpdate(dt); break;
+				case ECS_PROCESS_UPDATE:
+					if (system->actualSystem->m_Ticking)
+						system->actualSystem->PostUpdate(system->actualSystem->m_TickDt);
+					break;
 				case ECS_PROCESS_RENDER: system->actualSystem->PostRender(); break;
 				}
 			}
@@ -1421,7 +3184,7 @@ namespace Eunoia
 
 			SetActiveScene(activeScene);
 
-			ECSEntityContainer* entity = &m_CreatedEntities[entityID - 2];
+			ECSEntityContainer* entity = &m_CreatedEntities[EU_ECS_ENTITY_SLOT(entityID)];
 			entity->enabled = loadedEntity.enabled;
 			entity->name = loadedEntity.name;
 			entity->parent = parent;
@@ -1450,6 +3213,14 @@ namespace Eunoia
 			for (u32 i = 0; i < components.Size(); i++)
 			{
 				const ECSComponentContainer* component = &components[i];
+				m_ComponentSets[component->typeID]->Remove(id);
+
+				if (m_StorageMode == ECS_STORAGE_MODE_ARCHETYPE)
+				{
+					component->actualComponent->OnDestroy();
+					continue;
+				}
+
 				const auto&& it = m_ComponentTypeAllocators.find(component->typeID);
 				if (it == m_ComponentTypeAllocators.end())
 				{
@@ -1461,9 +3232,12 @@ namespace Eunoia
 				it->second->Free(component->actualComponent, component->allocatorIndex);
 			}
 
+			if (entity->archetype != EU_ECS_INVALID_ARCHETYPE)
+				RemoveEntityFromArchetype(entity);
+
 			if (entity->parent != EU_ECS_INVALID_ENTITY_ID)
 			{
-				ECSEntityContainer* parent = &m_CreatedEntities[entity->parent - 2];
+				ECSEntityContainer* parent = &m_CreatedEntities[EU_ECS_ENTITY_SLOT(entity->parent)];
 				for (u32 i = 0; i < parent->children.Size(); i++)
 				{
 					if (parent->children[i] == id)
@@ -1471,12 +3245,20 @@ namespace Eunoia
 				}
 			}
 
+			RemoveEntityFromSystems(id, entity->scene);
+			RemoveEntityFromNameIndex(id);
+			m_HierarchyDirty = true;
+
 			entity->children.Clear();
 			entity->components.Clear();
+			entity->scene = EU_ECS_INVALID_SCENE_ID;
 			entity->enabled = false;
 			entity->name = "";
+			entity->nameHash = 0;
 			entity->parent = EU_ECS_INVALID_ENTITY_ID;
-			m_FreeEntityIDs.Push(id);
+			entity->id = EU_ECS_INVALID_ENTITY_ID;
+			//The generation wraps after EU_ECS_ENTITY_GENERATION_MASK reuses of the same slot
+			m_FreeEntityIDs.Push(EU_ECS_NEXT_ENTITY_GENERATION(id));
 		}
 
 		inline void FreeAndResetECS()
@@ -1484,7 +3266,16 @@ namespace Eunoia
 			for (const auto& it_cta : m_ComponentTypeAllocators)
 				delete it_cta.second;
 
-			m_EventAllocator.Reset();
+			for (u32 i = 0; i < m_Archetypes.Size(); i++)
+				delete m_Archetypes[i];
+
+			for (u32 i = 0; i < m_ComponentSets.Size(); i++)
+				delete m_ComponentSets[i];
+
+			for (u32 i = 0; i < m_CreatedScenes.Size(); i++)
+				for (u32 j = 0; j < m_CreatedScenes[i].systems.Size(); j++)
+					m_CreatedScenes[i].systems[j].actualSystem->~ECSSystem();
+
 			m_SystemAllocator.Reset();
 
 			m_CreatedEntities.Clear();
@@ -1492,10 +3283,15 @@ namespace Eunoia
 			m_FreeSceneIDs.Clear();
 			m_FreeEntityIDs.Clear();
 			m_NextEntityID = 2;
+			m_HierarchyDirty = true;
 			m_ComponentTypeAllocators.clear();
-			m_Events.clear();
-			m_ActiveEvents.clear();
-			m_EventsToReset.Clear();
+			m_Archetypes.Clear();
+			m_ComponentSets.Clear();
+			m_NameIndex.Clear();
+			m_ChildNameIndex.Clear();
+			m_CommandBuffer.Reset();
+			for (u32 i = 0; i < EU_ECS_MAX_EVENT_TYPES; i++)
+				delete m_EventQueues[i].exchange(0);
 		}
 	private:
 		List<ECSEntityContainer> m_CreatedEntities;
@@ -1505,11 +3301,21 @@ namespace Eunoia
 		List < EntityID > m_FreeEntityIDs;
 		EntityID m_NextEntityID;
 		std::map < metadata_typeid, DynamicPoolAllocator* > m_ComponentTypeAllocators;
+		ECSStorageMode m_StorageMode;
+		List<ECSArchetype*> m_Archetypes;
+		//Reused by every structural change so moving an entity between archetypes doesn't allocate
+		List<metadata_typeid> m_ArchetypeComponentTypes;
+		List<ECSComponentSparseSet*> m_ComponentSets;
+		ECSEntityNameIndex m_NameIndex;
+		ECSEntityNameIndex m_ChildNameIndex;
+		b32 m_HierarchyDirty;
+		u32 m_HierarchyVersion;
+		b32 m_ParallelSystems;
+		r32 m_BackgroundTickRate;
+		std::atomic<ECSVersion> m_ChangeVersion;
 		PoolAllocator m_SystemAllocator;
-		LinearAllocator m_EventAllocator;
-		std::map<metadata_typeid, ECSEvent*> m_Events;
-		std::map<metadata_typeid, b32> m_ActiveEvents;
-		List<metadata_typeid> m_EventsToReset;
-		List<EntityID> m_EntitiesToDelete;
+		std::atomic<ECSEventQueue*> m_EventQueues[EU_ECS_MAX_EVENT_TYPES];
+		ECSSceneStreamer m_SceneStreamer;
+		ECSCommandBuffer m_CommandBuffer;
 	};
 }
@@ -0,0 +1,203 @@
+#pragma once
+
+#include "../Common.h"
+#include "../Metadata/Metadata.h"
+#include "../DataStructures/List.h"
+#include "../Memory/Allocators.h"
+#include "ECSTypes.h"
+#include <cstdlib>
+#include <cstring>
+
+#define EU_ECS_ARCHETYPE_CHUNK_SIZE			EU_KB(16)
+#define EU_ECS_ARCHETYPE_ARRAY_ALIGNMENT	16
+#define EU_ECS_INVALID_ARCHETYPE			EU_U32_MAX
+
+namespace Eunoia {
+
+	typedef u32 ArchetypeIndex;
+
+	enum ECSStorageMode
+	{
+		ECS_STORAGE_MODE_POOLED,
+		ECS_STORAGE_MODE_ARCHETYPE
+	};
+
+	/*
+		A chunk is one block of memory laid out as
+		[EntityID x capacity][Component0 x capacity][Component1 x capacity]...
+		Each component array starts on an EU_ECS_ARCHETYPE_ARRAY_ALIGNMENT boundary
+	*/
+	struct ECSArchetypeChunk
+	{
+		u8* memory;
+		u32 numEntities;
+	};
+
+	/*
+		Every entity with exactly the same set of component types lives in the same archetype.
+		Rows are always kept packed: every chunk except the last one is full, removing a row
+		moves the last row of the archetype into the hole.
+	*/
+	struct ECSArchetype
+	{
+		ECSArchetype() :
+			chunkCapacity(0),
+			chunkSize(0),
+			numEntities(0)
+		{}
+
+		~ECSArchetype()
+		{
+			for (u32 i = 0; i < chunks.Size(); i++)
+				free(chunks[i].memory);
+		}
+
+		inline void Init(const List<metadata_typeid>& sortedComponentTypes)
+		{
+			componentTypes = sortedComponentTypes;
+			componentSizes.Clear();
+			componentOffsets.Clear();
+
+			mem_size rowSize = sizeof(EntityID);
+			for (u32 i = 0; i < componentTypes.Size(); i++)
+			{
+				mem_size size = Metadata::GetMetadata(componentTypes[i]).cls->size;
+				componentSizes.Push(size);
+				rowSize += size;
+			}
+
+			mem_size padding = EU_ECS_ARCHETYPE_ARRAY_ALIGNMENT * (componentTypes.Size() + 1);
+			chunkCapacity = EU_ECS_ARCHETYPE_CHUNK_SIZE > padding ? (u32)((EU_ECS_ARCHETYPE_CHUNK_SIZE - padding) / rowSize) : 0;
+			if (chunkCapacity == 0)
+				chunkCapacity = 1;
+
+			mem_size offset = AlignOffset(sizeof(EntityID) * chunkCapacity);
+			for (u32 i = 0; i < componentTypes.Size(); i++)
+			{
+				componentOffsets.Push(offset);
+				offset = AlignOffset(offset + componentSizes[i] * chunkCapacity);
+			}
+
+			chunkSize = offset;
+		}
+
+		inline b32 Matches(const List<metadata_typeid>& sortedComponentTypes) const
+		{
+			if (sortedComponentTypes.Size() != componentTypes.Size())
+				return false;
+
+			for (u32 i = 0; i < componentTypes.Size(); i++)
+				if (componentTypes[i] != sortedComponentTypes[i])
+					return false;
+
+			return true;
+		}
+
+		inline b32 ContainsAll(const metadata_typeid* types, u32 numTypes) const
+		{
+			for (u32 i = 0; i < numTypes; i++)
+				if (GetComponentIndex(types[i]) == -1)
+					return false;
+
+			return true;
+		}
+
+		inline s32 GetComponentIndex(metadata_typeid typeID) const
+		{
+			for (u32 i = 0; i < componentTypes.Size(); i++)
+				if (componentTypes[i] == typeID)
+					return i;
+
+			return -1;
+		}
+
+		inline EntityID* GetEntityArray(u32 chunk) const
+		{
+			return (EntityID*)chunks[chunk].memory;
+		}
+
+		inline u8* GetComponentArray(u32 chunk, u32 componentIndex) const
+		{
+			return chunks[chunk].memory + componentOffsets[componentIndex];
+		}
+
+		template<class C>
+		inline C* GetComponentArray(u32 chunk) const
+		{
+			s32 componentIndex = GetComponentIndex(Metadata::GetTypeID<C>());
+			if (componentIndex == -1)
+				return 0;
+
+			return (C*)GetComponentArray(chunk, componentIndex);
+		}
+
+		inline u8* GetComponent(u32 chunk, u32 row, u32 componentIndex) const
+		{
+			return GetComponentArray(chunk, componentIndex) + componentSizes[componentIndex] * row;
+		}
+
+		inline void AllocateRow(EntityID entity, u32* chunk, u32* row)
+		{
+			if (chunks.Empty() || chunks[chunks.Size() - 1].numEntities == chunkCapacity)
+			{
+				ECSArchetypeChunk newChunk;
+				newChunk.memory = (u8*)malloc(chunkSize);
+				newChunk.numEntities = 0;
+				chunks.Push(newChunk);
+			}
+
+			*chunk = chunks.Size() - 1;
+			*row = chunks[*chunk].numEntities++;
+			GetEntityArray(*chunk)[*row] = entity;
+			numEntities++;
+		}
+
+		//Returns the entity that was moved into the freed row or EU_ECS_INVALID_ENTITY_ID if nothing moved
+		inline EntityID RemoveRow(u32 chunk, u32 row)
+		{
+			u32 lastChunk = chunks.Size() - 1;
+			u32 lastRow = chunks[lastChunk].numEntities - 1;
+
+			EntityID movedEntity = EU_ECS_INVALID_ENTITY_ID;
+			if (chunk != lastChunk || row != lastRow)
+			{
+				movedEntity = GetEntityArray(lastChunk)[lastRow];
+				GetEntityArray(chunk)[row] = movedEntity;
+				for (u32 i = 0; i < componentTypes.Size(); i++)
+					memcpy(GetComponent(chunk, row, i), GetComponent(lastChunk, lastRow, i), componentSizes[i]);
+			}
+
+			chunks[lastChunk].numEntities--;
+			numEntities--;
+			if (chunks[lastChunk].numEntities == 0)
+			{
+				free(chunks[lastChunk].memory);
+				chunks.Remove(lastChunk);
+			}
+
+			return movedEntity;
+		}
+
+		inline void Reset()
+		{
+			for (u32 i = 0; i < chunks.Size(); i++)
+				free(chunks[i].memory);
+			chunks.Clear();
+			numEntities = 0;
+		}
+
+		static inline mem_size AlignOffset(mem_size offset)
+		{
+			return (offset + (EU_ECS_ARCHETYPE_ARRAY_ALIGNMENT - 1)) & ~((mem_size)EU_ECS_ARCHETYPE_ARRAY_ALIGNMENT - 1);
+		}
+
+		List<metadata_typeid> componentTypes;
+		List<mem_size> componentSizes;
+		List<mem_size> componentOffsets;
+		List<ECSArchetypeChunk> chunks;
+		u32 chunkCapacity;
+		mem_size chunkSize;
+		u32 numEntities;
+	};
+
+}
@@ -0,0 +1,107 @@
+#include "ECS.h"
+#include "Components/Transform3DComponet.h"
+#include "Components/SpatialIndex3DComponent.h"
+#include "../Core/Benchmark.h"
+
+#define EU_ECS_BENCHMARK_NUM_UPDATES 20
+
+namespace Eunoia {
+
+	//Does the same work through both kinds of callbacks, never created through the ECS so it needs no metadata
+	class ECSBenchmarkSystem : public ECSSystem
+	{
+	public:
+		ECSBenchmarkSystem()
+		{
+			AddComponentType<Transform3DComponent>(ECS_COMPONENT_ACCESS_READ_WRITE);
+			AddComponentType<SpatialIndex3DComponent>(ECS_COMPONENT_ACCESS_READ);
+			SetThreading(ECS_SYSTEM_THREADING_PARALLEL_ENTITIES);
+		}
+
+		virtual void ProcessEntityOnUpdate(EntityID entity, r32 dt) override
+		{
+			Transform3DComponent* transform = m_ECS->GetComponent<Transform3DComponent>(entity);
+			const SpatialIndex3DComponent* bounds = m_ECS->GetComponent<SpatialIndex3DComponent>(entity);
+			transform->localTransform.pos.y += bounds->radius * dt;
+		}
+
+		virtual void ProcessBatchOnUpdate(const ECSEntityBatch& batch, r32 dt) override
+		{
+			ECS::View<Transform3DComponent, SpatialIndex3DComponent> view(batch);
+			for (u32 i = 0; i < view.Size(); i++)
+				view.Get<Transform3DComponent>(i)->localTransform.pos.y += view.Get<SpatialIndex3DComponent>(i)->radius * dt;
+		}
+	};
+
+	void ECS::RunBenchmark(u32 numEntities)
+	{
+		//Runs the system over every entity EU_ECS_BENCHMARK_NUM_UPDATES times and returns the time of one update
+		auto measureUpdate = [](ECS* ecs, ECSBenchmarkSystem* system)
+		{
+			BenchmarkTimer timer;
+			for (u32 i = 0; i < EU_ECS_BENCHMARK_NUM_UPDATES; i++)
+			{
+				system->m_TickDt = 0.016f;
+				ecs->ProcessSystemEntities(system, ECS_PROCESS_UPDATE, 0.016f);
+			}
+			return timer.GetElapsedMicroseconds() / EU_ECS_BENCHMARK_NUM_UPDATES;
+		};
+
+		auto createScene = [numEntities](ECSBenchmarkScene* scene, ECSBenchmarkSystem* system)
+		{
+			scene->Create("ECSBenchmark", numEntities);
+			for (u32 i = 0; i < numEntities; i++)
+				scene->ecs->CreateComponent<SpatialIndex3DComponent>(scene->entities[i], EU_RANDOM_FLOAT(0.5f, 4.0f));
+			scene->ecs->UpdateHierarchyCache();
+
+			system->m_ECS = scene->ecs;
+			system->m_Entities = ECSEntityList();
+			scene->ecs->AddMatchingEntitiesToSystem(system);
+		};
+
+		BenchmarkSamples perEntityTime, batchTime, parallelPerEntityTime, parallelBatchTime;
+		BenchmarkSamples archetypeBatchTime, parallelArchetypeBatchTime;
+		for (u32 sample = 0; sample < EU_BENCHMARK_NUM_SAMPLES; sample++)
+		{
+			ECSBenchmarkSystem system;
+			{
+				ECSBenchmarkScene scene;
+				createScene(&scene, &system);
+				ECS* ecs = scene.ecs;
+
+				ecs->SetParallelSystemsEnabled(false);
+				system.m_BatchProcessing = false;
+				perEntityTime.Add(measureUpdate(ecs, &system));
+				system.m_BatchProcessing = true;
+				batchTime.Add(measureUpdate(ecs, &system));
+
+				ecs->SetParallelSystemsEnabled(true);
+				system.m_BatchProcessing = false;
+				parallelPerEntityTime.Add(measureUpdate(ecs, &system));
+				system.m_BatchProcessing = true;
+				parallelBatchTime.Add(measureUpdate(ecs, &system));
+			}
+
+			//The same batch gathered from archetype chunks instead of the sparse sets
+			{
+				ECSBenchmarkScene scene;
+				scene.ecs->SetStorageMode(ECS_STORAGE_MODE_ARCHETYPE);
+				createScene(&scene, &system);
+				ECS* ecs = scene.ecs;
+
+				ecs->SetParallelSystemsEnabled(false);
+				archetypeBatchTime.Add(measureUpdate(ecs, &system));
+				ecs->SetParallelSystemsEnabled(true);
+				parallelArchetypeBatchTime.Add(measureUpdate(ecs, &system));
+			}
+		}
+
+		EU_LOG_BENCHMARK("ECS", "{0} entities, per entity callbacks {1:.0f}us, batch {2:.0f}us ({3:.2f}x), on the job system per entity {4:.0f}us, batch {5:.0f}us ({6:.2f}x)",
+			numEntities, perEntityTime.GetMedian(), batchTime.GetMedian(), perEntityTime.GetMedian() / batchTime.GetMedian(),
+			parallelPerEntityTime.GetMedian(), parallelBatchTime.GetMedian(), parallelPerEntityTime.GetMedian() / parallelBatchTime.GetMedian());
+		EU_LOG_BENCHMARK("ECS", "{0} entities in archetype storage, batch {1:.0f}us ({2:.2f}x of pooled), on the job system {3:.0f}us ({4:.2f}x of pooled)",
+			numEntities, archetypeBatchTime.GetMedian(), batchTime.GetMedian() / archetypeBatchTime.GetMedian(),
+			parallelArchetypeBatchTime.GetMedian(), parallelBatchTime.GetMedian() / parallelArchetypeBatchTime.GetMedian());
+	}
+
+}
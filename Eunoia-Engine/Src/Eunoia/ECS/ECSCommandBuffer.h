@@ -0,0 +1,293 @@
+#pragma once
+
+#include "../Common.h"
+#include "../Metadata/Metadata.h"
+#include "../DataStructures/List.h"
+#include "../DataStructures/String.h"
+#include "../Core/JobSystem.h"
+#include "ECSTypes.h"
+#include <mutex>
+#include <new>
+#include <utility>
+
+#define EU_ECS_INVALID_DEFERRED_ENTITY	EU_U32_MAX
+#define EU_ECS_COMMAND_QUEUE_SHIFT		24
+#define EU_ECS_COMMAND_DATA_ALIGNMENT	16
+
+namespace Eunoia {
+
+	//An entity recorded in a command buffer, resolves to a real EntityID when the buffer is played back
+	struct ECSDeferredEntity
+	{
+		u32 handle;
+	};
+
+	enum ECSCommandType
+	{
+		ECS_COMMAND_CREATE_ENTITY,
+		ECS_COMMAND_DESTROY_ENTITY,
+		ECS_COMMAND_CREATE_COMPONENT,
+		ECS_COMMAND_DESTROY_COMPONENT,
+		ECS_COMMAND_SET_ENTITY_ENABLED
+	};
+
+	//Moves a recorded component into dst when one is given, the recorded component is destroyed either way
+	typedef void(*ECSCommandReleaseComponentFunction)(void* dst, void* recorded);
+
+	template<class C>
+	inline void ECSReleaseRecordedComponent(void* dst, void* recorded)
+	{
+		if (dst)
+			new (dst) C(std::move(*(C*)recorded));
+		((C*)recorded)->~C();
+	}
+
+	struct ECSCommand
+	{
+		ECSCommandType type;
+		EntityID entity;
+		u32 deferredEntity;
+		EntityID parent;
+		u32 deferredParent;
+		metadata_typeid typeID;
+		u32 dataOffset;
+		ECSCommandReleaseComponentFunction releaseComponent;
+		b32 flag;
+	};
+
+	struct ECSCommandQueue
+	{
+		List<ECSCommand> commands;
+		List<u8> data;
+		List<String> names;
+		//Index into commands of the create command of every deferred entity
+		List<u32> createCommands;
+		//Filled in during playback, indexed like createCommands
+		List<EntityID> createdEntities;
+	};
+
+	/*
+		Records structural changes from any thread to be applied by ECS::FlushCommandBuffer at the frame's sync point.
+		Every job system worker records into its own queue so recording from parallel systems doesn't contend,
+		queues are played back in worker order and the commands of one queue in the order they were recorded.
+		Entities are created before any other command is applied so components can be added to deferred entities
+	*/
+	class ECSCommandBuffer
+	{
+	public:
+		ECSCommandBuffer() {}
+
+		inline ECSDeferredEntity CreateEntity(const String& name, EntityID parent = EU_ECS_ROOT_ENTITY)
+		{
+			return RecordCreateEntity(name, parent, EU_ECS_INVALID_DEFERRED_ENTITY);
+		}
+
+		inline ECSDeferredEntity CreateEntity(const String& name, ECSDeferredEntity parent)
+		{
+			return RecordCreateEntity(name, EU_ECS_INVALID_ENTITY_ID, parent.handle);
+		}
+
+		inline void DestroyEntity(EntityID entity, b32 destroyChildren = true)
+		{
+			ECSCommand command = MakeCommand(ECS_COMMAND_DESTROY_ENTITY, entity, EU_ECS_INVALID_DEFERRED_ENTITY);
+			command.flag = destroyChildren;
+			Record(command);
+		}
+
+		inline void SetEntityEnabled(EntityID entity, b32 enabled)
+		{
+			ECSCommand command = MakeCommand(ECS_COMMAND_SET_ENTITY_ENABLED, entity, EU_ECS_INVALID_DEFERRED_ENTITY);
+			command.flag = enabled;
+			Record(command);
+		}
+
+		//The component is constructed now and moved into the ECS on playback, systems see it once it holds the recorded data
+		template<class C, class... Args>
+		inline void CreateComponent(EntityID entity, Args&&... args)
+		{
+			RecordCreateComponent<C>(entity, EU_ECS_INVALID_DEFERRED_ENTITY, std::forward<Args>(args)...);
+		}
+
+		template<class C, class... Args>
+		inline void CreateComponent(ECSDeferredEntity entity, Args&&... args)
+		{
+			RecordCreateComponent<C>(EU_ECS_INVALID_ENTITY_ID, entity.handle, std::forward<Args>(args)...);
+		}
+
+		template<class C>
+		inline void DestroyComponent(EntityID entity)
+		{
+			DestroyComponent(entity, Metadata::GetTypeID<C>());
+		}
+
+		inline void DestroyComponent(EntityID entity, metadata_typeid typeID)
+		{
+			ECSCommand command = MakeCommand(ECS_COMMAND_DESTROY_COMPONENT, entity, EU_ECS_INVALID_DEFERRED_ENTITY);
+			command.typeID = typeID;
+			Record(command);
+		}
+
+		//Valid after the flush that created the entity until the next flush
+		inline EntityID GetCreatedEntity(ECSDeferredEntity entity) const
+		{
+			if (entity.handle == EU_ECS_INVALID_DEFERRED_ENTITY)
+				return EU_ECS_INVALID_ENTITY_ID;
+
+			const ECSCommandQueue& queue = m_Playback[entity.handle >> EU_ECS_COMMAND_QUEUE_SHIFT];
+			u32 index = entity.handle & ((1 << EU_ECS_COMMAND_QUEUE_SHIFT) - 1);
+			return index < queue.createdEntities.Size() ? queue.createdEntities[index] : EU_ECS_INVALID_ENTITY_ID;
+		}
+
+		inline b32 Empty()
+		{
+			for (u32 i = 0; i < EU_JOB_SYSTEM_MAX_THREAD_INDICES; i++)
+			{
+				std::lock_guard<std::mutex> lock(m_Mutexes[i]);
+				if (!m_Recording[i].commands.Empty())
+					return false;
+			}
+
+			return true;
+		}
+	private:
+		inline ECSCommand MakeCommand(ECSCommandType type, EntityID entity, u32 deferredEntity)
+		{
+			ECSCommand command;
+			command.type = type;
+			command.entity = entity;
+			command.deferredEntity = deferredEntity;
+			command.parent = EU_ECS_INVALID_ENTITY_ID;
+			command.deferredParent = EU_ECS_INVALID_DEFERRED_ENTITY;
+			command.typeID = 0;
+			command.dataOffset = 0;
+			command.releaseComponent = 0;
+			command.flag = false;
+			return command;
+		}
+
+		inline void Record(const ECSCommand& command)
+		{
+			u32 queueIndex = JobSystem::GetWorkerIndex();
+			std::lock_guard<std::mutex> lock(m_Mutexes[queueIndex]);
+			m_Recording[queueIndex].commands.Push(command);
+		}
+
+		inline ECSDeferredEntity RecordCreateEntity(const String& name, EntityID parent, u32 deferredParent)
+		{
+			ECSCommand command = MakeCommand(ECS_COMMAND_CREATE_ENTITY, EU_ECS_INVALID_ENTITY_ID, EU_ECS_INVALID_DEFERRED_ENTITY);
+			command.parent = parent;
+			command.deferredParent = deferredParent;
+
+			u32 queueIndex = JobSystem::GetWorkerIndex();
+			std::lock_guard<std::mutex> lock(m_Mutexes[queueIndex]);
+			ECSCommandQueue* queue = &m_Recording[queueIndex];
+
+			ECSDeferredEntity entity;
+			entity.handle = (queueIndex << EU_ECS_COMMAND_QUEUE_SHIFT) | queue->createCommands.Size();
+
+			command.deferredEntity = entity.handle;
+			command.dataOffset = queue->names.Size();
+			queue->names.Push(name);
+			queue->createCommands.Push(queue->commands.Size());
+			queue->commands.Push(command);
+
+			return entity;
+		}
+
+		template<class C, class... Args>
+		inline void RecordCreateComponent(EntityID entity, u32 deferredEntity, Args&&... args)
+		{
+			ECSCommand command = MakeCommand(ECS_COMMAND_CREATE_COMPONENT, entity, deferredEntity);
+			command.typeID = Metadata::GetTypeID<C>();
+			command.releaseComponent = ECSReleaseRecordedComponent<C>;
+
+			u32 queueIndex = JobSystem::GetWorkerIndex();
+			std::lock_guard<std::mutex> lock(m_Mutexes[queueIndex]);
+			ECSCommandQueue* queue = &m_Recording[queueIndex];
+
+			u32 offset = (queue->data.Size() + (EU_ECS_COMMAND_DATA_ALIGNMENT - 1)) & ~(EU_ECS_COMMAND_DATA_ALIGNMENT - 1);
+			u32 newSize = offset + sizeof(C);
+			if (newSize > queue->data.GetCapacity())
+				queue->data.SetCapacity(EU_MAX(newSize, (u32)queue->data.GetCapacity() * 2));
+			queue->data.AddToElementCount(newSize - queue->data.Size());
+
+			new (&queue->data[offset]) C(std::forward<Args>(args)...);
+			command.dataOffset = offset;
+			queue->commands.Push(command);
+		}
+
+		friend class ECS;
+
+		//Swaps the recorded commands into the playback queues so commands recorded during playback go to the next flush
+		inline void BeginPlayback()
+		{
+			for (u32 i = 0; i < EU_JOB_SYSTEM_MAX_THREAD_INDICES; i++)
+			{
+				std::lock_guard<std::mutex> lock(m_Mutexes[i]);
+				ECSCommandQueue* recording = &m_Recording[i];
+				ECSCommandQueue* playback = &m_Playback[i];
+
+				playback->commands.Swap(recording->commands);
+				playback->data.Swap(recording->data);
+				playback->names.Swap(recording->names);
+				playback->createCommands.Swap(recording->createCommands);
+				playback->createdEntities.Clear();
+				for (u32 j = 0; j < playback->createCommands.Size(); j++)
+					playback->createdEntities.Push(EU_ECS_INVALID_ENTITY_ID);
+
+				recording->commands.Clear();
+				recording->data.Clear();
+				recording->names.Clear();
+				recording->createCommands.Clear();
+			}
+		}
+
+		//Playback moves or destroys every recorded component, the created entities stay until the next flush
+		inline void EndPlayback()
+		{
+			for (u32 i = 0; i < EU_JOB_SYSTEM_MAX_THREAD_INDICES; i++)
+			{
+				ECSCommandQueue* playback = &m_Playback[i];
+				playback->commands.Clear();
+				playback->data.Clear();
+				playback->names.Clear();
+				playback->createCommands.Clear();
+			}
+		}
+
+		inline void Reset()
+		{
+			for (u32 i = 0; i < EU_JOB_SYSTEM_MAX_THREAD_INDICES; i++)
+			{
+				std::lock_guard<std::mutex> lock(m_Mutexes[i]);
+				ClearQueue(&m_Recording[i]);
+				ClearQueue(&m_Playback[i]);
+			}
+		}
+
+		//Destroys the components of commands that were never played
+		inline void ClearQueue(ECSCommandQueue* queue)
+		{
+			for (u32 i = 0; i < queue->commands.Size(); i++)
+			{
+				ECSCommand* command = &queue->commands[i];
+				if (command->type == ECS_COMMAND_CREATE_COMPONENT && command->releaseComponent)
+				{
+					command->releaseComponent(0, &queue->data[command->dataOffset]);
+					command->releaseComponent = 0;
+				}
+			}
+
+			queue->commands.Clear();
+			queue->data.Clear();
+			queue->names.Clear();
+			queue->createCommands.Clear();
+			queue->createdEntities.Clear();
+		}
+	private:
+		std::mutex m_Mutexes[EU_JOB_SYSTEM_MAX_THREAD_INDICES];
+		ECSCommandQueue m_Recording[EU_JOB_SYSTEM_MAX_THREAD_INDICES];
+		ECSCommandQueue m_Playback[EU_JOB_SYSTEM_MAX_THREAD_INDICES];
+	};
+
+}
@@ -0,0 +1,273 @@
+#pragma once
+
+#include "../Common.h"
+#include "../Metadata/MetadataInfo.h"
+#include <atomic>
+#include <mutex>
+#include <cstdlib>
+
+#define EU_ECS_MAX_EVENT_TYPES 512
+#define EU_ECS_EVENT_QUEUE_INITIAL_CAPACITY 256
+#define EU_ECS_EVENT_OVERFLOW_BLOCK_SIZE 64
+
+namespace Eunoia {
+
+	//Events that did not fit the ring this frame, blocks never move until the next frame
+	struct ECSEventOverflowBlock
+	{
+		ECSEventOverflowBlock* next;
+		u8* events;
+		std::atomic<u32> published[EU_ECS_EVENT_OVERFLOW_BLOCK_SIZE];
+	};
+
+	//Where to construct a reserved event and the flag that publishes it
+	struct ECSEventSlot
+	{
+		u8* memory;
+		std::atomic<u32>* published;
+		u32 publishedValue;
+	};
+
+	/*
+		All events of one type dispatched this frame, stored contiguously in a power of two ring of fixed size slots.
+		Producers reserve a slot with a CAS on the write index and publish it once constructed so any number of
+		threads can dispatch at the same time without locks. Once the ring is full for this frame the extra events go
+		to overflow blocks behind a lock, nothing is dropped, and the ring grows to fit them at the start of the next frame.
+		The pending event is the old single slot that stays active until it is reset, it is main thread only
+	*/
+	struct ECSEventQueue
+	{
+		ECSEventQueue(mem_size eventSize) :
+			eventSize(eventSize),
+			capacity(0),
+			memory(0),
+			published(0),
+			begin(0),
+			write(0),
+			overflowHead(0),
+			overflowTail(0),
+			overflowCount(0),
+			pendingActive(false),
+			resetPendingNextFrame(false)
+		{
+			pending = (u8*)malloc(eventSize);
+			Allocate(EU_ECS_EVENT_QUEUE_INITIAL_CAPACITY);
+		}
+
+		~ECSEventQueue()
+		{
+			FreeOverflow();
+			free(memory);
+			free(pending);
+			delete[] published;
+		}
+
+		//Returns where to construct the event, the event is only visible to readers once it is published
+		inline ECSEventSlot Reserve()
+		{
+			ECSEventSlot slot;
+			u32 w = write.load(std::memory_order_relaxed);
+			do
+			{
+				if (w - begin >= capacity)
+					return ReserveOverflow();
+			} while (!write.compare_exchange_weak(w, w + 1, std::memory_order_acq_rel, std::memory_order_relaxed));
+
+			slot.memory = GetEvent(w);
+			slot.published = &published[w & (capacity - 1)];
+			slot.publishedValue = w + 1;
+			return slot;
+		}
+
+		inline static void Publish(const ECSEventSlot& slot)
+		{
+			slot.published->store(slot.publishedValue, std::memory_order_release);
+		}
+
+		inline b32 IsPublished(u32 index) const
+		{
+			return published[index & (capacity - 1)].load(std::memory_order_acquire) == index + 1;
+		}
+
+		inline u8* GetEvent(u32 index) const
+		{
+			return memory + (index & (capacity - 1)) * eventSize;
+		}
+
+		inline u32 GetEnd() const { return write.load(std::memory_order_acquire); }
+
+		inline u32 GetOverflowEnd() const { return overflowCount.load(std::memory_order_acquire); }
+
+		//Walks the blocks, only used to find the last event so the overflow is expected to be short
+		inline const ECSEventOverflowBlock* GetOverflowBlock(u32 index) const
+		{
+			const ECSEventOverflowBlock* block = overflowHead;
+			for (u32 i = 0; i < index / EU_ECS_EVENT_OVERFLOW_BLOCK_SIZE; i++)
+				block = block->next;
+			return block;
+		}
+
+		inline ECSEventSlot ReserveOverflow()
+		{
+			std::lock_guard<std::mutex> lock(overflowMutex);
+
+			u32 index = overflowCount.load(std::memory_order_relaxed);
+			u32 blockIndex = index % EU_ECS_EVENT_OVERFLOW_BLOCK_SIZE;
+			if (blockIndex == 0)
+			{
+				ECSEventOverflowBlock* block = new ECSEventOverflowBlock();
+				block->next = 0;
+				block->events = (u8*)malloc(eventSize * EU_ECS_EVENT_OVERFLOW_BLOCK_SIZE);
+				for (u32 i = 0; i < EU_ECS_EVENT_OVERFLOW_BLOCK_SIZE; i++)
+					block->published[i].store(0, std::memory_order_relaxed);
+
+				if (overflowTail)
+					overflowTail->next = block;
+				else
+					overflowHead = block;
+				overflowTail = block;
+			}
+
+			//Readers only follow the blocks up to the count they loaded, so the block has to be linked first
+			overflowCount.store(index + 1, std::memory_order_release);
+
+			ECSEventSlot slot;
+			slot.memory = overflowTail->events + blockIndex * eventSize;
+			slot.published = &overflowTail->published[blockIndex];
+			slot.publishedValue = 1;
+			return slot;
+		}
+
+		inline void FreeOverflow()
+		{
+			ECSEventOverflowBlock* block = overflowHead;
+			while (block)
+			{
+				ECSEventOverflowBlock* next = block->next;
+				free(block->events);
+				delete block;
+				block = next;
+			}
+
+			overflowHead = 0;
+			overflowTail = 0;
+			overflowCount.store(0, std::memory_order_relaxed);
+		}
+
+		//Drops last frame's events, must not run while anything is dispatching
+		inline void BeginFrame()
+		{
+			u32 numOverflowed = overflowCount.load();
+			if (numOverflowed > 0)
+			{
+				u32 newCapacity = capacity * 2;
+				while (newCapacity < capacity + numOverflowed)
+					newCapacity *= 2;
+				Allocate(newCapacity);
+				FreeOverflow();
+			}
+
+			begin = write.load();
+
+			if (resetPendingNextFrame)
+			{
+				pendingActive = false;
+				resetPendingNextFrame = false;
+			}
+		}
+
+		//Drops this frame's events and the pending event, must not run while anything is dispatching
+		inline void Clear()
+		{
+			BeginFrame();
+			pendingActive = false;
+			resetPendingNextFrame = false;
+		}
+
+		inline void Allocate(u32 newCapacity)
+		{
+			free(memory);
+			delete[] published;
+
+			capacity = newCapacity;
+			memory = (u8*)malloc(eventSize * capacity);
+			published = new std::atomic<u32>[capacity];
+			for (u32 i = 0; i < capacity; i++)
+				published[i].store(0, std::memory_order_relaxed);
+
+			begin = 0;
+			write = 0;
+		}
+
+		mem_size eventSize;
+		u32 capacity;
+		u8* memory;
+		std::atomic<u32>* published;
+		u32 begin;
+		std::atomic<u32> write;
+
+		std::mutex overflowMutex;
+		ECSEventOverflowBlock* overflowHead;
+		ECSEventOverflowBlock* overflowTail;
+		std::atomic<u32> overflowCount;
+
+		u8* pending;
+		b32 pendingActive;
+		b32 resetPendingNextFrame;
+	};
+
+	/*
+		Iterates the events of one type dispatched this frame in dispatch order, the ring first and then the overflow
+		for (const MyEvent* e = events.Next(); e; e = events.Next())
+	*/
+	template<class E>
+	class ECSEventRange
+	{
+	public:
+		ECSEventRange(const ECSEventQueue* queue) :
+			m_Queue(queue),
+			m_Index(queue ? queue->begin : 0),
+			m_End(queue ? queue->GetEnd() : 0),
+			m_OverflowBlock(0),
+			m_OverflowIndex(0),
+			m_OverflowEnd(queue ? queue->GetOverflowEnd() : 0)
+		{
+			//The blocks covered by the count were linked before it was stored
+			if (m_OverflowEnd > 0)
+				m_OverflowBlock = queue->overflowHead;
+		}
+
+		inline const E* Next()
+		{
+			while (m_Index != m_End)
+			{
+				u32 index = m_Index++;
+				if (m_Queue->IsPublished(index))
+					return (const E*)m_Queue->GetEvent(index);
+			}
+
+			while (m_OverflowIndex != m_OverflowEnd)
+			{
+				u32 index = m_OverflowIndex++;
+				u32 blockIndex = index % EU_ECS_EVENT_OVERFLOW_BLOCK_SIZE;
+				if (blockIndex == 0 && index > 0)
+					m_OverflowBlock = m_OverflowBlock->next;
+
+				if (m_OverflowBlock->published[blockIndex].load(std::memory_order_acquire))
+					return (const E*)(m_OverflowBlock->events + blockIndex * m_Queue->eventSize);
+			}
+
+			return 0;
+		}
+
+		inline b32 Empty() const { return m_Index == m_End && m_OverflowIndex == m_OverflowEnd; }
+	private:
+		const ECSEventQueue* m_Queue;
+		u32 m_Index;
+		u32 m_End;
+		const ECSEventOverflowBlock* m_OverflowBlock;
+		u32 m_OverflowIndex;
+		u32 m_OverflowEnd;
+	};
+
+}
@@ -3,6 +3,8 @@
 #include <cstdio>
 #include "../Rendering/Asset/AssetManager.h"
 #include "../Rendering/Asset/MaterialLoader.h"
+#include "../Rendering/Asset/ModelLoader.h"
+#include "../Rendering/Asset/TextureLoader.h"
 #include "../Physics/RigidBody.h"
 
 namespace Eunoia {
@@ -143,6 +145,160 @@ namespace Eunoia {
 		}
 	}
 
+	struct ECSLoaderPreparedTexture
+	{
+		String path;
+		u8* pixels;
+		u32 width;
+		u32 height;
+	};
+
+	struct ECSLoaderPreparedModel
+	{
+		LoadedModel model;
+		EumdlLoadError error;
+	};
+
+	//Materials are loaded with their textures decoded so creating them on the main thread only uploads
+	struct ECSLoaderPreparedMaterial
+	{
+		LoadedMaterialFile materialFile;
+		EumtlLoadError error;
+		List<ECSLoaderPreparedTexture> textures;
+	};
+
+	static String ReadSafeString(const List<u8>& safeRuntimeData, mem_size offset)
+	{
+		u32 length;
+		memcpy(&length, &safeRuntimeData[offset], sizeof(u32));
+		String string = String(length);
+		memcpy(string.GetChars(), &safeRuntimeData[offset + sizeof(u32)], length);
+		return string;
+	}
+
+	static void* PrepareTextureMember(const List<u8>& safeRuntimeData)
+	{
+		ECSLoaderPreparedTexture* texture = new ECSLoaderPreparedTexture();
+		texture->path = ReadSafeString(safeRuntimeData, 0);
+		texture->pixels = TextureLoader::LoadEutexTexture(texture->path, &texture->width, &texture->height);
+		return texture;
+	}
+
+	static void ReadPreparedTextureMember(void* unsafeRuntimeData, void* preparedData)
+	{
+		const ECSLoaderPreparedTexture* texture = (const ECSLoaderPreparedTexture*)preparedData;
+		TextureID tid = AssetManager::CreateTexture(texture->path, texture->pixels, texture->width, texture->height);
+		memcpy(unsafeRuntimeData, &tid, sizeof(TextureID));
+	}
+
+	static void FreePreparedTextureMember(void* preparedData)
+	{
+		ECSLoaderPreparedTexture* texture = (ECSLoaderPreparedTexture*)preparedData;
+		if (texture->pixels)
+			TextureLoader::FreeEutexTexture(texture->pixels);
+		delete texture;
+	}
+
+	static void* PrepareModelMember(const List<u8>& safeRuntimeData)
+	{
+		ECSLoaderPreparedModel* model = new ECSLoaderPreparedModel();
+		model->error = ModelLoader::LoadEumdlModel(ReadSafeString(safeRuntimeData, 0), &model->model);
+		return model;
+	}
+
+	static void ReadPreparedModelMember(void* unsafeRuntimeData, void* preparedData)
+	{
+		const ECSLoaderPreparedModel* model = (const ECSLoaderPreparedModel*)preparedData;
+		ModelID mid = EU_INVALID_MODEL_ID;
+		if (model->error == EUMDL_LOAD_SUCCESS)
+			mid = AssetManager::CreateModel(model->model.path, model->model);
+		memcpy(unsafeRuntimeData, &mid, sizeof(ModelID));
+	}
+
+	static void FreePreparedModelMember(void* preparedData)
+	{
+		delete (ECSLoaderPreparedModel*)preparedData;
+	}
+
+	//Used for materials and material modifiers, both are stored as a name or a path to a eumtl file
+	static void* PrepareMaterialMember(const List<u8>& safeRuntimeData)
+	{
+		b32 isPath;
+		memcpy(&isPath, &safeRuntimeData[0], sizeof(b32));
+		if (!isPath)
+			return 0;
+
+		ECSLoaderPreparedMaterial* material = new ECSLoaderPreparedMaterial();
+		material->error = MaterialLoader::LoadEumtlMaterial(ReadSafeString(safeRuntimeData, sizeof(b32)), &material->materialFile);
+		if (material->error != EUMTL_LOAD_SUCCESS)
+			return material;
+
+		const List<LoadedMaterial>& materials = material->materialFile.materials;
+		for (u32 i = 0; i < materials.Size(); i++)
+		{
+			for (u32 j = 0; j < NUM_MATERIAL_TEXTURE_TYPES; j++)
+			{
+				const String& texturePath = materials[i].texturePaths[(MaterialTextureType)j];
+				if (texturePath.Empty())
+					continue;
+
+				b32 decoded = false;
+				for (u32 k = 0; k < material->textures.Size() && !decoded; k++)
+					decoded = material->textures[k].path == texturePath;
+				if (decoded)
+					continue;
+
+				ECSLoaderPreparedTexture texture;
+				texture.path = texturePath;
+				texture.pixels = TextureLoader::LoadEutexTexture(texturePath, &texture.width, &texture.height);
+				material->textures.Push(texture);
+			}
+		}
+
+		return material;
+	}
+
+	static b32 CreatePreparedMaterials(const ECSLoaderPreparedMaterial* material, MaterialID* mid, MaterialModifierID* mmid)
+	{
+		if (material->error != EUMTL_LOAD_SUCCESS)
+			return false;
+
+		//The material textures are looked up by path when the materials are created, the decoded ones are found instead of loaded again
+		for (u32 i = 0; i < material->textures.Size(); i++)
+		{
+			const ECSLoaderPreparedTexture& texture = material->textures[i];
+			if (texture.pixels)
+				AssetManager::CreateTexture(texture.path, texture.pixels, texture.width, texture.height);
+		}
+
+		AssetManager::CreateMaterials(material->materialFile, EU_SAMPLER_LINEAR_REPEAT_AF, mid, mmid);
+		return true;
+	}
+
+	static void ReadPreparedMaterialMember(void* unsafeRuntimeData, void* preparedData)
+	{
+		MaterialID mid = EU_INVALID_MATERIAL_ID;
+		CreatePreparedMaterials((const ECSLoaderPreparedMaterial*)preparedData, &mid, 0);
+		memcpy(unsafeRuntimeData, &mid, sizeof(MaterialID));
+	}
+
+	static void ReadPreparedMaterialModifierMember(void* unsafeRuntimeData, void* preparedData)
+	{
+		MaterialID mid;
+		MaterialModifierID mmid = EU_INVALID_MATERIAL_MODIFIER_ID;
+		CreatePreparedMaterials((const ECSLoaderPreparedMaterial*)preparedData, &mid, &mmid);
+		memcpy(unsafeRuntimeData, &mmid, sizeof(MaterialModifierID));
+	}
+
+	static void FreePreparedMaterialMember(void* preparedData)
+	{
+		ECSLoaderPreparedMaterial* material = (ECSLoaderPreparedMaterial*)preparedData;
+		for (u32 i = 0; i < material->textures.Size(); i++)
+			if (material->textures[i].pixels)
+				TextureLoader::FreeEutexTexture(material->textures[i].pixels);
+		delete material;
+	}
+
 	static void WriteRigidBodyMember(List<u8>* safeRuntimeData, const void* unsafeRuntimeData)
 	{
 		RigidBody* rb = (RigidBody*)unsafeRuntimeData;
@@ -182,6 +338,18 @@ namespace Eunoia {
 		rb->CreateRigidBodyFromInfo(info);
 	}
 
+	static void DeferUnsafeMember(ECSLoadedScene* loadedScene, u32 entity, u32 component, u32 offset, u32 handler, const List<u8>& safeData)
+	{
+		ECSLoadedUnsafeMember member;
+		member.entity = entity;
+		member.component = component;
+		member.offset = offset;
+		member.handler = handler;
+		member.safeData = safeData;
+		member.preparedData = 0;
+		loadedScene->unsafeMembers.Push(member);
+	}
+
 	void ECSLoader::Init()
 	{
 		ECSLoaderUnsafeRuntimeMember unsafeMember;
@@ -189,30 +357,47 @@ namespace Eunoia {
 		unsafeMember.typeName = "TextureID";
 		unsafeMember.WriteUnsafeMember = WriteTextureMember;
 		unsafeMember.ReadUnsafeMember = ReadTextureMember;
+		unsafeMember.PrepareUnsafeMember = PrepareTextureMember;
+		unsafeMember.ReadPreparedUnsafeMember = ReadPreparedTextureMember;
+		unsafeMember.FreePreparedUnsafeMember = FreePreparedTextureMember;
 		AddUnsafeRuntimeMember(unsafeMember);
 
 		unsafeMember.typeName = "ModelID";
 		unsafeMember.WriteUnsafeMember = WriteModelMember;
 		unsafeMember.ReadUnsafeMember = ReadModelMember;
+		unsafeMember.PrepareUnsafeMember = PrepareModelMember;
+		unsafeMember.ReadPreparedUnsafeMember = ReadPreparedModelMember;
+		unsafeMember.FreePreparedUnsafeMember = FreePreparedModelMember;
 		AddUnsafeRuntimeMember(unsafeMember);
 
 		unsafeMember.typeName = "MaterialID";
 		unsafeMember.WriteUnsafeMember = WriteMaterialMember;
 		unsafeMember.ReadUnsafeMember = ReadMaterialMember;
+		unsafeMember.PrepareUnsafeMember = PrepareMaterialMember;
+		unsafeMember.ReadPreparedUnsafeMember = ReadPreparedMaterialMember;
+		unsafeMember.FreePreparedUnsafeMember = FreePreparedMaterialMember;
 		AddUnsafeRuntimeMember(unsafeMember);
 
 		unsafeMember.typeName = "MaterialModifierID";
 		unsafeMember.WriteUnsafeMember = WriteMaterialModifierMember;
 		unsafeMember.ReadUnsafeMember = ReadMaterialModifierMember;
+		unsafeMember.PrepareUnsafeMember = PrepareMaterialMember;
+		unsafeMember.ReadPreparedUnsafeMember = ReadPreparedMaterialModifierMember;
+		unsafeMember.FreePreparedUnsafeMember = FreePreparedMaterialMember;
 		AddUnsafeRuntimeMember(unsafeMember);
 
+		//Rigid bodies are created in the physics world, there is nothing to do off the main thread
 		unsafeMember.typeName = "RigidBody";
 		unsafeMember.WriteUnsafeMember = WriteRigidBodyMember;
 		unsafeMember.ReadUnsafeMember = ReadRigidBodyMember;
+		unsafeMember.PrepareUnsafeMember = 0;
+		unsafeMember.ReadPreparedUnsafeMember = 0;
+		unsafeMember.FreePreparedUnsafeMember = 0;
+		unsafeMember.ownsRuntimeObjects = true;
 		AddUnsafeRuntimeMember(unsafeMember);
 	}
 
-	ECSLoadError ECSLoader::LoadECSSceneFromFile(ECSLoadedScene* loadedScene, const String& path)
+	ECSLoadError ECSLoader::LoadECSSceneFromFile(ECSLoadedScene* loadedScene, const String& path, b32 deferUnsafeMembers)
 	{
 		FILE* file = fopen(path.C_Str(), "rb");
 		if (!file)
@@ -224,12 +409,12 @@ namespace Eunoia {
 
 		List<u8> memory(fileSize, fileSize);
 		fread(&memory[0], 1, fileSize, file);
-		ECSLoadError error = LoadECSSceneFromMemory(loadedScene, memory);
+		ECSLoadError error = LoadECSSceneFromMemory(loadedScene, memory, deferUnsafeMembers);
 		fclose(file);
 		return error;
 	}
 
-	ECSLoadError ECSLoader::LoadECSSceneFromMemory(ECSLoadedScene* loadedScene, const List<u8>& memory)
+	ECSLoadError ECSLoader::LoadECSSceneFromMemory(ECSLoadedScene* loadedScene, const List<u8>& memory, b32 deferUnsafeMembers)
 	{
 		const List<u8>& buffer = memory;
 		mem_size offset = 0;
@@ -258,6 +443,7 @@ namespace Eunoia {
 		ReadBuffer(sceneName.GetChars(), buffer, &offset, length);
 		loadedScene->name = sceneName;
 
+		loadedScene->unsafeMembers.Clear();
 		loadedScene->entities.SetCapacityAndElementCount(metadata.numEntities);
 		loadedScene->systems.SetCapacityAndElementCount(metadata.numSystems);
 
@@ -305,7 +491,11 @@ namespace Eunoia {
 							ReadBuffer(&safeDataSize, buffer, &offset, sizeof(u32));
 							List<u8> safeData(safeDataSize, safeDataSize);
 							ReadBuffer(&safeData[0], buffer, &offset, safeDataSize);
-							unsafeMember.ReadUnsafeMember((void*)&loadedComponent->data[componentMember.offset - componentMetadata->baseClassSize], safeData);
+							u32 dataOffset = (u32)(componentMember.offset - componentMetadata->baseClassSize);
+							if (deferUnsafeMembers)
+								DeferUnsafeMember(loadedScene, i, j, dataOffset, l, safeData);
+							else
+								unsafeMember.ReadUnsafeMember((void*)&loadedComponent->data[dataOffset], safeData);
 							readUnsafeMember = true;
 							break;
 						}
@@ -342,7 +532,11 @@ namespace Eunoia {
 						ReadBuffer(&safeDataSize, buffer, &offset, sizeof(u32));
 						List<u8> safeData(safeDataSize, safeDataSize);
 						ReadBuffer(&safeData[0], buffer, &offset, safeDataSize);
-						unsafeMember.ReadUnsafeMember((void*)&loadedSystem->data[systemMember.offset - systemMetadata->baseClassSize], safeData);
+						u32 dataOffset = (u32)(systemMember.offset - systemMetadata->baseClassSize);
+						if (deferUnsafeMembers)
+							DeferUnsafeMember(loadedScene, EU_ECS_LOADED_SYSTEM_MEMBER, i, dataOffset, k, safeData);
+						else
+							unsafeMember.ReadUnsafeMember((void*)&loadedSystem->data[dataOffset], safeData);
 						readUnsafeMember = true;
 						break;
 					}
@@ -364,11 +558,24 @@ namespace Eunoia {
 		return ECS_LOAD_ERROR_NONE;
 	}
 
+	void* ECSLoader::GetLoadedUnsafeMemberData(ECSLoadedScene* loadedScene, const ECSLoadedUnsafeMember& member)
+	{
+		if (member.entity == EU_ECS_LOADED_SYSTEM_MEMBER)
+			return &loadedScene->systems[member.component].data[member.offset];
+
+		return &loadedScene->entities[member.entity].components[member.component].data[member.offset];
+	}
+
 	void ECSLoader::AddUnsafeRuntimeMember(const ECSLoaderUnsafeRuntimeMember& member)
 	{
 		s_Data.unsafeMembers.Push(member);
 	}
 
+	const List<ECSLoaderUnsafeRuntimeMember>& ECSLoader::GetUnsafeRuntimeMembers()
+	{
+		return s_Data.unsafeMembers;
+	}
+
 	void ECSLoader::WriteLoadedSceneToFile(const ECSLoadedScene& loadedScene, const String& path)
 	{
 		FILE* file = fopen(path.C_Str(), "wb");
@@ -4,6 +4,8 @@
 #include "../DataStructures/String.h"
 #include "../Metadata/MetadataInfo.h"
 
+#define EU_ECS_LOADED_SYSTEM_MEMBER EU_U32_MAX
+
 namespace Eunoia {
 
 	struct ECSLoadedSystem
@@ -28,21 +30,60 @@ namespace Eunoia {
 		u32 numChildren;
 	};
 
+	//An unsafe runtime member whose handler was not run while loading, see ECSLoader::LoadECSSceneFromMemory
+	struct ECSLoadedUnsafeMember
+	{
+		//Index into ECSLoadedScene::entities, EU_ECS_LOADED_SYSTEM_MEMBER for system members
+		u32 entity;
+		//Index into the entities components or into ECSLoadedScene::systems
+		u32 component;
+		//Offset into the loaded component or system data
+		u32 offset;
+		//Index into ECSLoader::GetUnsafeRuntimeMembers
+		u32 handler;
+		List<u8> safeData;
+		//Whatever the handlers PrepareUnsafeMember returned, can be shared by members with the same safe data
+		void* preparedData;
+	};
+
 	struct ECSLoadedScene
 	{
 		String name;
 		List<ECSLoadedEntity> entities;
 		List<ECSLoadedSystem> systems;
+		List<ECSLoadedUnsafeMember> unsafeMembers;
 	};
 
 	typedef void (*WriteUnsafeRuntimeMemberFunction)(List<u8>* safeRuntimeData, const void* unsafeRuntimeData);
 	typedef void (*ReadUnsafeRuntimeMemberFunction)(void* unsafeRuntimeData, const List<u8>& safeRuntimeData);
+	typedef void* (*PrepareUnsafeRuntimeMemberFunction)(const List<u8>& safeRuntimeData);
+	typedef void (*ReadPreparedUnsafeRuntimeMemberFunction)(void* unsafeRuntimeData, void* preparedData);
+	typedef void (*FreePreparedUnsafeRuntimeMemberFunction)(void* preparedData);
 
 	struct ECSLoaderUnsafeRuntimeMember
 	{
+		ECSLoaderUnsafeRuntimeMember() :
+			ReadUnsafeMember(0),
+			WriteUnsafeMember(0),
+			PrepareUnsafeMember(0),
+			ReadPreparedUnsafeMember(0),
+			FreePreparedUnsafeMember(0),
+			ownsRuntimeObjects(false)
+		{}
+
 		String typeName;
 		ReadUnsafeRuntimeMemberFunction ReadUnsafeMember;
 		WriteUnsafeRuntimeMemberFunction WriteUnsafeMember;
+		/*
+			Optional split of ReadUnsafeMember for streaming. Prepare may run on any thread and does the file reading and decoding,
+			it must not touch the AssetManager or the render context. ReadPrepared runs on the main thread and only creates the
+			runtime objects. Prepare returning 0 falls back to ReadUnsafeMember
+		*/
+		PrepareUnsafeRuntimeMemberFunction PrepareUnsafeMember;
+		ReadPreparedUnsafeRuntimeMemberFunction ReadPreparedUnsafeMember;
+		FreePreparedUnsafeRuntimeMemberFunction FreePreparedUnsafeMember;
+		//Members that point at objects living outside the ECS, snapshots go through the handlers for these instead of copying the pointers
+		b32 ownsRuntimeObjects;
 	};
 
 	enum ECSLoadError
@@ -58,9 +99,13 @@ namespace Eunoia {
 	{
 	public:
 		static void Init();
-		static ECSLoadError LoadECSSceneFromFile(ECSLoadedScene* loadedScene, const String& path);
-		static ECSLoadError LoadECSSceneFromMemory(ECSLoadedScene* loadedScene, const List<u8>& memory);
+		//Deferred unsafe members are not read, they are added to ECSLoadedScene::unsafeMembers instead. Safe to call off the main thread when deferring
+		static ECSLoadError LoadECSSceneFromFile(ECSLoadedScene* loadedScene, const String& path, b32 deferUnsafeMembers = false);
+		static ECSLoadError LoadECSSceneFromMemory(ECSLoadedScene* loadedScene, const List<u8>& memory, b32 deferUnsafeMembers = false);
+		//Where a deferred unsafe member has to be read to
+		static void* GetLoadedUnsafeMemberData(ECSLoadedScene* loadedScene, const ECSLoadedUnsafeMember& member);
 		static void AddUnsafeRuntimeMember(const ECSLoaderUnsafeRuntimeMember& member);
+		static const List<ECSLoaderUnsafeRuntimeMember>& GetUnsafeRuntimeMembers();
 
 		static void WriteLoadedSceneToFile(const ECSLoadedScene& loadedScene, const String& path);
 	private:
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "../Common.h"
+#include "../DataStructures/List.h"
+#include "ECSTypes.h"
+#include <unordered_map>
+
+#define EU_ECS_NAME_HASH_SEED 14695981039346656037ull
+
+namespace Eunoia {
+
+	typedef u64 ECSNameHash;
+
+	//FNV-1a, pass a previous hash to continue hashing as if the strings were concatenated
+	inline ECSNameHash ECSHashName(const char* name, ECSNameHash hash = EU_ECS_NAME_HASH_SEED)
+	{
+		for (const char* c = name; *c; c++)
+		{
+			hash ^= (u8)*c;
+			hash *= 1099511628211ull;
+		}
+
+		return hash;
+	}
+
+	inline u64 ECSChildNameKey(EntityID parent, ECSNameHash nameHash)
+	{
+		return nameHash ^ ((u64)parent * 0x9E3779B97F4A7C15ull);
+	}
+
+	/*
+		Buckets of entities keyed by a name hash (or a parent and name hash for the per parent index).
+		Different names can share a key so callers still compare the actual names of the candidates
+	*/
+	struct ECSEntityNameIndex
+	{
+		inline void Add(u64 key, EntityID entity)
+		{
+			buckets[key].Push(entity);
+		}
+
+		inline void Remove(u64 key, EntityID entity)
+		{
+			auto it = buckets.find(key);
+			if (it == buckets.end())
+				return;
+
+			List<EntityID>& bucket = it->second;
+			for (u32 i = 0; i < bucket.Size(); i++)
+			{
+				if (bucket[i] == entity)
+				{
+					bucket.Remove(i);
+					break;
+				}
+			}
+
+			if (bucket.Empty())
+				buckets.erase(it);
+		}
+
+		inline const List<EntityID>* Find(u64 key) const
+		{
+			auto it = buckets.find(key);
+			return it == buckets.end() ? 0 : &it->second;
+		}
+
+		inline void Clear()
+		{
+			buckets.clear();
+		}
+
+		std::unordered_map<u64, List<EntityID>> buckets;
+	};
+
+}
@@ -0,0 +1,128 @@
+#pragma once
+
+#include "../Common.h"
+#include "../Metadata/Metadata.h"
+#include "../DataStructures/List.h"
+#include "../DataStructures/String.h"
+#include "ECSTypes.h"
+#include "ECSNameIndex.h"
+
+#define EU_ECS_PREFAB_NO_PARENT EU_U32_MAX
+
+namespace Eunoia {
+
+	struct ECSPrefabEntity
+	{
+		String name;
+		ECSNameHash nameHash;
+		b32 enabled;
+		//Index of the parent in ECSPrefab::entities, EU_ECS_PREFAB_NO_PARENT for the captured root
+		u32 parentIndex;
+		u32 firstComponent;
+		u32 numComponents;
+	};
+
+	struct ECSPrefabComponent
+	{
+		metadata_typeid typeID;
+		//Offset of the component copy in ECSPrefab::data
+		u32 dataOffset;
+		u32 size;
+		u32 firstRuntimeMember;
+		u32 numRuntimeMembers;
+	};
+
+	//A member that owns runtime objects, like a rigid body. The prefab keeps its ECSLoader safe data and every instance builds its own objects from it
+	struct ECSPrefabRuntimeMember
+	{
+		u32 offset;
+		u32 handler;
+		List<u8> safeData;
+	};
+
+	//An EntityID member inside the component data that pointed at an entity of the captured subtree
+	struct ECSPrefabEntityField
+	{
+		u32 component;
+		u32 offset;
+		u32 targetEntity;
+	};
+
+	/*
+		A captured entity subtree. Entities are stored parents first and the prefab owns a copy constructed copy of every component,
+		vtable included, so a prefab is only valid in the process that captured it. Use ECSLoadedScene to save entities to disk
+	*/
+	struct ECSPrefab
+	{
+		ECSPrefab() {}
+		ECSPrefab(const ECSPrefab&) = delete;
+		ECSPrefab& operator=(const ECSPrefab&) = delete;
+
+		~ECSPrefab()
+		{
+			Clear();
+		}
+
+		inline void Clear()
+		{
+			for (u32 i = 0; i < components.Size(); i++)
+				Metadata::GetMetadata(components[i].typeID).cls->Destructor(&data[components[i].dataOffset]);
+
+			entities.Clear();
+			components.Clear();
+			runtimeMembers.Clear();
+			entityFields.Clear();
+			data.Clear();
+		}
+
+		//Makes room for size bytes aligned for any component and returns their offset
+		inline u32 AllocateData(u32 size)
+		{
+			u32 offset = (u32)EU_ALIGN_UP(data.Size(), EU_DEFAULT_ALIGNMENT);
+			u32 dataSize = offset + size;
+			if (dataSize > data.GetCapacity())
+				data.SetCapacity(EU_MAX(dataSize, (u32)data.GetCapacity() * 2));
+			data.AddToElementCount(dataSize - data.Size());
+			return offset;
+		}
+
+		inline u32 GetNumEntities() const { return entities.Size(); }
+
+		List<ECSPrefabEntity> entities;
+		List<ECSPrefabComponent> components;
+		List<ECSPrefabRuntimeMember> runtimeMembers;
+		List<ECSPrefabEntityField> entityFields;
+		List<u8> data;
+	};
+
+	//Appends the offsets of every reflected member of the given type, members that are reflected classes are searched too
+	inline void ECSCollectMemberOffsets(metadata_typeid typeID, const String& memberTypeName, u32 baseOffset, List<u32>* offsets)
+	{
+		const MetadataInfo& info = Metadata::GetMetadata(typeID);
+		if (info.type != METADATA_CLASS)
+			return;
+
+		for (u32 i = 0; i < info.cls->members.Size(); i++)
+		{
+			const MetadataMember& member = info.cls->members[i];
+			if (member.isStatic || member.isPointer)
+				continue;
+
+			//size is the size of one element for arrays
+			for (u32 j = 0; j < member.arrayLength; j++)
+			{
+				u32 offset = baseOffset + (u32)(member.offset + member.size * j);
+				if (member.typeName == memberTypeName)
+					offsets->Push(offset);
+				else if (Metadata::GetMetadata(member.typeID).type == METADATA_CLASS)
+					ECSCollectMemberOffsets(member.typeID, memberTypeName, offset, offsets);
+			}
+		}
+	}
+
+	inline void ECSCollectEntityIDFields(metadata_typeid typeID, u32 baseOffset, List<u32>* offsets)
+	{
+		ECSCollectMemberOffsets(typeID, "EntityID", baseOffset, offsets);
+	}
+
+}
@@ -0,0 +1,651 @@
+#include "ECSRecorder.h"
+#include "../Utils/Log.h"
+#include <chrono>
+
+namespace Eunoia {
+
+	ECSRecorder::ECSRecorder(mem_size memoryBudget) :
+		m_ECS(0),
+		m_LastVersion(0),
+		m_FullDiff(false),
+		m_Synced(false),
+		m_MemoryBudget(memoryBudget),
+		m_MemoryUsed(0),
+		m_NextFrame(0),
+		m_NumFrameRecords(0),
+		m_LastRecordTime(0.0)
+	{
+	}
+
+	void ECSRecorder::SetMemoryBudget(mem_size memoryBudget)
+	{
+		m_MemoryBudget = memoryBudget;
+		m_Ring.SetCapacityAndElementCount(0);
+		m_Frames.clear();
+		m_MemoryUsed = 0;
+	}
+
+	mem_size ECSRecorder::GetMemoryBudget() const
+	{
+		return m_MemoryBudget;
+	}
+
+	mem_size ECSRecorder::GetMemoryUsed() const
+	{
+		return m_MemoryUsed;
+	}
+
+	void ECSRecorder::SetFullDiff(b32 fullDiff)
+	{
+		m_FullDiff = fullDiff;
+	}
+
+	void ECSRecorder::RecordFrame(ECS* ecs, r32 dt)
+	{
+		auto start = std::chrono::high_resolution_clock::now();
+
+		if (ecs != m_ECS || !m_Synced)
+		{
+			Reset();
+			Sync(ecs);
+			m_LastRecordTime = std::chrono::duration<r64, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+			return;
+		}
+
+		List<ECSEntityContainer>& entities = ecs->GetAllEntities_();
+
+		m_Frame.Clear();
+		m_NumFrameRecords = 0;
+		AllocateFrameBytes(sizeof(ECSDeltaFrameHeader));
+
+		//The ECS only drops its entity table when it is reset, everything that was recorded past the end is gone
+		for (u32 i = entities.Size(); i < m_Entities.Size(); i++)
+			if (m_Entities[i].id != EU_ECS_INVALID_ENTITY_ID)
+				WriteDestroyedEntity(m_Entities[i]);
+
+		if (m_Entities.Size() != entities.Size())
+		{
+			if (m_Entities.GetCapacity() < entities.Size())
+				m_Entities.SetCapacity(EU_MAX(entities.Size(), (u32)m_Entities.GetCapacity() * 2));
+
+			for (u32 i = m_Entities.Size(); i < entities.Size(); i++)
+				m_Entities[i] = ECSRecorderEntity();
+
+			m_Entities.Clear();
+			m_Entities.AddToElementCount(entities.Size());
+		}
+
+		for (u32 i = 0; i < entities.Size(); i++)
+		{
+			const ECSEntityContainer& entity = entities[i];
+			ECSRecorderEntity* recorded = &m_Entities[i];
+
+			if (recorded->id != entity.id)
+			{
+				if (recorded->id != EU_ECS_INVALID_ENTITY_ID)
+					WriteDestroyedEntity(*recorded);
+
+				if (entity.id != EU_ECS_INVALID_ENTITY_ID)
+				{
+					ECSDeltaRecordHeader header;
+					header.type = ECS_DELTA_RECORD_ENTITY_CREATED;
+					header.typeID = 0;
+					header.entity = entity.id;
+					header.offset = 0;
+					header.size = 0;
+					WriteRecord(header, 0);
+				}
+
+				CaptureEntity(recorded, entity);
+				continue;
+			}
+
+			if (entity.id == EU_ECS_INVALID_ENTITY_ID)
+				continue;
+
+			recorded->parent = entity.parent;
+			recorded->enabled = entity.enabled;
+			if (recorded->nameHash != entity.nameHash)
+			{
+				recorded->name = entity.name;
+				recorded->nameHash = entity.nameHash;
+			}
+
+			if (!HaveSameComponents(*recorded, entity))
+			{
+				WriteChangedComponents(recorded, entity);
+				continue;
+			}
+
+			for (u32 j = 0; j < entity.components.Size(); j++)
+			{
+				const ECSComponent* component = entity.components[j].actualComponent;
+				if (!m_FullDiff && !EU_ECS_VERSION_NEWER(component->version, m_LastVersion))
+					continue;
+
+				WriteChangedMembers(entity.id, &recorded->components[j], (const u8*)component);
+			}
+		}
+
+		m_LastVersion = ecs->NextChangeVersion();
+
+		ECSDeltaFrameHeader* header = (ECSDeltaFrameHeader*)&m_Frame[0];
+		header->frame = m_NextFrame++;
+		header->dt = dt;
+		header->numRecords = m_NumFrameRecords;
+		header->size = m_Frame.Size();
+		PushFrame();
+
+		m_LastRecordTime = std::chrono::duration<r64, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+	}
+
+	void ECSRecorder::Reset()
+	{
+		m_ECS = 0;
+		m_Synced = false;
+		m_Frames.clear();
+		m_MemoryUsed = 0;
+		m_Entities.Clear();
+	}
+
+	u32 ECSRecorder::Rewind(ECS* ecs, u32 numFrames)
+	{
+		if (ecs != m_ECS || !m_Synced)
+			return 0;
+
+		//Entities that had to be created again get new IDs, older frames still refer to them by the old ones
+		std::unordered_map<EntityID, EntityID> remap;
+		List<u8> frame;
+		u32 numUndone = 0;
+		while (numUndone < numFrames && !m_Frames.empty())
+		{
+			PopFrame(&frame);
+			UndoFrame(ecs, frame, &remap);
+			numUndone++;
+		}
+
+		Sync(ecs);
+		return numUndone;
+	}
+
+	u32 ECSRecorder::GetNumFrames() const
+	{
+		return (u32)m_Frames.size();
+	}
+
+	r32 ECSRecorder::GetRecordedTime() const
+	{
+		r32 time = 0.0f;
+		for (u32 i = 0; i < m_Frames.size(); i++)
+			time += m_Frames[i].dt;
+		return time;
+	}
+
+	r64 ECSRecorder::GetLastRecordTime() const
+	{
+		return m_LastRecordTime;
+	}
+
+	const List<ECSRecorderMemberRange>& ECSRecorder::GetMemberRanges(metadata_typeid typeID)
+	{
+		auto it = m_MemberRanges.find(typeID);
+		if (it != m_MemberRanges.end())
+			return it->second;
+
+		List<ECSRecorderMemberRange>& ranges = m_MemberRanges[typeID];
+		CollectMemberRanges(typeID, 0, &ranges);
+
+		//Base class members come first but the order inside a class is the declaration order, diffing wants offsets ascending
+		for (u32 i = 1; i < ranges.Size(); i++)
+		{
+			ECSRecorderMemberRange key = ranges[i];
+			s32 j = i - 1;
+			while (j >= 0 && ranges[j].offset > key.offset)
+			{
+				ranges[j + 1] = ranges[j];
+				j--;
+			}
+			ranges[j + 1] = key;
+		}
+
+		return ranges;
+	}
+
+	void ECSRecorder::CollectMemberRanges(metadata_typeid typeID, u32 baseOffset, List<ECSRecorderMemberRange>* ranges)
+	{
+		const MetadataInfo& info = Metadata::GetMetadata(typeID);
+		if (info.type != METADATA_CLASS)
+			return;
+
+		if (!info.cls->baseClassName.Empty())
+			CollectMemberRanges(Metadata::GetClassTypeID(info.cls->baseClassName), baseOffset, ranges);
+
+		const List<ECSLoaderUnsafeRuntimeMember>& unsafeMembers = ECSLoader::GetUnsafeRuntimeMembers();
+		for (u32 i = 0; i < info.cls->members.Size(); i++)
+		{
+			const MetadataMember& member = info.cls->members[i];
+			if (member.isStatic || member.isPointer || member.typeName == "String")
+				continue;
+
+			b32 ownsRuntimeObjects = false;
+			for (u32 j = 0; j < unsafeMembers.Size() && !ownsRuntimeObjects; j++)
+				ownsRuntimeObjects = unsafeMembers[j].ownsRuntimeObjects && member.typeName == unsafeMembers[j].typeName;
+			if (ownsRuntimeObjects)
+				continue;
+
+			for (u32 j = 0; j < member.arrayLength; j++)
+			{
+				u32 offset = baseOffset + (u32)(member.offset + member.size * j);
+				if (Metadata::GetMetadata(member.typeID).type == METADATA_CLASS)
+				{
+					CollectMemberRanges(member.typeID, offset, ranges);
+				}
+				else
+				{
+					ECSRecorderMemberRange range;
+					range.offset = offset;
+					range.size = (u32)member.size;
+					ranges->Push(range);
+				}
+			}
+		}
+	}
+
+	void ECSRecorder::CaptureEntity(ECSRecorderEntity* recorded, const ECSEntityContainer& entity)
+	{
+		recorded->id = entity.id;
+		recorded->parent = entity.parent;
+		recorded->enabled = entity.enabled;
+		recorded->name = entity.name;
+		recorded->nameHash = entity.nameHash;
+
+		//The component slots and their byte lists are reused so recapturing an entity doesn't allocate
+		u32 numComponents = entity.components.Size();
+		if (recorded->components.GetCapacity() < numComponents)
+			recorded->components.SetCapacity(numComponents);
+		recorded->components.Clear();
+		recorded->components.AddToElementCount(numComponents);
+
+		for (u32 i = 0; i < numComponents; i++)
+		{
+			const ECSComponentContainer& component = entity.components[i];
+			ECSRecorderComponent* recordedComponent = &recorded->components[i];
+			u32 size = (u32)Metadata::GetMetadata(component.typeID).cls->size;
+
+			recordedComponent->typeID = component.typeID;
+			if (recordedComponent->data.GetCapacity() < size)
+				recordedComponent->data.SetCapacity(size);
+			recordedComponent->data.Clear();
+			recordedComponent->data.AddToElementCount(size);
+			memcpy(&recordedComponent->data[0], component.actualComponent, size);
+		}
+	}
+
+	b32 ECSRecorder::HaveSameComponents(const ECSRecorderEntity& recorded, const ECSEntityContainer& entity) const
+	{
+		if (recorded.components.Size() != entity.components.Size())
+			return false;
+
+		for (u32 i = 0; i < entity.components.Size(); i++)
+			if (recorded.components[i].typeID != entity.components[i].typeID)
+				return false;
+
+		return true;
+	}
+
+	void ECSRecorder::WriteDestroyedEntity(const ECSRecorderEntity& recorded)
+	{
+		u32 nameLength = recorded.name.Length();
+		u32 size = sizeof(b32) + sizeof(u32) + nameLength;
+		for (u32 i = 0; i < recorded.components.Size(); i++)
+			size += sizeof(metadata_typeid) + sizeof(u32) + recorded.components[i].data.Size();
+
+		ECSDeltaRecordHeader header;
+		header.type = ECS_DELTA_RECORD_ENTITY_DESTROYED;
+		header.typeID = recorded.components.Size();
+		header.entity = recorded.id;
+		header.offset = recorded.parent;
+		header.size = size;
+		WriteRecord(header, 0);
+
+		u8* data = AllocateFrameBytes(size);
+		memcpy(data, &recorded.enabled, sizeof(b32));
+		data += sizeof(b32);
+		memcpy(data, &nameLength, sizeof(u32));
+		data += sizeof(u32);
+		memcpy(data, recorded.name.C_Str(), nameLength);
+		data += nameLength;
+
+		for (u32 i = 0; i < recorded.components.Size(); i++)
+		{
+			const ECSRecorderComponent& component = recorded.components[i];
+			u32 componentSize = component.data.Size();
+			memcpy(data, &component.typeID, sizeof(metadata_typeid));
+			data += sizeof(metadata_typeid);
+			memcpy(data, &componentSize, sizeof(u32));
+			data += sizeof(u32);
+			memcpy(data, &component.data[0], componentSize);
+			data += componentSize;
+		}
+	}
+
+	//Components that stayed are diffed by type since the indices moved, the shadow copies are captured again afterwards
+	void ECSRecorder::WriteChangedComponents(ECSRecorderEntity* recorded, const ECSEntityContainer& entity)
+	{
+		for (u32 i = 0; i < recorded->components.Size(); i++)
+		{
+			ECSRecorderComponent* recordedComponent = &recorded->components[i];
+
+			const ECSComponent* component = 0;
+			for (u32 j = 0; j < entity.components.Size() && !component; j++)
+				if (entity.components[j].typeID == recordedComponent->typeID)
+					component = entity.components[j].actualComponent;
+
+			if (component)
+			{
+				if (m_FullDiff || EU_ECS_VERSION_NEWER(component->version, m_LastVersion))
+					WriteChangedMembers(entity.id, recordedComponent, (const u8*)component);
+				continue;
+			}
+
+			ECSDeltaRecordHeader header;
+			header.type = ECS_DELTA_RECORD_COMPONENT_REMOVED;
+			header.typeID = recordedComponent->typeID;
+			header.entity = entity.id;
+			header.offset = 0;
+			header.size = recordedComponent->data.Size();
+			WriteRecord(header, &recordedComponent->data[0]);
+		}
+
+		for (u32 i = 0; i < entity.components.Size(); i++)
+		{
+			b32 recordedBefore = false;
+			for (u32 j = 0; j < recorded->components.Size() && !recordedBefore; j++)
+				recordedBefore = recorded->components[j].typeID == entity.components[i].typeID;
+			if (recordedBefore)
+				continue;
+
+			ECSDeltaRecordHeader header;
+			header.type = ECS_DELTA_RECORD_COMPONENT_ADDED;
+			header.typeID = entity.components[i].typeID;
+			header.entity = entity.id;
+			header.offset = 0;
+			header.size = 0;
+			WriteRecord(header, 0);
+		}
+
+		CaptureEntity(recorded, entity);
+	}
+
+	void ECSRecorder::WriteChangedMembers(EntityID entity, ECSRecorderComponent* recorded, const u8* component)
+	{
+		const List<ECSRecorderMemberRange>& ranges = GetMemberRanges(recorded->typeID);
+		u8* shadow = &recorded->data[0];
+
+		//Changed members that sit right next to each other go into one record
+		u32 runBegin = 0;
+		u32 runEnd = 0;
+		for (u32 i = 0; i <= ranges.Size(); i++)
+		{
+			b32 changed = false;
+			if (i < ranges.Size())
+			{
+				const ECSRecorderMemberRange& range = ranges[i];
+				changed = memcmp(shadow + range.offset, component + range.offset, range.size) != 0;
+				if (changed && runEnd != runBegin && range.offset == runEnd)
+				{
+					runEnd += range.size;
+					continue;
+				}
+			}
+
+			if (runEnd != runBegin)
+			{
+				ECSDeltaRecordHeader header;
+				header.type = ECS_DELTA_RECORD_MEMBERS;
+				header.typeID = recorded->typeID;
+				header.entity = entity;
+				header.offset = runBegin;
+				header.size = runEnd - runBegin;
+				WriteRecord(header, 0);
+
+				memcpy(AllocateFrameBytes(header.size), shadow + runBegin, header.size);
+				memcpy(shadow + runBegin, component + runBegin, header.size);
+			}
+
+			runBegin = runEnd = 0;
+			if (changed)
+			{
+				runBegin = ranges[i].offset;
+				runEnd = runBegin + ranges[i].size;
+			}
+		}
+	}
+
+	void ECSRecorder::WriteRecord(const ECSDeltaRecordHeader& header, const void* data)
+	{
+		memcpy(AllocateFrameBytes(sizeof(ECSDeltaRecordHeader)), &header, sizeof(ECSDeltaRecordHeader));
+		if (data && header.size)
+			memcpy(AllocateFrameBytes(header.size), data, header.size);
+		m_NumFrameRecords++;
+	}
+
+	u8* ECSRecorder::AllocateFrameBytes(u32 size)
+	{
+		u32 offset = m_Frame.Size();
+		u32 frameSize = offset + size;
+		if (frameSize > m_Frame.GetCapacity())
+			m_Frame.SetCapacity(EU_MAX(frameSize, (u32)m_Frame.GetCapacity() * 2));
+		m_Frame.AddToElementCount(size);
+		return &m_Frame[offset];
+	}
+
+	void ECSRecorder::PushFrame()
+	{
+		u32 size = m_Frame.Size();
+		if (size > m_MemoryBudget)
+		{
+			EU_LOG_WARN("An ECS frame delta did not fit into the recorder memory budget, the recorded frames were dropped");
+			m_Frames.clear();
+			m_MemoryUsed = 0;
+			return;
+		}
+
+		if (m_Ring.Size() != m_MemoryBudget)
+			m_Ring.SetCapacityAndElementCount((u32)m_MemoryBudget);
+
+		while (m_MemoryBudget - m_MemoryUsed < size)
+		{
+			m_MemoryUsed -= m_Frames.front().size;
+			m_Frames.pop_front();
+		}
+
+		ECSRecordedFrame frame;
+		frame.offset = m_Frames.empty() ? 0 : (u32)((m_Frames.front().offset + m_MemoryUsed) % m_MemoryBudget);
+		frame.size = size;
+		frame.dt = ((const ECSDeltaFrameHeader*)&m_Frame[0])->dt;
+
+		u32 firstPart = EU_MIN(size, (u32)(m_MemoryBudget - frame.offset));
+		memcpy(&m_Ring[frame.offset], &m_Frame[0], firstPart);
+		if (firstPart < size)
+			memcpy(&m_Ring[0], &m_Frame[firstPart], size - firstPart);
+
+		m_Frames.push_back(frame);
+		m_MemoryUsed += size;
+	}
+
+	void ECSRecorder::PopFrame(List<u8>* frame)
+	{
+		const ECSRecordedFrame& recordedFrame = m_Frames.back();
+		if (frame->GetCapacity() < recordedFrame.size)
+			frame->SetCapacity(recordedFrame.size);
+		frame->Clear();
+		frame->AddToElementCount(recordedFrame.size);
+		CopyFromRing(recordedFrame.offset, &(*frame)[0], recordedFrame.size);
+
+		m_MemoryUsed -= recordedFrame.size;
+		m_Frames.pop_back();
+	}
+
+	void ECSRecorder::CopyFromRing(u32 offset, void* dst, u32 size) const
+	{
+		u32 firstPart = EU_MIN(size, (u32)(m_MemoryBudget - offset));
+		memcpy(dst, &m_Ring[offset], firstPart);
+		if (firstPart < size)
+			memcpy((u8*)dst + firstPart, &m_Ring[0], size - firstPart);
+	}
+
+	void ECSRecorder::Sync(ECS* ecs)
+	{
+		m_ECS = ecs;
+
+		List<ECSEntityContainer>& entities = ecs->GetAllEntities_();
+		if (m_Entities.GetCapacity() < entities.Size())
+			m_Entities.SetCapacity(entities.Size());
+		m_Entities.Clear();
+		m_Entities.AddToElementCount(entities.Size());
+
+		for (u32 i = 0; i < entities.Size(); i++)
+			CaptureEntity(&m_Entities[i], entities[i]);
+
+		//Allocated up front so the first recorded frame doesn't pay for it
+		if (m_Ring.Size() != m_MemoryBudget)
+			m_Ring.SetCapacityAndElementCount((u32)m_MemoryBudget);
+
+		m_LastVersion = ecs->NextChangeVersion();
+		m_Synced = true;
+	}
+
+	static EntityID ResolveRecordedEntity(EntityID entity, const std::unordered_map<EntityID, EntityID>& remap)
+	{
+		auto it = remap.find(entity);
+		return it == remap.end() ? entity : it->second;
+	}
+
+	void ECSRecorder::UndoFrame(ECS* ecs, const List<u8>& frame, std::unordered_map<EntityID, EntityID>* remap)
+	{
+		const ECSDeltaFrameHeader* frameHeader = (const ECSDeltaFrameHeader*)&frame[0];
+
+		List<u32> records(EU_MAX(frameHeader->numRecords, 1));
+		for (u32 offset = sizeof(ECSDeltaFrameHeader); offset < frameHeader->size; )
+		{
+			records.Push(offset);
+			offset += sizeof(ECSDeltaRecordHeader) + ((const ECSDeltaRecordHeader*)&frame[offset])->size;
+		}
+
+		List<u32> destroyedRecords;
+		for (s32 i = records.Size() - 1; i >= 0; i--)
+		{
+			const ECSDeltaRecordHeader* header = (const ECSDeltaRecordHeader*)&frame[records[i]];
+			const u8* data = (const u8*)(header + 1);
+			EntityID entity = ResolveRecordedEntity(header->entity, *remap);
+
+			switch (header->type)
+			{
+			case ECS_DELTA_RECORD_MEMBERS: {
+				ECSComponent* component = ecs->GetComponent(entity, header->typeID);
+				if (!component)
+					break;
+
+				memcpy((u8*)component + header->offset, data, header->size);
+				ecs->MarkComponentChanged(component);
+			} break;
+			case ECS_DELTA_RECORD_COMPONENT_ADDED: {
+				if (ecs->GetComponent(entity, header->typeID))
+					ecs->DestroyComponent(entity, header->typeID);
+			} break;
+			case ECS_DELTA_RECORD_COMPONENT_REMOVED: {
+				if (ecs->DoesEntityExist(entity) && !ecs->GetComponent(entity, header->typeID))
+					RecreateComponent(ecs, entity, header->typeID, data);
+			} break;
+			case ECS_DELTA_RECORD_ENTITY_CREATED: {
+				if (ecs->DoesEntityExist(entity))
+					ecs->DestroyEntity(entity);
+			} break;
+			case ECS_DELTA_RECORD_ENTITY_DESTROYED: {
+				destroyedRecords.Push(records[i]);
+			} break;
+			}
+		}
+
+		//Parents have to exist before their children can be created again
+		while (!destroyedRecords.Empty())
+		{
+			b32 createdAny = false;
+			for (u32 i = 0; i < destroyedRecords.Size(); )
+			{
+				const ECSDeltaRecordHeader* header = (const ECSDeltaRecordHeader*)&frame[destroyedRecords[i]];
+
+				b32 parentPending = false;
+				for (u32 j = 0; j < destroyedRecords.Size() && !parentPending; j++)
+					parentPending = j != i && ((const ECSDeltaRecordHeader*)&frame[destroyedRecords[j]])->entity == header->offset;
+
+				if (parentPending)
+				{
+					i++;
+					continue;
+				}
+
+				(*remap)[header->entity] = RecreateEntity(ecs, &frame[destroyedRecords[i]], *remap);
+				destroyedRecords.Remove(i);
+				createdAny = true;
+			}
+
+			if (!createdAny)
+			{
+				const ECSDeltaRecordHeader* header = (const ECSDeltaRecordHeader*)&frame[destroyedRecords[0]];
+				(*remap)[header->entity] = RecreateEntity(ecs, &frame[destroyedRecords[0]], *remap);
+				destroyedRecords.Remove(0);
+			}
+		}
+	}
+
+	EntityID ECSRecorder::RecreateEntity(ECS* ecs, const u8* record, const std::unordered_map<EntityID, EntityID>& remap)
+	{
+		const ECSDeltaRecordHeader* header = (const ECSDeltaRecordHeader*)record;
+		const u8* data = (const u8*)(header + 1);
+
+		b32 enabled;
+		memcpy(&enabled, data, sizeof(b32));
+		data += sizeof(b32);
+		u32 nameLength;
+		memcpy(&nameLength, data, sizeof(u32));
+		data += sizeof(u32);
+		String name(nameLength);
+		memcpy(name.GetChars(), data, nameLength);
+		data += nameLength;
+
+		EntityID parent = ResolveRecordedEntity(header->offset, remap);
+		if (!ecs->DoesEntityExist(parent))
+			parent = EU_ECS_ROOT_ENTITY;
+
+		EntityID entity = ecs->CreateEntity(name, parent);
+		ecs->SetEntityEnabled(entity, enabled);
+
+		for (u32 i = 0; i < header->typeID; i++)
+		{
+			metadata_typeid typeID;
+			memcpy(&typeID, data, sizeof(metadata_typeid));
+			data += sizeof(metadata_typeid);
+			u32 size;
+			memcpy(&size, data, sizeof(u32));
+			data += sizeof(u32);
+
+			RecreateComponent(ecs, entity, typeID, data);
+			data += size;
+		}
+
+		return entity;
+	}
+
+	void ECSRecorder::RecreateComponent(ECS* ecs, EntityID entity, metadata_typeid typeID, const u8* data)
+	{
+		ECSComponent* component = ecs->CreateComponent(entity, typeID);
+		const List<ECSRecorderMemberRange>& ranges = GetMemberRanges(typeID);
+		for (u32 i = 0; i < ranges.Size(); i++)
+			memcpy((u8*)component + ranges[i].offset, data + ranges[i].offset, ranges[i].size);
+		component->parent = entity;
+		ecs->MarkComponentChanged(component);
+	}
+
+}
@@ -0,0 +1,153 @@
+#pragma once
+
+#include "ECS.h"
+#include <deque>
+#include <unordered_map>
+
+#define EU_ECS_RECORDER_DEFAULT_MEMORY_BUDGET (64 * 1024 * 1024)
+
+namespace Eunoia {
+
+	enum ECSDeltaRecordType
+	{
+		//The bytes a run of changed members had before the frame, writing them back undoes the change
+		ECS_DELTA_RECORD_MEMBERS,
+		ECS_DELTA_RECORD_ENTITY_CREATED,
+		//Followed by everything needed to create the entity again
+		ECS_DELTA_RECORD_ENTITY_DESTROYED,
+		//Undone on the same entity so its ID, children and the IDs other components store stay valid
+		ECS_DELTA_RECORD_COMPONENT_ADDED,
+		//Followed by the bytes the component had before the frame
+		ECS_DELTA_RECORD_COMPONENT_REMOVED
+	};
+
+	struct ECSDeltaRecordHeader
+	{
+		u32 type;
+		//The component type for member and component records, the number of components for destroyed entities
+		metadata_typeid typeID;
+		EntityID entity;
+		//Offset into the component for member records, the parent for destroyed entities
+		u32 offset;
+		u32 size;
+	};
+
+	struct ECSDeltaFrameHeader
+	{
+		u32 frame;
+		r32 dt;
+		u32 numRecords;
+		u32 size;
+	};
+
+	//One contiguous run of bytes that can be compared and copied without knowing what's in it
+	struct ECSRecorderMemberRange
+	{
+		u32 offset;
+		u32 size;
+	};
+
+	struct ECSRecorderComponent
+	{
+		metadata_typeid typeID;
+		List<u8> data;
+	};
+
+	//What the recorder knows about an entity slot since the last recorded frame
+	struct ECSRecorderEntity
+	{
+		ECSRecorderEntity() :
+			id(EU_ECS_INVALID_ENTITY_ID),
+			parent(EU_ECS_INVALID_ENTITY_ID),
+			enabled(false),
+			nameHash(0)
+		{}
+
+		EntityID id;
+		EntityID parent;
+		b32 enabled;
+		String name;
+		ECSNameHash nameHash;
+		List<ECSRecorderComponent> components;
+	};
+
+	struct ECSRecordedFrame
+	{
+		u32 offset;
+		u32 size;
+		r32 dt;
+	};
+
+	/*
+		Keeps the last frames of an ECS as deltas in a ring buffer of a fixed size, the oldest frames are dropped to make room.
+		Components are diffed member by member against a shadow copy from the previous frame, only components whose version
+		moved since then are looked at. Rewind walks the deltas backwards from the current state so a hitch can be stepped
+		back to and simulated again. Members are undone by writing back their old bytes, so writes made after the last
+		RecordFrame, like inspector edits while paused, are overwritten where the undone frames changed the same members and kept elsewhere.
+		Only reflected members are recorded, String members and members owning runtime objects are skipped
+	*/
+	class EU_API ECSRecorder
+	{
+	public:
+		ECSRecorder(mem_size memoryBudget = EU_ECS_RECORDER_DEFAULT_MEMORY_BUDGET);
+
+		void SetMemoryBudget(mem_size memoryBudget);
+		mem_size GetMemoryBudget() const;
+		mem_size GetMemoryUsed() const;
+
+		//Compares every component instead of only the ones written through a mutable accessor
+		void SetFullDiff(b32 fullDiff);
+
+		//Call once per simulated frame after the systems ran
+		void RecordFrame(ECS* ecs, r32 dt);
+		//Forgets the recorded frames, the next frame starts a new history
+		void Reset();
+
+		//Undoes the last numFrames frames on the ECS and drops them, returns how many frames were undone
+		u32 Rewind(ECS* ecs, u32 numFrames);
+
+		u32 GetNumFrames() const;
+		r32 GetRecordedTime() const;
+		r64 GetLastRecordTime() const;
+
+		static void RunBenchmark(u32 numEntities = 10000);
+	private:
+		const List<ECSRecorderMemberRange>& GetMemberRanges(metadata_typeid typeID);
+		void CollectMemberRanges(metadata_typeid typeID, u32 baseOffset, List<ECSRecorderMemberRange>* ranges);
+
+		void CaptureEntity(ECSRecorderEntity* recorded, const ECSEntityContainer& entity);
+		b32 HaveSameComponents(const ECSRecorderEntity& recorded, const ECSEntityContainer& entity) const;
+		void WriteDestroyedEntity(const ECSRecorderEntity& recorded);
+		void WriteChangedComponents(ECSRecorderEntity* recorded, const ECSEntityContainer& entity);
+		void WriteChangedMembers(EntityID entity, ECSRecorderComponent* recorded, const u8* component);
+		void WriteRecord(const ECSDeltaRecordHeader& header, const void* data);
+		u8* AllocateFrameBytes(u32 size);
+
+		void PushFrame();
+		void PopFrame(List<u8>* frame);
+		void CopyFromRing(u32 offset, void* dst, u32 size) const;
+
+		void Sync(ECS* ecs);
+		void UndoFrame(ECS* ecs, const List<u8>& frame, std::unordered_map<EntityID, EntityID>* remap);
+		EntityID RecreateEntity(ECS* ecs, const u8* record, const std::unordered_map<EntityID, EntityID>& remap);
+		void RecreateComponent(ECS* ecs, EntityID entity, metadata_typeid typeID, const u8* data);
+	private:
+		ECS* m_ECS;
+		List<ECSRecorderEntity> m_Entities;
+		std::unordered_map<metadata_typeid, List<ECSRecorderMemberRange>> m_MemberRanges;
+		ECSVersion m_LastVersion;
+		b32 m_FullDiff;
+		b32 m_Synced;
+
+		List<u8> m_Ring;
+		std::deque<ECSRecordedFrame> m_Frames;
+		mem_size m_MemoryBudget;
+		mem_size m_MemoryUsed;
+		u32 m_NextFrame;
+
+		List<u8> m_Frame;
+		u32 m_NumFrameRecords;
+		r64 m_LastRecordTime;
+	};
+
+}
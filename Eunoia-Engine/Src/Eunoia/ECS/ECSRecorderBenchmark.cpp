@@ -0,0 +1,67 @@
+#include "ECSRecorder.h"
+#include "Components/Transform3DComponet.h"
+#include "../Core/Benchmark.h"
+
+namespace Eunoia {
+
+	static void MoveEntities(ECS* ecs, const List<EntityID>& entities, u32 numMoved)
+	{
+		for (u32 i = 0; i < numMoved; i++)
+			ecs->GetComponentMutable<Transform3DComponent>(entities[i])->localTransform.Translate(v3(0.0f, 1.0f, 0.0f));
+	}
+
+	void ECSRecorder::RunBenchmark(u32 numEntities)
+	{
+		BenchmarkSamples syncTime, staticTime, partialTime, fullTime, fullDiffTime, rewindTime;
+		u32 numMoved = 0, numRewound = 0;
+		mem_size partialSize = 0, fullSize = 0;
+		for (u32 sample = 0; sample < EU_BENCHMARK_NUM_SAMPLES; sample++)
+		{
+			ECSBenchmarkScene scene;
+			scene.Create("ECSRecorderBenchmark", numEntities);
+			ECS* ecs = scene.ecs;
+			numMoved = scene.numMoved;
+
+			ECSRecorder recorder;
+
+			//The first frame only takes the shadow copy
+			BenchmarkTimer timer;
+			recorder.RecordFrame(ecs, 0.016f);
+			syncTime.Add(timer.GetElapsedMicroseconds());
+
+			timer.Restart();
+			recorder.RecordFrame(ecs, 0.016f);
+			staticTime.Add(timer.GetElapsedMicroseconds());
+
+			MoveEntities(ecs, scene.entities, numMoved);
+			mem_size memoryBefore = recorder.GetMemoryUsed();
+			timer.Restart();
+			recorder.RecordFrame(ecs, 0.016f);
+			partialTime.Add(timer.GetElapsedMicroseconds());
+			partialSize = recorder.GetMemoryUsed() - memoryBefore;
+
+			MoveEntities(ecs, scene.entities, numEntities);
+			memoryBefore = recorder.GetMemoryUsed();
+			timer.Restart();
+			recorder.RecordFrame(ecs, 0.016f);
+			fullTime.Add(timer.GetElapsedMicroseconds());
+			fullSize = recorder.GetMemoryUsed() - memoryBefore;
+
+			//What the recorder would cost without the component versions
+			recorder.SetFullDiff(true);
+			timer.Restart();
+			recorder.RecordFrame(ecs, 0.016f);
+			fullDiffTime.Add(timer.GetElapsedMicroseconds());
+			recorder.SetFullDiff(false);
+
+			timer.Restart();
+			numRewound = recorder.Rewind(ecs, recorder.GetNumFrames());
+			rewindTime.Add(timer.GetElapsedMicroseconds());
+		}
+
+		EU_LOG_BENCHMARK("ECSRecorder", "{0} entities, sync {1:.0f}us, nothing moved {2:.0f}us, {3} moved {4:.0f}us {5} bytes, all moved {6:.0f}us {7} bytes, full diff {8:.0f}us, rewind {9} frames {10:.0f}us",
+			numEntities, syncTime.GetMedian(), staticTime.GetMedian(), numMoved, partialTime.GetMedian(), partialSize, fullTime.GetMedian(), fullSize,
+			fullDiffTime.GetMedian(), numRewound, rewindTime.GetMedian());
+	}
+
+}
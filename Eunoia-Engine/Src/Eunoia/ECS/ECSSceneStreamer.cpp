@@ -0,0 +1,292 @@
+#include "ECSSceneStreamer.h"
+#include "ECS.h"
+#include "Events/SceneStreamedEvent.h"
+#include <algorithm>
+#include <map>
+#include <string>
+
+namespace Eunoia {
+
+	ECSSceneStreamer::ECSSceneStreamer() :
+		m_NextStreamID(1),
+		m_Budget(EU_ECS_SCENE_STREAMING_DEFAULT_BUDGET),
+		m_LoaderRunning(false)
+	{
+	}
+
+	ECSSceneStreamer::~ECSSceneStreamer()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_LoadQueueMutex);
+			m_LoaderRunning = false;
+		}
+		m_LoadQueueCondition.notify_all();
+
+		if (m_LoaderThread.joinable())
+			m_LoaderThread.join();
+
+		for (u32 i = 0; i < m_Requests.Size(); i++)
+			FreeRequest(m_Requests[i]);
+	}
+
+	ECSSceneStreamID ECSSceneStreamer::LoadSceneAsync(const String& path, b32 setActive)
+	{
+		ECSSceneStreamRequest* request = new ECSSceneStreamRequest();
+		request->id = m_NextStreamID++;
+		request->path = path;
+		request->setActive = setActive;
+		request->state.store(ECS_SCENE_STREAM_QUEUED, std::memory_order_relaxed);
+		request->error = ECS_LOAD_ERROR_UNFINISHED;
+		request->nextUnsafeMember = 0;
+		request->scene = EU_ECS_INVALID_SCENE_ID;
+		request->nextEntity = 0;
+		m_Requests.Push(request);
+
+		{
+			std::lock_guard<std::mutex> lock(m_LoadQueueMutex);
+			m_LoadQueue.push_back(request);
+			if (!m_LoaderRunning)
+			{
+				m_LoaderRunning = true;
+				m_LoaderThread = std::thread(&ECSSceneStreamer::LoaderMain, this);
+			}
+		}
+		m_LoadQueueCondition.notify_one();
+
+		return request->id;
+	}
+
+	ECSSceneStreamState ECSSceneStreamer::GetState(ECSSceneStreamID stream) const
+	{
+		for (u32 i = 0; i < m_Requests.Size(); i++)
+			if (m_Requests[i]->id == stream)
+				return (ECSSceneStreamState)m_Requests[i]->state.load(std::memory_order_acquire);
+
+		return ECS_SCENE_STREAM_FINISHED;
+	}
+
+	u32 ECSSceneStreamer::GetNumPending() const
+	{
+		return m_Requests.Size();
+	}
+
+	void ECSSceneStreamer::SetBudget(r32 milliseconds)
+	{
+		m_Budget = milliseconds;
+	}
+
+	r32 ECSSceneStreamer::GetBudget() const
+	{
+		return m_Budget;
+	}
+
+	void ECSSceneStreamer::Update(ECS* ecs)
+	{
+		if (m_Requests.Empty())
+			return;
+
+		std::chrono::high_resolution_clock::time_point frameStart = std::chrono::high_resolution_clock::now();
+		while (!m_Requests.Empty())
+		{
+			ECSSceneStreamRequest* request = m_Requests[0];
+			if (request->state.load(std::memory_order_acquire) != ECS_SCENE_STREAM_INSTANTIATING)
+				break;
+
+			if (!InstantiateRequest(ecs, request, frameStart))
+				break;
+
+			b32 loaded = request->error == ECS_LOAD_ERROR_NONE;
+			ecs->DispatchEvent<SceneStreamedEvent>(request->id, request->scene, loaded);
+			request->state.store(ECS_SCENE_STREAM_FINISHED, std::memory_order_relaxed);
+			m_Requests.Remove(0);
+			FreeRequest(request);
+
+			if (IsOverBudget(frameStart))
+				break;
+		}
+	}
+
+	void ECSSceneStreamer::CancelAll()
+	{
+		std::deque<ECSSceneStreamRequest*> queued;
+		{
+			std::lock_guard<std::mutex> lock(m_LoadQueueMutex);
+			queued.swap(m_LoadQueue);
+		}
+
+		//The loader thread never sees the queued requests, the others are its own until they are ready to instantiate
+		for (u32 i = 0; i < m_Requests.Size(); i++)
+		{
+			ECSSceneStreamRequest* request = m_Requests[i];
+			if (std::find(queued.begin(), queued.end(), request) == queued.end())
+				while (request->state.load(std::memory_order_acquire) != ECS_SCENE_STREAM_INSTANTIATING)
+					std::this_thread::yield();
+
+			FreeRequest(request);
+		}
+
+		m_Requests.Clear();
+	}
+
+	void ECSSceneStreamer::LoaderMain()
+	{
+		for (;;)
+		{
+			ECSSceneStreamRequest* request;
+			{
+				std::unique_lock<std::mutex> lock(m_LoadQueueMutex);
+				m_LoadQueueCondition.wait(lock, [this]() { return !m_LoaderRunning || !m_LoadQueue.empty(); });
+				if (!m_LoaderRunning)
+					return;
+
+				request = m_LoadQueue.front();
+				m_LoadQueue.pop_front();
+			}
+
+			LoadRequest(request);
+		}
+	}
+
+	void ECSSceneStreamer::LoadRequest(ECSSceneStreamRequest* request)
+	{
+		request->state.store(ECS_SCENE_STREAM_LOADING, std::memory_order_relaxed);
+		request->error = ECSLoader::LoadECSSceneFromFile(&request->loadedScene, request->path, true);
+
+		if (request->error == ECS_LOAD_ERROR_NONE)
+		{
+			//Members with the same safe data (the same texture path most of the time) share the decoded asset
+			const List<ECSLoaderUnsafeRuntimeMember>& handlers = ECSLoader::GetUnsafeRuntimeMembers();
+			std::map<std::pair<u32, std::string>, void*> preparedMembers;
+			List<ECSLoadedUnsafeMember>& unsafeMembers = request->loadedScene.unsafeMembers;
+			for (u32 i = 0; i < unsafeMembers.Size(); i++)
+			{
+				ECSLoadedUnsafeMember* member = &unsafeMembers[i];
+				const ECSLoaderUnsafeRuntimeMember& handler = handlers[member->handler];
+				if (!handler.PrepareUnsafeMember)
+					continue;
+
+				std::string safeData = member->safeData.Empty() ? std::string() : std::string((const char*)&member->safeData[0], member->safeData.Size());
+				std::pair<u32, std::string> key(member->handler, safeData);
+				auto it = preparedMembers.find(key);
+				if (it == preparedMembers.end())
+				{
+					void* preparedData = handler.PrepareUnsafeMember(member->safeData);
+					it = preparedMembers.insert(std::make_pair(key, preparedData)).first;
+					if (preparedData)
+					{
+						request->preparedData.Push(preparedData);
+						request->preparedHandlers.Push(member->handler);
+					}
+				}
+
+				member->preparedData = it->second;
+			}
+		}
+
+		request->state.store(ECS_SCENE_STREAM_INSTANTIATING, std::memory_order_release);
+	}
+
+	b32 ECSSceneStreamer::InstantiateRequest(ECS* ecs, ECSSceneStreamRequest* request, std::chrono::high_resolution_clock::time_point frameStart)
+	{
+		if (request->error != ECS_LOAD_ERROR_NONE)
+		{
+			EU_LOG_WARN("Could not stream scene {0}", request->path.C_Str());
+			return true;
+		}
+
+		ECSLoadedScene* loadedScene = &request->loadedScene;
+
+		//Creating the runtime objects is mostly GPU uploads, one member per step
+		const List<ECSLoaderUnsafeRuntimeMember>& handlers = ECSLoader::GetUnsafeRuntimeMembers();
+		while (request->nextUnsafeMember < loadedScene->unsafeMembers.Size())
+		{
+			const ECSLoadedUnsafeMember& member = loadedScene->unsafeMembers[request->nextUnsafeMember++];
+			const ECSLoaderUnsafeRuntimeMember& handler = handlers[member.handler];
+			void* unsafeRuntimeData = ECSLoader::GetLoadedUnsafeMemberData(loadedScene, member);
+			if (member.preparedData)
+				handler.ReadPreparedUnsafeMember(unsafeRuntimeData, member.preparedData);
+			else
+				handler.ReadUnsafeMember(unsafeRuntimeData, member.safeData);
+
+			if (IsOverBudget(frameStart))
+				return false;
+		}
+
+		//Entities and systems are created in the active scene, the streamed scene is only active while it is being built
+		SceneID activeScene = ecs->GetActiveScene();
+		if (request->scene == EU_ECS_INVALID_SCENE_ID)
+		{
+			request->scene = ecs->CreateScene(loadedScene->name, true, false);
+			for (u32 i = 0; i < loadedScene->systems.Size(); i++)
+				ecs->LoadSystemFromLoadedDataFormat(loadedScene->systems[i]);
+		}
+		else
+		{
+			ecs->SetActiveScene(request->scene);
+		}
+
+		//Entities are stored parents first, the parents still waiting for children are kept on a stack
+		while (request->nextEntity < loadedScene->entities.Size())
+		{
+			const ECSLoadedEntity& loadedEntity = loadedScene->entities[request->nextEntity];
+
+			EntityID entity;
+			if (request->nextEntity == 0)
+			{
+				entity = ecs->GetRootEntity();
+			}
+			else
+			{
+				while (!request->parents.Empty() && request->parents.GetLastElement().remainingChildren == 0)
+					request->parents.Pop();
+
+				EntityID parent = ecs->GetRootEntity();
+				if (!request->parents.Empty())
+				{
+					ECSSceneStreamParent* streamParent = &request->parents[request->parents.Size() - 1];
+					streamParent->remainingChildren--;
+					parent = streamParent->entity;
+				}
+
+				entity = ecs->CreateEntity(loadedEntity.name, parent);
+			}
+
+			ecs->LoadEntityFromLoadedDataFormat(entity, loadedEntity);
+			request->nextEntity++;
+
+			if (loadedEntity.numChildren > 0)
+			{
+				ECSSceneStreamParent streamParent;
+				streamParent.entity = entity;
+				streamParent.remainingChildren = loadedEntity.numChildren;
+				request->parents.Push(streamParent);
+			}
+
+			if (request->nextEntity < loadedScene->entities.Size() && IsOverBudget(frameStart))
+			{
+				ecs->SetActiveScene(activeScene);
+				return false;
+			}
+		}
+
+		if (!request->setActive)
+			ecs->SetActiveScene(activeScene);
+
+		return true;
+	}
+
+	b32 ECSSceneStreamer::IsOverBudget(std::chrono::high_resolution_clock::time_point frameStart) const
+	{
+		return std::chrono::duration<r32, std::milli>(std::chrono::high_resolution_clock::now() - frameStart).count() >= m_Budget;
+	}
+
+	void ECSSceneStreamer::FreeRequest(ECSSceneStreamRequest* request)
+	{
+		const List<ECSLoaderUnsafeRuntimeMember>& handlers = ECSLoader::GetUnsafeRuntimeMembers();
+		for (u32 i = 0; i < request->preparedData.Size(); i++)
+			handlers[request->preparedHandlers[i]].FreePreparedUnsafeMember(request->preparedData[i]);
+
+		delete request;
+	}
+
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "ECSLoader.h"
+#include "ECSTypes.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#define EU_ECS_SCENE_STREAMING_DEFAULT_BUDGET 2.0f
+
+namespace Eunoia {
+
+	class ECS;
+
+	typedef u32 ECSSceneStreamID;
+
+	enum ECSSceneStreamState
+	{
+		ECS_SCENE_STREAM_QUEUED,
+		//The file is parsed and the assets are decoded on the loader thread
+		ECS_SCENE_STREAM_LOADING,
+		//The scene is created on the main thread a little every frame
+		ECS_SCENE_STREAM_INSTANTIATING,
+		ECS_SCENE_STREAM_FINISHED
+	};
+
+	struct ECSSceneStreamParent
+	{
+		EntityID entity;
+		u32 remainingChildren;
+	};
+
+	struct ECSSceneStreamRequest
+	{
+		ECSSceneStreamID id;
+		String path;
+		b32 setActive;
+		std::atomic<u32> state;
+
+		//Written by the loader thread before the state becomes ECS_SCENE_STREAM_INSTANTIATING
+		ECSLoadError error;
+		ECSLoadedScene loadedScene;
+		List<void*> preparedData;
+		List<u32> preparedHandlers;
+
+		//Main thread only, how far the instantiation got
+		u32 nextUnsafeMember;
+		SceneID scene;
+		u32 nextEntity;
+		List<ECSSceneStreamParent> parents;
+	};
+
+	/*
+		Loads scene files without stalling the frame. A background thread parses the file and decodes the textures, models and
+		materials it references through the ECSLoader prepare handlers. The main thread then uploads the assets and creates the
+		scene over as many frames as it takes to stay within the per frame budget, scenes are finished in the order they were requested.
+		The loader has its own thread instead of running on the job system since a thread waiting on a job counter would pick
+		the load up and stall for the whole file
+	*/
+	class EU_API ECSSceneStreamer
+	{
+	public:
+		ECSSceneStreamer();
+		~ECSSceneStreamer();
+
+		ECSSceneStreamID LoadSceneAsync(const String& path, b32 setActive);
+		ECSSceneStreamState GetState(ECSSceneStreamID stream) const;
+		u32 GetNumPending() const;
+
+		//Milliseconds of main thread time spent creating streamed scenes per frame, at least one step is taken every frame
+		void SetBudget(r32 milliseconds);
+		r32 GetBudget() const;
+
+		//Main thread only, called once per frame by ECS::Begin
+		void Update(ECS* ecs);
+		//Main thread only, drops every request without finishing it. Waits for the file the loader thread is reading
+		void CancelAll();
+	private:
+		void LoaderMain();
+		void LoadRequest(ECSSceneStreamRequest* request);
+
+		b32 InstantiateRequest(ECS* ecs, ECSSceneStreamRequest* request, std::chrono::high_resolution_clock::time_point frameStart);
+		b32 IsOverBudget(std::chrono::high_resolution_clock::time_point frameStart) const;
+		void FreeRequest(ECSSceneStreamRequest* request);
+	private:
+		List<ECSSceneStreamRequest*> m_Requests;
+		ECSSceneStreamID m_NextStreamID;
+		r32 m_Budget;
+
+		std::deque<ECSSceneStreamRequest*> m_LoadQueue;
+		std::mutex m_LoadQueueMutex;
+		std::condition_variable m_LoadQueueCondition;
+		std::thread m_LoaderThread;
+		b32 m_LoaderRunning;
+	};
+
+}
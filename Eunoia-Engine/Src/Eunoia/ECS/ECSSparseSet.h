@@ -0,0 +1,201 @@
+#pragma once
+
+#include "../Common.h"
+#include "../DataStructures/List.h"
+#include "ECSTypes.h"
+
+#define EU_ECS_INVALID_DENSE_INDEX EU_U32_MAX
+
+namespace Eunoia {
+
+	struct ECSComponent;
+
+	/*
+		One sparse set per component type.
+		sparse is indexed by entity index (without the generation) and stores the slot in the dense arrays,
+		the dense arrays hold every entity that has the component and a pointer to it packed together.
+		Lookup, insertion and removal are all constant time, removal swaps the last dense slot into the hole
+	*/
+	struct ECSComponentSparseSet
+	{
+		ECSComponentSparseSet() :
+			sparse(64),
+			denseEntities(64),
+			denseComponents(64)
+		{}
+
+		inline void Insert(EntityID entity, ECSComponent* component)
+		{
+			u32 index = EU_ECS_ENTITY_INDEX(entity);
+			while (index >= sparse.Size())
+				sparse.Push(EU_ECS_INVALID_DENSE_INDEX);
+
+			if (sparse[index] != EU_ECS_INVALID_DENSE_INDEX)
+			{
+				denseEntities[sparse[index]] = entity;
+				denseComponents[sparse[index]] = component;
+				return;
+			}
+
+			sparse[index] = denseEntities.Size();
+			denseEntities.Push(entity);
+			denseComponents.Push(component);
+		}
+
+		inline void Remove(EntityID entity)
+		{
+			if (!Has(entity))
+				return;
+
+			u32 denseIndex = sparse[EU_ECS_ENTITY_INDEX(entity)];
+			u32 lastIndex = denseEntities.Size() - 1;
+			if (denseIndex != lastIndex)
+			{
+				EntityID lastEntity = denseEntities[lastIndex];
+				denseEntities[denseIndex] = lastEntity;
+				denseComponents[denseIndex] = denseComponents[lastIndex];
+				sparse[EU_ECS_ENTITY_INDEX(lastEntity)] = denseIndex;
+			}
+
+			denseEntities.Remove(lastIndex);
+			denseComponents.Remove(lastIndex);
+			sparse[EU_ECS_ENTITY_INDEX(entity)] = EU_ECS_INVALID_DENSE_INDEX;
+		}
+
+		//A stale ID whose slot was reused fails the generation check on the dense entity
+		inline b32 Has(EntityID entity) const
+		{
+			u32 index = EU_ECS_ENTITY_INDEX(entity);
+			return index < sparse.Size() && sparse[index] != EU_ECS_INVALID_DENSE_INDEX && denseEntities[sparse[index]] == entity;
+		}
+
+		inline ECSComponent* Get(EntityID entity) const
+		{
+			if (!Has(entity))
+				return 0;
+
+			return denseComponents[sparse[EU_ECS_ENTITY_INDEX(entity)]];
+		}
+
+		//Used when the component memory moves (archetype changes, pool compaction)
+		inline void Relocate(EntityID entity, ECSComponent* component)
+		{
+			if (Has(entity))
+				denseComponents[sparse[EU_ECS_ENTITY_INDEX(entity)]] = component;
+		}
+
+		inline u32 Size() const { return denseEntities.Size(); }
+
+		inline void Clear()
+		{
+			sparse.Clear();
+			denseEntities.Clear();
+			denseComponents.Clear();
+		}
+
+		List<u32> sparse;
+		List<EntityID> denseEntities;
+		List<ECSComponent*> denseComponents;
+	};
+
+	/*
+		Dense iteration over every component of one type.
+		The order is unspecified and the view is invalidated by adding or removing components of that type
+	*/
+	template<class C>
+	class ECSComponentView
+	{
+	public:
+		ECSComponentView(const ECSComponentSparseSet* set) :
+			m_Set(set)
+		{}
+
+		inline u32 Size() const { return m_Set ? m_Set->Size() : 0; }
+		inline b32 Empty() const { return Size() == 0; }
+		inline EntityID GetEntity(u32 index) const { return m_Set->denseEntities[index]; }
+		inline C* GetComponent(u32 index) const { return (C*)m_Set->denseComponents[index]; }
+		inline C* operator[](u32 index) const { return GetComponent(index); }
+	private:
+		const ECSComponentSparseSet* m_Set;
+	};
+
+	/*
+		The list of entities a system matches, kept up to date by the ECS when components are added or removed.
+		Removal swaps the last entity into the hole so the list is only in hierarchy order after the ECS sorts it
+	*/
+	struct ECSEntityList
+	{
+		ECSEntityList() :
+			sorted(true),
+			version(0)
+		{}
+
+		inline void Add(EntityID entity)
+		{
+			u32 index = EU_ECS_ENTITY_INDEX(entity);
+			while (index >= sparse.Size())
+				sparse.Push(EU_ECS_INVALID_DENSE_INDEX);
+
+			if (sparse[index] != EU_ECS_INVALID_DENSE_INDEX)
+				return;
+
+			sparse[index] = entities.Size();
+			entities.Push(entity);
+			sorted = false;
+			version++;
+		}
+
+		inline void Remove(EntityID entity)
+		{
+			if (!Contains(entity))
+				return;
+
+			u32 index = sparse[EU_ECS_ENTITY_INDEX(entity)];
+			u32 lastIndex = entities.Size() - 1;
+			if (index != lastIndex)
+			{
+				EntityID lastEntity = entities[lastIndex];
+				entities[index] = lastEntity;
+				sparse[EU_ECS_ENTITY_INDEX(lastEntity)] = index;
+				sorted = false;
+			}
+
+			entities.Remove(lastIndex);
+			sparse[EU_ECS_ENTITY_INDEX(entity)] = EU_ECS_INVALID_DENSE_INDEX;
+			version++;
+		}
+
+		inline b32 Contains(EntityID entity) const
+		{
+			u32 index = EU_ECS_ENTITY_INDEX(entity);
+			return index < sparse.Size() && sparse[index] != EU_ECS_INVALID_DENSE_INDEX && entities[sparse[index]] == entity;
+		}
+
+		//Call after reordering the entities array directly
+		inline void RebuildIndices()
+		{
+			for (u32 i = 0; i < entities.Size(); i++)
+				sparse[EU_ECS_ENTITY_INDEX(entities[i])] = i;
+		}
+
+		inline void Clear()
+		{
+			for (u32 i = 0; i < entities.Size(); i++)
+				sparse[EU_ECS_ENTITY_INDEX(entities[i])] = EU_ECS_INVALID_DENSE_INDEX;
+			entities.Clear();
+			sorted = true;
+			version++;
+		}
+
+		inline u32 Size() const { return entities.Size(); }
+		inline b32 Empty() const { return entities.Empty(); }
+		inline EntityID operator[](u32 index) const { return entities[index]; }
+
+		List<EntityID> entities;
+		List<u32> sparse;
+		b32 sorted;
+		//Bumped whenever an entity is added or removed
+		u32 version;
+	};
+
+}
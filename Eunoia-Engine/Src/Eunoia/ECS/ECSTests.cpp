@@ -0,0 +1,430 @@
+#include "ECS.h"
+#include "ECSRecorder.h"
+#include "Components/Transform3DComponet.h"
+#include "Components/Text2DComponent.h"
+#include "Components/SpatialIndex3DComponent.h"
+#include "Events/RigidBodyTransformModifiedEvent.h"
+#include "../Memory/Allocators.h"
+#include "../Utils/Log.h"
+
+#define EU_ECS_CHECK(condition) if (!(condition)) { EU_LOG_ERROR("ECS test failed: {0} ({1})", #condition, __LINE__); passed = false; }
+
+namespace Eunoia {
+
+	//Every entry point that takes an EntityID has to ignore an ID whose slot was reused by a newer entity
+	static b32 TestStaleEntityIDs(ECS* ecs)
+	{
+		b32 passed = true;
+
+		EntityID stale = ecs->CreateEntity("Stale");
+		ecs->CreateComponent<Transform3DComponent>(stale);
+		ecs->DestroyEntity(stale);
+
+		EntityID entity = ecs->CreateEntity("Reused");
+		ecs->CreateComponent<Transform3DComponent>(entity);
+		EU_ECS_CHECK(EU_ECS_ENTITY_SLOT(entity) == EU_ECS_ENTITY_SLOT(stale));
+		EU_ECS_CHECK(entity != stale);
+
+		EU_ECS_CHECK(!ecs->DoesEntityExist(stale));
+		EU_ECS_CHECK(ecs->GetComponent<Transform3DComponent>(stale) == 0);
+		EU_ECS_CHECK(!ecs->IsEntityEnabled(stale));
+		EU_ECS_CHECK(ecs->GetEntityName(stale).Empty());
+		EU_ECS_CHECK(ecs->GetParentEntity(stale) == EU_ECS_INVALID_ENTITY_ID);
+
+		ecs->SetEntityEnabled(stale, false);
+		EU_ECS_CHECK(ecs->IsEntityEnabled(entity));
+		ecs->SetEntityEnabledOpposite(stale);
+		EU_ECS_CHECK(ecs->IsEntityEnabled(entity));
+
+		EU_ECS_CHECK(!ecs->DestroyComponent<Transform3DComponent>(stale));
+		EU_ECS_CHECK(!ecs->DestroyComponentByIndex(stale, 0));
+		EU_ECS_CHECK(!ecs->DestroyComponentByIndex(entity, 1));
+		EU_ECS_CHECK(ecs->GetComponent<Transform3DComponent>(entity) != 0);
+
+		ecs->DestroyEntity(stale);
+		EU_ECS_CHECK(ecs->DoesEntityExist(entity));
+		EU_ECS_CHECK(ecs->GetEntityName(entity) == "Reused");
+
+		ecs->DestroyEntity(entity);
+		return passed;
+	}
+
+	//Removing from the middle of a component set swaps the last component into the hole, every other entity keeps its component
+	static b32 TestComponentSetRemove(ECS* ecs)
+	{
+		b32 passed = true;
+
+		u32 numBefore = ecs->GetComponentView<SpatialIndex3DComponent>().Size();
+		EntityID entities[3];
+		for (u32 i = 0; i < 3; i++)
+		{
+			entities[i] = ecs->CreateEntity("Indexed");
+			ecs->CreateComponent<SpatialIndex3DComponent>(entities[i], (r32)(i + 1));
+		}
+
+		EU_ECS_CHECK(ecs->DestroyComponent<SpatialIndex3DComponent>(entities[0]));
+		EU_ECS_CHECK(!ecs->DoesEntityHaveComponent<SpatialIndex3DComponent>(entities[0]));
+		EU_ECS_CHECK(ecs->GetComponent<SpatialIndex3DComponent>(entities[0]) == 0);
+		EU_ECS_CHECK(ecs->GetComponent<SpatialIndex3DComponent>(entities[1])->radius == 2.0f);
+		EU_ECS_CHECK(ecs->GetComponent<SpatialIndex3DComponent>(entities[2])->radius == 3.0f);
+
+		ECSComponentView<SpatialIndex3DComponent> view = ecs->GetComponentView<SpatialIndex3DComponent>();
+		EU_ECS_CHECK(view.Size() == numBefore + 2);
+		for (u32 i = 0; i < view.Size(); i++)
+			EU_ECS_CHECK(view.GetComponent(i)->parent == view.GetEntity(i));
+
+		//The removed slot is reused by a new entity without the component
+		ecs->DestroyEntity(entities[0]);
+		EntityID reused = ecs->CreateEntity("Reused");
+		EU_ECS_CHECK(EU_ECS_ENTITY_SLOT(reused) == EU_ECS_ENTITY_SLOT(entities[0]));
+		EU_ECS_CHECK(!ecs->DoesEntityHaveComponent<SpatialIndex3DComponent>(reused));
+		ecs->CreateComponent<SpatialIndex3DComponent>(reused, 4.0f);
+		EU_ECS_CHECK(ecs->GetComponent<SpatialIndex3DComponent>(entities[0]) == 0);
+		EU_ECS_CHECK(ecs->GetComponent<SpatialIndex3DComponent>(reused)->radius == 4.0f);
+
+		ecs->DestroyEntity(reused);
+		ecs->DestroyEntity(entities[1]);
+		ecs->DestroyEntity(entities[2]);
+		EU_ECS_CHECK(ecs->GetComponentView<SpatialIndex3DComponent>().Size() == numBefore);
+		return passed;
+	}
+
+	//Entities sharing a name are told apart by slot and parent, suffix lookups see renames of both the parent and the child
+	static b32 TestNameIndex(ECS* ecs)
+	{
+		b32 passed = true;
+
+		EntityID first = ecs->CreateEntity("Panel");
+		EntityID second = ecs->CreateEntity("Panel");
+		EntityID lowest = EU_ECS_ENTITY_INDEX(first) < EU_ECS_ENTITY_INDEX(second) ? first : second;
+		EU_ECS_CHECK(ecs->GetEntityID("Panel") == lowest);
+
+		EntityID firstSlider = ecs->CreateEntity("Panel_Slider", first);
+		EntityID secondSlider = ecs->CreateEntity("Panel_Slider", second);
+		EU_ECS_CHECK(ecs->GetChildEntity(first, "Panel_Slider") == firstSlider);
+		EU_ECS_CHECK(ecs->GetChildEntity(second, "Panel_Slider") == secondSlider);
+		EU_ECS_CHECK(ecs->GetChildEntityWithNameSuffix(first, "_Slider") == firstSlider);
+		EU_ECS_CHECK(ecs->GetChildEntityWithNameSuffix(second, "_Slider") == secondSlider);
+		EU_ECS_CHECK(ecs->GetChildEntityWithNameSuffix(first, "_vScrollBar") == EU_ECS_INVALID_ENTITY_ID);
+		EU_ECS_CHECK(ecs->GetChildEntityWithNameSuffix(first, "_Slide") == EU_ECS_INVALID_ENTITY_ID);
+
+		//The child keeps its old name so the suffix no longer matches until it is renamed as well
+		ecs->SetEntityName(second, "Window");
+		EU_ECS_CHECK(ecs->GetEntityID("Panel") == first);
+		EU_ECS_CHECK(ecs->GetEntityID("Window") == second);
+		EU_ECS_CHECK(ecs->GetChildEntityWithNameSuffix(second, "_Slider") == EU_ECS_INVALID_ENTITY_ID);
+		ecs->SetEntityName(secondSlider, "Window_Slider");
+		EU_ECS_CHECK(ecs->GetChildEntityWithNameSuffix(second, "_Slider") == secondSlider);
+		EU_ECS_CHECK(ecs->GetChildEntity(second, "Panel_Slider") == EU_ECS_INVALID_ENTITY_ID);
+
+		ecs->DestroyEntity(firstSlider);
+		ecs->DestroyEntity(first);
+		EU_ECS_CHECK(ecs->GetEntityID("Panel") == EU_ECS_INVALID_ENTITY_ID);
+		EU_ECS_CHECK(ecs->GetEntityID("Panel_Slider") == EU_ECS_INVALID_ENTITY_ID);
+		EU_ECS_CHECK(ecs->GetEntityID("Window_Slider") == secondSlider);
+
+		ecs->DestroyEntity(secondSlider);
+		ecs->DestroyEntity(second);
+		EU_ECS_CHECK(ecs->GetEntityID("Window_Slider") == EU_ECS_INVALID_ENTITY_ID);
+		return passed;
+	}
+
+	//Compaction empties the least used pools into the others and releases them, moved components keep their data
+	static b32 TestComponentCompaction(ECS* ecs)
+	{
+		b32 passed = true;
+
+		//28 elements fill pools of 4, 8 and 16, one element is kept in each
+		DynamicPoolAllocator allocator(sizeof(u32), 4);
+		u32* elements[28];
+		u32 indices[28];
+		for (u32 i = 0; i < 28; i++)
+		{
+			elements[i] = (u32*)allocator.Allocate(&indices[i]);
+			*elements[i] = i;
+		}
+		EU_ECS_CHECK(allocator.GetNumPools() == 3);
+
+		u32 kept[3] = { 0, 5, 20 };
+		for (u32 i = 0; i < 28; i++)
+			if (i != kept[0] && i != kept[1] && i != kept[2])
+				allocator.Free(elements[i], indices[i]);
+
+		EU_ECS_CHECK(allocator.BeginCompaction() == 2);
+		for (u32 i = 0; i < 3; i++)
+		{
+			u32 element = kept[i];
+			if (!allocator.IsEvacuating(indices[element]))
+				continue;
+
+			u32 index;
+			u32* moved = (u32*)allocator.Allocate(&index);
+			*moved = *elements[element];
+			allocator.Free(elements[element], indices[element]);
+			elements[element] = moved;
+			indices[element] = index;
+		}
+		allocator.EndCompaction();
+
+		EU_ECS_CHECK(allocator.GetNumPools() == 1);
+		EU_ECS_CHECK(allocator.GetNumAllocations() == 3);
+		for (u32 i = 0; i < 3; i++)
+		{
+			EU_ECS_CHECK(*elements[kept[i]] == kept[i]);
+			allocator.Free(elements[kept[i]], indices[kept[i]]);
+		}
+
+		//The same through the ECS, every component left over has to be found at its new address
+		const u32 numEntities = 200;
+		List<EntityID> entities(numEntities);
+		for (u32 i = 0; i < numEntities; i++)
+		{
+			EntityID entity = ecs->CreateEntity("Compacted");
+			ecs->CreateComponent<SpatialIndex3DComponent>(entity, (r32)i);
+			entities.Push(entity);
+		}
+
+		for (u32 i = 0; i < numEntities; i++)
+			if (i % 20)
+				ecs->DestroyEntity(entities[i]);
+
+		ecs->CompactComponentMemory();
+		for (u32 i = 0; i < numEntities; i += 20)
+		{
+			SpatialIndex3DComponent* spatial = ecs->GetComponent<SpatialIndex3DComponent>(entities[i]);
+			EU_ECS_CHECK(spatial && spatial->radius == (r32)i && spatial->parent == entities[i]);
+		}
+
+		ECSComponentView<SpatialIndex3DComponent> view = ecs->GetComponentView<SpatialIndex3DComponent>();
+		for (u32 i = 0; i < view.Size(); i++)
+			EU_ECS_CHECK(view.GetComponent(i) == ecs->GetComponent<SpatialIndex3DComponent>(view.GetEntity(i)));
+
+		for (u32 i = 0; i < numEntities; i += 20)
+			ecs->DestroyEntity(entities[i]);
+		return passed;
+	}
+
+	//A frame that dispatches more events than the ring holds keeps all of them, in order
+	static b32 TestEventOverflow(ECS* ecs)
+	{
+		b32 passed = true;
+
+		const u32 numEvents = EU_ECS_EVENT_QUEUE_INITIAL_CAPACITY * 3 + 5;
+		for (u32 frame = 0; frame < 2; frame++)
+		{
+			ecs->Begin();
+			for (u32 i = 0; i < numEvents; i++)
+				ecs->DispatchEvent<RigidBodyTransformModifiedEvent>(i);
+
+			u32 numFound = 0;
+			ECSEventRange<RigidBodyTransformModifiedEvent> events = ecs->GetEvents<RigidBodyTransformModifiedEvent>();
+			for (const RigidBodyTransformModifiedEvent* e = events.Next(); e; e = events.Next())
+			{
+				EU_ECS_CHECK(e->entity == numFound);
+				numFound++;
+			}
+			EU_ECS_CHECK(numFound == numEvents);
+
+			const RigidBodyTransformModifiedEvent* last = (const RigidBodyTransformModifiedEvent*)ecs->CheckForEvent<RigidBodyTransformModifiedEvent>();
+			EU_ECS_CHECK(last && last->entity == numEvents - 1);
+		}
+
+		//The first frame overflowed, the ring grew to fit the second
+		const ECSEventQueue* queue = ecs->GetEventQueue(Metadata::GetTypeID<RigidBodyTransformModifiedEvent>());
+		EU_ECS_CHECK(queue->GetOverflowEnd() == 0);
+
+		ecs->Begin();
+		EU_ECS_CHECK(ecs->GetEvents<RigidBodyTransformModifiedEvent>().Empty());
+		return passed;
+	}
+
+	//Every prefab instance owns its own copy of the heap members of its components
+	static b32 TestPrefabCopies(ECS* ecs)
+	{
+		b32 passed = true;
+
+		EntityID source = ecs->CreateEntity("PrefabSource");
+		ecs->CreateComponent<Transform3DComponent>(source);
+		ecs->CreateComponent<Text2DComponent>(source, "Hello", v4(1.0f, 1.0f, 1.0f, 1.0f));
+
+		ECSPrefab prefab;
+		ecs->CreatePrefab(source, &prefab);
+		ecs->DestroyEntity(source);
+		EU_ECS_CHECK(prefab.GetNumEntities() == 1);
+
+		EntityID instances[2];
+		ecs->InstantiatePrefab(prefab, 2, EU_ECS_ROOT_ENTITY, instances);
+		Text2DComponent* first = ecs->GetComponent<Text2DComponent>(instances[0]);
+		Text2DComponent* second = ecs->GetComponent<Text2DComponent>(instances[1]);
+		EU_ECS_CHECK(first && second);
+		if (!passed)
+			return false;
+
+		EU_ECS_CHECK(first->text == "Hello" && second->text == "Hello");
+		EU_ECS_CHECK(first->text.C_Str() != second->text.C_Str());
+
+		first->text = "Changed";
+		EU_ECS_CHECK(second->text == "Hello");
+
+		ecs->DestroyEntity(instances[0]);
+		EU_ECS_CHECK(second->text == "Hello");
+
+		prefab.Clear();
+		EU_ECS_CHECK(second->text == "Hello");
+
+		ecs->DestroyEntity(instances[1]);
+		return passed;
+	}
+
+	//A restore gives every component its own copies again and drops the events of the state it replaced
+	static b32 TestSnapshotRestore(ECS* ecs)
+	{
+		b32 passed = true;
+
+		EntityID entity = ecs->CreateEntity("Snapshot");
+		ecs->CreateComponent<Text2DComponent>(entity, "Before", v4(1.0f, 1.0f, 1.0f, 1.0f));
+
+		ECSSnapshot snapshot;
+		ecs->CreateSnapshot(&snapshot);
+		EU_ECS_CHECK(snapshot.valid);
+
+		for (u32 i = 0; i < 2; i++)
+		{
+			ecs->Begin();
+			ecs->GetComponent<Text2DComponent>(entity)->text = "After";
+			EntityID added = ecs->CreateEntity("Added");
+			ecs->DispatchEvent<RigidBodyTransformModifiedEvent>(added);
+
+			ecs->RestoreSnapshot(snapshot);
+			Text2DComponent* text = ecs->GetComponent<Text2DComponent>(entity);
+			EU_ECS_CHECK(text && text->text == "Before");
+			EU_ECS_CHECK(!ecs->DoesEntityExist(added));
+			EU_ECS_CHECK(ecs->GetEvents<RigidBodyTransformModifiedEvent>().Empty());
+		}
+
+		snapshot.Clear();
+		EU_ECS_CHECK(ecs->GetComponent<Text2DComponent>(entity)->text == "Before");
+
+		ecs->DestroyEntity(entity);
+		return passed;
+	}
+
+	//Adding or removing a component is undone on the same entity, its ID and its children stay
+	static b32 TestRecorderRewindComponents(ECS* ecs)
+	{
+		b32 passed = true;
+
+		EntityID parent = ecs->CreateEntity("RecordedParent");
+		EntityID child = ecs->CreateEntity("RecordedChild", parent);
+		ecs->CreateComponent<SpatialIndex3DComponent>(parent, 1.0f);
+
+		ECSRecorder recorder;
+		recorder.RecordFrame(ecs, 0.016f);
+		ecs->CreateComponent<Text2DComponent>(parent, "Added", v4(1.0f, 1.0f, 1.0f, 1.0f));
+		ecs->GetComponentMutable<SpatialIndex3DComponent>(parent)->radius = 2.0f;
+		recorder.RecordFrame(ecs, 0.016f);
+		ecs->DestroyComponent<SpatialIndex3DComponent>(parent);
+		recorder.RecordFrame(ecs, 0.016f);
+
+		EU_ECS_CHECK(recorder.Rewind(ecs, 1) == 1);
+		EU_ECS_CHECK(ecs->DoesEntityExist(parent));
+		SpatialIndex3DComponent* spatial = ecs->GetComponent<SpatialIndex3DComponent>(parent);
+		EU_ECS_CHECK(spatial && spatial->radius == 2.0f && spatial->parent == parent);
+
+		EU_ECS_CHECK(recorder.Rewind(ecs, 1) == 1);
+		EU_ECS_CHECK(ecs->DoesEntityExist(parent) && ecs->DoesEntityExist(child));
+		EU_ECS_CHECK(ecs->GetParentEntity(child) == parent);
+		EU_ECS_CHECK(ecs->GetComponent<Text2DComponent>(parent) == 0);
+		spatial = ecs->GetComponent<SpatialIndex3DComponent>(parent);
+		EU_ECS_CHECK(spatial && spatial->radius == 1.0f);
+
+		ecs->DestroyEntity(child);
+		ecs->DestroyEntity(parent);
+		return passed;
+	}
+
+	//Deferred parents resolve across queues, commands apply in record order and recorded components keep their data
+	static b32 TestCommandBuffer(ECS* ecs)
+	{
+		b32 passed = true;
+
+		EntityID existing = ecs->CreateEntity("Existing");
+		EntityID dead = ecs->CreateEntity("Dead");
+
+		ECSCommandBuffer* commands = ecs->GetCommandBuffer();
+		ECSDeferredEntity parent = commands->CreateEntity("DeferredParent");
+		ECSDeferredEntity child = commands->CreateEntity("DeferredChild", parent);
+		commands->CreateComponent<Text2DComponent>(child, "Recorded", v4(1.0f, 1.0f, 1.0f, 1.0f));
+		commands->CreateComponent<Transform3DComponent>(existing);
+		commands->DestroyComponent<Transform3DComponent>(existing);
+		commands->CreateComponent<SpatialIndex3DComponent>(existing, 4.0f);
+		commands->CreateComponent<Text2DComponent>(dead, "Dropped", v4(1.0f, 1.0f, 1.0f, 1.0f));
+		ecs->DestroyEntity(dead);
+		ecs->FlushCommandBuffer();
+
+		EntityID createdParent = commands->GetCreatedEntity(parent);
+		EntityID createdChild = commands->GetCreatedEntity(child);
+		EU_ECS_CHECK(ecs->DoesEntityExist(createdParent) && ecs->DoesEntityExist(createdChild));
+		EU_ECS_CHECK(ecs->GetParentEntity(createdChild) == createdParent);
+
+		Text2DComponent* text = ecs->GetComponent<Text2DComponent>(createdChild);
+		EU_ECS_CHECK(text && text->text == "Recorded" && text->parent == createdChild);
+
+		EU_ECS_CHECK(ecs->GetComponent<Transform3DComponent>(existing) == 0);
+		SpatialIndex3DComponent* spatial = ecs->GetComponent<SpatialIndex3DComponent>(existing);
+		EU_ECS_CHECK(spatial && spatial->radius == 4.0f);
+		EU_ECS_CHECK(commands->Empty());
+
+		ecs->DestroyEntity(createdChild);
+		ecs->DestroyEntity(createdParent);
+		ecs->DestroyEntity(existing);
+		return passed;
+	}
+
+	//Rewinding writes back the recorded bytes, a write after the last recorded frame doesn't corrupt them
+	static b32 TestRecorderRewind(ECS* ecs)
+	{
+		b32 passed = true;
+
+		EntityID entity = ecs->CreateEntity("Recorded");
+		ecs->CreateComponent<SpatialIndex3DComponent>(entity, 1.0f);
+
+		ECSRecorder recorder;
+		recorder.RecordFrame(ecs, 0.016f);
+		ecs->GetComponentMutable<SpatialIndex3DComponent>(entity)->radius = 2.0f;
+		recorder.RecordFrame(ecs, 0.016f);
+
+		//Like an inspector edit while paused
+		ecs->GetComponentMutable<SpatialIndex3DComponent>(entity)->radius = 3.0f;
+		EU_ECS_CHECK(recorder.Rewind(ecs, 1) == 1);
+		EU_ECS_CHECK(ecs->GetComponent<SpatialIndex3DComponent>(entity)->radius == 1.0f);
+
+		ecs->DestroyEntity(entity);
+		return passed;
+	}
+
+	b32 ECS::RunTests()
+	{
+		ECS* ecs = new ECS();
+		ecs->CreateScene("ECSTests", true, false);
+
+		b32 passed = true;
+		passed &= TestStaleEntityIDs(ecs);
+		passed &= TestComponentSetRemove(ecs);
+		passed &= TestNameIndex(ecs);
+		passed &= TestComponentCompaction(ecs);
+		passed &= TestEventOverflow(ecs);
+		passed &= TestPrefabCopies(ecs);
+		passed &= TestSnapshotRestore(ecs);
+		passed &= TestRecorderRewind(ecs);
+		passed &= TestRecorderRewindComponents(ecs);
+		passed &= TestCommandBuffer(ecs);
+
+		delete ecs;
+
+		if (passed)
+			EU_LOG_INFO("ECS tests passed");
+		return passed;
+	}
+
+}
@@ -7,11 +7,42 @@
 #define EU_ECS_INVALID_ENTITY_ID	EU_ECS_INVALID_ID
 #define EU_ECS_INVALID_SCENE_ID		EU_ECS_INVALID_ID
 
+/*
+	An EntityID is a slot index in the low bits and a generation in the high bits.
+	The generation is bumped every time a slot is freed so stale IDs stop resolving,
+	IDs that were never recycled have generation 0 and keep their old values
+*/
+#define EU_ECS_ENTITY_INDEX_BITS		20
+#define EU_ECS_ENTITY_GENERATION_BITS	12
+#define EU_ECS_ENTITY_INDEX_MASK		((1u << EU_ECS_ENTITY_INDEX_BITS) - 1)
+#define EU_ECS_ENTITY_GENERATION_MASK	((1u << EU_ECS_ENTITY_GENERATION_BITS) - 1)
+#define EU_ECS_MAX_ENTITIES				EU_ECS_ENTITY_INDEX_MASK
+
+#define EU_ECS_ENTITY_INDEX(Entity)					((Entity) & EU_ECS_ENTITY_INDEX_MASK)
+#define EU_ECS_ENTITY_GENERATION(Entity)			(((Entity) >> EU_ECS_ENTITY_INDEX_BITS) & EU_ECS_ENTITY_GENERATION_MASK)
+#define EU_ECS_MAKE_ENTITY_ID(Index, Generation)	((((Generation) & EU_ECS_ENTITY_GENERATION_MASK) << EU_ECS_ENTITY_INDEX_BITS) | (Index))
+#define EU_ECS_NEXT_ENTITY_GENERATION(Entity)		EU_ECS_MAKE_ENTITY_ID(EU_ECS_ENTITY_INDEX(Entity), EU_ECS_ENTITY_GENERATION(Entity) + 1)
+//Index into ECS::GetAllEntities_(), the first two indices are the invalid and root IDs
+#define EU_ECS_ENTITY_SLOT(Entity)					(EU_ECS_ENTITY_INDEX(Entity) - 2)
+
 #define EU_ECS_MAX_COMPONENTS_A_SYSTEM_CAN_PROCESS 16
+#define EU_ECS_MAX_SYSTEMS 32
+#define EU_ECS_MAX_SYSTEM_SIZE 1024
+#define EU_ECS_PARALLEL_ENTITY_CHUNK_SIZE 256
+//Entities processed between two checks of a systems time budget
+#define EU_ECS_TIME_SLICE_CHUNK_SIZE 16
+#define EU_ECS_DEFAULT_BACKGROUND_TICK_RATE 10.0f
+
+/*
+	Component versions come from one counter shared by the whole ECS. The comparison is done on the
+	signed difference so the counter can wrap around
+*/
+#define EU_ECS_VERSION_NEWER(Version, Since) ((s32)((Version) - (Since)) > 0)
 
 namespace Eunoia
 {
 	typedef u32 ECSID;
 	typedef ECSID EntityID;
 	typedef ECSID SceneID;
+	typedef u32 ECSVersion;
 }
\ No newline at end of file
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "../Common.h"
+#include "../Metadata/Metadata.h"
+#include "ECSTypes.h"
+
+#define EU_ECS_MAX_BATCH_COMPONENT_TYPES (EU_ECS_MAX_COMPONENTS_A_SYSTEM_CAN_PROCESS * 2)
+
+namespace Eunoia {
+
+	struct ECSComponent;
+
+	/*
+		A span of the entities a system matches that are active in the hierarchy, handed to the batch callbacks.
+		components[slot][i] is the component of type componentTypes[slot] on entities[i], the required component
+		types come first followed by the optional ones which can be null
+	*/
+	struct ECSEntityBatch
+	{
+		inline s32 GetComponentSlot(metadata_typeid typeID) const
+		{
+			for (u32 i = 0; i < numComponentTypes; i++)
+				if (componentTypes[i] == typeID)
+					return i;
+
+			return -1;
+		}
+
+		inline ECSEntityBatch GetRange(u32 begin, u32 end) const
+		{
+			ECSEntityBatch range = *this;
+			range.entities = entities + begin;
+			range.numEntities = end - begin;
+			for (u32 i = 0; i < numComponentTypes; i++)
+				range.components[i] = components[i] + begin;
+
+			return range;
+		}
+
+		const EntityID* entities;
+		u32 numEntities;
+		ECSComponent* const* components[EU_ECS_MAX_BATCH_COMPONENT_TYPES];
+		metadata_typeid componentTypes[EU_ECS_MAX_BATCH_COMPONENT_TYPES];
+		u32 numComponentTypes;
+	};
+
+	template<class C, class... Cs>
+	struct ECSViewTypeIndex;
+
+	template<class C, class... Cs>
+	struct ECSViewTypeIndex<C, C, Cs...>
+	{
+		static const u32 value = 0;
+	};
+
+	template<class C, class D, class... Cs>
+	struct ECSViewTypeIndex<C, D, Cs...>
+	{
+		static const u32 value = 1 + ECSViewTypeIndex<C, Cs...>::value;
+	};
+
+	/*
+		Typed access to a batch, the component slots are looked up once when the view is created.
+		Viewing a type the system did not declare gives null components
+	*/
+	template<class... Cs>
+	class ECSView
+	{
+	public:
+		ECSView(const ECSEntityBatch& batch) :
+			m_Batch(&batch)
+		{
+			metadata_typeid types[] = { Metadata::GetTypeID<Cs>()... };
+			for (u32 i = 0; i < sizeof...(Cs); i++)
+			{
+				s32 slot = batch.GetComponentSlot(types[i]);
+				m_Components[i] = slot == -1 ? 0 : batch.components[slot];
+			}
+		}
+
+		inline u32 Size() const { return m_Batch->numEntities; }
+		inline EntityID GetEntity(u32 index) const { return m_Batch->entities[index]; }
+
+		template<class C>
+		inline C* Get(u32 index) const
+		{
+			ECSComponent* const* components = m_Components[ECSViewTypeIndex<C, Cs...>::value];
+			return components ? (C*)components[index] : 0;
+		}
+	private:
+		const ECSEntityBatch* m_Batch;
+		ECSComponent* const* m_Components[sizeof...(Cs)];
+	};
+
+}
@@ -2,3 +2,4 @@
 
 #include "GuiElementOnClickEvent.h"
 #include "RigidBodyTransformModifiedEvent.h"
+#include "SceneStreamedEvent.h"
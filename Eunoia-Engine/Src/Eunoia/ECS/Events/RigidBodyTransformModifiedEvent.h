@@ -7,7 +7,14 @@ namespace Eunoia {
 	EU_REFLECT(Event)
 	struct RigidBodyTransformModifiedEvent : public ECSEvent
 	{
+		RigidBodyTransformModifiedEvent(EntityID entity) :
+			entity(entity)
+		{}
 
+		RigidBodyTransformModifiedEvent()
+		{}
+
+		EU_PROPERTY() EntityID entity;
 	};
 
 }
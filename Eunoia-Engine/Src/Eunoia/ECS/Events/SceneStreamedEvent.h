@@ -0,0 +1,25 @@
+#pragma once
+
+#include "../ECS.h"
+
+namespace Eunoia {
+
+	//Dispatched when a scene requested with ECS::LoadSceneAsync is fully created, or could not be loaded
+	EU_REFLECT(Event)
+	struct SceneStreamedEvent : public ECSEvent
+	{
+		SceneStreamedEvent(ECSSceneStreamID stream, SceneID scene, b32 loaded) :
+			stream(stream),
+			scene(scene),
+			loaded(loaded)
+		{}
+
+		SceneStreamedEvent()
+		{}
+
+		EU_PROPERTY() ECSSceneStreamID stream;
+		EU_PROPERTY() SceneID scene;
+		EU_PROPERTY() b32 loaded;
+	};
+
+}
@@ -35,7 +35,7 @@ namespace Eunoia {
 
 	void Gamepad3DSystem::ProcessEntityOnUpdate(EntityID entity, r32 dt)
 	{
-		Transform3D* transform = &m_ECS->GetComponent<Transform3DComponent>(entity)->localTransform;
+		Transform3D* transform = &m_ECS->GetComponentMutable<Transform3DComponent>(entity)->localTransform;
 		const Gamepad3DComponent* gamepad = m_ECS->GetComponent<Gamepad3DComponent>(entity);
 
 		if (!m_Toggled)
@@ -21,6 +21,7 @@ namespace Eunoia
 	{
 		AddComponentType<GuiComponent>();
 		AddComponentType<Transform2DComponent>();
+		SetProcessInHierarchyOrder(true);
 
 		u32 width = Engine::GetDisplay()->GetWidth();
 		u32 height = Engine::GetDisplay()->GetHeigth();
@@ -42,16 +43,16 @@ namespace Eunoia
 		GuiComponent* guiComponent = m_ECS->GetComponent<GuiComponent>(entity);
 		const Transform2D& transform = m_ECS->GetComponent<Transform2DComponent>(entity)->worldTransform;
 
-		if (guiComponent->affectedByScroll && guiComponent->panel != EU_ECS_INVALID_ENTITY_ID)
+		if (guiComponent->affectedByScroll && m_ECS->DoesEntityExist(guiComponent->panel))
 		{
 			v2 panelPos = m_ECS->GetComponent<Transform2DComponent>(guiComponent->panel)->worldTransform.pos;
 			r32 panelHeight = m_ECS->GetComponent<GuiComponent>(guiComponent->panel)->size.y;
-			EntityID vScrollBar = m_ECS->GetChildEntity(guiComponent->panel, m_ECS->GetEntityName(guiComponent->panel) + "_vScrollBar");
-			EntityID hScrollBar = m_ECS->GetChildEntity(guiComponent->panel, m_ECS->GetEntityName(guiComponent->panel) + "_vScrollBar");
+			EntityID vScrollBar = m_ECS->GetChildEntityWithNameSuffix(guiComponent->panel, "_vScrollBar");
+			EntityID hScrollBar = m_ECS->GetChildEntityWithNameSuffix(guiComponent->panel, "_vScrollBar");
 
 			if (vScrollBar != EU_ECS_INVALID_ENTITY_ID)
 			{
-				EntityID vScrollBarSlider = m_ECS->GetChildEntity(vScrollBar, m_ECS->GetEntityName(vScrollBar) + "_Slider");
+				EntityID vScrollBarSlider = m_ECS->GetChildEntityWithNameSuffix(vScrollBar, "_Slider");
 				r32 localY = m_ECS->GetComponent<Transform2DComponent>(vScrollBarSlider)->localTransform.pos.y - 10;
 				
 				b32 isAbove = (transform.pos.y - localY) < (panelPos.y + 22);
@@ -119,8 +120,7 @@ namespace Eunoia
 				}
 				else if ((element->flags & GUI_CLICK_RESPONSE_FLAG_INTERNAL_CHECKBOX) == GUI_CLICK_RESPONSE_FLAG_INTERNAL_CHECKBOX)
 				{
-					const String& name = m_ECS->GetEntityName(entity);
-					EntityID checkEntity = m_ECS->GetChildEntity(entity, name + "_Check");
+					EntityID checkEntity = m_ECS->GetChildEntityWithNameSuffix(entity, "_Check");
 					m_ECS->SetEntityEnabledOpposite(checkEntity);
 					m_ECS->DispatchEvent<GuiElementOnClickEvent>(entity, EU_BUTTON_LEFT, mousePos, m_ECS->IsEntityEnabled(checkEntity));
 				}
@@ -165,8 +165,8 @@ namespace Eunoia
 	{
 		if (m_MovingElement != EU_ECS_INVALID_ENTITY_ID)
 		{
-			Transform2D* transform = &m_ECS->GetComponent<Transform2DComponent>(m_MovingElement)->localTransform;
-			v2 moveAmount = Engine::GetDisplay()->GetMouseDeltaPos();
+			Transform2D* transform = &m_ECS->GetComponentMutable<Transform2DComponent>(m_MovingElement)->localTransform;
+			v2 moveAmount = Engine::GetDisplay()->GetStepMouseDeltaPos();
 			if (m_MovingElementMoveX && transform->pos.x >= m_MovingElementMin.x && transform->pos.x <= m_MovingElementMax.x)
 			{
 				transform->pos.x += moveAmount.x;
@@ -242,4 +242,12 @@ namespace Eunoia
 		renderer->SetSpritePosOrigin(m_PrevOrigin);
 		//renderer->SetProjection(m_PrevOrtho);
 	}
+
+	//The element being dragged may not exist in the restored state
+	void GuiSystem::OnSnapshotRestored()
+	{
+		m_MovingElement = EU_ECS_INVALID_ENTITY_ID;
+		m_PendingEventLeft = false;
+		m_PendingEventRight = false;
+	}
 }
@@ -15,6 +15,7 @@ namespace Eunoia {
 		virtual void PreRender() override;
 		virtual void ProcessEntityOnRender(EntityID entity) override;
 		virtual void PostRender() override;
+		virtual void OnSnapshotRestored() override;
 	private:
 		friend void DisplayResizeCallback(const DisplayEvent& e, void* userPtr);
 	private:
@@ -13,7 +13,7 @@ namespace Eunoia {
 
 	void KeyboardLookAround3DSystem::ProcessEntityOnUpdate(EntityID entity, r32 dt)
 	{
-		Transform3D* transform = &m_ECS->GetComponent<Transform3DComponent>(entity)->localTransform;
+		Transform3D* transform = &m_ECS->GetComponentMutable<Transform3DComponent>(entity)->localTransform;
 		KeyboardLookAround3DComponent* lookAround = m_ECS->GetComponent<KeyboardLookAround3DComponent>(entity);
 
 		if (EUInput::IsKeyDown(lookAround->up))
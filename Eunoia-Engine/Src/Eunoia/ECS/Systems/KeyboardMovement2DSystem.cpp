@@ -15,7 +15,7 @@ namespace Eunoia {
 	void KeyboardMovement2DSystem::ProcessEntityOnUpdate(EntityID entity, r32 dt)
 	{
 		KeyboardMovement2DComponent* movement = m_ECS->GetComponent<KeyboardMovement2DComponent>(entity);
-		Transform2DComponent* transform = m_ECS->GetComponent<Transform2DComponent>(entity);
+		Transform2DComponent* transform = m_ECS->GetComponentMutable<Transform2DComponent>(entity);
 
 		if (EUInput::IsKeyDown(movement->up))
 		{
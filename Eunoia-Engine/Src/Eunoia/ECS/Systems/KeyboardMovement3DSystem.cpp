@@ -7,14 +7,15 @@ namespace Eunoia {
 
 	KeyboardMovement3DSystem::KeyboardMovement3DSystem()
 	{
-		AddComponentType<KeyboardMovement3DComponent>();
-		AddComponentType<Transform3DComponent>();
+		AddComponentType<KeyboardMovement3DComponent>(ECS_COMPONENT_ACCESS_READ);
+		AddComponentType<Transform3DComponent>(ECS_COMPONENT_ACCESS_READ_WRITE);
+		SetThreading(ECS_SYSTEM_THREADING_PARALLEL_ENTITIES);
 	}
 
 	void KeyboardMovement3DSystem::ProcessEntityOnUpdate(EntityID entity, r32 dt)
 	{
 		const KeyboardMovement3DComponent* movement = m_ECS->GetComponent<KeyboardMovement3DComponent>(entity);
-		Transform3D* transform = &m_ECS->GetComponent<Transform3DComponent>(entity)->localTransform;
+		Transform3D* transform = &m_ECS->GetComponentMutable<Transform3DComponent>(entity)->localTransform;
 
 		r32 speed = movement->speed * dt;
 
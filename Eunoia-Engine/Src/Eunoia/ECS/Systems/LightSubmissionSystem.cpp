@@ -13,7 +13,7 @@ namespace Eunoia {
 
 	void LightSubmissionSystem::ProcessEntityOnRender(EntityID entity)
 	{
-		const Transform3D& transform = m_ECS->GetComponent<Transform3DComponent>(entity)->localTransform;
+		const Transform3D& transform = m_ECS->GetComponent<Transform3DComponent>(entity)->renderTransform;
 		const Light3DComponent* lightComponent = m_ECS->GetComponent<Light3DComponent>(entity);
 
 		Light3D light;
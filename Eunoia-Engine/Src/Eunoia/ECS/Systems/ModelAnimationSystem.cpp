@@ -7,8 +7,9 @@ namespace Eunoia {
 
 	ModelAnimationSystem::ModelAnimationSystem()
 	{
-		AddComponentType<ModelAnimationComponent>();
-		AddComponentType<ModelComponent>();
+		AddComponentType<ModelAnimationComponent>(ECS_COMPONENT_ACCESS_READ_WRITE);
+		AddComponentType<ModelComponent>(ECS_COMPONENT_ACCESS_READ);
+		SetThreading(ECS_SYSTEM_THREADING_PARALLEL_ENTITIES);
 	}
 
 	void ModelAnimationSystem::ProcessEntityOnUpdate(EntityID entity, r32 dt)
@@ -11,53 +11,50 @@ namespace Eunoia {
 
 	ModelSubmissionSystem::ModelSubmissionSystem()
 	{
-		AddComponentType<ModelComponent>();
-		AddComponentType<Transform3DComponent>();
+		AddComponentType<ModelComponent>(ECS_COMPONENT_ACCESS_READ);
+		AddComponentType<Transform3DComponent>(ECS_COMPONENT_ACCESS_READ);
+		AddOptionalComponentType<MaterialComponent>(ECS_COMPONENT_ACCESS_READ);
+		AddOptionalComponentType<ModelAnimationComponent>(ECS_COMPONENT_ACCESS_READ);
+		SetBatchProcessing(true);
 	}
 
-	void ModelSubmissionSystem::ProcessEntityOnRender(EntityID entity)
+	void ModelSubmissionSystem::ProcessBatchOnRender(const ECSEntityBatch& batch)
 	{
 		Renderer3D* renderer = Engine::GetRenderer()->GetRenderer3D();
+		ECS::View<ModelComponent, Transform3DComponent, MaterialComponent, ModelAnimationComponent> view(batch);
 
-		ModelComponent* modelComponent = m_ECS->GetComponent<ModelComponent>(entity);
-		m4 transform = m_ECS->GetComponent<Transform3DComponent>(entity)->worldTransform.CreateTransformMatrix();
-		MaterialComponent* materialComponent = m_ECS->GetComponent<MaterialComponent>(entity);
-		ModelAnimationComponent* animationComponent = m_ECS->GetComponent<ModelAnimationComponent>(entity);
-
-		const Model& model = AssetManager::GetModel(modelComponent->model);
-
-		if (modelComponent->wireframe)
+		for (u32 i = 0; i < view.Size(); i++)
 		{
-			renderer->SubmitWireframeModel(model, transform);
-			return;
-		}
+			EntityID entity = view.GetEntity(i);
+			ModelComponent* modelComponent = view.Get<ModelComponent>(i);
+			const m4& transform = view.Get<Transform3DComponent>(i)->renderMatrix;
+			MaterialComponent* materialComponent = view.Get<MaterialComponent>(i);
+			ModelAnimationComponent* animationComponent = view.Get<ModelAnimationComponent>(i);
 
-		if (materialComponent)
-		{
-			Model modelCustomMaterial = model;
-			for (u32 i = 0; i < modelCustomMaterial.materials.Size(); i++)
-				modelCustomMaterial.materials[i] = materialComponent->material;
-			for (u32 i = 0; i < modelCustomMaterial.modifiers.Size(); i++)
-				modelCustomMaterial.modifiers[i] = materialComponent->modifier;
+			const Model& model = AssetManager::GetModel(modelComponent->model);
 
-			if (animationComponent)
-			{
-				renderer->SubmitModel(modelCustomMaterial, transform, &animationComponent->boneTransforms[0], animationComponent->boneTransforms.Size(), true, entity);
-			}
-			else
+			if (modelComponent->wireframe)
 			{
-				renderer->SubmitModel(modelCustomMaterial, transform, 0, 0, false, entity);
+				renderer->SubmitWireframeModel(model, transform);
+				continue;
 			}
-		}
-		else
-		{
-			if (animationComponent)
+
+			m4* boneTransforms = animationComponent ? &animationComponent->boneTransforms[0] : 0;
+			u32 numBoneTransforms = animationComponent ? animationComponent->boneTransforms.Size() : 0;
+
+			if (materialComponent)
 			{
-				renderer->SubmitModel(model, transform, &animationComponent->boneTransforms[0], animationComponent->boneTransforms.Size(), true, entity);
+				Model modelCustomMaterial = model;
+				for (u32 j = 0; j < modelCustomMaterial.materials.Size(); j++)
+					modelCustomMaterial.materials[j] = materialComponent->material;
+				for (u32 j = 0; j < modelCustomMaterial.modifiers.Size(); j++)
+					modelCustomMaterial.modifiers[j] = materialComponent->modifier;
+
+				renderer->SubmitModel(modelCustomMaterial, transform, boneTransforms, numBoneTransforms, animationComponent != 0, entity);
 			}
 			else
 			{
-				renderer->SubmitModel(model, transform, 0, 0, false, entity);
+				renderer->SubmitModel(model, transform, boneTransforms, numBoneTransforms, animationComponent != 0, entity);
 			}
 		}
 	}
@@ -9,7 +9,7 @@ namespace Eunoia {
 	{
 	public:
 		ModelSubmissionSystem();
-		virtual void ProcessEntityOnRender(EntityID entity) override;
+		virtual void ProcessBatchOnRender(const ECSEntityBatch& batch) override;
 	};
 
 }
\ No newline at end of file
@@ -34,7 +34,7 @@ namespace Eunoia {
 	void MouseLookAround3DSystem::ProcessEntityOnUpdate(EntityID entity, r32 dt)
 	{
 		const MouseLookAround3DComponent* lookAround = m_ECS->GetComponent<MouseLookAround3DComponent>(entity);
-		Transform3D* transform = &m_ECS->GetComponent<Transform3DComponent>(entity)->localTransform;
+		Transform3D* transform = &m_ECS->GetComponentMutable<Transform3DComponent>(entity)->localTransform;
 		
 		Display* display = Engine::GetDisplay();
 		v2 centerPos = v2(display->GetWidth() / 2, display->GetHeigth() / 2);
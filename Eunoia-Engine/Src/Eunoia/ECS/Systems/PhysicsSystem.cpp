@@ -11,6 +11,7 @@ namespace Eunoia {
 	{
 		AddComponentType<RigidBodyComponent>();
 		AddComponentType<Transform3DComponent>();
+		SetBatchProcessing(true);
 	}
 
 	void PhysicsSystem::Init()
@@ -19,71 +20,88 @@ namespace Eunoia {
 		m_BoundingBox = EU_MODEL_CUBE_ID;
 	}
 
-	void PhysicsSystem::PrePhysicsSimulation(EntityID entity, r32 dt)
+	void PhysicsSystem::PrePhysicsSimulationBatch(const ECSEntityBatch& batch, r32 dt)
 	{
-		//if (m_ECS->CheckForEvent<RigidBodyTransformModifiedEvent>())
-		//{
-			btRigidBody* rigidBody = m_ECS->GetComponent<RigidBodyComponent>(entity)->body.GetRigidBody();
-			Transform3D* transform = &m_ECS->GetComponent<Transform3DComponent>(entity)->worldTransform;
+		ECS::View<RigidBodyComponent, Transform3DComponent> view(batch);
+		for (u32 i = 0; i < view.Size(); i++)
+		{
+			btRigidBody* rigidBody = view.Get<RigidBodyComponent>(i)->body.GetRigidBody();
+			const Transform3D& transform = view.Get<Transform3DComponent>(i)->worldTransform;
 
 			if (!rigidBody)
-				return;
+				continue;
 
 			btTransform rt;
-			rt.setOrigin(PhysicsEngine3D::ToBulletVector(transform->pos));
-			rt.setRotation(PhysicsEngine3D::ToBulletQuat(transform->rot));
+			rt.setOrigin(PhysicsEngine3D::ToBulletVector(transform.pos));
+			rt.setRotation(PhysicsEngine3D::ToBulletQuat(transform.rot));
 			rigidBody->setWorldTransform(rt);
-
-			//m_ECS->ResetPendingEvent<RigidBodyTransformModifiedEvent>();
-		//}
+		}
 	}
 
-	void PhysicsSystem::PostPhysicsSimulation(EntityID entity, r32 dt)
+	void PhysicsSystem::PostPhysicsSimulationBatch(const ECSEntityBatch& batch, r32 dt)
 	{
-		btRigidBody* rigidBody = m_ECS->GetComponent<RigidBodyComponent>(entity)->body.GetRigidBody();
-		Transform3D* transform = &m_ECS->GetComponent<Transform3DComponent>(entity)->localTransform;
-		rigidBody->setActivationState(ACTIVE_TAG);
+		ECS::View<RigidBodyComponent, Transform3DComponent> view(batch);
+		for (u32 i = 0; i < view.Size(); i++)
+		{
+			btRigidBody* rigidBody = view.Get<RigidBodyComponent>(i)->body.GetRigidBody();
+			Transform3DComponent* transformComponent = view.Get<Transform3DComponent>(i);
+			Transform3D* transform = &transformComponent->localTransform;
+
+			if (!rigidBody)
+				continue;
+
+			rigidBody->setActivationState(ACTIVE_TAG);
 
-		if (!rigidBody)
-			return;
+			const btTransform& rt = rigidBody->getWorldTransform();
+			v3 pos = PhysicsEngine3D::ToEngineVector(rt.getOrigin());
+			quat rot = PhysicsEngine3D::ToEngineQuat(rt.getRotation());
 
-		const btTransform& rt = rigidBody->getWorldTransform();
-		transform->pos = PhysicsEngine3D::ToEngineVector(rt.getOrigin());
-		transform->rot = PhysicsEngine3D::ToEngineQuat(rt.getRotation());
+			//Resting bodies leave their transform untouched so the hierarchy doesn't propagate them again
+			if (pos == transform->pos && rot == transform->rot)
+				continue;
+
+			transform->pos = pos;
+			transform->rot = rot;
+			m_ECS->MarkComponentChanged(transformComponent);
+		}
 	}
 
-	void PhysicsSystem::ProcessEntityOnRender(EntityID entity)
+	void PhysicsSystem::ProcessBatchOnRender(const ECSEntityBatch& batch)
 	{
-		RigidBodyComponent* rigidBodyComponent = m_ECS->GetComponent<RigidBodyComponent>(entity);
-
-		if (!rigidBodyComponent->body.WasRigidBodyCreated())
-			return;
+		Renderer3D* renderer = Engine::GetRenderer()->GetRenderer3D();
+		ECS::View<RigidBodyComponent, Transform3DComponent> view(batch);
 
-		if (rigidBodyComponent->debugDraw || rigidBodyComponent->forceDraw)
+		for (u32 i = 0; i < view.Size(); i++)
 		{
-			const Transform3D& transform = m_ECS->GetComponent<Transform3DComponent>(entity)->worldTransform;
+			RigidBodyComponent* rigidBodyComponent = view.Get<RigidBodyComponent>(i);
+
+			if (!rigidBodyComponent->body.WasRigidBodyCreated())
+				continue;
+
+			if (!rigidBodyComponent->debugDraw && !rigidBodyComponent->forceDraw)
+				continue;
+
+			const m4& worldMatrix = view.Get<Transform3DComponent>(i)->renderMatrix;
 
 			btRigidBody* btRigidBody = rigidBodyComponent->body.GetRigidBody();
 			btCompoundShape* shapes = (btCompoundShape*)btRigidBody->getCollisionShape();
-			Renderer3D* renderer = Engine::GetRenderer()->GetRenderer3D();
-			for (u32 i = 0; i < shapes->getNumChildShapes(); i++)
+			for (u32 j = 0; j < shapes->getNumChildShapes(); j++)
 			{
-				btCollisionShape* shape = shapes->getChildShape(i);
-				const btTransform& localTransform = shapes->getChildTransform(i);
-				Transform3D finalTransform(PhysicsEngine3D::ToEngineVector(localTransform.getOrigin()), v3(1.0f, 1.0f, 1.0f), PhysicsEngine3D::ToEngineQuat(localTransform.getRotation()));
-				finalTransform = transform * finalTransform;
+				btCollisionShape* shape = shapes->getChildShape(j);
+				const btTransform& localTransform = shapes->getChildTransform(j);
+				Transform3D shapeTransform(PhysicsEngine3D::ToEngineVector(localTransform.getOrigin()), v3(1.0f, 1.0f, 1.0f), PhysicsEngine3D::ToEngineQuat(localTransform.getRotation()));
 
 				switch (shape->getShapeType())
 				{
 					case SPHERE_SHAPE_PROXYTYPE: {
 						const Model& sphereModel = AssetManager::GetModel(m_BoundingSphere);
-						finalTransform.Scale(((btSphereShape*)shape)->getRadius());
-						renderer->SubmitWireframeModel(sphereModel, finalTransform.CreateTransformMatrix());
+						shapeTransform.Scale(((btSphereShape*)shape)->getRadius());
+						renderer->SubmitWireframeModel(sphereModel, worldMatrix * shapeTransform.CreateTransformMatrix());
 					} break;
 					case BOX_SHAPE_PROXYTYPE: {
 						const Model& cubeModel = AssetManager::GetModel(m_BoundingBox);
-						finalTransform.Scale(PhysicsEngine3D::ToEngineVector(((btBoxShape*)shape)->getHalfExtentsWithoutMargin()));
-						renderer->SubmitWireframeModel(cubeModel, finalTransform.CreateTransformMatrix());
+						shapeTransform.Scale(PhysicsEngine3D::ToEngineVector(((btBoxShape*)shape)->getHalfExtentsWithoutMargin()));
+						renderer->SubmitWireframeModel(cubeModel, worldMatrix * shapeTransform.CreateTransformMatrix());
 					} break;
 				}
 			}
@@ -12,9 +12,9 @@ namespace Eunoia {
 		PhysicsSystem();
 
 		virtual void Init() override;
-		virtual void PrePhysicsSimulation(EntityID entity, r32 dt) override;
-		virtual void PostPhysicsSimulation(EntityID entity, r32 dt) override;
-		virtual void ProcessEntityOnRender(EntityID entity) override;
+		virtual void PrePhysicsSimulationBatch(const ECSEntityBatch& batch, r32 dt) override;
+		virtual void PostPhysicsSimulationBatch(const ECSEntityBatch& batch, r32 dt) override;
+		virtual void ProcessBatchOnRender(const ECSEntityBatch& batch) override;
 	private:
 		ModelID m_BoundingSphere;
 		ModelID m_BoundingBox;
@@ -0,0 +1,105 @@
+#include "SpatialIndex3DSystem.h"
+#include "TransformHierarchy3DSystem.h"
+#include "../Components/Transform3DComponet.h"
+#include "../Components/SpatialIndex3DComponent.h"
+#include "../../Core/Benchmark.h"
+
+#define EU_SPATIAL_INDEX_BENCHMARK_WORLD_SIZE 1000.0f
+#define EU_SPATIAL_INDEX_BENCHMARK_NUM_QUERIES 1000
+
+namespace Eunoia {
+
+	//What a proximity check costs without the index, every transform is tested
+	static u32 QuerySphereWithScan(ECS* ecs, const ECSEntityList& entities, const v3& center, r32 radius)
+	{
+		u32 numFound = 0;
+		for (u32 i = 0; i < entities.Size(); i++)
+		{
+			const Transform3DComponent* transform = ecs->GetComponent<Transform3DComponent>(entities[i]);
+			const SpatialIndex3DComponent* bounds = ecs->GetComponent<SpatialIndex3DComponent>(entities[i]);
+			r32 maxDistance = radius + bounds->radius;
+			v3 offset = transform->worldTransform.pos - center;
+			if (offset.Dot(offset) <= maxDistance * maxDistance)
+				numFound++;
+		}
+
+		return numFound;
+	}
+
+	static v3 GetRandomPosition()
+	{
+		r32 halfSize = EU_SPATIAL_INDEX_BENCHMARK_WORLD_SIZE * 0.5f;
+		return v3(EU_RANDOM_FLOAT(-halfSize, halfSize), EU_RANDOM_FLOAT(-halfSize, halfSize), EU_RANDOM_FLOAT(-halfSize, halfSize));
+	}
+
+	void SpatialIndex3DSystem::RunBenchmark(u32 numEntities)
+	{
+		BenchmarkSamples buildTime, staticTime, movedTime, queryTime, batchTime, scanTime;
+		u32 numMoved = 0, numFound = 0, numQueries = EU_SPATIAL_INDEX_BENCHMARK_NUM_QUERIES;
+		for (u32 sample = 0; sample < EU_BENCHMARK_NUM_SAMPLES; sample++)
+		{
+			//A fresh scene every sample so the build is measured cold
+			ECSBenchmarkScene scene;
+			scene.Create("SpatialIndexBenchmark", numEntities);
+			ECS* ecs = scene.ecs;
+			numMoved = scene.numMoved;
+
+			for (u32 i = 0; i < numEntities; i++)
+			{
+				ecs->GetComponentMutable<Transform3DComponent>(scene.entities[i])->localTransform.pos = GetRandomPosition();
+				ecs->CreateComponent<SpatialIndex3DComponent>(scene.entities[i], EU_RANDOM_FLOAT(0.5f, 4.0f));
+			}
+			ecs->CreateSystem<TransformHierarchy3DSystem>();
+			SpatialIndex3DSystem* system = ecs->CreateSystem<SpatialIndex3DSystem>();
+
+			BenchmarkTimer timer;
+			ecs->UpdateSystems(0.0f);
+			buildTime.Add(timer.GetElapsedMicroseconds());
+
+			timer.Restart();
+			ecs->UpdateSystems(0.0f);
+			staticTime.Add(timer.GetElapsedMicroseconds());
+
+			for (u32 i = 0; i < numMoved; i++)
+				ecs->GetComponentMutable<Transform3DComponent>(scene.entities[i])->localTransform.pos = GetRandomPosition();
+			timer.Restart();
+			ecs->UpdateSystems(0.0f);
+			movedTime.Add(timer.GetElapsedMicroseconds());
+
+			List<SpatialQuery> queries(numQueries);
+			queries.SetCapacityAndElementCount(numQueries);
+			for (u32 i = 0; i < queries.Size(); i++)
+			{
+				queries[i].type = SPATIAL_QUERY_SPHERE;
+				queries[i].center = GetRandomPosition();
+				queries[i].radius = 20.0f;
+			}
+
+			timer.Restart();
+			numFound = 0;
+			for (u32 i = 0; i < queries.Size(); i++)
+			{
+				queries[i].results.Clear();
+				system->QuerySphere(queries[i].center, queries[i].radius, &queries[i].results);
+				numFound += queries[i].results.Size();
+			}
+			queryTime.Add(timer.GetElapsedMicroseconds());
+
+			timer.Restart();
+			system->RunQueries(&queries[0], queries.Size());
+			batchTime.Add(timer.GetElapsedMicroseconds());
+
+			//A tenth of the queries is enough to see the difference
+			u32 numScans = EU_MAX(queries.Size() / 10, 1);
+			timer.Restart();
+			for (u32 i = 0; i < numScans; i++)
+				QuerySphereWithScan(ecs, system->GetEntities(), queries[i].center, queries[i].radius);
+			scanTime.Add(timer.GetElapsedMicroseconds() * ((r64)queries.Size() / numScans));
+		}
+
+		EU_LOG_BENCHMARK("SpatialIndex3D", "{0} entities, build {1:.0f}us, nothing moved {2:.0f}us, {3} moved {4:.0f}us, {5} sphere queries {6:.0f}us ({7} found), batched {8:.0f}us, scanning {9:.0f}us",
+			numEntities, buildTime.GetMedian(), staticTime.GetMedian(), numMoved, movedTime.GetMedian(), numQueries, queryTime.GetMedian(), numFound,
+			batchTime.GetMedian(), scanTime.GetMedian());
+	}
+
+}
@@ -0,0 +1,442 @@
+#include "SpatialIndex3DSystem.h"
+#include "../Components/Transform3DComponet.h"
+#include "../Components/SpatialIndex3DComponent.h"
+#include "../../Core/JobSystem.h"
+#include <cfloat>
+#include <cstdlib>
+
+//Cell coordinates are packed into 21 bits each
+#define EU_SPATIAL_INDEX_CELL_BITS 21
+#define EU_SPATIAL_INDEX_CELL_MASK ((1 << EU_SPATIAL_INDEX_CELL_BITS) - 1)
+#define EU_SPATIAL_INDEX_MAX_CELL ((1 << (EU_SPATIAL_INDEX_CELL_BITS - 1)) - 1)
+//Never produced by packing cell coordinates, marks entries in the large list
+#define EU_SPATIAL_INDEX_LARGE_CELL EU_U64_MAX
+
+namespace Eunoia {
+
+	static inline u64 PackCellCoords(s32 x, s32 y, s32 z)
+	{
+		return ((u64)((u32)x & EU_SPATIAL_INDEX_CELL_MASK)) |
+			((u64)((u32)y & EU_SPATIAL_INDEX_CELL_MASK) << EU_SPATIAL_INDEX_CELL_BITS) |
+			((u64)((u32)z & EU_SPATIAL_INDEX_CELL_MASK) << (EU_SPATIAL_INDEX_CELL_BITS * 2));
+	}
+
+	static inline s32 UnpackCellCoord(u64 key, u32 axis)
+	{
+		u32 coord = (u32)(key >> (EU_SPATIAL_INDEX_CELL_BITS * axis)) & EU_SPATIAL_INDEX_CELL_MASK;
+		return (s32)(coord << (32 - EU_SPATIAL_INDEX_CELL_BITS)) >> (32 - EU_SPATIAL_INDEX_CELL_BITS);
+	}
+
+	static inline b32 SphereOverlapsAABB(const v3& center, r32 radius, const v3& min, const v3& max)
+	{
+		v3 closest = center.Max(min).Min(max);
+		v3 offset = center - closest;
+		return offset.Dot(offset) <= radius * radius;
+	}
+
+	static inline b32 SphereOverlapsFrustum(const v3& center, r32 radius, const v4* planes, u32 numPlanes)
+	{
+		for (u32 i = 0; i < numPlanes; i++)
+			if (planes[i].x * center.x + planes[i].y * center.y + planes[i].z * center.z + planes[i].w < -radius)
+				return false;
+
+		return true;
+	}
+
+	//Tests the corner of the box furthest along each plane normal
+	static inline b32 AABBOverlapsFrustum(const v3& min, const v3& max, const v4* planes, u32 numPlanes)
+	{
+		for (u32 i = 0; i < numPlanes; i++)
+		{
+			const v4& plane = planes[i];
+			v3 corner(plane.x >= 0.0f ? max.x : min.x, plane.y >= 0.0f ? max.y : min.y, plane.z >= 0.0f ? max.z : min.z);
+			if (plane.x * corner.x + plane.y * corner.y + plane.z * corner.z + plane.w < 0.0f)
+				return false;
+		}
+
+		return true;
+	}
+
+	SpatialIndex3DSystem::SpatialIndex3DSystem() :
+		m_CellSize(EU_SPATIAL_INDEX_DEFAULT_CELL_SIZE),
+		m_InvCellSize(1.0f / EU_SPATIAL_INDEX_DEFAULT_CELL_SIZE),
+		m_Sweep(0),
+		m_IndexedHierarchyVersion(EU_U32_MAX),
+		m_IndexedEntityListVersion(EU_U32_MAX)
+	{
+		AddComponentType<Transform3DComponent>(ECS_COMPONENT_ACCESS_READ);
+		AddComponentType<SpatialIndex3DComponent>(ECS_COMPONENT_ACCESS_READ);
+		SetBatchProcessing(true);
+	}
+
+	//Calls function(entries, looseMin, looseMax) for every occupied cell an entry overlapping [min, max] can be in
+	template<class F>
+	void SpatialIndex3DSystem::ForEachCell(const v3& min, const v3& max, const F& function) const
+	{
+		v3 looseExtent(m_CellSize, m_CellSize, m_CellSize);
+		s32 minCell[3];
+		s32 maxCell[3];
+		GetCellCoords(min - looseExtent, minCell);
+		GetCellCoords(max + looseExtent, maxCell);
+
+		auto visitCell = [&](const List<u32>& entries, s32 x, s32 y, s32 z)
+		{
+			v3 cellMin = v3((r32)x, (r32)y, (r32)z) * m_CellSize;
+			function(entries, cellMin - looseExtent, cellMin + looseExtent * 2.0f);
+		};
+
+		//Big ranges walk the occupied cells instead of every cell in the range
+		r64 numCells = (r64)(maxCell[0] - minCell[0] + 1) * (r64)(maxCell[1] - minCell[1] + 1) * (r64)(maxCell[2] - minCell[2] + 1);
+		if (numCells > (r64)m_Cells.size())
+		{
+			for (auto it = m_Cells.begin(); it != m_Cells.end(); it++)
+			{
+				s32 x = UnpackCellCoord(it->first, 0);
+				s32 y = UnpackCellCoord(it->first, 1);
+				s32 z = UnpackCellCoord(it->first, 2);
+				if (x >= minCell[0] && x <= maxCell[0] && y >= minCell[1] && y <= maxCell[1] && z >= minCell[2] && z <= maxCell[2])
+					visitCell(it->second, x, y, z);
+			}
+			return;
+		}
+
+		for (s32 x = minCell[0]; x <= maxCell[0]; x++)
+			for (s32 y = minCell[1]; y <= maxCell[1]; y++)
+				for (s32 z = minCell[2]; z <= maxCell[2]; z++)
+				{
+					auto it = m_Cells.find(PackCellCoords(x, y, z));
+					if (it != m_Cells.end())
+						visitCell(it->second, x, y, z);
+				}
+	}
+
+	void SpatialIndex3DSystem::ProcessBatchOnUpdate(const ECSEntityBatch& batch, r32 dt)
+	{
+		//Entities leave the batch when they are destroyed, disabled or lose a component, only then are missing entries looked for
+		b32 sweep = m_IndexedHierarchyVersion != m_ECS->GetHierarchyVersion() || m_IndexedEntityListVersion != GetEntities().version;
+		if (sweep)
+		{
+			m_Sweep++;
+			m_IndexedHierarchyVersion = m_ECS->GetHierarchyVersion();
+			m_IndexedEntityListVersion = GetEntities().version;
+		}
+
+		ECS::View<Transform3DComponent, SpatialIndex3DComponent> view(batch);
+		for (u32 i = 0; i < view.Size(); i++)
+		{
+			EntityID entity = view.GetEntity(i);
+			u32 entityIndex = EU_ECS_ENTITY_INDEX(entity);
+			while (entityIndex >= m_EntryIndices.Size())
+				m_EntryIndices.Push(EU_U32_MAX);
+
+			u32 entryIndex = m_EntryIndices[entityIndex];
+			if (entryIndex != EU_U32_MAX && m_Entries[entryIndex].entity != entity)
+			{
+				RemoveEntry(entryIndex);
+				entryIndex = EU_U32_MAX;
+			}
+
+			Transform3DComponent* transform = view.Get<Transform3DComponent>(i);
+			SpatialIndex3DComponent* bounds = view.Get<SpatialIndex3DComponent>(i);
+			if (entryIndex != EU_U32_MAX && !HasComponentChanged(transform) && !HasComponentChanged(bounds))
+			{
+				m_Entries[entryIndex].sweep = m_Sweep;
+				continue;
+			}
+
+			const m4& world = transform->worldMatrix;
+			const v3& c = bounds->center;
+			v3 center(world[0][0] * c.x + world[0][1] * c.y + world[0][2] * c.z + world[0][3],
+				world[1][0] * c.x + world[1][1] * c.y + world[1][2] * c.z + world[1][3],
+				world[2][0] * c.x + world[2][1] * c.y + world[2][2] * c.z + world[2][3]);
+			const v3& scale = transform->worldTransform.scale;
+			r32 radius = bounds->radius * EU_MAX(EU_MAX(fabsf(scale.x), fabsf(scale.y)), fabsf(scale.z));
+
+			if (entryIndex == EU_U32_MAX)
+			{
+				entryIndex = m_Entries.Size();
+				m_EntryIndices[entityIndex] = entryIndex;
+
+				SpatialIndexEntry entry;
+				entry.entity = entity;
+				entry.center = center;
+				entry.radius = radius;
+				entry.sweep = m_Sweep;
+				m_Entries.Push(entry);
+				InsertEntry(entryIndex);
+				continue;
+			}
+
+			SpatialIndexEntry* entry = &m_Entries[entryIndex];
+			entry->center = center;
+			entry->radius = radius;
+			entry->sweep = m_Sweep;
+
+			u64 cell = radius > m_CellSize ? EU_SPATIAL_INDEX_LARGE_CELL : GetCellKey(center);
+			if (cell != entry->cell)
+			{
+				RemoveFromCell(entryIndex);
+				InsertEntry(entryIndex);
+			}
+		}
+
+		if (sweep)
+		{
+			//Backwards so the entry swapped into a removed slot has already been looked at
+			for (u32 i = m_Entries.Size(); i > 0; i--)
+				if (m_Entries[i - 1].sweep != m_Sweep)
+					RemoveEntry(i - 1);
+		}
+	}
+
+	//The entries point at entities of the state before the restore, the next update indexes everything again
+	void SpatialIndex3DSystem::OnSnapshotRestored()
+	{
+		Clear();
+		m_IndexedHierarchyVersion = EU_U32_MAX;
+		m_IndexedEntityListVersion = EU_U32_MAX;
+	}
+
+	void SpatialIndex3DSystem::SetCellSize(r32 cellSize)
+	{
+		m_CellSize = cellSize;
+		m_InvCellSize = 1.0f / cellSize;
+		Clear();
+	}
+
+	r32 SpatialIndex3DSystem::GetCellSize() const
+	{
+		return m_CellSize;
+	}
+
+	u32 SpatialIndex3DSystem::GetNumIndexed() const
+	{
+		return m_Entries.Size();
+	}
+
+	void SpatialIndex3DSystem::QuerySphere(const v3& center, r32 radius, List<EntityID>* results) const
+	{
+		auto queryEntries = [&](const List<u32>& entries)
+		{
+			for (u32 i = 0; i < entries.Size(); i++)
+			{
+				const SpatialIndexEntry& entry = m_Entries[entries[i]];
+				v3 offset = entry.center - center;
+				r32 maxDistance = radius + entry.radius;
+				if (offset.Dot(offset) <= maxDistance * maxDistance)
+					results->Push(entry.entity);
+			}
+		};
+
+		queryEntries(m_LargeEntries);
+		v3 extent(radius, radius, radius);
+		ForEachCell(center - extent, center + extent, [&](const List<u32>& entries, const v3& cellMin, const v3& cellMax)
+		{
+			if (SphereOverlapsAABB(center, radius, cellMin, cellMax))
+				queryEntries(entries);
+		});
+	}
+
+	void SpatialIndex3DSystem::QueryAABB(const v3& min, const v3& max, List<EntityID>* results) const
+	{
+		auto queryEntries = [&](const List<u32>& entries)
+		{
+			for (u32 i = 0; i < entries.Size(); i++)
+			{
+				const SpatialIndexEntry& entry = m_Entries[entries[i]];
+				if (SphereOverlapsAABB(entry.center, entry.radius, min, max))
+					results->Push(entry.entity);
+			}
+		};
+
+		queryEntries(m_LargeEntries);
+		ForEachCell(min, max, [&](const List<u32>& entries, const v3& cellMin, const v3& cellMax)
+		{
+			queryEntries(entries);
+		});
+	}
+
+	void SpatialIndex3DSystem::QueryFrustum(const v4* planes, u32 numPlanes, List<EntityID>* results) const
+	{
+		auto queryEntries = [&](const List<u32>& entries)
+		{
+			for (u32 i = 0; i < entries.Size(); i++)
+			{
+				const SpatialIndexEntry& entry = m_Entries[entries[i]];
+				if (SphereOverlapsFrustum(entry.center, entry.radius, planes, numPlanes))
+					results->Push(entry.entity);
+			}
+		};
+
+		//Frustums are rarely small enough to walk the cells they touch, every occupied cell is tested against the planes instead
+		queryEntries(m_LargeEntries);
+		ForEachCell(v3(-FLT_MAX, -FLT_MAX, -FLT_MAX), v3(FLT_MAX, FLT_MAX, FLT_MAX), [&](const List<u32>& entries, const v3& cellMin, const v3& cellMax)
+		{
+			if (AABBOverlapsFrustum(cellMin, cellMax, planes, numPlanes))
+				queryEntries(entries);
+		});
+	}
+
+	EntityID SpatialIndex3DSystem::QueryNearest(const v3& point, r32 maxDistance, r32* distance) const
+	{
+		EntityID nearest = EU_ECS_INVALID_ENTITY_ID;
+		r32 nearestDistance = maxDistance;
+		auto queryEntries = [&](const List<u32>& entries)
+		{
+			for (u32 i = 0; i < entries.Size(); i++)
+			{
+				const SpatialIndexEntry& entry = m_Entries[entries[i]];
+				r32 entryDistance = EU_MAX((entry.center - point).Length() - entry.radius, 0.0f);
+				if (entryDistance < nearestDistance || (entryDistance == nearestDistance && nearest == EU_ECS_INVALID_ENTITY_ID))
+				{
+					nearest = entry.entity;
+					nearestDistance = entryDistance;
+				}
+			}
+		};
+
+		queryEntries(m_LargeEntries);
+
+		s32 pointCell[3];
+		GetCellCoords(point, pointCell);
+		r64 maxRing = EU_MIN((r64)maxDistance * m_InvCellSize + 2.0, (r64)EU_SPATIAL_INDEX_MAX_CELL);
+		r64 ringCells = (2.0 * maxRing + 1.0) * (2.0 * maxRing + 1.0) * (2.0 * maxRing + 1.0);
+		if (ringCells > (r64)m_Cells.size())
+		{
+			for (auto it = m_Cells.begin(); it != m_Cells.end(); it++)
+				queryEntries(it->second);
+		}
+		else
+		{
+			/*
+				Grows a cube of cells around the point one shell at a time. The centers in shell r are at least (r - 1) cells away and the
+				radius of an entry in a cell is at most one cell, nothing past shell r can beat a distance of (r - 1) cells
+			*/
+			for (s32 ring = 0; ring <= (s32)maxRing; ring++)
+			{
+				for (s32 x = -ring; x <= ring; x++)
+					for (s32 y = -ring; y <= ring; y++)
+						for (s32 z = -ring; z <= ring; z++)
+						{
+							if (EU_MAX(EU_MAX(abs(x), abs(y)), abs(z)) != ring)
+								continue;
+
+							auto it = m_Cells.find(PackCellCoords(pointCell[0] + x, pointCell[1] + y, pointCell[2] + z));
+							if (it != m_Cells.end())
+								queryEntries(it->second);
+						}
+
+				if (nearest != EU_ECS_INVALID_ENTITY_ID && nearestDistance <= (ring - 1) * m_CellSize)
+					break;
+			}
+		}
+
+		if (distance)
+			*distance = nearestDistance;
+
+		return nearest;
+	}
+
+	void SpatialIndex3DSystem::RunQueries(SpatialQuery* queries, u32 numQueries) const
+	{
+		JobSystem::ParallelFor(numQueries, 1, [&](u32 i)
+		{
+			SpatialQuery* query = &queries[i];
+			query->results.Clear();
+			switch (query->type)
+			{
+			case SPATIAL_QUERY_SPHERE: QuerySphere(query->center, query->radius, &query->results); break;
+			case SPATIAL_QUERY_AABB: QueryAABB(query->min, query->max, &query->results); break;
+			case SPATIAL_QUERY_FRUSTUM: QueryFrustum(query->planes, query->numPlanes, &query->results); break;
+			}
+		});
+	}
+
+	void SpatialIndex3DSystem::ExtractFrustumPlanes(const m4& viewProjection, v4 planes[6])
+	{
+		//Left, right, bottom, top, near, far from the rows of the matrix, clip space z is -w to w
+		const r32* w = viewProjection[3];
+		for (u32 i = 0; i < 6; i++)
+		{
+			const r32* row = viewProjection[i / 2];
+			r32 sign = (i % 2) == 0 ? 1.0f : -1.0f;
+			v4 plane(w[0] + row[0] * sign, w[1] + row[1] * sign, w[2] + row[2] * sign, w[3] + row[3] * sign);
+
+			r32 length = sqrtf(plane.x * plane.x + plane.y * plane.y + plane.z * plane.z);
+			planes[i] = v4(plane.x / length, plane.y / length, plane.z / length, plane.w / length);
+		}
+	}
+
+	void SpatialIndex3DSystem::Clear()
+	{
+		m_Entries.Clear();
+		m_EntryIndices.Clear();
+		m_Cells.clear();
+		m_LargeEntries.Clear();
+	}
+
+	void SpatialIndex3DSystem::InsertEntry(u32 entryIndex)
+	{
+		SpatialIndexEntry* entry = &m_Entries[entryIndex];
+		entry->cell = entry->radius > m_CellSize ? EU_SPATIAL_INDEX_LARGE_CELL : GetCellKey(entry->center);
+
+		List<u32>& entries = entry->cell == EU_SPATIAL_INDEX_LARGE_CELL ? m_LargeEntries : m_Cells[entry->cell];
+		entry->cellSlot = entries.Size();
+		entries.Push(entryIndex);
+	}
+
+	void SpatialIndex3DSystem::RemoveFromCell(u32 entryIndex)
+	{
+		const SpatialIndexEntry& entry = m_Entries[entryIndex];
+		b32 large = entry.cell == EU_SPATIAL_INDEX_LARGE_CELL;
+		auto cell = large ? m_Cells.end() : m_Cells.find(entry.cell);
+		List<u32>& entries = large ? m_LargeEntries : cell->second;
+
+		u32 lastEntry = entries.GetLastElement();
+		entries[entry.cellSlot] = lastEntry;
+		m_Entries[lastEntry].cellSlot = entry.cellSlot;
+		entries.Pop();
+
+		//Empty cells are dropped so the frustum query only walks occupied ones
+		if (!large && entries.Empty())
+			m_Cells.erase(cell);
+	}
+
+	void SpatialIndex3DSystem::RemoveEntry(u32 entryIndex)
+	{
+		RemoveFromCell(entryIndex);
+		m_EntryIndices[EU_ECS_ENTITY_INDEX(m_Entries[entryIndex].entity)] = EU_U32_MAX;
+
+		u32 lastIndex = m_Entries.Size() - 1;
+		if (entryIndex != lastIndex)
+		{
+			SpatialIndexEntry* moved = &m_Entries[entryIndex];
+			*moved = m_Entries[lastIndex];
+			m_EntryIndices[EU_ECS_ENTITY_INDEX(moved->entity)] = entryIndex;
+			if (moved->cell == EU_SPATIAL_INDEX_LARGE_CELL)
+				m_LargeEntries[moved->cellSlot] = entryIndex;
+			else
+				m_Cells[moved->cell][moved->cellSlot] = entryIndex;
+		}
+
+		m_Entries.Pop();
+	}
+
+	u64 SpatialIndex3DSystem::GetCellKey(const v3& point) const
+	{
+		s32 coords[3];
+		GetCellCoords(point, coords);
+		return PackCellCoords(coords[0], coords[1], coords[2]);
+	}
+
+	void SpatialIndex3DSystem::GetCellCoords(const v3& point, s32* coords) const
+	{
+		const r32* values = &point.x;
+		for (u32 i = 0; i < 3; i++)
+		{
+			r32 coord = floorf(values[i] * m_InvCellSize);
+			coords[i] = (s32)EU_CLAMP(-(r32)EU_SPATIAL_INDEX_MAX_CELL, (r32)EU_SPATIAL_INDEX_MAX_CELL, coord);
+		}
+	}
+
+}
@@ -0,0 +1,104 @@
+#pragma once
+
+#include "../ECS.h"
+#include <unordered_map>
+
+#define EU_SPATIAL_INDEX_DEFAULT_CELL_SIZE 16.0f
+#define EU_SPATIAL_INDEX_MAX_FRUSTUM_PLANES 6
+
+namespace Eunoia {
+
+	enum SpatialQueryType
+	{
+		SPATIAL_QUERY_SPHERE,
+		SPATIAL_QUERY_AABB,
+		SPATIAL_QUERY_FRUSTUM
+	};
+
+	struct SpatialQuery
+	{
+		SpatialQueryType type;
+		v3 center;
+		r32 radius;
+		v3 min;
+		v3 max;
+		//Pointing inwards as (normal, distance), see SpatialIndex3DSystem::ExtractFrustumPlanes
+		v4 planes[EU_SPATIAL_INDEX_MAX_FRUSTUM_PLANES];
+		u32 numPlanes;
+
+		List<EntityID> results;
+	};
+
+	struct SpatialIndexEntry
+	{
+		EntityID entity;
+		v3 center;
+		r32 radius;
+		u64 cell;
+		//Index into the entry list of the cell
+		u32 cellSlot;
+		u32 sweep;
+	};
+
+	/*
+		Keeps the bounding spheres of every entity with a Transform3DComponent and a SpatialIndex3DComponent in a loose hashed grid.
+		An entity is stored in the cell its center is in, queries look one cell further out so spheres up to a cell size in radius are
+		never missed, bigger ones are kept in a list every query checks. Only entities whose components changed since the previous
+		update are moved, a static entity costs one version compare per frame.
+		Queries only read the index and can run on any number of threads as long as this system is not updating, queries from other
+		systems see the transforms of the previous frame unless they are created after this system
+	*/
+	EU_REFLECT(System)
+	class EU_API SpatialIndex3DSystem : public ECSSystem
+	{
+	public:
+		SpatialIndex3DSystem();
+		virtual void ProcessBatchOnUpdate(const ECSEntityBatch& batch, r32 dt) override;
+		virtual void OnSnapshotRestored() override;
+
+		//Empties the index, every entity is put back on the next update
+		void SetCellSize(r32 cellSize);
+		r32 GetCellSize() const;
+		u32 GetNumIndexed() const;
+
+		//The query functions append to results
+		void QuerySphere(const v3& center, r32 radius, List<EntityID>* results) const;
+		void QueryAABB(const v3& min, const v3& max, List<EntityID>* results) const;
+		void QueryFrustum(const v4* planes, u32 numPlanes, List<EntityID>* results) const;
+		//The entity whose bounding sphere is closest to point, EU_ECS_INVALID_ENTITY_ID if there is none within maxDistance
+		EntityID QueryNearest(const v3& point, r32 maxDistance, r32* distance = 0) const;
+
+		//Clears the results of every query and runs them on the job system
+		void RunQueries(SpatialQuery* queries, u32 numQueries) const;
+
+		static void ExtractFrustumPlanes(const m4& viewProjection, v4 planes[6]);
+
+		//Logs the update and query times against a scan over every transform, creates and destroys its own ECS
+		static void RunBenchmark(u32 numEntities = 100000);
+	private:
+		void Clear();
+		void InsertEntry(u32 entryIndex);
+		void RemoveFromCell(u32 entryIndex);
+		void RemoveEntry(u32 entryIndex);
+
+		u64 GetCellKey(const v3& point) const;
+		void GetCellCoords(const v3& point, s32* coords) const;
+
+		template<class F>
+		void ForEachCell(const v3& min, const v3& max, const F& function) const;
+	private:
+		r32 m_CellSize;
+		r32 m_InvCellSize;
+
+		List<SpatialIndexEntry> m_Entries;
+		//Entry index by entity index
+		List<u32> m_EntryIndices;
+		std::unordered_map<u64, List<u32>> m_Cells;
+		List<u32> m_LargeEntries;
+
+		u32 m_Sweep;
+		u32 m_IndexedHierarchyVersion;
+		u32 m_IndexedEntityListVersion;
+	};
+
+}
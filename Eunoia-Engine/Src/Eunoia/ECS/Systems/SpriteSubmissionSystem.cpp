@@ -9,6 +9,7 @@ namespace Eunoia {
 	{
 		AddComponentType<SpriteComponent>();
 		AddComponentType<Transform2DComponent>();
+		SetProcessInHierarchyOrder(true);
 	}
 
 	void SpriteSubmissionSystem::ProcessEntityOnRender(EntityID entity)
@@ -31,6 +32,7 @@ namespace Eunoia {
 	SpriteGroupSubmissionSystem::SpriteGroupSubmissionSystem()
 	{
 		AddComponentType<SpriteGroupComponent>();
+		SetProcessInHierarchyOrder(true);
 	}
 
 	void SpriteGroupSubmissionSystem::ProcessEntityOnRender(EntityID entity)
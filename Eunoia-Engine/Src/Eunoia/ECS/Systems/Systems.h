@@ -15,4 +15,5 @@
 #include "Gamepad3DSystem.h"
 #include "KeyboardLookAround3DSystem.h"
 #include "KeyboardMovement2DSystem.h"
-#include "ViewProjection2DSystem.h"
\ No newline at end of file
+#include "ViewProjection2DSystem.h"
+#include "SpatialIndex3DSystem.h"
\ No newline at end of file
@@ -9,6 +9,7 @@ namespace Eunoia {
 	{
 		AddComponentType<Text2DComponent>();
 		AddComponentType<Transform2DComponent>();
+		SetProcessInHierarchyOrder(true);
 	}
 
 	void Text2DSubmissionSystem::ProcessEntityOnRender(EntityID entity)
@@ -3,27 +3,41 @@
 
 namespace Eunoia {
 
-	TransformHierarchy2DSystem::TransformHierarchy2DSystem()
+	TransformHierarchy2DSystem::TransformHierarchy2DSystem() :
+		m_PropagatedHierarchyVersion(EU_U32_MAX),
+		m_PropagateAll(true)
 	{
-		AddComponentType<Transform2DComponent>();
+		AddComponentType<Transform2DComponent>(ECS_COMPONENT_ACCESS_READ_WRITE);
+		SetProcessInHierarchyOrder(true);
+		SetThreading(ECS_SYSTEM_THREADING_PARALLEL);
+		SetBackgroundPolicy(ECS_SYSTEM_BACKGROUND_RUN);
+	}
+
+	void TransformHierarchy2DSystem::PreUpdate(r32 dt)
+	{
+		m_PropagateAll = m_PropagatedHierarchyVersion != m_ECS->GetHierarchyVersion();
+		m_PropagatedHierarchyVersion = m_ECS->GetHierarchyVersion();
 	}
 
 	void TransformHierarchy2DSystem::ProcessEntityOnUpdate(EntityID entity, r32 dt)
 	{
 		EntityID parentEntity = m_ECS->GetParentEntity(entity);
 		Transform2DComponent* transform = m_ECS->GetComponent<Transform2DComponent>(entity);
-		if (parentEntity == EU_ECS_INVALID_ENTITY_ID)
-		{
-			transform->worldTransform = transform->localTransform;
+		Transform2DComponent* parentTransform = parentEntity == EU_ECS_INVALID_ENTITY_ID ? 0 : m_ECS->GetComponent<Transform2DComponent>(parentEntity);
+		if (!m_PropagateAll && !HasComponentChanged(transform) && !(parentTransform && HasComponentChanged(parentTransform)))
 			return;
-		}
-		Transform2DComponent* parentTransform = m_ECS->GetComponent<Transform2DComponent>(parentEntity);
+
 		if (!parentTransform)
-		{
 			transform->worldTransform = transform->localTransform;
-			return;
-		}
-		transform->worldTransform = parentTransform->worldTransform * transform->localTransform;
+		else
+			transform->worldTransform = parentTransform->worldTransform * transform->localTransform;
+
+		transform->version = GetChangeVersion();
+	}
+
+	void TransformHierarchy2DSystem::OnSnapshotRestored()
+	{
+		m_PropagatedHierarchyVersion = EU_U32_MAX;
 	}
 
 }
@@ -9,7 +9,12 @@ namespace Eunoia {
 	{
 	public:
 		TransformHierarchy2DSystem();
+		virtual void PreUpdate(r32 dt) override;
 		virtual void ProcessEntityOnUpdate(EntityID entity, r32 dt) override;
+		virtual void OnSnapshotRestored() override;
+	private:
+		u32 m_PropagatedHierarchyVersion;
+		b32 m_PropagateAll;
 	};
 
 }
\ No newline at end of file
@@ -0,0 +1,72 @@
+#include "TransformHierarchy3DSystem.h"
+#include "../Components/Transform3DComponet.h"
+#include "../../Core/Benchmark.h"
+
+namespace Eunoia {
+
+	//What the system did before the flat hierarchy, every entity looks up its parent and both components
+	static void PropagateWithLookups(ECS* ecs, const ECSEntityList& entities)
+	{
+		for (u32 i = 0; i < entities.Size(); i++)
+		{
+			EntityID entity = entities[i];
+			Transform3DComponent* transform = ecs->GetComponent<Transform3DComponent>(entity);
+			EntityID parentEntity = ecs->GetParentEntity(entity);
+			Transform3DComponent* parentTransform = parentEntity == EU_ECS_INVALID_ENTITY_ID ? 0 : ecs->GetComponent<Transform3DComponent>(parentEntity);
+			if (!parentTransform)
+				transform->worldTransform = transform->localTransform;
+			else
+				transform->worldTransform = parentTransform->worldTransform * transform->localTransform;
+		}
+	}
+
+	void TransformHierarchy3DSystem::RunBenchmark(u32 numTransforms)
+	{
+		BenchmarkSamples lookupTime, rebuildTime, fullTime, partialTime, staticTime;
+		u32 numMoved = 0;
+		for (u32 sample = 0; sample < EU_BENCHMARK_NUM_SAMPLES; sample++)
+		{
+			//A fresh 4 way tree every sample so the rebuild is measured cold
+			ECSBenchmarkScene scene;
+			scene.Create("TransformHierarchyBenchmark", numTransforms, 4);
+			ECS* ecs = scene.ecs;
+			numMoved = scene.numMoved;
+
+			for (u32 i = 0; i < numTransforms; i++)
+			{
+				Transform3D localTransform(v3(EU_RANDOM_FLOAT(-1.0f, 1.0f), EU_RANDOM_FLOAT(-1.0f, 1.0f), EU_RANDOM_FLOAT(-1.0f, 1.0f)),
+					v3(1.0f, 1.0f, 1.0f), quat(v3(0.0f, 1.0f, 0.0f), EU_RANDOM_FLOAT(0.0f, 360.0f)));
+				ecs->GetComponentMutable<Transform3DComponent>(scene.entities[i])->localTransform = localTransform;
+			}
+			TransformHierarchy3DSystem* system = ecs->CreateSystem<TransformHierarchy3DSystem>();
+
+			BenchmarkTimer timer;
+			ecs->UpdateSystems(0.0f);
+			rebuildTime.Add(timer.GetElapsedMicroseconds());
+
+			timer.Restart();
+			PropagateWithLookups(ecs, system->GetEntities());
+			lookupTime.Add(timer.GetElapsedMicroseconds());
+
+			//Moving the top entity moves every transform without touching the flat hierarchy
+			ecs->GetComponentMutable<Transform3DComponent>(scene.entities[0])->localTransform.Translate(v3(1.0f, 0.0f, 0.0f));
+			timer.Restart();
+			ecs->UpdateSystems(0.0f);
+			fullTime.Add(timer.GetElapsedMicroseconds());
+
+			for (u32 i = 0; i < numMoved; i++)
+				ecs->GetComponentMutable<Transform3DComponent>(scene.entities[numTransforms - 1 - i])->localTransform.Translate(v3(0.0f, 1.0f, 0.0f));
+			timer.Restart();
+			ecs->UpdateSystems(0.0f);
+			partialTime.Add(timer.GetElapsedMicroseconds());
+
+			timer.Restart();
+			ecs->UpdateSystems(0.0f);
+			staticTime.Add(timer.GetElapsedMicroseconds());
+		}
+
+		EU_LOG_BENCHMARK("TransformHierarchy3D", "{0} transforms, per entity lookups {1:.0f}us, rebuild {2:.0f}us, all moved {3:.0f}us, {4} leaves moved {5:.0f}us, nothing moved {6:.0f}us",
+			numTransforms, lookupTime.GetMedian(), rebuildTime.GetMedian(), fullTime.GetMedian(), numMoved, partialTime.GetMedian(), staticTime.GetMedian());
+	}
+
+}
@@ -1,28 +1,176 @@
 #include "TransformHierarchy3DSystem.h"
 #include "../Components/Transform3DComponet.h"
+#include "../../Core/Engine.h"
+#include <cstring>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE__)
+#include <xmmintrin.h>
+#define EU_TRANSFORM_HIERARCHY_SSE
+#endif
 
 namespace Eunoia
 {
-	TransformHierarchy3DSystem::TransformHierarchy3DSystem()
+	/*
+		Same result as parent * local with Transform3D::operator*. Transform3D is pos, scale and rot packed as 10 floats
+		so the 4 wide loads of pos and scale read the first float of the next member, the stores are done in member order
+		so the extra float written with pos and scale gets overwritten by the following store
+	*/
+	static inline void CombineTransforms(const Transform3D& parent, const Transform3D& local, Transform3D* world)
+	{
+#ifdef EU_TRANSFORM_HIERARCHY_SSE
+		__m128 pos = _mm_add_ps(_mm_loadu_ps(&parent.pos.x), _mm_loadu_ps(&local.pos.x));
+		__m128 scale = _mm_mul_ps(_mm_loadu_ps(&parent.scale.x), _mm_loadu_ps(&local.scale.x));
+
+		//local.rot * parent.rot
+		__m128 a = _mm_loadu_ps(&local.rot.x);
+		__m128 b = _mm_loadu_ps(&parent.rot.x);
+		__m128 t0 = _mm_mul_ps(a, _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 3, 3, 3)));
+		__m128 t1 = _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(0, 3, 3, 3)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(0, 2, 1, 0)));
+		__m128 t2 = _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(1, 0, 2, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 1, 0, 2)));
+		__m128 t3 = _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 1, 0, 2)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(2, 0, 2, 1)));
+		__m128 negateW = _mm_set_ps(-0.0f, 0.0f, 0.0f, 0.0f);
+		__m128 rot = _mm_sub_ps(_mm_add_ps(t0, _mm_xor_ps(_mm_add_ps(t1, t2), negateW)), t3);
+
+		__m128 lengthSquared = _mm_mul_ps(rot, rot);
+		lengthSquared = _mm_add_ps(lengthSquared, _mm_shuffle_ps(lengthSquared, lengthSquared, _MM_SHUFFLE(2, 3, 0, 1)));
+		lengthSquared = _mm_add_ps(lengthSquared, _mm_shuffle_ps(lengthSquared, lengthSquared, _MM_SHUFFLE(1, 0, 3, 2)));
+		rot = _mm_div_ps(rot, _mm_sqrt_ps(lengthSquared));
+
+		_mm_storeu_ps(&world->pos.x, pos);
+		_mm_storeu_ps(&world->scale.x, scale);
+		_mm_storeu_ps(&world->rot.x, rot);
+#else
+		*world = parent * local;
+#endif
+	}
+
+	TransformHierarchy3DSystem::TransformHierarchy3DSystem() :
+		m_PropagatedHierarchyVersion(EU_U32_MAX),
+		m_PropagatedEntityListVersion(EU_U32_MAX)
+	{
+		AddComponentType<Transform3DComponent>(ECS_COMPONENT_ACCESS_READ_WRITE);
+		SetProcessInHierarchyOrder(true);
+		SetThreading(ECS_SYSTEM_THREADING_PARALLEL);
+		SetBatchProcessing(true);
+		SetBackgroundPolicy(ECS_SYSTEM_BACKGROUND_RUN);
+	}
+
+	void TransformHierarchy3DSystem::ProcessBatchOnUpdate(const ECSEntityBatch& batch, r32 dt)
+	{
+		SettleInterpolatedTransforms();
+
+		//Reparenting or enabling entities can change a world transform without any local transform changing
+		b32 propagateAll = m_PropagatedHierarchyVersion != m_ECS->GetHierarchyVersion() || m_PropagatedEntityListVersion != GetEntities().version;
+		if (propagateAll)
+		{
+			RebuildParentIndices(batch);
+			m_PropagatedHierarchyVersion = m_ECS->GetHierarchyVersion();
+			m_PropagatedEntityListVersion = GetEntities().version;
+		}
+
+		ECS::View<Transform3DComponent> view(batch);
+		const u32* parentIndices = &m_ParentIndices[0];
+		b32* changed = &m_Changed[0];
+		for (u32 i = 0; i < view.Size(); i++)
+		{
+			Transform3DComponent* transform = view.Get<Transform3DComponent>(i);
+			u32 parentIndex = parentIndices[i];
+
+			changed[i] = propagateAll || HasComponentChanged(transform) || (parentIndex != EU_U32_MAX && changed[parentIndex]);
+			if (!changed[i])
+				continue;
+
+			transform->previousWorldTransform = transform->worldTransform;
+			if (parentIndex == EU_U32_MAX)
+				transform->worldTransform = transform->localTransform;
+			else
+				CombineTransforms(view.Get<Transform3DComponent>(parentIndex)->worldTransform, transform->localTransform, &transform->worldTransform);
+
+			//New transforms have nothing to blend from
+			if (!transform->hasPreviousWorldTransform)
+			{
+				transform->previousWorldTransform = transform->worldTransform;
+				transform->hasPreviousWorldTransform = true;
+			}
+			else if (memcmp(&transform->previousWorldTransform, &transform->worldTransform, sizeof(Transform3D)) != 0)
+			{
+				m_InterpolatedEntities.Push(view.GetEntity(i));
+			}
+
+			transform->UpdateWorldMatrices();
+
+			//Stamped with our own version so other systems see the change but we don't on the next update
+			transform->version = GetChangeVersion();
+		}
+	}
+
+	void TransformHierarchy3DSystem::PreRender()
+	{
+		r32 alpha = Engine::GetInterpolationAlpha();
+		for (u32 i = 0; i < m_InterpolatedEntities.Size(); i++)
+		{
+			Transform3DComponent* transform = m_ECS->GetComponent<Transform3DComponent>(m_InterpolatedEntities[i]);
+			if (!transform)
+				continue;
+
+			const Transform3D& previous = transform->previousWorldTransform;
+			const Transform3D& current = transform->worldTransform;
+			transform->renderTransform = Transform3D(previous.pos.Lerp(current.pos, alpha), previous.scale.Lerp(current.scale, alpha), previous.rot.Slerp(current.rot, alpha));
+			transform->renderMatrix = transform->renderTransform.CreateTransformMatrix();
+		}
+	}
+
+	//The restored transforms are propagated from scratch, nothing is blended into them
+	void TransformHierarchy3DSystem::OnSnapshotRestored()
 	{
-		AddComponentType<Transform3DComponent>();
+		m_InterpolatedEntities.Clear();
+		m_PropagatedHierarchyVersion = EU_U32_MAX;
+		m_PropagatedEntityListVersion = EU_U32_MAX;
 	}
 
-	void TransformHierarchy3DSystem::ProcessEntityOnUpdate(EntityID entity, r32 dt)
+	//Entities that moved on the previous step and not since then are drawn where they are
+	void TransformHierarchy3DSystem::SettleInterpolatedTransforms()
 	{
-		EntityID parentEntity = m_ECS->GetParentEntity(entity);
-		Transform3DComponent* transform = m_ECS->GetComponent<Transform3DComponent>(entity);
-		if (parentEntity == EU_ECS_INVALID_ENTITY_ID)
+		for (u32 i = 0; i < m_InterpolatedEntities.Size(); i++)
 		{
-			transform->worldTransform = transform->localTransform;
-			return;
+			Transform3DComponent* transform = m_ECS->GetComponent<Transform3DComponent>(m_InterpolatedEntities[i]);
+			if (!transform)
+				continue;
+
+			transform->previousWorldTransform = transform->worldTransform;
+			transform->renderTransform = transform->worldTransform;
+			transform->renderMatrix = transform->worldMatrix;
+		}
+
+		m_InterpolatedEntities.Clear();
+	}
+
+	void TransformHierarchy3DSystem::RebuildParentIndices(const ECSEntityBatch& batch)
+	{
+		u32 numEntities = batch.numEntities;
+		m_ParentIndices.SetCapacityAndElementCount(EU_MAX(numEntities, 1));
+		m_Changed.SetCapacityAndElementCount(EU_MAX(numEntities, 1));
+
+		for (u32 i = 0; i < numEntities; i++)
+		{
+			u32 index = EU_ECS_ENTITY_INDEX(batch.entities[i]);
+			while (index >= m_BatchIndices.Size())
+				m_BatchIndices.Push(EU_U32_MAX);
+			m_BatchIndices[index] = i;
 		}
-		Transform3DComponent* parentTransform = m_ECS->GetComponent<Transform3DComponent>(parentEntity);
-		if (!parentTransform)
+
+		for (u32 i = 0; i < numEntities; i++)
 		{
-			transform->worldTransform = transform->localTransform;
-			return;
+			EntityID parent = m_ECS->GetParentEntity(batch.entities[i]);
+			u32 parentIndex = EU_U32_MAX;
+			if (parent != EU_ECS_INVALID_ENTITY_ID && EU_ECS_ENTITY_INDEX(parent) < m_BatchIndices.Size())
+			{
+				u32 batchIndex = m_BatchIndices[EU_ECS_ENTITY_INDEX(parent)];
+				if (batchIndex < i && batch.entities[batchIndex] == parent)
+					parentIndex = batchIndex;
+			}
+
+			m_ParentIndices[i] = parentIndex;
 		}
-		transform->worldTransform = parentTransform->worldTransform * transform->localTransform;
 	}
 }
@@ -9,7 +9,30 @@ namespace Eunoia {
 	{
 	public:
 		TransformHierarchy3DSystem();
-		virtual void ProcessEntityOnUpdate(EntityID entity, r32 dt) override;
+		virtual void ProcessBatchOnUpdate(const ECSEntityBatch& batch, r32 dt) override;
+		//Blends the render transforms of the entities that moved on the last simulation step
+		virtual void PreRender() override;
+		virtual void OnSnapshotRestored() override;
+
+		//Logs the time of a full and a partial propagation against the old per entity lookups, creates and destroys its own ECS
+		static void RunBenchmark(u32 numTransforms);
+	private:
+		void RebuildParentIndices(const ECSEntityBatch& batch);
+		void SettleInterpolatedTransforms();
+	private:
+		/*
+			Flat copy of the hierarchy for the entities in the batch. The batch is in hierarchy order so a parent always
+			comes before its children, m_ParentIndices[i] is the batch index of the parent of entity i or EU_U32_MAX for roots.
+			Only rebuilt when the hierarchy or the entity list changes, moving whole subtrees just marks them changed
+		*/
+		List<u32> m_ParentIndices;
+		List<u32> m_BatchIndices;
+		List<b32> m_Changed;
+		u32 m_PropagatedHierarchyVersion;
+		u32 m_PropagatedEntityListVersion;
+
+		//Entities whose world transform differs from the one before the last step
+		List<EntityID> m_InterpolatedEntities;
 	};
 
-}
\ No newline at end of file
+}
@@ -14,9 +14,10 @@ namespace Eunoia {
 		AddComponentType<Transform3DComponent>();
 	}
 
-	void ViewProjectionSystem::ProcessEntityOnUpdate(EntityID entity, r32 dt)
+	//Set while rendering so the camera moves with the blended transforms instead of once per simulation step
+	void ViewProjectionSystem::ProcessEntityOnRender(EntityID entity)
 	{
-		const Transform3D& transform = m_ECS->GetComponent<Transform3DComponent>(entity)->worldTransform;
+		const Transform3D& transform = m_ECS->GetComponent<Transform3DComponent>(entity)->renderTransform;
 		const CameraComponent* camera = m_ECS->GetComponent<CameraComponent>(entity);
 
 		m4 viewMatrix = m4::CreateView(transform.pos, transform.rot);
@@ -9,7 +9,7 @@ namespace Eunoia {
 	{
 	public:
 		ViewProjectionSystem();
-		virtual void ProcessEntityOnUpdate(EntityID entityID, r32 dt) override;
+		virtual void ProcessEntityOnRender(EntityID entityID) override;
 	};
 
 }
\ No newline at end of file
@@ -6,6 +6,7 @@
 #include "Core\Application.h"
 #include "Core\InputDefs.h"
 #include "Core\Input.h"
+#include "Core\JobSystem.h"
 
 #include "ECS\ECS.h"
 #include "ECS\ECSLoader.h"
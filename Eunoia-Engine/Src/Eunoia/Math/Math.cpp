@@ -7,6 +7,26 @@ namespace Eunoia {
 		return CreateTranslation(translation) * (rot.CreateRotationMatrix() * CreateScale(scale));
 	}
 
+	m4 m4::CreateInverseTransformation(const v3& translation, const v3& scale, const quat& rot)
+	{
+		//(T * R * S)^-1 = S^-1 * R^T * T^-1
+		m4 rotation = rot.CreateRotationMatrix();
+		v3 invScale(1.0f / scale.x, 1.0f / scale.y, 1.0f / scale.z);
+		r32 invScales[3] = { invScale.x, invScale.y, invScale.z };
+		r32 t[3] = { translation.x, translation.y, translation.z };
+
+		m4 result = CreateIdentity();
+		for (u32 i = 0; i < 3; i++)
+		{
+			for (u32 j = 0; j < 3; j++)
+				result[i][j] = rotation[j][i] * invScales[i];
+
+			result[i][3] = -(result[i][0] * t[0] + result[i][1] * t[1] + result[i][2] * t[2]);
+		}
+
+		return result;
+	}
+
 	m4 m4::CreateView(const v3& cameraPos, const quat& cameraRot)
 	{
 		return cameraRot.Conjugate().CreateRotationMatrix() * m4::CreateTranslation(cameraPos * -1.0f);
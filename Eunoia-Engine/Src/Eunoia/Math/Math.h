@@ -415,6 +415,8 @@ namespace Eunoia
 		}
 
 		EU_API static m4 CreateTransformation(const v3& translation, const v3& scale, const quat& rot);
+		//Inverse of CreateTransformation built directly from the parts instead of a general inverse
+		EU_API static m4 CreateInverseTransformation(const v3& translation, const v3& scale, const quat& rot);
 
 		inline static m4 CreateRotation(const v3& axis) { return CreateRotationX(axis.x) * (CreateRotationY(axis.y) * CreateRotationZ(axis.z)); }
 
@@ -676,6 +678,7 @@ namespace Eunoia
 		inline Transform3D& Rotate(const v3& axis, r32 deg) { return Rotate(quat(axis, deg)); }
 
 		inline m4 CreateTransformMatrix() const { return m4::CreateTransformation(pos, scale, rot); }
+		inline m4 CreateInverseTransformMatrix() const { return m4::CreateInverseTransformation(pos, scale, rot); }
 
 		EU_PROPERTY() v3 pos;
 		EU_PROPERTY() v3 scale;
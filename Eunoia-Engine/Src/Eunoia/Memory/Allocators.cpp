@@ -1,6 +1,9 @@
 #include "Allocators.h"
 #include <cstdlib>
 #include <cstring>
+#ifdef _MSC_VER
+#include <malloc.h>
+#endif
 
 namespace Eunoia {
 
@@ -89,48 +92,47 @@ namespace Eunoia {
 		return m_NumAllocations;
 	}
 
-	PoolAllocator::PoolAllocator(mem_size numElements, mem_size elementSize, void* memoryToAllocate) :
-		m_MaxElements(numElements),
-		m_ElementSize(elementSize),
-		m_NumAllocations(0)
+	static void* AllocateAligned(mem_size size, mem_size alignment)
 	{
-		union {
-			PoolElement* as_self;
-			unsigned char* as_char;
-			void* as_void;
-		};
+#ifdef _MSC_VER
+		return _aligned_malloc(size, alignment);
+#else
+		return aligned_alloc(alignment, EU_ALIGN_UP(size, alignment));
+#endif
+	}
 
+	static void FreeAligned(void* memory)
+	{
+#ifdef _MSC_VER
+		_aligned_free(memory);
+#else
+		free(memory);
+#endif
+	}
 
+	PoolAllocator::PoolAllocator(mem_size numElements, mem_size elementSize, void* memoryToAllocate, mem_size alignment) :
+		m_MaxElements(numElements),
+		m_ElementSize(EU_ALIGN_UP(elementSize < sizeof(PoolElement) ? sizeof(PoolElement) : elementSize, alignment)),
+		m_NumAllocations(0)
+	{
 		if (memoryToAllocate)
 		{
-			m_Next = (PoolElement*)memoryToAllocate;
-			m_Memory = m_Next;
+			m_Memory = memoryToAllocate;
 			m_FreeMemory = false;
 		}
 		else
 		{
-			m_Next = (PoolElement*)malloc((numElements) * elementSize);
-			m_Memory = m_Next;
+			m_Memory = AllocateAligned(numElements * m_ElementSize, alignment);
 			m_FreeMemory = true;
 		}
 
-		as_self = m_Next;
-
-		PoolElement* runner = m_Next;
-		for (u32 i = 0; i < m_MaxElements; i++)
-		{
-			runner->next = as_self;
-			runner = as_self;
-			as_char += elementSize;
-		}
-
-		runner->next = 0;
+		Reset();
 	}
 
 	PoolAllocator::~PoolAllocator()
 	{
 		if (m_FreeMemory)
-			free(m_Memory);
+			FreeAligned(m_Memory);
 	}
 
 	mem_size PoolAllocator::GetMaxElements() const
@@ -138,6 +140,16 @@ namespace Eunoia {
 		return m_MaxElements;
 	}
 
+	mem_size PoolAllocator::GetElementSize() const
+	{
+		return m_ElementSize;
+	}
+
+	b32 PoolAllocator::IsFull() const
+	{
+		return m_NumAllocations == m_MaxElements;
+	}
+
 	void* PoolAllocator::Allocate(mem_size size)
 	{
 		PoolAllocator::PoolElement* head = m_Next;
@@ -151,6 +163,7 @@ namespace Eunoia {
 		PoolAllocator::PoolElement* head = (PoolAllocator::PoolElement*)memory;
 		head->next = m_Next;
 		m_Next = head;
+		m_NumAllocations--;
 	}
 
 	void PoolAllocator::Reset() 
@@ -181,10 +194,13 @@ namespace Eunoia {
 		return m_NumAllocations;
 	}
 
-	DynamicPoolAllocator::DynamicPoolAllocator(mem_size elementSize, mem_size initialMaxCapacity) :
-		m_ElementSize(elementSize)
+	DynamicPoolAllocator::DynamicPoolAllocator(mem_size elementSize, mem_size initialMaxCapacity, mem_size alignment) :
+		m_ElementSize(elementSize),
+		m_Alignment(alignment),
+		m_InitialMaxCapacity(initialMaxCapacity),
+		m_NextMaxCapacity(initialMaxCapacity)
 	{
-		m_Allocators.Push(new PoolAllocator(initialMaxCapacity, elementSize, 0));
+		CreatePool();
 	}
 
 	DynamicPoolAllocator::~DynamicPoolAllocator()
@@ -195,23 +211,208 @@ namespace Eunoia {
 
 	void* DynamicPoolAllocator::Allocate(u32* allocatorIndex)
 	{
+		if (m_FreePools.Empty())
+			CreatePool();
+
+		u32 index = m_FreePools.GetLastElement();
+		PoolAllocator* allocator = m_Allocators[index];
+		void* memory = allocator->Allocate();
+
+		if (allocator->IsFull())
+		{
+			m_FreePools.Remove(m_FreePools.Size() - 1);
+			m_InFreePools[index] = false;
+		}
+
+		*allocatorIndex = index;
+		return memory;
+	}
+
+	void DynamicPoolAllocator::Free(void* memory, u32 allocatorIndex)
+	{
+		m_Allocators[allocatorIndex]->Free(memory);
+
+		//Pools being emptied by a compaction must not be handed out again
+		if (!m_InFreePools[allocatorIndex] && !m_Evacuating[allocatorIndex])
+		{
+			m_FreePools.Push(allocatorIndex);
+			m_InFreePools[allocatorIndex] = true;
+		}
+	}
+
+	void DynamicPoolAllocator::Reserve(mem_size numElements)
+	{
+		mem_size freeElements = 0;
+		for (u32 i = 0; i < m_FreePools.Size(); i++)
+		{
+			PoolAllocator* allocator = m_Allocators[m_FreePools[i]];
+			freeElements += allocator->GetMaxElements() - allocator->GetNumAllocations();
+		}
+
+		if (freeElements < numElements)
+			CreatePool(numElements - freeElements);
+	}
+
+	void DynamicPoolAllocator::Reset()
+	{
+		m_FreePools.Clear();
 		for (u32 i = 0; i < m_Allocators.Size(); i++)
 		{
-			if (m_Allocators[i]->GetNumAllocations() < m_Allocators[i]->GetMaxElements())
+			m_Evacuating[i] = false;
+			m_InFreePools[i] = m_Allocators[i] != 0;
+			if (m_Allocators[i])
 			{
-				*allocatorIndex = i;
-				return m_Allocators[i]->Allocate();
+				m_Allocators[i]->Reset();
+				m_FreePools.Push(i);
 			}
 		}
+	}
 
-		PoolAllocator* allocator = new PoolAllocator(m_Allocators[m_Allocators.Size() - 1]->GetMaxElements() * 2, m_ElementSize, 0);
-		m_Allocators.Push(allocator);
-		*allocatorIndex = m_Allocators.Size() - 1;
-		return allocator->Allocate();
+	mem_size DynamicPoolAllocator::GetNumAllocations() const
+	{
+		mem_size numAllocations = 0;
+		for (u32 i = 0; i < m_Allocators.Size(); i++)
+			if (m_Allocators[i])
+				numAllocations += m_Allocators[i]->GetNumAllocations();
+		return numAllocations;
 	}
 
-	void DynamicPoolAllocator::Free(void* memory, u32 allocatorIndex)
+	mem_size DynamicPoolAllocator::GetCapacity() const
 	{
-		m_Allocators[allocatorIndex]->Free(memory);
+		mem_size capacity = 0;
+		for (u32 i = 0; i < m_Allocators.Size(); i++)
+			if (m_Allocators[i])
+				capacity += m_Allocators[i]->GetMaxElements();
+		return capacity;
+	}
+
+	u32 DynamicPoolAllocator::GetNumPools() const
+	{
+		u32 numPools = 0;
+		for (u32 i = 0; i < m_Allocators.Size(); i++)
+			if (m_Allocators[i])
+				numPools++;
+		return numPools;
+	}
+
+	u32 DynamicPoolAllocator::BeginCompaction()
+	{
+		//Least used pools first, they are the cheapest to empty
+		List<u32> order;
+		for (u32 i = 0; i < m_Allocators.Size(); i++)
+			if (m_Allocators[i])
+				order.Push(i);
+
+		for (u32 i = 1; i < order.Size(); i++)
+		{
+			u32 index = order[i];
+			u32 j = i;
+			for (; j > 0 && m_Allocators[order[j - 1]]->GetNumAllocations() > m_Allocators[index]->GetNumAllocations(); j--)
+				order[j] = order[j - 1];
+			order[j] = index;
+		}
+
+		mem_size freeSpace = 0;
+		for (u32 i = 0; i < order.Size(); i++)
+			freeSpace += m_Allocators[order[i]]->GetMaxElements() - m_Allocators[order[i]]->GetNumAllocations();
+
+		//Keep emptying pools while the pools that stay can still hold everything moved out of them
+		u32 numEvacuating = 0;
+		mem_size numMoved = 0;
+		for (u32 i = 0; i + 1 < order.Size(); i++)
+		{
+			const PoolAllocator* pool = m_Allocators[order[i]];
+			mem_size remainingFreeSpace = freeSpace - (pool->GetMaxElements() - pool->GetNumAllocations());
+			if (remainingFreeSpace < numMoved + pool->GetNumAllocations())
+				break;
+
+			freeSpace = remainingFreeSpace;
+			numMoved += pool->GetNumAllocations();
+			m_Evacuating[order[i]] = true;
+			numEvacuating++;
+		}
+
+		if (numEvacuating == 0)
+			return 0;
+
+		for (u32 i = 0; i < m_FreePools.Size();)
+		{
+			if (m_Evacuating[m_FreePools[i]])
+			{
+				m_InFreePools[m_FreePools[i]] = false;
+				m_FreePools.Remove(i);
+			}
+			else
+			{
+				i++;
+			}
+		}
+
+		return numEvacuating;
+	}
+
+	b32 DynamicPoolAllocator::IsEvacuating(u32 allocatorIndex) const
+	{
+		return m_Evacuating[allocatorIndex];
+	}
+
+	void DynamicPoolAllocator::EndCompaction()
+	{
+		mem_size largestCapacity = 0;
+		for (u32 i = 0; i < m_Allocators.Size(); i++)
+		{
+			if (m_Evacuating[i])
+			{
+				m_Evacuating[i] = false;
+				if (m_Allocators[i]->GetNumAllocations() == 0)
+				{
+					delete m_Allocators[i];
+					m_Allocators[i] = 0;
+				}
+				else if (!m_Allocators[i]->IsFull())
+				{
+					m_FreePools.Push(i);
+					m_InFreePools[i] = true;
+				}
+			}
+
+			if (m_Allocators[i])
+				largestCapacity = EU_MAX(largestCapacity, m_Allocators[i]->GetMaxElements());
+		}
+
+		//Released pools no longer count towards the size of the next one
+		m_NextMaxCapacity = largestCapacity ? largestCapacity * 2 : m_InitialMaxCapacity;
+	}
+
+	u32 DynamicPoolAllocator::CreatePool(mem_size minCapacity)
+	{
+		mem_size capacity = EU_MAX(m_NextMaxCapacity, minCapacity);
+		PoolAllocator* allocator = new PoolAllocator(capacity, m_ElementSize, 0, m_Alignment);
+		m_NextMaxCapacity = capacity * 2;
+
+		u32 index = m_Allocators.Size();
+		for (u32 i = 0; i < m_Allocators.Size(); i++)
+		{
+			if (!m_Allocators[i])
+			{
+				index = i;
+				break;
+			}
+		}
+
+		if (index == m_Allocators.Size())
+		{
+			m_Allocators.Push(allocator);
+			m_InFreePools.Push(false);
+			m_Evacuating.Push(false);
+		}
+		else
+		{
+			m_Allocators[index] = allocator;
+		}
+
+		m_FreePools.Push(index);
+		m_InFreePools[index] = true;
+		return index;
 	}
-}
\ No newline at end of file
+}
@@ -7,6 +7,9 @@
 #define EU_MB(mb) (EU_KB(mb) * 1024)
 #define EU_GB(gb) (EU_MB(gb) * 1024)
 
+#define EU_DEFAULT_ALIGNMENT 16
+#define EU_ALIGN_UP(Size, Alignment) (((Size) + ((Alignment) - 1)) & ~((mem_size)(Alignment) - 1))
+
 
 namespace Eunoia {
 
@@ -60,10 +63,13 @@ namespace Eunoia {
 	class EU_API PoolAllocator : public Allocator
 	{
 	public:
-		PoolAllocator(mem_size numElements, mem_size elementSize, void* memoryToAllocate = 0);
+		//Elements are padded to the alignment, memoryToAllocate must already be aligned and hold numElements padded elements
+		PoolAllocator(mem_size numElements, mem_size elementSize, void* memoryToAllocate = 0, mem_size alignment = EU_DEFAULT_ALIGNMENT);
 		~PoolAllocator();
 
 		mem_size GetMaxElements() const;
+		mem_size GetElementSize() const;
+		b32 IsFull() const;
 
 		void* Allocate(mem_size size = 0) override;
 		void Free(void* memory) override;
@@ -83,16 +89,46 @@ namespace Eunoia {
 		mem_size m_NumAllocations;
 	};
 
+	/*
+		Grows by adding pools twice the size of the largest one. allocatorIndex identifies the pool an element came from
+		and stays valid until that pool is released, released pool slots are reused by later pools.
+		The pools with free space are kept on a stack so allocating and freeing are constant time
+	*/
 	class EU_API DynamicPoolAllocator
 	{
 	public:
-		DynamicPoolAllocator(mem_size elementSize, mem_size initialMaxCapacity);
+		DynamicPoolAllocator(mem_size elementSize, mem_size initialMaxCapacity, mem_size alignment = EU_DEFAULT_ALIGNMENT);
 		~DynamicPoolAllocator();
 
 		void* Allocate(u32* allocatorIndex);
 		void Free(void* memory, u32 allocatorIndex);
+		//Makes room for numElements more allocations, creating at most one pool
+		void Reserve(mem_size numElements);
+		//Frees every element at once but keeps the pools
+		void Reset();
+
+		mem_size GetNumAllocations() const;
+		mem_size GetCapacity() const;
+		u32 GetNumPools() const;
+
+		/*
+			Compaction empties the least used pools into the others. BeginCompaction picks the pools to empty and returns
+			how many were picked, the owner then moves every element that IsEvacuating reports through Allocate/memcpy/Free
+			and EndCompaction releases every pool left empty. Returns 0 when nothing would be released
+		*/
+		u32 BeginCompaction();
+		b32 IsEvacuating(u32 allocatorIndex) const;
+		void EndCompaction();
+	private:
+		u32 CreatePool(mem_size minCapacity = 0);
 	private:
 		List<PoolAllocator*> m_Allocators;
+		List<u32> m_FreePools;
+		List<b32> m_InFreePools;
+		List<b32> m_Evacuating;
 		mem_size m_ElementSize;
+		mem_size m_Alignment;
+		mem_size m_InitialMaxCapacity;
+		mem_size m_NextMaxCapacity;
 	};
 }
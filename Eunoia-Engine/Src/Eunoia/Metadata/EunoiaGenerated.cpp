@@ -124,6 +124,8 @@ namespace Eunoia {
 		info.cls->isSystem = false;
 		info.cls->isEvent = false;
 		info.cls->DefaultConstructor = Eunoia::MetadataCreateInstance< String >;
+		info.cls->CopyConstructor = Eunoia::MetadataGetCopyInstance< String >();
+		info.cls->Destructor = Eunoia::MetadataDestroyInstance< String >;
 		info.cls->members.SetCapacityAndElementCount( 2 );
 
 		info.cls->members[ 0 ].name = "m_Chars";
@@ -537,6 +539,8 @@ namespace Eunoia {
 		info.cls->isSystem = false;
 		info.cls->isEvent = false;
 		info.cls->DefaultConstructor = Eunoia::MetadataCreateInstance< v2 >;
+		info.cls->CopyConstructor = Eunoia::MetadataGetCopyInstance< v2 >();
+		info.cls->Destructor = Eunoia::MetadataDestroyInstance< v2 >;
 		info.cls->members.SetCapacityAndElementCount( 2 );
 
 		info.cls->members[ 0 ].name = "x";
@@ -590,6 +594,8 @@ namespace Eunoia {
 		info.cls->isSystem = false;
 		info.cls->isEvent = false;
 		info.cls->DefaultConstructor = Eunoia::MetadataCreateInstance< v3 >;
+		info.cls->CopyConstructor = Eunoia::MetadataGetCopyInstance< v3 >();
+		info.cls->Destructor = Eunoia::MetadataDestroyInstance< v3 >;
 		info.cls->members.SetCapacityAndElementCount( 3 );
 
 		info.cls->members[ 0 ].name = "x";
@@ -658,6 +664,8 @@ namespace Eunoia {
 		info.cls->isSystem = false;
 		info.cls->isEvent = false;
 		info.cls->DefaultConstructor = Eunoia::MetadataCreateInstance< v4 >;
+		info.cls->CopyConstructor = Eunoia::MetadataGetCopyInstance< v4 >();
+		info.cls->Destructor = Eunoia::MetadataDestroyInstance< v4 >;
 		info.cls->members.SetCapacityAndElementCount( 4 );
 
 		info.cls->members[ 0 ].name = "x";
@@ -741,6 +749,8 @@ namespace Eunoia {
 		info.cls->isSystem = false;
 		info.cls->isEvent = false;
 		info.cls->DefaultConstructor = Eunoia::MetadataCreateInstance< m3 >;
+		info.cls->CopyConstructor = Eunoia::MetadataGetCopyInstance< m3 >();
+		info.cls->Destructor = Eunoia::MetadataDestroyInstance< m3 >;
 		info.cls->members.SetCapacityAndElementCount( 0 );
 
 		return info;
@@ -764,6 +774,8 @@ namespace Eunoia {
 		info.cls->isSystem = false;
 		info.cls->isEvent = false;
 		info.cls->DefaultConstructor = Eunoia::MetadataCreateInstance< m4 >;
+		info.cls->CopyConstructor = Eunoia::MetadataGetCopyInstance< m4 >();
+		info.cls->Destructor = Eunoia::MetadataDestroyInstance< m4 >;
 		info.cls->members.SetCapacityAndElementCount( 0 );
 
 		return info;
@@ -787,6 +799,8 @@ namespace Eunoia {
 		info.cls->isSystem = false;
 		info.cls->isEvent = false;
 		info.cls->DefaultConstructor = Eunoia::MetadataCreateInstance< quat >;
+		info.cls->CopyConstructor = Eunoia::MetadataGetCopyInstance< quat >();
+		info.cls->Destructor = Eunoia::MetadataDestroyInstance< quat >;
 		info.cls->members.SetCapacityAndElementCount( 4 );
 
 		info.cls->members[ 0 ].name = "x";
@@ -870,6 +884,8 @@ namespace Eunoia {
 		info.cls->isSystem = false;
 		info.cls->isEvent = false;
 		info.cls->DefaultConstructor = Eunoia::MetadataCreateInstance< Transform2D >;
+		info.cls->CopyConstructor = Eunoia::MetadataGetCopyInstance< Transform2D >();
+		info.cls->Destructor = Eunoia::MetadataDestroyInstance< Transform2D >;
 		info.cls->members.SetCapacityAndElementCount( 3 );
 
 		info.cls->members[ 0 ].name = "pos";
@@ -938,6 +954,8 @@ namespace Eunoia {
 		info.cls->isSystem = false;
 		info.cls->isEvent = false;
 		info.cls->DefaultConstructor = Eunoia::MetadataCreateInstance< Transform3D >;
+		info.cls->CopyConstructor = Eunoia::MetadataGetCopyInstance< Transform3D >();
+		info.cls->Destructor = Eunoia::MetadataDestroyInstance< Transform3D >;
 		info.cls->members.SetCapacityAndElementCount( 3 );
 
 		info.cls->members[ 0 ].name = "pos";
@@ -1006,6 +1024,8 @@ namespace Eunoia {
 		info.cls->isSystem = false;
 		info.cls->isEvent = false;
 		info.cls->DefaultConstructor = Eunoia::MetadataCreateInstance< SpriteSheet >;
+		info.cls->CopyConstructor = Eunoia::MetadataGetCopyInstance< SpriteSheet >();
+		info.cls->Destructor = Eunoia::MetadataDestroyInstance< SpriteSheet >;
 		info.cls->members.SetCapacityAndElementCount( 3 );
 
 		info.cls->members[ 0 ].name = "texture";
@@ -1098,6 +1118,8 @@ namespace Eunoia {
 		info.cls->isSystem = false;
 		info.cls->isEvent = false;
 		info.cls->DefaultConstructor = Eunoia::MetadataCreateInstance< Attenuation >;
+		info.cls->CopyConstructor = Eunoia::MetadataGetCopyInstance< Attenuation >();
+		info.cls->Destructor = Eunoia::MetadataDestroyInstance< Attenuation >;
 		info.cls->members.SetCapacityAndElementCount( 3 );
 
 		info.cls->members[ 0 ].name = "constant";
@@ -1166,6 +1188,8 @@ namespace Eunoia {
 		info.cls->isSystem = false;
 		info.cls->isEvent = false;
 		info.cls->DefaultConstructor = Eunoia::MetadataCreateInstance< ShadowInfo >;
+		info.cls->CopyConstructor = Eunoia::MetadataGetCopyInstance< ShadowInfo >();
+		info.cls->Destructor = Eunoia::MetadataDestroyInstance< ShadowInfo >;
 		info.cls->members.SetCapacityAndElementCount( 0 );
 
 		return info;
@@ -1189,6 +1213,8 @@ namespace Eunoia {
 		info.cls->isSystem = false;
 		info.cls->isEvent = false;
 		info.cls->DefaultConstructor = Eunoia::MetadataCreateInstance< Light3D >;
+		info.cls->CopyConstructor = Eunoia::MetadataGetCopyInstance< Light3D >();
+		info.cls->Destructor = Eunoia::MetadataDestroyInstance< Light3D >;
 		info.cls->members.SetCapacityAndElementCount( 0 );
 
 		return info;
@@ -1205,7 +1231,7 @@ namespace Eunoia {
 		info.type = METADATA_ENUM;
 		info.enm = Eunoia::Metadata::AllocateEnum( true );
 		info.enm->name = "EunoiaWorldFlag_T";
-		info.enm->values.SetCapacityAndElementCount( 7 );
+		info.enm->values.SetCapacityAndElementCount( 8 );
 		info.enm->values[ 0 ].name = "EUNOIA_WORLD_FLAG_RENDER_2D";
 		info.enm->values[ 0 ].value = EUNOIA_WORLD_FLAG_RENDER_2D;
 		info.enm->values[ 1 ].name = "EUNOIA_WORLD_FLAG_RENDER_3D";
@@ -1214,12 +1240,14 @@ namespace Eunoia {
 		info.enm->values[ 2 ].value = EUNOIA_WORLD_FLAG_DISPLAY;
 		info.enm->values[ 3 ].name = "EUNOIA_WORLD_FLAG_PHYSICS_ENGINE_3D";
 		info.enm->values[ 3 ].value = EUNOIA_WORLD_FLAG_PHYSICS_ENGINE_3D;
-		info.enm->values[ 4 ].name = "EUNOIA_WORLD_FLAG_RENDER";
-		info.enm->values[ 4 ].value = EUNOIA_WORLD_FLAG_RENDER;
-		info.enm->values[ 5 ].name = "EUNOIA_WORLD_FLAG_RENDER_DISPLAY";
-		info.enm->values[ 5 ].value = EUNOIA_WORLD_FLAG_RENDER_DISPLAY;
-		info.enm->values[ 6 ].name = "EUNOIA_WORLD_FLAG_ALL";
-		info.enm->values[ 6 ].value = EUNOIA_WORLD_FLAG_ALL;
+		info.enm->values[ 4 ].name = "EUNOIA_WORLD_FLAG_HEADLESS";
+		info.enm->values[ 4 ].value = EUNOIA_WORLD_FLAG_HEADLESS;
+		info.enm->values[ 5 ].name = "EUNOIA_WORLD_FLAG_RENDER";
+		info.enm->values[ 5 ].value = EUNOIA_WORLD_FLAG_RENDER;
+		info.enm->values[ 6 ].name = "EUNOIA_WORLD_FLAG_RENDER_DISPLAY";
+		info.enm->values[ 6 ].value = EUNOIA_WORLD_FLAG_RENDER_DISPLAY;
+		info.enm->values[ 7 ].name = "EUNOIA_WORLD_FLAG_ALL";
+		info.enm->values[ 7 ].value = EUNOIA_WORLD_FLAG_ALL;
 
 		return info;
 	}
@@ -1270,6 +1298,8 @@ namespace Eunoia {
 		info.cls->isSystem = false;
 		info.cls->isEvent = false;
 		info.cls->DefaultConstructor = Eunoia::MetadataCreateInstance< ECSComponent >;
+		info.cls->CopyConstructor = Eunoia::MetadataGetCopyInstance< ECSComponent >();
+		info.cls->Destructor = Eunoia::MetadataDestroyInstance< ECSComponent >;
 		info.cls->members.SetCapacityAndElementCount( 2 );
 
 		info.cls->members[ 0 ].name = "enabled";
@@ -1323,6 +1353,8 @@ namespace Eunoia {
 		info.cls->isSystem = false;
 		info.cls->isEvent = false;
 		info.cls->DefaultConstructor = Eunoia::MetadataCreateInstance< ECSEvent >;
+		info.cls->CopyConstructor = Eunoia::MetadataGetCopyInstance< ECSEvent >();
+		info.cls->Destructor = Eunoia::MetadataDestroyInstance< ECSEvent >;
 		info.cls->members.SetCapacityAndElementCount( 1 );
 
 		info.cls->members[ 0 ].name = "time";
@@ -1361,6 +1393,8 @@ namespace Eunoia {
 		info.cls->isSystem = false;
 		info.cls->isEvent = false;
 		info.cls->DefaultConstructor = Eunoia::MetadataCreateInstance< ECSSystem >;
+		info.cls->CopyConstructor = Eunoia::MetadataGetCopyInstance< ECSSystem >();
+		info.cls->Destructor = Eunoia::MetadataDestroyInstance< ECSSystem >;
 		info.cls->members.SetCapacityAndElementCount( 0 );
 
 		return info;
@@ -1384,6 +1418,8 @@ namespace Eunoia {
 		info.cls->isSystem = false;
 		info.cls->isEvent = false;
 		info.cls->DefaultConstructor = Eunoia::MetadataCreateInstance< CameraComponent >;
+		info.cls->CopyConstructor = Eunoia::MetadataGetCopyInstance< CameraComponent >();
+		info.cls->Destructor = Eunoia::MetadataDestroyInstance< CameraComponent >;
 		info.cls->members.SetCapacityAndElementCount( 1 );
 
 		info.cls->members[ 0 ].name = "fov";
@@ -1422,6 +1458,8 @@ namespace Eunoia {
 		info.cls->isSystem = false;
 		info.cls->isEvent = false;
 		info.cls->DefaultConstructor = Eunoia::MetadataCreateInstance< KeyboardMovement3DComponent >;
+		info.cls->CopyConstructor = Eunoia::MetadataGetCopyInstance< KeyboardMovement3DComponent >();
+		info.cls->Destructor = Eunoia::MetadataDestroyInstance< KeyboardMovement3DComponent >;
 		info.cls->members.SetCapacityAndElementCount( 7 );
 
 		info.cls->members[ 0 ].name = "forward";
@@ -1550,6 +1588,8 @@ namespace Eunoia {
 		info.cls->isSystem = false;
 		info.cls->isEvent = false;
 		info.cls->DefaultConstructor = Eunoia::MetadataCreateInstance< MaterialComponent >;
+		info.cls->CopyConstructor = Eunoia::MetadataGetCopyInstance< MaterialComponent >();
+		info.cls->Destructor = Eunoia::MetadataDestroyInstance< MaterialComponent >;
 		info.cls->members.SetCapacityAndElementCount( 2 );
 
 		info.cls->members[ 0 ].name = "material";
@@ -1603,6 +1643,8 @@ namespace Eunoia {
 		info.cls->isSystem = false;
 		info.cls->isEvent = false;
 		info.cls->DefaultConstructor = Eunoia::MetadataCreateInstance< ModelComponent >;
+		info.cls->CopyConstructor = Eunoia::MetadataGetCopyInstance< ModelComponent >();
+		info.cls->Destructor = Eunoia::MetadataDestroyInstance< ModelComponent >;
 		info.cls->members.SetCapacityAndElementCount( 2 );
 
 		info.cls->members[ 0 ].name = "model";
@@ -1656,6 +1698,8 @@ namespace Eunoia {
 		info.cls->isSystem = false;
 		info.cls->isEvent = false;
 		info.cls->DefaultConstructor = Eunoia::MetadataCreateInstance< MouseLookAround3DComponent >;
+		info.cls->CopyConstructor = Eunoia::MetadataGetCopyInstance< MouseLookAround3DComponent >();
+		info.cls->Destructor = Eunoia::MetadataDestroyInstance< MouseLookAround3DComponent >;
 		info.cls->members.SetCapacityAndElementCount( 2 );
 
 		info.cls->members[ 0 ].name = "sensitivity";
@@ -1709,6 +1753,8 @@ namespace Eunoia {
 		info.cls->isSystem = false;
 		info.cls->isEvent = false;
 		info.cls->DefaultConstructor = Eunoia::MetadataCreateInstance< Transform3DComponent >;
+		info.cls->CopyConstructor = Eunoia::MetadataGetCopyInstance< Transform3DComponent >();
+		info.cls->Destructor = Eunoia::MetadataDestroyInstance< Transform3DComponent >;
 		info.cls->members.SetCapacityAndElementCount( 1 );
 
 		info.cls->members[ 0 ].name = "localTransform";
@@ -1747,6 +1793,8 @@ namespace Eunoia {
 		info.cls->isSystem = false;
 		info.cls->isEvent = false;
 		info.cls->DefaultConstructor = Eunoia::MetadataCreateInstance< Light3DComponent >;
+		info.cls->CopyConstructor = Eunoia::MetadataGetCopyInstance< Light3DComponent >();
+		info.cls->Destructor = Eunoia::MetadataDestroyInstance< Light3DComponent >;
 		info.cls->members.SetCapacityAndElementCount( 4 );
 
 		info.cls->members[ 0 ].name = "type";
@@ -1830,6 +1878,8 @@ namespace Eunoia {
 		info.cls->isSystem = false;
 		info.cls->isEvent = false;
 		info.cls->DefaultConstructor = Eunoia::MetadataCreateInstance< Transform2DComponent >;
+		info.cls->CopyConstructor = Eunoia::MetadataGetCopyInstance< Transform2DComponent >();
+		info.cls->Destructor = Eunoia::MetadataDestroyInstance< Transform2DComponent >;
 		info.cls->members.SetCapacityAndElementCount( 1 );
 
 		info.cls->members[ 0 ].name = "localTransform";
@@ -1868,6 +1918,8 @@ namespace Eunoia {
 		info.cls->isSystem = false;
 		info.cls->isEvent = false;
 		info.cls->DefaultConstructor = Eunoia::MetadataCreateInstance< SpriteComponent >;
+		info.cls->CopyConstructor = Eunoia::MetadataGetCopyInstance< SpriteComponent >();
+		info.cls->Destructor = Eunoia::MetadataDestroyInstance< SpriteComponent >;
 		info.cls->members.SetCapacityAndElementCount( 5 );
 
 		info.cls->members[ 0 ].name = "size";
@@ -1966,6 +2018,8 @@ namespace Eunoia {
 		info.cls->isSystem = false;
 		info.cls->isEvent = false;
 		info.cls->DefaultConstructor = Eunoia::MetadataCreateInstance< SpriteGroupComponent >;
+		info.cls->CopyConstructor = Eunoia::MetadataGetCopyInstance< SpriteGroupComponent >();
+		info.cls->Destructor = Eunoia::MetadataDestroyInstance< SpriteGroupComponent >;
 		info.cls->members.SetCapacityAndElementCount( 0 );
 
 		return info;
@@ -1989,6 +2043,8 @@ namespace Eunoia {
 		info.cls->isSystem = false;
 		info.cls->isEvent = false;
 		info.cls->DefaultConstructor = Eunoia::MetadataCreateInstance< GuiClickResponseComponent >;
+		info.cls->CopyConstructor = Eunoia::MetadataGetCopyInstance< GuiClickResponseComponent >();
+		info.cls->Destructor = Eunoia::MetadataDestroyInstance< GuiClickResponseComponent >;
 		info.cls->members.SetCapacityAndElementCount( 0 );
 
 		return info;
@@ -2012,6 +2068,8 @@ namespace Eunoia {
 		info.cls->isSystem = false;
 		info.cls->isEvent = false;
 		info.cls->DefaultConstructor = Eunoia::MetadataCreateInstance< GuiComponent >;
+		info.cls->CopyConstructor = Eunoia::MetadataGetCopyInstance< GuiComponent >();
+		info.cls->Destructor = Eunoia::MetadataDestroyInstance< GuiComponent >;
 		info.cls->members.SetCapacityAndElementCount( 6 );
 
 		info.cls->members[ 0 ].name = "size";
@@ -2125,6 +2183,8 @@ namespace Eunoia {
 		info.cls->isSystem = false;
 		info.cls->isEvent = false;
 		info.cls->DefaultConstructor = Eunoia::MetadataCreateInstance< Text2DComponent >;
+		info.cls->CopyConstructor = Eunoia::MetadataGetCopyInstance< Text2DComponent >();
+		info.cls->Destructor = Eunoia::MetadataDestroyInstance< Text2DComponent >;
 		info.cls->members.SetCapacityAndElementCount( 0 );
 
 		return info;
@@ -2148,6 +2208,8 @@ namespace Eunoia {
 		info.cls->isSystem = false;
 		info.cls->isEvent = false;
 		info.cls->DefaultConstructor = Eunoia::MetadataCreateInstance< ModelAnimationComponent >;
+		info.cls->CopyConstructor = Eunoia::MetadataGetCopyInstance< ModelAnimationComponent >();
+		info.cls->Destructor = Eunoia::MetadataDestroyInstance< ModelAnimationComponent >;
 		info.cls->members.SetCapacityAndElementCount( 3 );
 
 		info.cls->members[ 0 ].name = "name";
@@ -2216,6 +2278,8 @@ namespace Eunoia {
 		info.cls->isSystem = false;
 		info.cls->isEvent = false;
 		info.cls->DefaultConstructor = Eunoia::MetadataCreateInstance< KeyboardMovement2DComponent >;
+		info.cls->CopyConstructor = Eunoia::MetadataGetCopyInstance< KeyboardMovement2DComponent >();
+		info.cls->Destructor = Eunoia::MetadataDestroyInstance< KeyboardMovement2DComponent >;
 		info.cls->members.SetCapacityAndElementCount( 5 );
 
 		info.cls->members[ 0 ].name = "up";
@@ -2338,6 +2402,8 @@ namespace Eunoia {
 		info.cls->isSystem = false;
 		info.cls->isEvent = false;
 		info.cls->DefaultConstructor = Eunoia::MetadataCreateInstance< RigidBody >;
+		info.cls->CopyConstructor = Eunoia::MetadataGetCopyInstance< RigidBody >();
+		info.cls->Destructor = Eunoia::MetadataDestroyInstance< RigidBody >;
 		info.cls->members.SetCapacityAndElementCount( 0 );
 
 		return info;
@@ -2361,6 +2427,8 @@ namespace Eunoia {
 		info.cls->isSystem = false;
 		info.cls->isEvent = false;
 		info.cls->DefaultConstructor = Eunoia::MetadataCreateInstance< RigidBodyComponent >;
+		info.cls->CopyConstructor = Eunoia::MetadataGetCopyInstance< RigidBodyComponent >();
+		info.cls->Destructor = Eunoia::MetadataDestroyInstance< RigidBodyComponent >;
 		info.cls->members.SetCapacityAndElementCount( 2 );
 
 		info.cls->members[ 0 ].name = "body";
@@ -2414,6 +2482,8 @@ namespace Eunoia {
 		info.cls->isSystem = false;
 		info.cls->isEvent = false;
 		info.cls->DefaultConstructor = Eunoia::MetadataCreateInstance< Gamepad3DComponent >;
+		info.cls->CopyConstructor = Eunoia::MetadataGetCopyInstance< Gamepad3DComponent >();
+		info.cls->Destructor = Eunoia::MetadataDestroyInstance< Gamepad3DComponent >;
 		info.cls->members.SetCapacityAndElementCount( 7 );
 
 		info.cls->members[ 0 ].name = "gamepad";
@@ -2542,6 +2612,8 @@ namespace Eunoia {
 		info.cls->isSystem = false;
 		info.cls->isEvent = false;
 		info.cls->DefaultConstructor = Eunoia::MetadataCreateInstance< KeyboardLookAround3DComponent >;
+		info.cls->CopyConstructor = Eunoia::MetadataGetCopyInstance< KeyboardLookAround3DComponent >();
+		info.cls->Destructor = Eunoia::MetadataDestroyInstance< KeyboardLookAround3DComponent >;
 		info.cls->members.SetCapacityAndElementCount( 5 );
 
 		info.cls->members[ 0 ].name = "up";
@@ -2640,6 +2712,8 @@ namespace Eunoia {
 		info.cls->isSystem = false;
 		info.cls->isEvent = false;
 		info.cls->DefaultConstructor = Eunoia::MetadataCreateInstance< Camera2DComponent >;
+		info.cls->CopyConstructor = Eunoia::MetadataGetCopyInstance< Camera2DComponent >();
+		info.cls->Destructor = Eunoia::MetadataDestroyInstance< Camera2DComponent >;
 		info.cls->members.SetCapacityAndElementCount( 1 );
 
 		info.cls->members[ 0 ].name = "orthoScale";
@@ -2678,6 +2752,8 @@ namespace Eunoia {
 		info.cls->isSystem = true;
 		info.cls->isEvent = false;
 		info.cls->DefaultConstructor = Eunoia::MetadataCreateInstance< KeyboardMovement3DSystem >;
+		info.cls->CopyConstructor = Eunoia::MetadataGetCopyInstance< KeyboardMovement3DSystem >();
+		info.cls->Destructor = Eunoia::MetadataDestroyInstance< KeyboardMovement3DSystem >;
 		info.cls->members.SetCapacityAndElementCount( 0 );
 
 		return info;
@@ -2701,6 +2777,8 @@ namespace Eunoia {
 		info.cls->isSystem = true;
 		info.cls->isEvent = false;
 		info.cls->DefaultConstructor = Eunoia::MetadataCreateInstance< ModelSubmissionSystem >;
+		info.cls->CopyConstructor = Eunoia::MetadataGetCopyInstance< ModelSubmissionSystem >();
+		info.cls->Destructor = Eunoia::MetadataDestroyInstance< ModelSubmissionSystem >;
 		info.cls->members.SetCapacityAndElementCount( 0 );
 
 		return info;
@@ -2724,6 +2802,8 @@ namespace Eunoia {
 		info.cls->isSystem = true;
 		info.cls->isEvent = false;
 		info.cls->DefaultConstructor = Eunoia::MetadataCreateInstance< MouseLookAround3DSystem >;
+		info.cls->CopyConstructor = Eunoia::MetadataGetCopyInstance< MouseLookAround3DSystem >();
+		info.cls->Destructor = Eunoia::MetadataDestroyInstance< MouseLookAround3DSystem >;
 		info.cls->members.SetCapacityAndElementCount( 0 );
 
 		return info;
@@ -2747,6 +2827,8 @@ namespace Eunoia {
 		info.cls->isSystem = true;
 		info.cls->isEvent = false;
 		info.cls->DefaultConstructor = Eunoia::MetadataCreateInstance< ViewProjectionSystem >;
+		info.cls->CopyConstructor = Eunoia::MetadataGetCopyInstance< ViewProjectionSystem >();
+		info.cls->Destructor = Eunoia::MetadataDestroyInstance< ViewProjectionSystem >;
 		info.cls->members.SetCapacityAndElementCount( 0 );
 
 		return info;
@@ -2770,6 +2852,8 @@ namespace Eunoia {
 		info.cls->isSystem = true;
 		info.cls->isEvent = false;
 		info.cls->DefaultConstructor = Eunoia::MetadataCreateInstance< LightSubmissionSystem >;
+		info.cls->CopyConstructor = Eunoia::MetadataGetCopyInstance< LightSubmissionSystem >();
+		info.cls->Destructor = Eunoia::MetadataDestroyInstance< LightSubmissionSystem >;
 		info.cls->members.SetCapacityAndElementCount( 0 );
 
 		return info;
@@ -2793,6 +2877,8 @@ namespace Eunoia {
 		info.cls->isSystem = true;
 		info.cls->isEvent = false;
 		info.cls->DefaultConstructor = Eunoia::MetadataCreateInstance< SpriteSubmissionSystem >;
+		info.cls->CopyConstructor = Eunoia::MetadataGetCopyInstance< SpriteSubmissionSystem >();
+		info.cls->Destructor = Eunoia::MetadataDestroyInstance< SpriteSubmissionSystem >;
 		info.cls->members.SetCapacityAndElementCount( 0 );
 
 		return info;
@@ -2816,6 +2902,8 @@ namespace Eunoia {
 		info.cls->isSystem = true;
 		info.cls->isEvent = false;
 		info.cls->DefaultConstructor = Eunoia::MetadataCreateInstance< TransformHierarchy3DSystem >;
+		info.cls->CopyConstructor = Eunoia::MetadataGetCopyInstance< TransformHierarchy3DSystem >();
+		info.cls->Destructor = Eunoia::MetadataDestroyInstance< TransformHierarchy3DSystem >;
 		info.cls->members.SetCapacityAndElementCount( 0 );
 
 		return info;
@@ -2839,6 +2927,8 @@ namespace Eunoia {
 		info.cls->isSystem = true;
 		info.cls->isEvent = false;
 		info.cls->DefaultConstructor = Eunoia::MetadataCreateInstance< TransformHierarchy2DSystem >;
+		info.cls->CopyConstructor = Eunoia::MetadataGetCopyInstance< TransformHierarchy2DSystem >();
+		info.cls->Destructor = Eunoia::MetadataDestroyInstance< TransformHierarchy2DSystem >;
 		info.cls->members.SetCapacityAndElementCount( 0 );
 
 		return info;
@@ -2862,6 +2952,8 @@ namespace Eunoia {
 		info.cls->isSystem = true;
 		info.cls->isEvent = false;
 		info.cls->DefaultConstructor = Eunoia::MetadataCreateInstance< GuiSystem >;
+		info.cls->CopyConstructor = Eunoia::MetadataGetCopyInstance< GuiSystem >();
+		info.cls->Destructor = Eunoia::MetadataDestroyInstance< GuiSystem >;
 		info.cls->members.SetCapacityAndElementCount( 0 );
 
 		return info;
@@ -2885,6 +2977,8 @@ namespace Eunoia {
 		info.cls->isSystem = true;
 		info.cls->isEvent = false;
 		info.cls->DefaultConstructor = Eunoia::MetadataCreateInstance< Text2DSubmissionSystem >;
+		info.cls->CopyConstructor = Eunoia::MetadataGetCopyInstance< Text2DSubmissionSystem >();
+		info.cls->Destructor = Eunoia::MetadataDestroyInstance< Text2DSubmissionSystem >;
 		info.cls->members.SetCapacityAndElementCount( 0 );
 
 		return info;
@@ -2908,6 +3002,8 @@ namespace Eunoia {
 		info.cls->isSystem = true;
 		info.cls->isEvent = false;
 		info.cls->DefaultConstructor = Eunoia::MetadataCreateInstance< ModelAnimationSystem >;
+		info.cls->CopyConstructor = Eunoia::MetadataGetCopyInstance< ModelAnimationSystem >();
+		info.cls->Destructor = Eunoia::MetadataDestroyInstance< ModelAnimationSystem >;
 		info.cls->members.SetCapacityAndElementCount( 0 );
 
 		return info;
@@ -2931,6 +3027,8 @@ namespace Eunoia {
 		info.cls->isSystem = true;
 		info.cls->isEvent = false;
 		info.cls->DefaultConstructor = Eunoia::MetadataCreateInstance< PhysicsSystem >;
+		info.cls->CopyConstructor = Eunoia::MetadataGetCopyInstance< PhysicsSystem >();
+		info.cls->Destructor = Eunoia::MetadataDestroyInstance< PhysicsSystem >;
 		info.cls->members.SetCapacityAndElementCount( 0 );
 
 		return info;
@@ -2954,6 +3052,8 @@ namespace Eunoia {
 		info.cls->isSystem = true;
 		info.cls->isEvent = false;
 		info.cls->DefaultConstructor = Eunoia::MetadataCreateInstance< Gamepad3DSystem >;
+		info.cls->CopyConstructor = Eunoia::MetadataGetCopyInstance< Gamepad3DSystem >();
+		info.cls->Destructor = Eunoia::MetadataDestroyInstance< Gamepad3DSystem >;
 		info.cls->members.SetCapacityAndElementCount( 0 );
 
 		return info;
@@ -2977,6 +3077,8 @@ namespace Eunoia {
 		info.cls->isSystem = true;
 		info.cls->isEvent = false;
 		info.cls->DefaultConstructor = Eunoia::MetadataCreateInstance< KeyboardLookAround3DSystem >;
+		info.cls->CopyConstructor = Eunoia::MetadataGetCopyInstance< KeyboardLookAround3DSystem >();
+		info.cls->Destructor = Eunoia::MetadataDestroyInstance< KeyboardLookAround3DSystem >;
 		info.cls->members.SetCapacityAndElementCount( 0 );
 
 		return info;
@@ -3000,6 +3102,8 @@ namespace Eunoia {
 		info.cls->isSystem = true;
 		info.cls->isEvent = false;
 		info.cls->DefaultConstructor = Eunoia::MetadataCreateInstance< KeyboardMovement2DSystem >;
+		info.cls->CopyConstructor = Eunoia::MetadataGetCopyInstance< KeyboardMovement2DSystem >();
+		info.cls->Destructor = Eunoia::MetadataDestroyInstance< KeyboardMovement2DSystem >;
 		info.cls->members.SetCapacityAndElementCount( 0 );
 
 		return info;
@@ -3023,6 +3127,8 @@ namespace Eunoia {
 		info.cls->isSystem = true;
 		info.cls->isEvent = false;
 		info.cls->DefaultConstructor = Eunoia::MetadataCreateInstance< ViewProjection2DSystem >;
+		info.cls->CopyConstructor = Eunoia::MetadataGetCopyInstance< ViewProjection2DSystem >();
+		info.cls->Destructor = Eunoia::MetadataDestroyInstance< ViewProjection2DSystem >;
 		info.cls->members.SetCapacityAndElementCount( 0 );
 
 		return info;
@@ -3046,6 +3152,8 @@ namespace Eunoia {
 		info.cls->isSystem = false;
 		info.cls->isEvent = true;
 		info.cls->DefaultConstructor = Eunoia::MetadataCreateInstance< GuiElementOnClickEvent >;
+		info.cls->CopyConstructor = Eunoia::MetadataGetCopyInstance< GuiElementOnClickEvent >();
+		info.cls->Destructor = Eunoia::MetadataDestroyInstance< GuiElementOnClickEvent >;
 		info.cls->members.SetCapacityAndElementCount( 4 );
 
 		info.cls->members[ 0 ].name = "elementClicked";
@@ -3129,11 +3237,163 @@ namespace Eunoia {
 		info.cls->isSystem = false;
 		info.cls->isEvent = true;
 		info.cls->DefaultConstructor = Eunoia::MetadataCreateInstance< RigidBodyTransformModifiedEvent >;
+		info.cls->CopyConstructor = Eunoia::MetadataGetCopyInstance< RigidBodyTransformModifiedEvent >();
+		info.cls->Destructor = Eunoia::MetadataDestroyInstance< RigidBodyTransformModifiedEvent >;
+		info.cls->members.SetCapacityAndElementCount( 0 );
+
+		return info;
+	}
+
+	template<>
+	EU_API metadata_typeid Metadata::GetTypeID < SceneStreamedEvent > () { return 73; }
+
+	template<>
+	MetadataInfo Metadata::ConstructMetadataInfo<SceneStreamedEvent>()
+	{
+		MetadataInfo info;
+		info.id = 73;
+		info.type = METADATA_CLASS;
+		info.cls = Eunoia::Metadata::AllocateClass( true );
+		info.cls->name = "SceneStreamedEvent";
+		info.cls->baseClassName = "ECSEvent";
+		info.cls->baseClassSize = sizeof( ECSEvent );
+		info.cls->size = sizeof( SceneStreamedEvent );
+		info.cls->isComponent = false;
+		info.cls->isSystem = false;
+		info.cls->isEvent = true;
+		info.cls->DefaultConstructor = Eunoia::MetadataCreateInstance< SceneStreamedEvent >;
+		info.cls->CopyConstructor = Eunoia::MetadataGetCopyInstance< SceneStreamedEvent >();
+		info.cls->Destructor = Eunoia::MetadataDestroyInstance< SceneStreamedEvent >;
+		info.cls->members.SetCapacityAndElementCount( 3 );
+
+		info.cls->members[ 0 ].name = "stream";
+		info.cls->members[ 0 ].typeName = "ECSSceneStreamID";
+		info.cls->members[ 0 ].typeID = GetTypeID<ECSSceneStreamID>();
+		info.cls->members[ 0 ].accessModifier = METADATA_ACCESS_MODIFIER_PUBLIC;
+		info.cls->members[ 0 ].offset = offsetof( SceneStreamedEvent, SceneStreamedEvent::stream );
+		info.cls->members[ 0 ].size = sizeof( ECSSceneStreamID );
+		info.cls->members[ 0 ].isStatic = false;
+		info.cls->members[ 0 ].isConst = false;
+		info.cls->members[ 0 ].isPointer = false;
+		info.cls->members[ 0 ].arrayLength = 1;
+		info.cls->members[ 0 ].uiSliderMin = v4(0.0);
+		info.cls->members[ 0 ].uiSliderMax = v4(0.0);
+		info.cls->members[ 0 ].uiSliderSpeed = 0.1;
+		info.cls->members[ 0 ].is32BitBool = false;
+
+		info.cls->members[ 1 ].name = "scene";
+		info.cls->members[ 1 ].typeName = "SceneID";
+		info.cls->members[ 1 ].typeID = GetTypeID<SceneID>();
+		info.cls->members[ 1 ].accessModifier = METADATA_ACCESS_MODIFIER_PUBLIC;
+		info.cls->members[ 1 ].offset = offsetof( SceneStreamedEvent, SceneStreamedEvent::scene );
+		info.cls->members[ 1 ].size = sizeof( SceneID );
+		info.cls->members[ 1 ].isStatic = false;
+		info.cls->members[ 1 ].isConst = false;
+		info.cls->members[ 1 ].isPointer = false;
+		info.cls->members[ 1 ].arrayLength = 1;
+		info.cls->members[ 1 ].uiSliderMin = v4(0.0);
+		info.cls->members[ 1 ].uiSliderMax = v4(0.0);
+		info.cls->members[ 1 ].uiSliderSpeed = 0.1;
+		info.cls->members[ 1 ].is32BitBool = false;
+
+		info.cls->members[ 2 ].name = "loaded";
+		info.cls->members[ 2 ].typeName = "b32";
+		info.cls->members[ 2 ].typeID = GetTypeID<b32>();
+		info.cls->members[ 2 ].accessModifier = METADATA_ACCESS_MODIFIER_PUBLIC;
+		info.cls->members[ 2 ].offset = offsetof( SceneStreamedEvent, SceneStreamedEvent::loaded );
+		info.cls->members[ 2 ].size = sizeof( b32 );
+		info.cls->members[ 2 ].isStatic = false;
+		info.cls->members[ 2 ].isConst = false;
+		info.cls->members[ 2 ].isPointer = false;
+		info.cls->members[ 2 ].arrayLength = 1;
+		info.cls->members[ 2 ].uiSliderMin = v4(0.0);
+		info.cls->members[ 2 ].uiSliderMax = v4(0.0);
+		info.cls->members[ 2 ].uiSliderSpeed = 0.1;
+		info.cls->members[ 2 ].is32BitBool = false;
+
+		return info;
+	}
+
+	template<>
+	EU_API metadata_typeid Metadata::GetTypeID < SpatialIndex3DComponent > () { return 74; }
+
+	template<>
+	MetadataInfo Metadata::ConstructMetadataInfo<SpatialIndex3DComponent>()
+	{
+		MetadataInfo info;
+		info.id = 74;
+		info.type = METADATA_CLASS;
+		info.cls = Eunoia::Metadata::AllocateClass( true );
+		info.cls->name = "SpatialIndex3DComponent";
+		info.cls->baseClassName = "ECSComponent";
+		info.cls->baseClassSize = sizeof( ECSComponent );
+		info.cls->size = sizeof( SpatialIndex3DComponent );
+		info.cls->isComponent = true;
+		info.cls->isSystem = false;
+		info.cls->isEvent = false;
+		info.cls->DefaultConstructor = Eunoia::MetadataCreateInstance< SpatialIndex3DComponent >;
+		info.cls->CopyConstructor = Eunoia::MetadataGetCopyInstance< SpatialIndex3DComponent >();
+		info.cls->Destructor = Eunoia::MetadataDestroyInstance< SpatialIndex3DComponent >;
+		info.cls->members.SetCapacityAndElementCount( 2 );
+
+		info.cls->members[ 0 ].name = "radius";
+		info.cls->members[ 0 ].typeName = "r32";
+		info.cls->members[ 0 ].typeID = GetTypeID<r32>();
+		info.cls->members[ 0 ].accessModifier = METADATA_ACCESS_MODIFIER_PUBLIC;
+		info.cls->members[ 0 ].offset = offsetof( SpatialIndex3DComponent, SpatialIndex3DComponent::radius );
+		info.cls->members[ 0 ].size = sizeof( r32 );
+		info.cls->members[ 0 ].isStatic = false;
+		info.cls->members[ 0 ].isConst = false;
+		info.cls->members[ 0 ].isPointer = false;
+		info.cls->members[ 0 ].arrayLength = 1;
+		info.cls->members[ 0 ].uiSliderMin = v4(0.0);
+		info.cls->members[ 0 ].uiSliderMax = v4(0.0);
+		info.cls->members[ 0 ].uiSliderSpeed = 0.1;
+		info.cls->members[ 0 ].is32BitBool = false;
+
+		info.cls->members[ 1 ].name = "center";
+		info.cls->members[ 1 ].typeName = "v3";
+		info.cls->members[ 1 ].typeID = GetTypeID<v3>();
+		info.cls->members[ 1 ].accessModifier = METADATA_ACCESS_MODIFIER_PUBLIC;
+		info.cls->members[ 1 ].offset = offsetof( SpatialIndex3DComponent, SpatialIndex3DComponent::center );
+		info.cls->members[ 1 ].size = sizeof( v3 );
+		info.cls->members[ 1 ].isStatic = false;
+		info.cls->members[ 1 ].isConst = false;
+		info.cls->members[ 1 ].isPointer = false;
+		info.cls->members[ 1 ].arrayLength = 1;
+		info.cls->members[ 1 ].uiSliderMin = v4(0.0);
+		info.cls->members[ 1 ].uiSliderMax = v4(0.0);
+		info.cls->members[ 1 ].uiSliderSpeed = 0.1;
+		info.cls->members[ 1 ].is32BitBool = false;
+
+		return info;
+	}
+
+	template<>
+	EU_API metadata_typeid Metadata::GetTypeID < SpatialIndex3DSystem > () { return 75; }
+
+	template<>
+	MetadataInfo Metadata::ConstructMetadataInfo<SpatialIndex3DSystem>()
+	{
+		MetadataInfo info;
+		info.id = 75;
+		info.type = METADATA_CLASS;
+		info.cls = Eunoia::Metadata::AllocateClass( true );
+		info.cls->name = "SpatialIndex3DSystem";
+		info.cls->baseClassName = "ECSSystem";
+		info.cls->baseClassSize = sizeof( ECSSystem );
+		info.cls->size = sizeof( SpatialIndex3DSystem );
+		info.cls->isComponent = false;
+		info.cls->isSystem = true;
+		info.cls->isEvent = false;
+		info.cls->DefaultConstructor = Eunoia::MetadataCreateInstance< SpatialIndex3DSystem >;
+		info.cls->CopyConstructor = Eunoia::MetadataGetCopyInstance< SpatialIndex3DSystem >();
+		info.cls->Destructor = Eunoia::MetadataDestroyInstance< SpatialIndex3DSystem >;
 		info.cls->members.SetCapacityAndElementCount( 0 );
 
 		return info;
 	}
-	const metadata_typeid Metadata::LastEngineTypeID = 72;
+	const metadata_typeid Metadata::LastEngineTypeID = 75;
 
 	void Metadata::InitMetadataInfos()
 	{
@@ -3201,6 +3461,9 @@ namespace Eunoia {
 		RegisterMetadataInfo( ConstructMetadataInfo< ViewProjection2DSystem >() );
 		RegisterMetadataInfo( ConstructMetadataInfo< GuiElementOnClickEvent >() );
 		RegisterMetadataInfo( ConstructMetadataInfo< RigidBodyTransformModifiedEvent >() );
+		RegisterMetadataInfo( ConstructMetadataInfo< SceneStreamedEvent >() );
+		RegisterMetadataInfo( ConstructMetadataInfo< SpatialIndex3DComponent >() );
+		RegisterMetadataInfo( ConstructMetadataInfo< SpatialIndex3DSystem >() );
 	}
 
 }
\ No newline at end of file
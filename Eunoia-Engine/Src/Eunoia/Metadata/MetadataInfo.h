@@ -3,10 +3,22 @@
 #include "../DataStructures/String.h"
 #include "../DataStructures/List.h"
 #include "../Math/Math.h"
+#include <type_traits>
 
 namespace Eunoia {
 
 	template<typename T> static void MetadataCreateInstance(void* dst) { new(dst) T(); }
+	template<typename T> static void MetadataCopyInstance(void* dst, const void* src) { new(dst) T(*(const T*)src); }
+	template<typename T> static void MetadataDestroyInstance(void* dst) { ((T*)dst)->~T(); }
+
+	//Types with a deleted copy constructor get 0 so callers can refuse to copy them
+	template<typename T> static void (*MetadataGetCopyInstance())(void*, const void*)
+	{
+		if constexpr (std::is_copy_constructible<T>::value)
+			return MetadataCopyInstance<T>;
+		else
+			return 0;
+	}
 
 	typedef u32 metadata_typeid;
 
@@ -64,6 +76,9 @@ namespace Eunoia {
 		b32 isSystem;
 		b32 isEvent;
 		void (*DefaultConstructor)(void*);
+		//Copies the members with their own copy constructors, 0 if the type can't be copied
+		void (*CopyConstructor)(void* dst, const void* src);
+		void (*Destructor)(void*);
 	};
 
 	enum MetadataPrimitveType
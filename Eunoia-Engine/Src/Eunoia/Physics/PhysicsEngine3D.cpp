@@ -1,4 +1,5 @@
 #include "PhysicsEngine3D.h"
+#include "../Core/Profiler.h"
 #include "../DataStructures/List.h"
 
 namespace Eunoia {
@@ -113,7 +114,9 @@ namespace Eunoia {
 
 	void PhysicsEngine3D::StepSimulation(r32 dt)
 	{
-		m_World->stepSimulation(dt);
+		EU_PROFILE_FUNCTION();
+		//The engine already runs physics in fixed steps, Bullet takes exactly one step of dt instead of interpolating its own
+		m_World->stepSimulation(dt, 1, dt);
 	}
 
 	void PhysicsEngine3D::ClearForces()
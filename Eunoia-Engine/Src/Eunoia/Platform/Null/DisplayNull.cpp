@@ -0,0 +1,99 @@
+#include "DisplayNull.h"
+
+namespace Eunoia {
+
+	DisplayNull::DisplayNull() :
+		m_Width(0),
+		m_Height(0),
+		m_IsFullscreened(false),
+		m_IsCursorVisible(true),
+		m_MousePos(0.0f, 0.0f)
+	{}
+
+	b32 DisplayNull::Create(const String& title, u32 width, u32 height)
+	{
+		m_Title = title;
+		m_Width = width;
+		m_Height = height;
+		return true;
+	}
+
+	void DisplayNull::Destroy()
+	{
+	}
+
+	void DisplayNull::Update()
+	{
+	}
+
+	String DisplayNull::GetTitle() const
+	{
+		return m_Title;
+	}
+
+	u32 DisplayNull::GetWidth() const
+	{
+		return m_Width;
+	}
+
+	u32 DisplayNull::GetHeigth() const
+	{
+		return m_Height;
+	}
+
+	b32 DisplayNull::IsMinimized() const
+	{
+		return false;
+	}
+
+	b32 DisplayNull::IsFocused() const
+	{
+		return true;
+	}
+
+	b32 DisplayNull::IsFullscreened() const
+	{
+		return m_IsFullscreened;
+	}
+
+	void DisplayNull::SetFullscreen(b32 fullscreen)
+	{
+		m_IsFullscreened = fullscreen;
+	}
+
+	void DisplayNull::ToggleFullscreen()
+	{
+		m_IsFullscreened = !m_IsFullscreened;
+	}
+
+	v2 DisplayNull::GetMousePos()
+	{
+		return m_MousePos;
+	}
+
+	v2 DisplayNull::GetMouseDeltaPos()
+	{
+		return v2(0.0f, 0.0f);
+	}
+
+	void DisplayNull::SetMousePos(const v2& pos)
+	{
+		m_MousePos = pos;
+	}
+
+	b32 DisplayNull::IsCursorVisible()
+	{
+		return m_IsCursorVisible;
+	}
+
+	void DisplayNull::SetCursorVisible(b32 visible)
+	{
+		m_IsCursorVisible = visible;
+	}
+
+	b32 DisplayNull::CheckForEvent(DisplayEventType type) const
+	{
+		return false;
+	}
+
+}
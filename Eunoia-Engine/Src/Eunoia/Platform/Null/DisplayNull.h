@@ -0,0 +1,42 @@
+#pragma once
+
+#include "../../Rendering/Display.h"
+
+namespace Eunoia {
+
+	//A display without a window for headless worlds. It never minimizes, is always focused, never gets input and never asks to close
+	class EU_API DisplayNull : public Display
+	{
+	public:
+		DisplayNull();
+
+		virtual b32 Create(const String& title, u32 width, u32 height) override;
+		virtual void Destroy() override;
+		virtual void Update() override;
+		virtual String GetTitle() const override;
+		virtual u32 GetWidth() const override;
+		virtual u32 GetHeigth() const override;
+		virtual b32 IsMinimized() const override;
+		virtual b32 IsFocused() const override;
+		virtual b32 IsFullscreened() const override;
+
+		virtual void SetFullscreen(b32 fullscreen) override;
+		virtual void ToggleFullscreen() override;
+
+		virtual v2 GetMousePos() override;
+		virtual v2 GetMouseDeltaPos() override;
+		virtual void SetMousePos(const v2& Pos) override;
+		virtual b32 IsCursorVisible() override;
+		virtual void SetCursorVisible(b32 visuble) override;
+
+		virtual b32 CheckForEvent(DisplayEventType type) const override;
+	private:
+		String m_Title;
+		u32 m_Width;
+		u32 m_Height;
+		b32 m_IsFullscreened;
+		b32 m_IsCursorVisible;
+		v2 m_MousePos;
+	};
+
+}
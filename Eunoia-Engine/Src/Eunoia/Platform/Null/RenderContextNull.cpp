@@ -0,0 +1,287 @@
+#include "RenderContextNull.h"
+#include "../../Rendering/Asset/TextureLoader.h"
+
+namespace Eunoia {
+
+	RenderContextNull::RenderContextNull() :
+		m_Display(0),
+		m_NumShaders(0),
+		m_NumShaderBuffers(0),
+		m_NumSamplers(0),
+		m_CurrentPipeline(0)
+	{
+		ResetStats();
+	}
+
+	void RenderContextNull::Init(Display* display)
+	{
+		m_Display = display;
+	}
+
+	ShaderID RenderContextNull::LoadShader(const String& name)
+	{
+		return ++m_NumShaders;
+	}
+
+	RenderPassID RenderContextNull::CreateRenderPass(const RenderPass& renderPass)
+	{
+		RenderPassNull renderPassNull;
+		renderPassNull.width = renderPass.framebuffer.width;
+		renderPassNull.height = renderPass.framebuffer.height;
+		renderPassNull.useSwapchainSize = renderPass.framebuffer.useSwapchainSize;
+
+		m_RenderPasses.Push(renderPassNull);
+		return m_RenderPasses.Size();
+	}
+
+	ShaderBufferID RenderContextNull::CreateShaderBuffer(ShaderBufferType type, mem_size size, u32 initialMaxUpdatesPerFrame)
+	{
+		return ++m_NumShaderBuffers;
+	}
+
+	BufferID RenderContextNull::CreateBuffer(BufferType type, BufferUsage usage, const void* data, mem_size size)
+	{
+		m_Buffers.Push(BufferNull());
+		BufferID buffer = m_Buffers.Size();
+		RecreateBuffer(buffer, type, usage, data, size);
+		return buffer;
+	}
+
+	TextureID RenderContextNull::CreateTexture2D(const String& path)
+	{
+		//Still decoded so loading costs the same as with a GPU
+		u32 width, height;
+		u8* pixels = TextureLoader::LoadEutexTexture(path, &width, &height);
+
+		if (!pixels)
+			return EU_INVALID_TEXTURE_ID;
+
+		TextureID tid = CreateTexture2D(pixels, width, height, TEXTURE_FORMAT_RGBA8_UNORM, false, path);
+		TextureLoader::FreeEutexTexture(pixels);
+		return tid;
+	}
+
+	TextureID RenderContextNull::CreateTexture2D(const u8* pixels, u32 width, u32 height, TextureFormat format, b32 isFramebufferAttachment, const String& path)
+	{
+		TextureNull texture;
+		texture.width = width;
+		texture.height = height;
+		texture.renderPass = EU_INVALID_RENDER_PASS_ID;
+
+		m_Textures.Push(texture);
+		return m_Textures.Size();
+	}
+
+	TextureID RenderContextNull::CreateTextureHandleForFramebufferAttachment(RenderPassID renderPass, u32 attachment)
+	{
+		TextureNull texture;
+		texture.width = 0;
+		texture.height = 0;
+		texture.renderPass = renderPass;
+
+		m_Textures.Push(texture);
+		return m_Textures.Size();
+	}
+
+	SamplerID RenderContextNull::CreateSampler(const Sampler& sampler)
+	{
+		return ++m_NumSamplers;
+	}
+
+	void RenderContextNull::DestroyRenderPass(RenderPassID renderPass)
+	{
+	}
+
+	void RenderContextNull::DestroyShader(ShaderID shader)
+	{
+	}
+
+	void RenderContextNull::DestroyTexture(TextureID texture)
+	{
+	}
+
+	void RenderContextNull::DestroyBuffer(BufferID buffer)
+	{
+		m_Buffers[buffer - 1].data.Clear();
+	}
+
+	void RenderContextNull::RecreateBuffer(BufferID buffer, BufferType type, BufferUsage usage, const void* data, mem_size size)
+	{
+		List<u8>* memory = &m_Buffers[buffer - 1].data;
+		memory->Clear();
+		if (size == 0)
+			return;
+
+		memory->SetCapacityAndElementCount((u32)size);
+		if (data)
+			memcpy(&(*memory)[0], data, size);
+		else
+			memset(&(*memory)[0], 0, size);
+	}
+
+	void RenderContextNull::AttachShaderBufferToRenderPass(RenderPassID renderPass, ShaderBufferID shaderBuffer, u32 subpass, u32 pipeline, u32 set, u32 binding)
+	{
+	}
+
+	void RenderContextNull::BeginFrame()
+	{
+		m_CurrentPipeline = 0;
+	}
+
+	void RenderContextNull::BeginRenderPass(const RenderPassBeginInfo& beginInfo)
+	{
+		m_CurrentPipeline = beginInfo.initialPipeline;
+		m_FrameStats.numRenderPasses++;
+	}
+
+	void RenderContextNull::ClearAttachments(const ClearFramebufferAttachmentsCommand& clearCommand)
+	{
+	}
+
+	void RenderContextNull::ClearStencil(u32 stencil)
+	{
+	}
+
+	void RenderContextNull::SetViewport(const Rect& viewport)
+	{
+	}
+
+	void RenderContextNull::SetScissor(const Rect& scissor)
+	{
+	}
+
+	void RenderContextNull::UpdateShaderBuffer(ShaderBufferID shaderBuffer, const void* data, mem_size size)
+	{
+		m_FrameStats.numShaderBufferUpdates++;
+		m_FrameStats.shaderBufferUpdateSize += size;
+	}
+
+	void RenderContextNull::UpdateShaderBufferAllFrames(ShaderBufferID shaderBuffer, const void* data, mem_size size)
+	{
+		UpdateShaderBuffer(shaderBuffer, data, size);
+	}
+
+	void RenderContextNull::BindTextureGroup(const TextureGroupBind& groupBind)
+	{
+		m_FrameStats.numTextureGroupBinds++;
+		for (u32 i = 0; i < groupBind.numTextureBinds; i++)
+			m_FrameStats.numTextureBinds += groupBind.binds[i].textureArrayLength;
+	}
+
+	void RenderContextNull::SubmitRenderCommand(const RenderCommand& renderCommand)
+	{
+		m_FrameStats.numDraws++;
+		m_FrameStats.numIndices += renderCommand.count;
+	}
+
+	void RenderContextNull::NextSubpass(u32 initialPipeline)
+	{
+		m_CurrentPipeline = initialPipeline;
+	}
+
+	u32 RenderContextNull::SwitchPipeline(u32 pipeline)
+	{
+		m_CurrentPipeline = pipeline;
+		return m_CurrentPipeline;
+	}
+
+	void RenderContextNull::EndRenderPass()
+	{
+	}
+
+	void RenderContextNull::Present()
+	{
+		m_FrameStats.numFrames = 1;
+		m_LastFrameStats = m_FrameStats;
+
+		m_TotalStats.numFrames++;
+		m_TotalStats.numRenderPasses += m_FrameStats.numRenderPasses;
+		m_TotalStats.numDraws += m_FrameStats.numDraws;
+		m_TotalStats.numIndices += m_FrameStats.numIndices;
+		m_TotalStats.numShaderBufferUpdates += m_FrameStats.numShaderBufferUpdates;
+		m_TotalStats.shaderBufferUpdateSize += m_FrameStats.shaderBufferUpdateSize;
+		m_TotalStats.numTextureGroupBinds += m_FrameStats.numTextureGroupBinds;
+		m_TotalStats.numTextureBinds += m_FrameStats.numTextureBinds;
+		m_TotalStats.numBufferMaps += m_FrameStats.numBufferMaps;
+
+		memset(&m_FrameStats, 0, sizeof(RenderContextNullStats));
+	}
+
+	void RenderContextNull::ReadPixelsIntoBuffer(TextureID texture, BufferID buffer)
+	{
+	}
+
+	void RenderContextNull::ResizeFramebuffer(RenderPassID renderPass, u32 width, u32 height)
+	{
+		RenderPassNull* renderPassNull = &m_RenderPasses[renderPass - 1];
+		renderPassNull->width = width;
+		renderPassNull->height = height;
+		renderPassNull->useSwapchainSize = false;
+	}
+
+	void* RenderContextNull::MapBuffer(BufferID buffer)
+	{
+		m_FrameStats.numBufferMaps++;
+		List<u8>* memory = &m_Buffers[buffer - 1].data;
+		return memory->Empty() ? 0 : &(*memory)[0];
+	}
+
+	void RenderContextNull::UnmapBuffer(BufferID buffer)
+	{
+	}
+
+	void RenderContextNull::GetTextureSize(TextureID texture, u32* width, u32* height, u32* depth)
+	{
+		const TextureNull& textureNull = m_Textures[texture - 1];
+		if (textureNull.renderPass != EU_INVALID_RENDER_PASS_ID)
+		{
+			GetFramebufferSize(textureNull.renderPass, width, height);
+		}
+		else
+		{
+			*width = textureNull.width;
+			*height = textureNull.height;
+		}
+
+		if (depth)
+			*depth = 1;
+	}
+
+	void RenderContextNull::GetFramebufferSize(RenderPassID renderPass, u32* width, u32* height)
+	{
+		const RenderPassNull& renderPassNull = m_RenderPasses[renderPass - 1];
+		if (renderPassNull.useSwapchainSize)
+		{
+			*width = m_Display->GetWidth();
+			*height = m_Display->GetHeigth();
+		}
+		else
+		{
+			*width = renderPassNull.width;
+			*height = renderPassNull.height;
+		}
+	}
+
+	RenderAPI RenderContextNull::GetRenderAPI() const
+	{
+		return RENDER_API_NULL;
+	}
+
+	const RenderContextNullStats& RenderContextNull::GetLastFrameStats() const
+	{
+		return m_LastFrameStats;
+	}
+
+	const RenderContextNullStats& RenderContextNull::GetTotalStats() const
+	{
+		return m_TotalStats;
+	}
+
+	void RenderContextNull::ResetStats()
+	{
+		memset(&m_FrameStats, 0, sizeof(RenderContextNullStats));
+		memset(&m_LastFrameStats, 0, sizeof(RenderContextNullStats));
+		memset(&m_TotalStats, 0, sizeof(RenderContextNullStats));
+	}
+
+}
@@ -0,0 +1,116 @@
+#pragma once
+
+#include "../../Rendering/RenderContext.h"
+#include "../../DataStructures/List.h"
+
+namespace Eunoia {
+
+	struct RenderContextNullStats
+	{
+		u32 numFrames;
+		u32 numRenderPasses;
+		u32 numDraws;
+		u64 numIndices;
+		u32 numShaderBufferUpdates;
+		u64 shaderBufferUpdateSize;
+		u32 numTextureGroupBinds;
+		u32 numTextureBinds;
+		u32 numBufferMaps;
+	};
+
+	struct BufferNull
+	{
+		List<u8> data;
+	};
+
+	struct TextureNull
+	{
+		u32 width;
+		u32 height;
+		//Framebuffer attachments follow the size of their render pass
+		RenderPassID renderPass;
+	};
+
+	struct RenderPassNull
+	{
+		u32 width;
+		u32 height;
+		b32 useSwapchainSize;
+	};
+
+	/*
+		Accepts every call without a GPU for headless worlds. Objects get valid ids, buffers are kept in memory so they can be
+		mapped, everything else is only counted so the cost of the CPU side of rendering can be measured on its own
+	*/
+	class EU_API RenderContextNull : public RenderContext
+	{
+	public:
+		RenderContextNull();
+		virtual void Init(Display* display) override;
+
+		virtual ShaderID LoadShader(const String& name) override;
+		virtual RenderPassID CreateRenderPass(const RenderPass& renderPass) override;
+		virtual ShaderBufferID CreateShaderBuffer(ShaderBufferType type, mem_size size, u32 initialMaxUpdatesPerFrame = 1) override;
+		virtual BufferID CreateBuffer(BufferType type, BufferUsage usage, const void* data, mem_size size) override;
+		virtual TextureID CreateTexture2D(const String& path) override;
+		virtual TextureID CreateTexture2D(const u8* pixels, u32 width, u32 height, TextureFormat format, b32 isFramebufferAttachment = false, const String& path = "_NoPath_") override;
+		virtual TextureID CreateTextureHandleForFramebufferAttachment(RenderPassID renderPass, u32 attachment) override;
+		virtual SamplerID CreateSampler(const Sampler& sampler) override;
+
+		virtual void DestroyRenderPass(RenderPassID renderPass) override;
+		virtual void DestroyShader(ShaderID shader) override;
+		virtual void DestroyTexture(TextureID texture) override;
+
+		virtual void DestroyBuffer(BufferID buffer) override;
+		virtual void RecreateBuffer(BufferID buffer, BufferType type, BufferUsage usage, const void* data, mem_size size) override;
+
+		virtual void AttachShaderBufferToRenderPass(RenderPassID renderPass, ShaderBufferID shaderBuffer, u32 subpass, u32 pipeline, u32 set, u32 binding) override;
+
+		virtual void BeginFrame() override;
+		virtual void BeginRenderPass(const RenderPassBeginInfo& beginInfo) override;
+		virtual void ClearAttachments(const ClearFramebufferAttachmentsCommand& clearCommand) override;
+		virtual void ClearStencil(u32 stencil) override;
+		virtual void SetViewport(const Rect& viewport) override;
+		virtual void SetScissor(const Rect& scissor) override;
+		virtual void UpdateShaderBuffer(ShaderBufferID shaderBuffer, const void* data, mem_size size) override;
+		virtual void UpdateShaderBufferAllFrames(ShaderBufferID shaderBuffer, const void* data, mem_size size) override;
+		virtual void BindTextureGroup(const TextureGroupBind& groupBind) override;
+		virtual void SubmitRenderCommand(const RenderCommand& renderCommand) override;
+		virtual void NextSubpass(u32 initialPipeline = 0) override;
+		virtual u32 SwitchPipeline(u32 pipeline) override;
+		virtual void EndRenderPass() override;
+		virtual void Present() override;
+
+		virtual void ReadPixelsIntoBuffer(TextureID texture, BufferID buffer) override;
+
+		virtual void ResizeFramebuffer(RenderPassID renderPass, u32 width, u32 height) override;
+
+		virtual void* MapBuffer(BufferID buffer) override;
+		virtual void UnmapBuffer(BufferID buffer) override;
+		virtual void GetTextureSize(TextureID texture, u32* width, u32* height, u32* depth = 0) override;
+		virtual void GetFramebufferSize(RenderPassID renderPass, u32* width, u32* height) override;
+
+		virtual RenderAPI GetRenderAPI() const override;
+
+		//Everything counted up to the last Present
+		const RenderContextNullStats& GetLastFrameStats() const;
+		//Everything counted since the context was created or the stats were reset
+		const RenderContextNullStats& GetTotalStats() const;
+		void ResetStats();
+	private:
+		Display* m_Display;
+
+		List<BufferNull> m_Buffers;
+		List<TextureNull> m_Textures;
+		List<RenderPassNull> m_RenderPasses;
+		u32 m_NumShaders;
+		u32 m_NumShaderBuffers;
+		u32 m_NumSamplers;
+		u32 m_CurrentPipeline;
+
+		RenderContextNullStats m_FrameStats;
+		RenderContextNullStats m_LastFrameStats;
+		RenderContextNullStats m_TotalStats;
+	};
+
+}
@@ -138,6 +138,11 @@ namespace Eunoia {
 		return IsIconic(m_Handle);
 	}
 
+	b32 DisplayWin32::IsFocused() const
+	{
+		return GetForegroundWindow() == m_Handle;
+	}
+
 	b32 DisplayWin32::IsFullscreened() const
 	{
 		return m_IsFullscreened;
@@ -20,6 +20,7 @@ namespace Eunoia {
 		virtual u32 GetWidth() const override;
 		virtual u32 GetHeigth() const override;
 		virtual b32 IsMinimized() const override;
+		virtual b32 IsFocused() const override;
 		virtual b32 IsFullscreened() const override;
 
 		virtual void SetFullscreen(b32 fullscreen) override;
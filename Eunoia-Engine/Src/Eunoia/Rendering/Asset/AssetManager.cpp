@@ -1,5 +1,6 @@
 #include "AssetManager.h"
 #include "../../Core/Engine.h"
+#include "../../Core/Profiler.h"
 #include "MaterialLoader.h"
 #include "ModelLoader.h"
 #include "../../Utils/Log.h"
@@ -121,18 +122,22 @@ namespace Eunoia {
 				material.textures[type] = CreateTexture(loadedMaterial.texturePaths[type]);
 		}
 
+		//The render thread reads the material list while binding
+		Engine::WaitForRenderThread();
 		s_Data.materials.Push(material);
 		return s_Data.materials.Size();
 	}
 
 	MaterialID AssetManager::CreateMaterial(const Material& material)
 	{
+		Engine::WaitForRenderThread();
 		s_Data.materials.Push(material);
 		return s_Data.materials.Size();
 	}
 
 	MaterialModifierID AssetManager::CreateMaterialModifier(const LoadedMaterialModifier& loadedMaterialModifier)
 	{
+		Engine::WaitForRenderThread();
 		s_Data.modifiers.Push(loadedMaterialModifier);
 		return s_Data.modifiers.Size();
 	}
@@ -148,6 +153,7 @@ namespace Eunoia {
 
 	void AssetManager::CreateMaterials(const String& eumtlFile, SamplerID sampler, MaterialID* firstMatID, MaterialModifierID* firstModID)
 	{
+		EU_PROFILE_FUNCTION();
 		LoadedMaterialFile loadedMaterialFile;
 		EumtlLoadError error = MaterialLoader::LoadEumtlMaterial(eumtlFile, &loadedMaterialFile);
 		if (error == EUMTL_LOAD_SUCCESS)
@@ -156,6 +162,8 @@ namespace Eunoia {
 
 	ModelID AssetManager::CreateModel(const LoadedModel& loadedModel)
 	{
+		EU_PROFILE_FUNCTION();
+		Engine::WaitForRenderThread();
 		RenderContext* rc = Engine::GetRenderContext();
 
 		Model model;
@@ -201,6 +209,7 @@ namespace Eunoia {
 
 	ModelID AssetManager::CreateModel(const String& eumdlFile)
 	{
+		EU_PROFILE_FUNCTION();
 		const List<MapKeyPair<ModelID, ModelPathInfo>> createdModelPaths = s_Data.modelPaths.GetKeyPairList();
 		for (u32 i = 0; i < createdModelPaths.Size(); i++)
 			if (createdModelPaths[i].elem.path == eumdlFile)
@@ -212,11 +221,23 @@ namespace Eunoia {
 			return CreateModel(loadedModel);
 	}
 
+	ModelID AssetManager::CreateModel(const String& eumdlFile, const LoadedModel& loadedModel)
+	{
+		const List<MapKeyPair<ModelID, ModelPathInfo>>& createdModelPaths = s_Data.modelPaths.GetKeyPairList();
+		for (u32 i = 0; i < createdModelPaths.Size(); i++)
+			if (createdModelPaths[i].elem.path == eumdlFile)
+				return createdModelPaths[i].key;
+
+		return CreateModel(loadedModel);
+	}
+
 	TextureID AssetManager::CreateTexture(const String& eutexFile)
 	{
+		EU_PROFILE_FUNCTION();
 		TextureID id = EU_INVALID_TEXTURE_ID;
 		if (!s_Data.textures.FindElement(eutexFile, &id))
 		{
+			Engine::WaitForRenderThread();
 			id = Engine::GetRenderContext()->CreateTexture2D(eutexFile);
 			s_Data.textures[eutexFile] = id;
 		}
@@ -224,11 +245,29 @@ namespace Eunoia {
 		return id;
 	}
 
+	TextureID AssetManager::CreateTexture(const String& eutexFile, const u8* pixels, u32 width, u32 height)
+	{
+		EU_PROFILE_FUNCTION();
+		TextureID id = EU_INVALID_TEXTURE_ID;
+		if (!s_Data.textures.FindElement(eutexFile, &id))
+		{
+			if (!pixels)
+				return EU_INVALID_TEXTURE_ID;
+
+			Engine::WaitForRenderThread();
+			id = Engine::GetRenderContext()->CreateTexture2D(pixels, width, height, TEXTURE_FORMAT_RGBA8_UNORM, false, eutexFile);
+			s_Data.textures[eutexFile] = id;
+		}
+
+		return id;
+	}
+
 	SamplerID AssetManager::CreateSampler(const Sampler& sampler, const String& name)
 	{
 		SamplerID id = EU_INVALID_SAMPLER_ID;
 		if (!s_Data.samplers.FindElement(name, &id))
 		{
+			Engine::WaitForRenderThread();
 			id = Engine::GetRenderContext()->CreateSampler(sampler);
 			s_Data.samplers[name] = id;
 		}
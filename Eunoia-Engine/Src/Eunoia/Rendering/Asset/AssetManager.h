@@ -24,8 +24,12 @@ namespace Eunoia {
 		static void CreateMaterials(const String& eumtlFile, SamplerID sampler, MaterialID* firstMatID = 0, MaterialModifierID* firstModID = 0);
 		static ModelID CreateModel(const LoadedModel& loadedModel);
 		static ModelID CreateModel(const String& eumdlFile);
+		//Same as CreateModel(eumdlFile) for a model that was already loaded from it, for models loaded off the main thread
+		static ModelID CreateModel(const String& eumdlFile, const LoadedModel& loadedModel);
 
 		static TextureID CreateTexture(const String& eutexFile);
+		//Same as CreateTexture(eutexFile) with the pixels already decoded from it, for textures loaded off the main thread
+		static TextureID CreateTexture(const String& eutexFile, const u8* pixels, u32 width, u32 height);
 
 		static SamplerID CreateSampler(const Sampler& sampler, const String& name);
 		static SamplerID CreateSampler(const Sampler& sampler);
@@ -13,6 +13,12 @@ namespace Eunoia {
 	{
 		String p = path;
 		FILE* file = fopen(p.C_Str(), "rb");
+		if (!file)
+		{
+			EU_LOG_WARN("Could not open eutex texture");
+			return 0;
+		}
+
 		char header[5];
 		fread(header, 1, 5, file);
 		if (!(header[0] == 'e' && header[1] == 'u' && header[2] == 't' && header[3] == 'e' && header[4] == 'x'))
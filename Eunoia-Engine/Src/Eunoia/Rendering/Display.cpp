@@ -1,13 +1,25 @@
 #include "Display.h"
 
 #include "../Core/Input.h"
+#include <cstring>
 
 #ifdef EU_PLATFORM_WINDOWS
 #include "../Platform/Win32/DisplayWin32.h"
+#else
+#include "../Platform/Null/DisplayNull.h"
 #endif
 
 namespace Eunoia {
 
+	Display::Display() :
+		m_StepMousePos(0.0f, 0.0f),
+		m_StepMouseDeltaPos(0.0f, 0.0f),
+		m_HasStepMousePos(false)
+	{
+		memset(m_PendingStepEvents, false, sizeof(b32) * NUM_DISPLAY_EVENT_TYPES);
+		memset(m_StepEvents, false, sizeof(b32) * NUM_DISPLAY_EVENT_TYPES);
+	}
+
 	void Display::AddDisplayEventCallback(DisplayEventFunction function, void* userPtr)
 	{
 		DisplayEventCallback callback;
@@ -23,6 +35,34 @@ namespace Eunoia {
 			m_Callbacks[i].function(info, m_Callbacks[i].userPtr);
 	}
 
+	v2 Display::GetStepMouseDeltaPos() const
+	{
+		return m_StepMouseDeltaPos;
+	}
+
+	b32 Display::CheckForStepEvent(DisplayEventType type) const
+	{
+		return m_StepEvents[type];
+	}
+
+	void Display::AccumulateStepInput()
+	{
+		for (u32 i = 0; i < NUM_DISPLAY_EVENT_TYPES; i++)
+			m_PendingStepEvents[i] |= CheckForEvent((DisplayEventType)i);
+	}
+
+	//The delta is taken between steps rather than summed per update so motion is counted once however the frames fall
+	void Display::BeginStepInput()
+	{
+		v2 mousePos = GetMousePos();
+		m_StepMouseDeltaPos = m_HasStepMousePos ? mousePos - m_StepMousePos : v2(0.0f, 0.0f);
+		m_StepMousePos = mousePos;
+		m_HasStepMousePos = true;
+
+		memcpy(m_StepEvents, m_PendingStepEvents, sizeof(b32) * NUM_DISPLAY_EVENT_TYPES);
+		memset(m_PendingStepEvents, false, sizeof(b32) * NUM_DISPLAY_EVENT_TYPES);
+	}
+
 	void Display::SetKeyState(Key key, b32 state)
 	{
 		EUInput::s_Keys[key] = state;
@@ -37,7 +77,9 @@ namespace Eunoia {
 	{
 #ifdef EU_PLATFORM_WINDOWS
 		return new DisplayWin32();
+#else
+		//No window backend on this platform yet, only headless worlds can run
+		return new DisplayNull();
 #endif
-		return 0;
 	}
 }
@@ -44,6 +44,8 @@ namespace Eunoia {
 	class EU_API Display
 	{
 	public:
+		Display();
+
 		virtual b32 Create(const String& title, u32 width, u32 heigth) = 0;
 		virtual void Destroy() = 0;
 		virtual void Update() = 0;
@@ -51,6 +53,8 @@ namespace Eunoia {
 		virtual u32 GetWidth() const = 0;
 		virtual u32 GetHeigth() const = 0;
 		virtual b32 IsMinimized() const = 0;
+		//Whether the display has keyboard focus
+		virtual b32 IsFocused() const = 0;
 		virtual b32 IsFullscreened() const = 0;
 
 		virtual void SetFullscreen(b32 fullscreen) = 0;
@@ -65,6 +69,17 @@ namespace Eunoia {
 		virtual void SetCursorVisible(b32 visuble) = 0;
 
 		void AddDisplayEventCallback(DisplayEventFunction function, void* userPtr = 0);
+
+		/*
+			The displays are updated once per frame but a frame runs zero or more simulation steps. Code running in a step
+			reads these instead of GetMouseDeltaPos and CheckForEvent, every step gets what happened since the step before it
+		*/
+		v2 GetStepMouseDeltaPos() const;
+		b32 CheckForStepEvent(DisplayEventType type) const;
+
+		//Called by the engine after every Update and before every simulation step
+		void AccumulateStepInput();
+		void BeginStepInput();
 	protected:
 		void ProcessDisplayEvents(const DisplayEvent& info);
 		static void SetKeyState(Key key, b32 state);
@@ -79,6 +94,12 @@ namespace Eunoia {
 		};
 
 		List<DisplayEventCallback> m_Callbacks;
+
+		b32 m_PendingStepEvents[NUM_DISPLAY_EVENT_TYPES];
+		b32 m_StepEvents[NUM_DISPLAY_EVENT_TYPES];
+		v2 m_StepMousePos;
+		v2 m_StepMouseDeltaPos;
+		b32 m_HasStepMousePos;
 	};
 
 }
\ No newline at end of file
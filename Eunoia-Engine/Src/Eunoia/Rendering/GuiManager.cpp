@@ -214,8 +214,7 @@ namespace Eunoia {
 
 	b32 GuiManager::IsCheckboxChecked(ECS* ecs, EntityID checkBox)
 	{
-		const String& name = ecs->GetEntityName(checkBox);
-		EntityID checkEntity = ecs->GetChildEntity(checkBox, name + "_Check");
+		EntityID checkEntity = ecs->GetChildEntityWithNameSuffix(checkBox, "_Check");
 		return ecs->IsEntityEnabled(checkEntity);
 	}
 
@@ -237,12 +236,12 @@ namespace Eunoia {
 		PanelData* panelData = &s_Data.panelData[panel];
 
 		const v2& panelSize = ecs->GetComponent<GuiComponent>(panel)->size;
-		EntityID vScrollBar = ecs->GetChildEntity(panel, ecs->GetEntityName(panel) + "_vScrollBar");
-		EntityID hScrollBar = ecs->GetChildEntity(panel, ecs->GetEntityName(panel) + "_hScrollBar");
+		EntityID vScrollBar = ecs->GetChildEntityWithNameSuffix(panel, "_vScrollBar");
+		EntityID hScrollBar = ecs->GetChildEntityWithNameSuffix(panel, "_hScrollBar");
 
 		if(vScrollBar != EU_ECS_INVALID_ENTITY_ID)
 		{
-			EntityID vScrollBarSlider = ecs->GetChildEntity(vScrollBar, ecs->GetEntityName(vScrollBar) + "_Slider");
+			EntityID vScrollBarSlider = ecs->GetChildEntityWithNameSuffix(vScrollBar, "_Slider");
 			r32 contentHeight = panelData->currentY + panelData->currentLineHeight + panelData->lineGap;
 			r32 panelHeight = panelSize.y;
 
@@ -261,13 +260,13 @@ namespace Eunoia {
 
 	void GuiManager::AdjustTransformToScrollBar(ECS* ecs, EntityID panel, Transform2D* transform)
 	{
-		EntityID vScrollBar = ecs->GetChildEntity(panel, ecs->GetEntityName(panel) + "_vScrollBar");
-		EntityID hScrollBar = ecs->GetChildEntity(panel, ecs->GetEntityName(panel) + "_hScrollBar");
+		EntityID vScrollBar = ecs->GetChildEntityWithNameSuffix(panel, "_vScrollBar");
+		EntityID hScrollBar = ecs->GetChildEntityWithNameSuffix(panel, "_hScrollBar");
 
 		v2 offset;
 		if (vScrollBar != EU_ECS_INVALID_ENTITY_ID)
 		{
-			EntityID vScrollBarSlider = ecs->GetChildEntity(vScrollBar, ecs->GetEntityName(vScrollBar) + "_Slider");
+			EntityID vScrollBarSlider = ecs->GetChildEntityWithNameSuffix(vScrollBar, "_Slider");
 
 			r32 sliderPos = ecs->GetComponent<Transform2DComponent>(vScrollBarSlider)->localTransform.pos.y;
 			offset.x = 0.0f;
@@ -282,7 +281,7 @@ namespace Eunoia {
 		}
 		if (hScrollBar != EU_ECS_INVALID_ENTITY_ID)
 		{
-			EntityID hScrollBarSlider = ecs->GetChildEntity(hScrollBar, ecs->GetEntityName(hScrollBar) + "_Slider");
+			EntityID hScrollBarSlider = ecs->GetChildEntityWithNameSuffix(hScrollBar, "_Slider");
 		}
 
 		transform->Translate(offset);
@@ -1,5 +1,10 @@
 #include "RenderContext.h"
+#include "../Platform/Null/RenderContextNull.h"
+#include "../Utils/Log.h"
+
+#ifdef EU_PLATFORM_WINDOWS
 #include "../Platform/Vulkan/RenderContextVK.h"
+#endif
 
 namespace Eunoia {
 
@@ -23,7 +28,13 @@ namespace Eunoia {
 	{
 		switch (api)
 		{
+#ifdef EU_PLATFORM_WINDOWS
 		case RENDER_API_VULKAN: return new RenderContextVK();
+#else
+		//The Vulkan backend is only built on Windows for now
+		case RENDER_API_VULKAN: EU_LOG_WARN("The Vulkan render context is not built on this platform, using the null render context"); return new RenderContextNull();
+#endif
+		case RENDER_API_NULL: return new RenderContextNull();
 		}
 
 		return 0;
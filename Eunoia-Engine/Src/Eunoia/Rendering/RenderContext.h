@@ -31,6 +31,8 @@ namespace Eunoia {
 	enum RenderAPI
 	{
 		RENDER_API_VULKAN,
+		//Accepts every call without a GPU, used by headless worlds
+		RENDER_API_NULL,
 
 		NUM_RENDER_APIS
 	};
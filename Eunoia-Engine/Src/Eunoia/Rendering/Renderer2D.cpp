@@ -35,6 +35,9 @@ namespace Eunoia {
 		m_View = m4::CreateIdentity();
 		m_Projection = m4::CreateIdentity();
 		m_TransformStackSize = 0;
+		m_SubmitFrame = 0;
+		m_Frames[0].numSpriteGroups = 0;
+		m_Frames[1].numSpriteGroups = 0;
 
 		ShaderID spriteMapShader = m_RenderContext->LoadShader("Batch2D");
 		ShaderID occlusionMapShader = m_RenderContext->LoadShader("OcclusionMap");
@@ -397,10 +400,14 @@ namespace Eunoia {
 
 	void Renderer2D::BeginFrame()
 	{
-		m_NumSpriteGroups = 0;
-		m_ColoredSprites.Clear();
-		m_Lights.Clear();
-		m_Occluders.Clear();
+		Renderer2DFrame* frame = &m_Frames[m_SubmitFrame];
+		for (u32 i = 0; i < frame->numSpriteGroups; i++)
+			frame->spriteGroups[i].sprites.Clear();
+
+		frame->numSpriteGroups = 0;
+		frame->coloredSprites.Clear();
+		frame->lights.Clear();
+		frame->occluders.Clear();
 	}
 
 	void Renderer2D::SubmitText(const String& text, v3 pos, v4 color, r32 scale)
@@ -435,11 +442,12 @@ namespace Eunoia {
 
 	void Renderer2D::SubmitLight(const Light& light)
 	{
-		m_Lights.Push(light);
+		m_Frames[m_SubmitFrame].lights.Push(light);
 	}
 
 	void Renderer2D::SubmitSprite(const Sprite& sprite)
 	{
+		Renderer2DFrame* frame = &m_Frames[m_SubmitFrame];
 		SubmitedSprite s;
 
 		v2 pos = sprite.pos.xy();
@@ -488,7 +496,7 @@ namespace Eunoia {
 			occluder.vertices[2].pos = s.vertices[2].pos;
 			occluder.vertices[3].pos = s.vertices[3].pos;
 
-			m_Occluders.Push(occluder);
+			frame->occluders.Push(occluder);
 		}
 
 		/*s.vertices[0].pos = v3(transform * v2(0, 0) + pos, sprite.pos.z);
@@ -513,7 +521,7 @@ namespace Eunoia {
 			s.vertices[1].textureIndex = 0.0f;
 			s.vertices[2].textureIndex = 0.0f;
 			s.vertices[3].textureIndex = 0.0f;
-			m_ColoredSprites.Push(s);
+			frame->coloredSprites.Push(s);
 			return;
 		}
 		else
@@ -530,43 +538,43 @@ namespace Eunoia {
 			}
 		}
 
-		for (u32 i = 0; i < m_NumSpriteGroups; i++)
+		for (u32 i = 0; i < frame->numSpriteGroups; i++)
 		{
-			for (u32 j = 0; j < m_SpriteGroups[i].numTextures; j++)
+			for (u32 j = 0; j < frame->spriteGroups[i].numTextures; j++)
 			{
-				if (sprite.spriteSheet.texture == m_SpriteGroups[i].textures[j])
+				if (sprite.spriteSheet.texture == frame->spriteGroups[i].textures[j])
 				{
 					s.vertices[0].textureIndex = j;
 					s.vertices[1].textureIndex = j;
 					s.vertices[2].textureIndex = j;
 					s.vertices[3].textureIndex = j;
-					m_SpriteGroups[i].sprites.Push(s);
+					frame->spriteGroups[i].sprites.Push(s);
 					return;
 				}
 			}
 
-			if (m_SpriteGroups[i].numTextures != EU_MAX_ARRAY_OF_TEXTURES_SIZE)
+			if (frame->spriteGroups[i].numTextures != EU_MAX_ARRAY_OF_TEXTURES_SIZE)
 			{
-				u32 textureIndex = m_SpriteGroups[i].numTextures;
+				u32 textureIndex = frame->spriteGroups[i].numTextures;
 				s.vertices[0].textureIndex = textureIndex;
 				s.vertices[1].textureIndex = textureIndex;
 				s.vertices[2].textureIndex = textureIndex;
 				s.vertices[3].textureIndex = textureIndex;
 
-				m_SpriteGroups[i].numTextures++;
-				m_SpriteGroups[i].textures[textureIndex] = sprite.spriteSheet.texture;
-				m_SpriteGroups[i].sprites.Push(s);
+				frame->spriteGroups[i].numTextures++;
+				frame->spriteGroups[i].textures[textureIndex] = sprite.spriteSheet.texture;
+				frame->spriteGroups[i].sprites.Push(s);
 				return;
 			}
 		}
 
-		if (m_NumSpriteGroups == EU_RENDERER2D_MAX_SPRITE_GROUPS)
+		if (frame->numSpriteGroups == EU_RENDERER2D_MAX_SPRITE_GROUPS)
 		{
 			EU_LOG_ERROR("Cannot submit this sprite. Sprite group limit has been reached");
 			return;
 		}
 
-		SpriteGroup* group = &m_SpriteGroups[m_NumSpriteGroups++];
+		SpriteGroup* group = &frame->spriteGroups[frame->numSpriteGroups++];
 		group->numTextures = 1;
 		group->textures[0] = sprite.spriteSheet.texture;
 
@@ -625,38 +633,41 @@ namespace Eunoia {
 
 	void Renderer2D::EndFrame()
 	{
+		m_Frames[m_SubmitFrame].viewProjection = m_Projection * m_View;
+		m_SubmitFrame ^= 1;
+	}
+
+	void Renderer2D::RenderFrame()
+	{
+		Renderer2DFrame* frame = &m_Frames[m_SubmitFrame ^ 1];
+
 		Renderer2DVertex* vertex = (Renderer2DVertex*)m_RenderContext->MapBuffer(m_VertexBuffer);
 		
-		if (!m_Occluders.Empty())
+		if (!frame->occluders.Empty())
 		{
 			Renderer2DVertex* occluderVertex = (Renderer2DVertex*)m_RenderContext->MapBuffer(m_OcclusionVertexBuffer);
-			memcpy(occluderVertex, &m_Occluders[0], sizeof(SubmitedOccluder) * m_Occluders.Size());
+			memcpy(occluderVertex, &frame->occluders[0], sizeof(SubmitedOccluder) * frame->occluders.Size());
 			m_RenderContext->UnmapBuffer(m_OcclusionVertexBuffer);
 		}
 
-		memcpy(vertex, &m_ColoredSprites[0], sizeof(SubmitedSprite) * m_ColoredSprites.Size());
+		memcpy(vertex, &frame->coloredSprites[0], sizeof(SubmitedSprite) * frame->coloredSprites.Size());
 
-		u32 currentVertexOffset = m_ColoredSprites.Size() * 4;
+		u32 currentVertexOffset = frame->coloredSprites.Size() * 4;
 		vertex += currentVertexOffset;
 
-		for (u32 i = 0; i < m_NumSpriteGroups; i++)
+		for (u32 i = 0; i < frame->numSpriteGroups; i++)
 		{
-			m_SpriteGroups[i].vertexOffset = currentVertexOffset;
-			m_SpriteGroups[i].indexCount = m_SpriteGroups[i].sprites.Size() * 6;
+			frame->spriteGroups[i].vertexOffset = currentVertexOffset;
+			frame->spriteGroups[i].indexCount = frame->spriteGroups[i].sprites.Size() * 6;
 
-			memcpy(vertex, &m_SpriteGroups[i].sprites[0], sizeof(SubmitedSprite) * m_SpriteGroups[i].sprites.Size());
-			vertex += 4 * m_SpriteGroups[i].sprites.Size();
+			memcpy(vertex, &frame->spriteGroups[i].sprites[0], sizeof(SubmitedSprite) * frame->spriteGroups[i].sprites.Size());
+			vertex += 4 * frame->spriteGroups[i].sprites.Size();
 
-			currentVertexOffset += m_SpriteGroups[i].sprites.Size() * 4;
-
-			m_SpriteGroups[i].sprites.Clear();
+			currentVertexOffset += frame->spriteGroups[i].sprites.Size() * 4;
 		}
 
 		m_RenderContext->UnmapBuffer(m_VertexBuffer);
-	}
 
-	void Renderer2D::RenderFrame()
-	{
 		RenderPassBeginInfo beginInfo;
 		beginInfo.initialPipeline = 0;
 		beginInfo.numClearValues = 2;
@@ -668,12 +679,10 @@ namespace Eunoia {
 
 		m_RenderContext->BeginRenderPass(beginInfo);
 
-		m4 viewProjection = m_Projection * m_View;
-
-		if(!m_ColoredSprites.Empty() || m_NumSpriteGroups > 0)
-			m_RenderContext->UpdateShaderBuffer(m_PerFrameUBO, &viewProjection, sizeof(m4));
+		if(!frame->coloredSprites.Empty() || frame->numSpriteGroups > 0)
+			m_RenderContext->UpdateShaderBuffer(m_PerFrameUBO, &frame->viewProjection, sizeof(m4));
 
-		if (!m_ColoredSprites.Empty())
+		if (!frame->coloredSprites.Empty())
 		{
 			TextureGroupBind bind;
 			bind.set = 1;
@@ -689,30 +698,30 @@ namespace Eunoia {
 			command.vertexBuffer = m_VertexBuffer;
 			command.indexBuffer = m_IndexBuffer;
 			command.indexOffset = 0;
-			command.count = m_ColoredSprites.Size() * 6;
+			command.count = frame->coloredSprites.Size() * 6;
 			command.indexType = m_IndexType;
 			command.vertexOffset = 0;
 
 			m_RenderContext->SubmitRenderCommand(command);
 		}
 
-		for (u32 i = 0; i < m_NumSpriteGroups; i++)
+		for (u32 i = 0; i < frame->numSpriteGroups; i++)
 		{
 			RenderCommand command;
 			command.vertexBuffer = m_VertexBuffer;
 			command.indexBuffer = m_IndexBuffer;
 			command.indexOffset = 0;
 			command.indexType = m_IndexType;
-			command.count = m_SpriteGroups[i].indexCount;
-			command.vertexOffset = m_SpriteGroups[i].vertexOffset;
+			command.count = frame->spriteGroups[i].indexCount;
+			command.vertexOffset = frame->spriteGroups[i].vertexOffset;
 
 			TextureGroupBind bind;
 			bind.set = 1;
 			bind.numTextureBinds = 1;
 			bind.binds[0].binding = 0;
 			bind.binds[0].sampler = EU_SAMPLER_NEAREST_CLAMP_TO_EDGE;
-			bind.binds[0].textureArrayLength = m_SpriteGroups[i].numTextures;
-			memcpy(bind.binds[0].texture, m_SpriteGroups[i].textures, sizeof(TextureID) * m_SpriteGroups[i].numTextures);
+			bind.binds[0].textureArrayLength = frame->spriteGroups[i].numTextures;
+			memcpy(bind.binds[0].texture, frame->spriteGroups[i].textures, sizeof(TextureID) * frame->spriteGroups[i].numTextures);
 
 			m_RenderContext->BindTextureGroup(bind);
 			m_RenderContext->SubmitRenderCommand(command);
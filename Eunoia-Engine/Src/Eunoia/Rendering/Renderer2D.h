@@ -145,6 +145,17 @@ namespace Eunoia {
 		LightData lights[EU_RENDERER2D_MAX_LIGHT_COUNT];
 	};
 
+	//Everything RenderFrame reads, sprites are submitted into one frame while the other one is rendered
+	struct Renderer2DFrame
+	{
+		m4 viewProjection;
+		SpriteGroup spriteGroups[EU_RENDERER2D_MAX_SPRITE_GROUPS];
+		u32 numSpriteGroups;
+		List<SubmitedSprite> coloredSprites;
+		List<SubmitedOccluder> occluders;
+		List<Light> lights;
+	};
+
 	class EU_API Renderer2D
 	{
 	public:
@@ -199,11 +210,9 @@ namespace Eunoia {
 		BufferID m_IndexBuffer;
 		IndexType m_IndexType;
 
-		SpriteGroup m_SpriteGroups[EU_RENDERER2D_MAX_SPRITE_GROUPS];
-		u32 m_NumSpriteGroups;
-		List<SubmitedSprite> m_ColoredSprites;
-		List<SubmitedOccluder> m_Occluders;
-		List<Light>	m_Lights;
+		//EndFrame swaps the two, RenderFrame only reads the frame that isn't being submitted to
+		Renderer2DFrame m_Frames[2];
+		u32 m_SubmitFrame;
 		LightBufferData m_LightBufferData;
 
 		SpritePosOrigin m_Origin;
@@ -1,6 +1,7 @@
 #include "Renderer3D.h"
 
 #include "../Core/Engine.h"
+#include "../Core/Profiler.h"
 #include "Asset/AssetManager.h"
 #include "../DataStructures/Map.h"
 #include "Asset/ModelLoader.h"
@@ -95,6 +96,7 @@ namespace Eunoia {
 		m_CamPos = v3(0.0f, 0.0f, 0.0f);
 		m_ViewProjection = m4::CreateIdentity();
 		m_WireframeColor = v3(1.0f, 1.0f, 0.0);
+		m_SubmitFrame = 0;
 
 		InitDeferredRenderPass(lightingModel);
 		InitGuassianBlurRenderPass();
@@ -209,14 +211,18 @@ namespace Eunoia {
 
 	void Renderer3D::BeginFrame()
 	{
-		m_Renderables.Clear();
-		m_WireframeRenderables.Clear();
-		m_DLights.Clear();
-		m_PLights.Clear();
+		Renderer3DFrame* frame = &m_Frames[m_SubmitFrame];
+		frame->renderables.Clear();
+		frame->boneTransforms.Clear();
+		frame->wireframeRenderables.Clear();
+		frame->dlights.Clear();
+		frame->plights.Clear();
 	}
 
 	void Renderer3D::SubmitModel(const Model& model, const m4& transform, m4* boneTransforms, u32 numBoneTransforms, b32 animated, EntityID entity)
 	{
+		Renderer3DFrame* frame = &m_Frames[m_SubmitFrame];
+
 		SubmittedRenderable renderable;
 		renderable.vertexBuffer = model.vertexBuffer;
 		renderable.indexBuffer = model.indexBuffer;
@@ -225,12 +231,16 @@ namespace Eunoia {
 		renderable.materials = model.materials;
 		renderable.modifiers = model.modifiers;
 		renderable.transform = transform;
-		renderable.boneTransforms = boneTransforms;
+		renderable.firstBoneTransform = frame->boneTransforms.Size();
 		renderable.numBoneTransforms = numBoneTransforms;
 		renderable.animated = animated;
 		renderable.entityID = entity;
 
-		m_Renderables.Push(renderable);
+		//Copied since the animation keeps writing to its bones while this frame is rendered
+		for (u32 i = 0; i < numBoneTransforms; i++)
+			frame->boneTransforms.Push(boneTransforms[i]);
+
+		frame->renderables.Push(renderable);
 	}
 
 	void Renderer3D::SubmitWireframeModel(const Model& model, const m4& transform)
@@ -241,18 +251,19 @@ namespace Eunoia {
 		renderable.totalIndexCount = model.totalIndexCount;
 		renderable.transform = transform;
 
-		m_WireframeRenderables.Push(renderable);
+		m_Frames[m_SubmitFrame].wireframeRenderables.Push(renderable);
 	}
 
 	void Renderer3D::SubmitLight(const Light3D& light)
 	{
+		Renderer3DFrame* frame = &m_Frames[m_SubmitFrame];
 		if (light.type == LIGHT3D_DIRECTIONAL)
 		{
 			DirectionalLightSubmission dlight;
 			dlight.shadowInfo = light.shadowInfo;
 			dlight.light.color = light.colorAndIntensity;
 			dlight.light.direction = light.direction;
-			m_DLights.Push(dlight);
+			frame->dlights.Push(dlight);
 		}
 		else if (light.type == LIGHT3D_POINT)
 		{
@@ -260,12 +271,21 @@ namespace Eunoia {
 			plight.color = light.colorAndIntensity;
 			plight.position = light.pos;
 			plight.attenuation = light.attenuation;
-			m_PLights.Push(plight);
+			frame->plights.Push(plight);
 		}
 	}
 
 	void Renderer3D::EndFrame()
 	{
+		Renderer3DFrame* frame = &m_Frames[m_SubmitFrame];
+		frame->viewProjection = m_ViewProjection;
+		frame->camPos = m_CamPos;
+		frame->ambient = m_Ambient;
+		frame->bloomThreshold = m_BloomThreshold;
+		frame->bloomBlurIterationCount = m_BloomBlurIterationCount;
+		frame->wireframeColor = m_WireframeColor;
+
+		m_SubmitFrame ^= 1;
 	}
 
 	void Renderer3D::DoShadowMapPass()
@@ -273,8 +293,9 @@ namespace Eunoia {
 		
 	}
 
-	void Renderer3D::DoDeferredPass()
+	void Renderer3D::DoDeferredPass(const Renderer3DFrame& frame)
 	{
+		EU_PROFILE_FUNCTION();
 		RenderPassBeginInfo begin;
 		begin.initialPipeline = 0;
 		begin.renderPass = m_DeferredPass;
@@ -296,23 +317,23 @@ namespace Eunoia {
 		m_RenderContext->BeginRenderPass(begin);
 
 		GBufferPerFrameBuffer perFrame;
-		perFrame.viewProjection = m_ViewProjection;
-		perFrame.ambient = m_Ambient;
-		perFrame.camPos = m_CamPos;
+		perFrame.viewProjection = frame.viewProjection;
+		perFrame.ambient = frame.ambient;
+		perFrame.camPos = frame.camPos;
 
 		m_RenderContext->UpdateShaderBuffer(m_GBufferPerFrameBuffer, &perFrame, sizeof(GBufferPerFrameBuffer));
 		RenderCommand renderMesh;
 		renderMesh.indexType = INDEX_TYPE_U32;
 		renderMesh.vertexOffset = 0;
-		for (u32 i = 0; i < m_Renderables.Size(); i++)
+		for (u32 i = 0; i < frame.renderables.Size(); i++)
 		{
-			const SubmittedRenderable& renderable = m_Renderables[i];
+			const SubmittedRenderable& renderable = frame.renderables[i];
 			m_GBufferPerInstanceBufferData.model = renderable.transform;
 			m_GBufferPerInstanceBufferData.animated = renderable.animated;
 			m_GBufferPerInstanceBufferData.entityID = renderable.entityID;
 			m_RenderContext->UpdateShaderBuffer(m_GBufferPerInstanceBuffer, &m_GBufferPerInstanceBufferData, sizeof(GBufferPerInstanceBuffer));
 			if (renderable.numBoneTransforms > 0)
-				m_RenderContext->UpdateShaderBuffer(m_GBufferBoneBuffer, renderable.boneTransforms, sizeof(m4) * renderable.numBoneTransforms);
+				m_RenderContext->UpdateShaderBuffer(m_GBufferBoneBuffer, &frame.boneTransforms[renderable.firstBoneTransform], sizeof(m4) * renderable.numBoneTransforms);
 
 			renderMesh.vertexBuffer = renderable.vertexBuffer;
 			renderMesh.indexBuffer = renderable.indexBuffer;
@@ -331,17 +352,17 @@ namespace Eunoia {
 
 		m_RenderContext->NextSubpass();
 
-		m_RenderContext->UpdateShaderBuffer(m_LightPerFrameBuffer, &m_CamPos, sizeof(v3));
-		for (u32 i = 0; i < m_DLights.Size(); i++)
+		m_RenderContext->UpdateShaderBuffer(m_LightPerFrameBuffer, &frame.camPos, sizeof(v3));
+		for (u32 i = 0; i < frame.dlights.Size(); i++)
 		{
-			m_RenderContext->UpdateShaderBuffer(m_DLightLightBuffer, &m_DLights[i].light, sizeof(DirectionalLight));
+			m_RenderContext->UpdateShaderBuffer(m_DLightLightBuffer, &frame.dlights[i].light, sizeof(DirectionalLight));
 			m_RenderContext->SubmitRenderCommand(m_DrawQuad);
 		}
 
-		for (u32 i = 0; i < m_PLights.Size(); i++)
+		for (u32 i = 0; i < frame.plights.Size(); i++)
 		{
-			r32 scale = CalcPointLightSphereScale(m_PLights[i]) * 1.5f;
-			m4 mvp = m_ViewProjection * (m4::CreateTranslation(m_PLights[i].position) * m4::CreateScale(v3(scale, scale, scale)));
+			r32 scale = CalcPointLightSphereScale(frame.plights[i]) * 1.5f;
+			m4 mvp = frame.viewProjection * (m4::CreateTranslation(frame.plights[i].position) * m4::CreateScale(v3(scale, scale, scale)));
 
 			m_RenderContext->UpdateShaderBuffer(m_PLightMVPBuffer, &mvp, sizeof(m4));
 
@@ -350,7 +371,7 @@ namespace Eunoia {
 			m_RenderContext->SubmitRenderCommand(m_DrawBoundingSphere);
 
 			m_RenderContext->SwitchPipeline(1);
-			m_RenderContext->UpdateShaderBuffer(m_PLightBuffer, &m_PLights[i], sizeof(PointLight));
+			m_RenderContext->UpdateShaderBuffer(m_PLightBuffer, &frame.plights[i], sizeof(PointLight));
 			m_RenderContext->SubmitRenderCommand(m_DrawBoundingSphere);
 		}
 
@@ -361,11 +382,11 @@ namespace Eunoia {
 		wireframeCommand.indexOffset = 0;
 		wireframeCommand.indexType = INDEX_TYPE_U32;
 
-		for (u32 i = 0; i < m_WireframeRenderables.Size(); i++)
+		for (u32 i = 0; i < frame.wireframeRenderables.Size(); i++)
 		{
-			const SubmittedWireframeRenderable& renderable = m_WireframeRenderables[i];
+			const SubmittedWireframeRenderable& renderable = frame.wireframeRenderables[i];
 			m_RenderContext->UpdateShaderBuffer(m_WireframePerInstanceBuffer, &renderable.transform, sizeof(m4));
-			m_RenderContext->UpdateShaderBuffer(m_WireframeBuffer, &m_WireframeColor, sizeof(v3));
+			m_RenderContext->UpdateShaderBuffer(m_WireframeBuffer, &frame.wireframeColor, sizeof(v3));
 			wireframeCommand.vertexBuffer = renderable.vertexBuffer;
 			wireframeCommand.indexBuffer = renderable.indexBuffer;
 			wireframeCommand.count = renderable.totalIndexCount;
@@ -374,14 +395,15 @@ namespace Eunoia {
 		}
 
 		m_RenderContext->NextSubpass();
-		m_RenderContext->UpdateShaderBuffer(m_BloomThresholdBuffer, &m_BloomThreshold, sizeof(r32));
+		m_RenderContext->UpdateShaderBuffer(m_BloomThresholdBuffer, &frame.bloomThreshold, sizeof(r32));
 		m_RenderContext->SubmitRenderCommand(m_DrawQuad);
 
 		m_RenderContext->EndRenderPass();
 	}
 
-	void Renderer3D::DoBloomPass()
+	void Renderer3D::DoBloomPass(const Renderer3DFrame& frame)
 	{
+		EU_PROFILE_FUNCTION();
 		RenderPassBeginInfo blurBeginInfo;
 		blurBeginInfo.initialPipeline = 0;
 		blurBeginInfo.renderPass = m_GaussIter1RenderPass;
@@ -395,7 +417,7 @@ namespace Eunoia {
 		blurBind.binds[0].texture[0] = m_Textures.gbufferBloomThreshold;
 		blurBind.binds[0].textureArrayLength = 1;
 
-		for (u32 i = 0; i < m_BloomBlurIterationCount; i++)
+		for (u32 i = 0; i < frame.bloomBlurIterationCount; i++)
 		{
 			blurBeginInfo.renderPass = m_GaussIter1RenderPass;
 			if (i > 0)
@@ -418,6 +440,7 @@ namespace Eunoia {
 
 	void Renderer3D::DoFinalPass()
 	{
+		EU_PROFILE_FUNCTION();
 		TextureGroupBind finalBind;
 		finalBind.set = 0;
 		finalBind.numTextureBinds = 2;
@@ -443,8 +466,10 @@ namespace Eunoia {
 
 	void Renderer3D::RenderFrame()
 	{
-		DoDeferredPass();
-		DoBloomPass();
+		EU_PROFILE_FUNCTION();
+		const Renderer3DFrame& frame = m_Frames[m_SubmitFrame ^ 1];
+		DoDeferredPass(frame);
+		DoBloomPass(frame);
 		DoFinalPass();
 	}
 
@@ -45,7 +45,8 @@ namespace Eunoia {
 		List<LoadedMesh> meshes;
 		List<MaterialID> materials;
 		List<MaterialModifierID> modifiers;
-		m4* boneTransforms;
+		//Into the bone transforms copied into the frame
+		u32 firstBoneTransform;
 		u32 numBoneTransforms;
 		m4 transform;
 		b32 animated;
@@ -89,6 +90,23 @@ namespace Eunoia {
 		ShadowInfo shadowInfo;
 	};
 
+	//Everything RenderFrame reads, models are submitted into one frame while the other one is rendered
+	struct Renderer3DFrame
+	{
+		m4 viewProjection;
+		v3 camPos;
+		v3 ambient;
+		r32 bloomThreshold;
+		u32 bloomBlurIterationCount;
+		v3 wireframeColor;
+
+		List<SubmittedRenderable> renderables;
+		List<m4> boneTransforms;
+		List<SubmittedWireframeRenderable> wireframeRenderables;
+		List<DirectionalLightSubmission> dlights;
+		List<PointLight> plights;
+	};
+
 	class EU_API Renderer3D
 	{
 	public:
@@ -136,8 +154,8 @@ namespace Eunoia {
 		void BindMaterialModifier(MaterialModifierID modifier);
 
 		void DoShadowMapPass();
-		void DoDeferredPass();
-		void DoBloomPass();
+		void DoDeferredPass(const Renderer3DFrame& frame);
+		void DoBloomPass(const Renderer3DFrame& frame);
 		void DoFinalPass();
 	private:
 		RenderContext* m_RenderContext;
@@ -186,10 +204,9 @@ namespace Eunoia {
 
 		RenderCommand m_DrawQuad;
 		RenderCommand m_DrawBoundingSphere;
-		List<SubmittedRenderable> m_Renderables;
-		List< SubmittedWireframeRenderable> m_WireframeRenderables;
-		List<DirectionalLightSubmission> m_DLights;
-		List<PointLight> m_PLights;
+		//EndFrame swaps the two, RenderFrame only reads the frame that isn't being submitted to
+		Renderer3DFrame m_Frames[2];
+		u32 m_SubmitFrame;
 	};
 
 }
\ No newline at end of file
@@ -383,7 +383,9 @@ static void WriteConstructMetadataInfoFuntionClass(const std::string& Name, cons
 	std::string Text = "\n\n\ttemplate<>\n\tMetadataInfo Metadata::ConstructMetadataInfo<" + Name + ">()\n\t{\n\t\tMetadataInfo info;\n\t\tinfo.id = " + IDString +
 		";\n\t\tinfo.type = METADATA_CLASS;\n\t\tinfo.cls = Eunoia::Metadata::AllocateClass( " + IsEngineText + " );\n\t\tinfo.cls->name = \"" + Name + "\";\n\t\tinfo.cls->baseClassName = \"" + BaseClassName + "\";\n\t\tinfo.cls->baseClassSize = " + (BaseClassName.empty() ? "0;" : "sizeof( " + BaseClassName + " );")
 		+ "\n\t\tinfo.cls->size = sizeof( " + Name + " );\n\t\tinfo.cls->isComponent = " + IsComponent + ";\n\t\tinfo.cls->isSystem = " + IsSystem + ";\n\t\tinfo.cls->isEvent = " + IsEvent +
-		";\n\t\tinfo.cls->DefaultConstructor = Eunoia::MetadataCreateInstance< " + Name + " >;" + "\n\t\tinfo.cls->members.SetCapacityAndElementCount( " + std::to_string(Members.size()) + " );";
+		";\n\t\tinfo.cls->DefaultConstructor = Eunoia::MetadataCreateInstance< " + Name + " >;" +
+		"\n\t\tinfo.cls->CopyConstructor = Eunoia::MetadataGetCopyInstance< " + Name + " >();" +
+		"\n\t\tinfo.cls->Destructor = Eunoia::MetadataDestroyInstance< " + Name + " >;" + "\n\t\tinfo.cls->members.SetCapacityAndElementCount( " + std::to_string(Members.size()) + " );";
 
 	std::string MemberVectorInitializationText = "";
 	for (u32 i = 0; i < Members.size(); i++)
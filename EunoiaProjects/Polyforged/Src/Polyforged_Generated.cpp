@@ -19,6 +19,8 @@
 		info.cls->isSystem = false;
 		info.cls->isEvent = false;
 		info.cls->DefaultConstructor = Eunoia::MetadataCreateInstance< ThirdPersonCameraComponent >;
+		info.cls->CopyConstructor = Eunoia::MetadataGetCopyInstance< ThirdPersonCameraComponent >();
+		info.cls->Destructor = Eunoia::MetadataDestroyInstance< ThirdPersonCameraComponent >;
 		info.cls->members.SetCapacityAndElementCount( 0 );
 
 		return info;
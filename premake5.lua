@@ -32,25 +32,48 @@ project "Eunoia-Engine"
 		"%{prj.name}/Libs/Bullet/Include"
 	}
 
-	links  
-	{
-		"Eunoia-Engine/Libs/Vulkan/x64/vulkan-1",
-		"Eunoia-Engine/Libs/FreeType/x64/freetype.lib",
-		"Xinput9_1_0"
-	}
-
 	defines
 	{
 		"EU_BUILD_DLL",
 		"EU_ENGINE",
 	}
 
-	prebuildcommands
-	{
-		"call \"../Bin/Dist-windows-x86_64/Eunoia-Introspection/Eunoia-Introspection.exe\" \"Src/Eunoia/Eunoia.h\" \"Src/Eunoia/Metadata/EunoiaGenerated.cpp\""
-	}
+	filter "system:windows"
+		links  
+		{
+			"Eunoia-Engine/Libs/Vulkan/x64/vulkan-1",
+			"Eunoia-Engine/Libs/FreeType/x64/freetype.lib",
+			"Xinput9_1_0",
+			"Winmm"
+		}
 
-	filter "configurations:Debug"
+		prebuildcommands
+		{
+			"call \"../Bin/Dist-windows-x86_64/Eunoia-Introspection/Eunoia-Introspection.exe\" \"Src/Eunoia/Eunoia.h\" \"Src/Eunoia/Metadata/EunoiaGenerated.cpp\""
+		}
+
+	-- Only headless worlds run on Linux, the Win32 display and the Vulkan backend are left out
+	filter "system:linux"
+		cppdialect "C++17"
+		pic "On"
+
+		removefiles
+		{
+			"%{prj.name}/Src/Eunoia/Platform/Win32/**",
+			"%{prj.name}/Src/Eunoia/Platform/Vulkan/**"
+		}
+
+		links
+		{
+			"freetype",
+			"BulletDynamics",
+			"BulletCollision",
+			"BulletSoftBody",
+			"LinearMath",
+			"pthread"
+		}
+
+	filter { "system:windows", "configurations:Debug" }
 		buildoptions "/MDd" 
 		links
 		{
@@ -60,7 +83,7 @@ project "Eunoia-Engine"
 			"Eunoia-Engine/Libs/Bullet/x64/Debug/LinearMath_Debug"
 		}
 
-	filter "configurations:Release"
+	filter { "system:windows", "configurations:Release" }
 		buildoptions "/MD"
 		links 
 		{
@@ -71,7 +94,7 @@ project "Eunoia-Engine"
 		}
 
 
-	filter "configurations:Dist"
+	filter { "system:windows", "configurations:Dist" }
 		buildoptions "/MD"
 		links 
 		{